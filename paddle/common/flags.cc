@@ -483,6 +483,97 @@ PHI_DEFINE_EXPORTED_string(
     "on the same GPU card but may lead to more memory fragmentation "
     "(i.e., maximum batch size of models may be smaller).");
 
+/**
+ * Allocator related FLAG
+ * Name: FLAGS_use_auto_growth_cpu_allocator
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: Whether to use the chunked auto_growth best-fit allocator for
+ *       CPUPlace when FLAGS_allocator_strategy is auto_growth. Chunks are
+ *       allocated per NUMA node and reused instead of returning each block
+ *       to the system.
+ */
+PHI_DEFINE_EXPORTED_bool(
+    use_auto_growth_cpu_allocator,
+    false,
+    "Whether to use the auto_growth best-fit allocator for CPUPlace "
+    "under the auto_growth allocator strategy.");
+
+/**
+ * Allocator related FLAG
+ * Name: FLAGS_cpu_auto_growth_chunk_size_in_mb
+ * Since Version: 3.1.0
+ * Value Range: uint64, default=64 (MB)
+ * Example:
+ * Note: The minimal chunk size of the CPU auto_growth allocator.
+ *       The real chunk size is max(request_size,
+ *       FLAGS_cpu_auto_growth_chunk_size_in_mb).
+ */
+PHI_DEFINE_EXPORTED_uint64(
+    cpu_auto_growth_chunk_size_in_mb,
+    64ul,
+    "The minimal chunk size of CPU memory block in auto_growth allocator. "
+    "The real chunk size is max(request_size, "
+    "FLAGS_cpu_auto_growth_chunk_size_in_mb).");
+
+/**
+ * Allocator related FLAG
+ * Name: FLAGS_use_cpu_huge_page
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: Whether chunks of the CPU auto_growth allocator are advised to be
+ *       backed by transparent huge pages. Only takes effect on Linux.
+ */
+PHI_DEFINE_EXPORTED_bool(use_cpu_huge_page,
+                         false,
+                         "Whether to back CPU auto_growth allocator chunks "
+                         "with transparent huge pages.");
+
+/**
+ * Allocator related FLAG
+ * Name: FLAGS_use_thread_local_cpu_cache
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: Whether to put a per-thread, size-class bucketed cache in front of
+ *       the CPU allocator, so that small allocations from multiple threads
+ *       do not contend on the lock of the shared allocator.
+ */
+PHI_DEFINE_EXPORTED_bool(use_thread_local_cpu_cache,
+                         false,
+                         "Whether to cache small CPU allocations per thread.");
+
+/**
+ * Allocator related FLAG
+ * Name: FLAGS_thread_local_cpu_cache_size_in_mb
+ * Since Version: 3.1.0
+ * Value Range: uint64, default=16 (MB)
+ * Example:
+ * Note: The maximum bytes cached by each thread when
+ *       FLAGS_use_thread_local_cpu_cache is true.
+ */
+PHI_DEFINE_EXPORTED_uint64(
+    thread_local_cpu_cache_size_in_mb,
+    16ul,
+    "The maximum size of free CPU blocks cached by each thread.");
+
+/**
+ * Allocator related FLAG
+ * Name: FLAGS_thread_local_cpu_cache_spill_size_in_mb
+ * Since Version: 3.1.0
+ * Value Range: uint64, default=256 (MB)
+ * Example:
+ * Note: The maximum bytes of the pool shared by all threads, which receives
+ *       the blocks that do not fit into the cache of their owning thread.
+ *       Blocks beyond this limit are freed to the CPU allocator.
+ */
+PHI_DEFINE_EXPORTED_uint64(
+    thread_local_cpu_cache_spill_size_in_mb,
+    256ul,
+    "The maximum size of free CPU blocks spilled to the shared pool.");
+
 /**
  * Memory related FLAG
  * Name: FLAGS_fraction_of_cpu_memory_to_use
@@ -678,6 +769,24 @@ PHI_DEFINE_EXPORTED_bool(
  */
 PHI_DEFINE_EXPORTED_bool(use_mkldnn, false, "Use MKLDNN to run");
 
+/**
+ * Convolution related FLAG
+ * Name: FLAGS_conv2d_cpu_direct
+ * Since Version: 3.1.0
+ * Value Range: int32, default=-1
+ * Example: FLAGS_conv2d_cpu_direct=1 always uses the direct convolution.
+ * Note: Selects the algorithm of the conv2d kernels on CPU. The blocked
+ * direct convolution needs no im2col buffer. If it is -1, the direct
+ * convolution is used in builds without oneDNN; if it is 0, im2col + gemm is
+ * always used; if it is 1, the direct convolution is always used. 1x1
+ * convolutions which need no im2col always use gemm.
+ */
+PHI_DEFINE_EXPORTED_int32(conv2d_cpu_direct,
+                          -1,
+                          "The algorithm of the conv2d kernels on CPU, -1 "
+                          "for auto, 0 for im2col + gemm, 1 for the blocked "
+                          "direct convolution.");
+
 /**
  * Debug related FLAG
  * Name: FLAGS_call_stack_level
@@ -1618,6 +1727,22 @@ PHI_DEFINE_EXPORTED_bool(pir_apply_inplace_pass,
                          "Whether to apply inplace pass on lowering "
                          "::pir::Program to Kernel Dialect");
 
+/**
+ * Inference related FLAG
+ * Name: FLAGS_inference_static_memory_plan
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: If True, memory_optimize_pass plans the intermediate tensors of fixed
+ *       shapes into one arena, and the predictor binds every one of them to
+ *       its offset of a buffer allocated once, so that steady-state runs of
+ *       the naive executor do not call the allocator for them.
+ */
+PHI_DEFINE_EXPORTED_bool(inference_static_memory_plan,
+                         false,
+                         "Whether to plan the intermediate tensors of fixed "
+                         "shapes of inference programs into one arena.");
+
 PHI_DEFINE_EXPORTED_string(
     ir_inplace_kernel_blacklist,
     "",
@@ -1986,6 +2111,20 @@ PHI_DEFINE_EXPORTED_bool(save_cf_stack_op,
                          false,
                          "Save cf stack op for higher-order derivatives.");
 
+/**
+ * PIR serialization related FLAG
+ * Name: FLAGS_save_pir_as_binary
+ * Since Version: 3.1.0
+ * Value Range: bool, default=false
+ * Example:
+ * Note: If True, pir::WriteModule saves programs in the binary format, which
+ *       is smaller and faster to load than JSON. pir::ReadModule reads both
+ *       formats. Readable programs are always saved as JSON.
+ */
+PHI_DEFINE_EXPORTED_bool(save_pir_as_binary,
+                         false,
+                         "Save PIR programs in the binary format.");
+
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
 /**
  * FlashAttention related FLAG
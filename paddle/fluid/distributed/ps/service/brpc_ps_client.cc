@@ -18,6 +18,7 @@
 #include <sstream>
 #include <string>
 
+#include "butil/object_pool.h"
 #include "paddle/fluid/distributed/ps/service/coordinator_client.h"
 #include "paddle/fluid/framework/archive.h"
 #include "paddle/utils/string/split.h"
@@ -39,6 +40,10 @@ PD_DEFINE_int32(pserver_push_sparse_merge_limit,
                 12,
                 "limit max push_sparse local merge requests");
 
+PD_DEFINE_int32(pserver_pull_sparse_merge_limit,
+                12,
+                "limit max pull_sparse requests merged into one rpc");
+
 PD_DEFINE_int32(pserver_pull_dense_limit,
                 12,
                 "limit max push_sparse local merge requests");
@@ -88,6 +93,72 @@ inline size_t get_sparse_shard(uint32_t shard_num,
   return (key % shard_num) / local_shard_num;
 }
 
+// 按PullSparseValue::DeserializeFromBytes的格式序列化一个server的keys,
+// 有序的重复key只发送一次并记录次数. 在对象池的buffer中拼好后一次append.
+// 返回去重后的key数
+uint32_t SerializePullSparseRequest(
+    const std::vector<std::pair<uint64_t, float *>> &sorted_kvs,
+    bool is_training,
+    butil::IOBuf *request_buffer) {
+  size_t sorted_kv_size = sorted_kvs.size();
+  auto *keys_counter = butil::get_object<std::vector<uint32_t>>();
+  auto *buffer = butil::get_object<std::vector<char>>();
+  keys_counter->clear();
+  buffer->resize(sizeof(bool) +
+                 (sizeof(uint64_t) + sizeof(uint32_t)) * sorted_kv_size);
+  char *cursor = buffer->data();
+  memcpy(cursor, &is_training, sizeof(bool));
+  cursor += sizeof(bool);
+  for (size_t kv_idx = 0; kv_idx < sorted_kv_size; ++kv_idx) {
+    uint32_t keys = 1;
+    uint64_t last_key = sorted_kvs[kv_idx].first;
+    memcpy(cursor, &last_key, sizeof(uint64_t));
+    cursor += sizeof(uint64_t);
+    while (kv_idx + 1 < sorted_kv_size &&
+           last_key == sorted_kvs[kv_idx + 1].first) {
+      ++kv_idx;
+      ++keys;
+    }
+    keys_counter->push_back(keys);
+  }
+  uint32_t kv_request_count = keys_counter->size();
+  memcpy(cursor,
+         keys_counter->data(),
+         sizeof(uint32_t) * keys_counter->size());
+  cursor += sizeof(uint32_t) * keys_counter->size();
+  request_buffer->append(buffer->data(), cursor - buffer->data());
+  butil::return_object(buffer);
+  butil::return_object(keys_counter);
+  return kv_request_count;
+}
+
+// 将server返回的values按有序的kvs回填, 重复的key复制同一份value
+int32_t DeserializePullSparseResponse(
+    const std::vector<std::pair<uint64_t, float *>> &sorted_kvs,
+    const butil::IOBuf &response_buffer,
+    size_t value_size) {
+  butil::IOBufBytesIterator io_buffer_itr(response_buffer);
+  uint64_t last_key = UINT64_MAX;
+  float *last_value_data = NULL;
+  for (auto &kv_pair : sorted_kvs) {
+    if (kv_pair.first == last_key) {
+      memcpy(reinterpret_cast<void *>(kv_pair.second),
+             reinterpret_cast<void *>(last_value_data),
+             value_size);
+    } else {
+      last_key = kv_pair.first;
+      last_value_data = kv_pair.second;
+      if (value_size !=
+          io_buffer_itr.copy_and_forward(
+              reinterpret_cast<void *>(last_value_data), value_size)) {
+        LOG(WARNING) << "res data is lack or not in format";
+        return -1;
+      }
+    }
+  }
+  return 0;
+}
+
 void DownpourPsClientService::service(
     ::google::protobuf::RpcController *controller,
     const PsRequestMessage *request,
@@ -344,12 +415,15 @@ int32_t BrpcPsClient::Initialize() {
       _push_sparse_merge_count_map[table_id] = 0;
     }
   }
+  _pull_sparse_task_queue =
+      ::paddle::framework::MakeChannel<SparsePullAsyncTask *>();
 
   auto &profiler = CostProfiler::instance();
   profiler.register_profiler("pserver_client_pull_dense");
   profiler.register_profiler("pserver_client_pull_sparse");
   profiler.register_profiler("pserver_client_pull_sparse_param");
   profiler.register_profiler("pserver_client_pull_sparse_local");
+  profiler.register_profiler("pserver_client_pull_sparse_pipelined");
   profiler.register_profiler("pserver_client_push_sparse");
   profiler.register_profiler("pserver_client_push_sparse_parse");
   profiler.register_profiler("client_push_sparse_put");
@@ -369,6 +443,8 @@ int32_t BrpcPsClient::Initialize() {
   _async_push_sparse_thread =
       std::thread(std::bind(&BrpcPsClient::PushSparseTaskConsume, this));
   // _async_push_sparse_thread.detach();
+  _async_pull_sparse_thread =
+      std::thread(std::bind(&BrpcPsClient::PullSparseTaskConsume, this));
   _async_push_dense_thread =
       std::thread(std::bind(&BrpcPsClient::PushDenseTaskConsume, this));
   // for debug
@@ -725,6 +801,8 @@ void BrpcPsClient::FinalizeWorker() {
   _running = false;
   _async_push_dense_thread.join();
   _async_push_sparse_thread.join();
+  _pull_sparse_task_queue->Close();
+  _async_pull_sparse_thread.join();
   // _print_thread.join();
   VLOG(0) << "BrpcPsClient::FinalizeWorker begin join server";
   _server.Stop(1000);
@@ -1149,16 +1227,7 @@ std::future<int32_t> BrpcPsClient::PullSparse(float **select_values,
       std::vector<std::vector<std::pair<uint64_t, float *>>>>();
   shard_sorted_kvs->resize(request_call_num);
 
-  const auto &server_param = _config.server_param().downpour_server_param();
-  uint64_t shard_num = FLAGS_pserver_sparse_table_shard_num;
-  for (int i = 0; i < server_param.downpour_table_param_size(); ++i) {
-    const auto &table_param = server_param.downpour_table_param(i);
-    if (table_param.table_id() == table_id) {
-      shard_num = table_param.shard_num();
-      break;
-    }
-  }
-
+  uint64_t shard_num = GetSparseShardNum(table_id);
   for (size_t i = 0; i < num; ++i) {
     size_t shard_id = get_sparse_shard(shard_num, request_call_num, keys[i]);
     shard_sorted_kvs->at(shard_id).push_back({keys[i], select_values[i]});
@@ -1173,34 +1242,14 @@ std::future<int32_t> BrpcPsClient::PullSparse(float **select_values,
         int ret = 0;
         auto *closure = reinterpret_cast<DownpourBrpcClosure *>(done);
         for (size_t i = 0; i < shard_sorted_kvs->size(); ++i) {
-          if (closure->check_response(i, PS_PULL_SPARSE_TABLE) != 0) {
+          if (closure->check_response(i, PS_PULL_SPARSE_TABLE) != 0 ||
+              DeserializePullSparseResponse(
+                  shard_sorted_kvs->at(i),
+                  closure->cntl(i)->response_attachment(),
+                  value_size) != 0) {
             ret = -1;
             break;
           }
-
-          auto &request_kvs = shard_sorted_kvs->at(i);
-          auto &res_io_buffer = closure->cntl(i)->response_attachment();
-          butil::IOBufBytesIterator io_buffer_itr(res_io_buffer);
-          uint64_t last_key = UINT64_MAX;
-          float *last_value_data = NULL;
-
-          for (auto &kv_pair : request_kvs) {
-            if (kv_pair.first == last_key) {
-              memcpy(reinterpret_cast<void *>(kv_pair.second),
-                     reinterpret_cast<void *>(last_value_data),
-                     value_size);
-            } else {
-              last_key = kv_pair.first;
-              last_value_data = kv_pair.second;
-              if (value_size !=
-                  io_buffer_itr.copy_and_forward(
-                      reinterpret_cast<void *>(last_value_data), value_size)) {
-                LOG(WARNING) << "res data is lack or not in format";
-                ret = -1;
-                break;
-              }
-            }
-          }
         }
         closure->set_promise_value(ret);
       });
@@ -1209,8 +1258,28 @@ std::future<int32_t> BrpcPsClient::PullSparse(float **select_values,
   closure->add_promise(promise);
   std::future<int> fut = promise->get_future();
 
-  for (size_t i = 0; i < request_call_num; ++i) {
-    auto &sorted_kvs = shard_sorted_kvs->at(i);
+  PullSparseSendRequests(closure, *shard_sorted_kvs, table_id, is_training);
+  return fut;
+}
+
+uint64_t BrpcPsClient::GetSparseShardNum(size_t table_id) {
+  const auto &server_param = _config.server_param().downpour_server_param();
+  for (int i = 0; i < server_param.downpour_table_param_size(); ++i) {
+    const auto &table_param = server_param.downpour_table_param(i);
+    if (table_param.table_id() == table_id) {
+      return table_param.shard_num();
+    }
+  }
+  return FLAGS_pserver_sparse_table_shard_num;
+}
+
+void BrpcPsClient::PullSparseSendRequests(
+    DownpourBrpcClosure *closure,
+    std::vector<std::vector<std::pair<uint64_t, float *>>> &shard_sorted_kvs,
+    size_t table_id,
+    bool is_training) {
+  for (size_t i = 0; i < shard_sorted_kvs.size(); ++i) {
+    auto &sorted_kvs = shard_sorted_kvs[i];
     std::sort(sorted_kvs.begin(),
               sorted_kvs.end(),
               [](const std::pair<uint64_t, float *> &k1,
@@ -1218,31 +1287,9 @@ std::future<int32_t> BrpcPsClient::PullSparse(float **select_values,
                 return k1.first < k2.first;
               });
 
-    uint64_t last_key = UINT64_MAX;
-    uint32_t kv_request_count = 0;
-    size_t sorted_kv_size = sorted_kvs.size();
     auto &request_buffer = closure->cntl(i)->request_attachment();
-
-    request_buffer.append(reinterpret_cast<void *>(&is_training), sizeof(bool));
-    std::vector<uint32_t> keys_counter;
-    keys_counter.reserve(sorted_kv_size);
-
-    for (size_t kv_idx = 0; kv_idx < sorted_kv_size; ++kv_idx) {
-      ++kv_request_count;
-      uint32_t keys = 1;
-      last_key = sorted_kvs[kv_idx].first;
-      request_buffer.append(reinterpret_cast<void *>(&last_key),
-                            sizeof(uint64_t));
-      while (kv_idx < sorted_kv_size - 1 &&
-             last_key == sorted_kvs[kv_idx + 1].first) {
-        ++kv_idx;
-        ++keys;
-      }
-      keys_counter.push_back(keys);
-    }
-
-    request_buffer.append(reinterpret_cast<void *>(keys_counter.data()),
-                          sizeof(uint32_t) * keys_counter.size());
+    uint32_t kv_request_count =
+        SerializePullSparseRequest(sorted_kvs, is_training, &request_buffer);
 
     if (kv_request_count == 0) {
       closure->Run();
@@ -1258,9 +1305,98 @@ std::future<int32_t> BrpcPsClient::PullSparse(float **select_values,
           closure->cntl(i), closure->request(i), closure->response(i), closure);
     }
   }
+}
+
+std::future<int32_t> BrpcPsClient::PullSparsePipelined(float **select_values,
+                                                       size_t table_id,
+                                                       const uint64_t *keys,
+                                                       size_t num,
+                                                       bool is_training) {
+  auto timer =
+      std::make_shared<CostTimer>("pserver_client_pull_sparse_pipelined");
+  SparsePullTaskData data;
+  data.select_values = select_values;
+  data.keys = keys;
+  data.num = num;
+  data.is_training = is_training;
+  auto *async_task = new SparsePullAsyncTask(data, table_id, timer);
+  std::future<int32_t> fut = async_task->get_future();
+  _pull_sparse_task_queue->Put(std::move(async_task));
   return fut;
 }
 
+void BrpcPsClient::PullSparseTaskConsume() {
+  size_t merge_size = FLAGS_pserver_pull_sparse_merge_limit > 0
+                          ? FLAGS_pserver_pull_sparse_merge_limit
+                          : 1;
+  std::vector<SparsePullAsyncTask *> task_list;
+  // 阻塞直到有task, 取出已排队的task一起发送; 队列关闭且取空后返回0
+  while (_pull_sparse_task_queue->ReadOnce(task_list, merge_size) > 0) {
+    size_t begin = 0;
+    while (begin < task_list.size()) {
+      // 只合并相邻的同table同is_training的task
+      size_t end = begin + 1;
+      while (end < task_list.size() &&
+             task_list[end]->table_id() == task_list[begin]->table_id() &&
+             task_list[end]->data().is_training ==
+                 task_list[begin]->data().is_training) {
+        ++end;
+      }
+      PullSparseMergedTasks(task_list, begin, end);
+      begin = end;
+    }
+    for (auto *task : task_list) {
+      delete task;
+    }
+    task_list.clear();
+  }
+}
+
+void BrpcPsClient::PullSparseMergedTasks(
+    std::vector<SparsePullAsyncTask *> &task_list, size_t begin, size_t end) {
+  size_t table_id = task_list[begin]->table_id();
+  bool is_training = task_list[begin]->data().is_training;
+  size_t request_call_num = _server_channels.size();
+
+  auto shard_sorted_kvs = std::make_shared<
+      std::vector<std::vector<std::pair<uint64_t, float *>>>>();
+  shard_sorted_kvs->resize(request_call_num);
+  uint64_t shard_num = GetSparseShardNum(table_id);
+  for (size_t task_idx = begin; task_idx < end; ++task_idx) {
+    auto &data = task_list[task_idx]->data();
+    for (size_t i = 0; i < data.num; ++i) {
+      size_t shard_id =
+          get_sparse_shard(shard_num, request_call_num, data.keys[i]);
+      shard_sorted_kvs->at(shard_id).push_back(
+          {data.keys[i], data.select_values[i]});
+    }
+  }
+
+  auto *accessor = GetTableAccessor(table_id);
+  size_t value_size = accessor->GetAccessorInfo().select_size;
+  DownpourBrpcClosure *closure = new DownpourBrpcClosure(
+      request_call_num, [shard_sorted_kvs, value_size](void *done) {
+        int ret = 0;
+        auto *closure = reinterpret_cast<DownpourBrpcClosure *>(done);
+        for (size_t i = 0; i < shard_sorted_kvs->size(); ++i) {
+          if (closure->check_response(i, PS_PULL_SPARSE_TABLE) != 0 ||
+              DeserializePullSparseResponse(
+                  shard_sorted_kvs->at(i),
+                  closure->cntl(i)->response_attachment(),
+                  value_size) != 0) {
+            ret = -1;
+            break;
+          }
+        }
+        closure->set_promise_value(ret);
+      });
+  for (size_t task_idx = begin; task_idx < end; ++task_idx) {
+    closure->add_timer(task_list[task_idx]->timer());
+    closure->add_promise(task_list[task_idx]->promise());
+  }
+  PullSparseSendRequests(closure, *shard_sorted_kvs, table_id, is_training);
+}
+
 // for GEO
 std::future<int32_t> BrpcPsClient::PullSparseParam(float **select_values,
                                                    size_t table_id,
@@ -193,6 +193,14 @@ struct SparseTaskPool {
   std::mutex _mutex;
 };
 
+// 一次PullSparsePipelined调用, 指针由调用方持有
+struct SparsePullTaskData {
+  float **select_values = nullptr;
+  const uint64_t *keys = nullptr;
+  size_t num = 0;
+  bool is_training = false;
+};
+
 template <class T>
 struct array_deleter {
   void operator()(T *&x) const { delete[] x; }  // NOLINT
@@ -212,6 +220,12 @@ class BrpcPsClient : public PSClient {
     if (_async_push_sparse_thread.joinable()) {
       _async_push_sparse_thread.join();
     }
+    if (_pull_sparse_task_queue) {
+      _pull_sparse_task_queue->Close();
+    }
+    if (_async_pull_sparse_thread.joinable()) {
+      _async_pull_sparse_thread.join();
+    }
     if (_server_started) {
       _server.Stop(1000);
       _server.Join();
@@ -267,6 +281,11 @@ class BrpcPsClient : public PSClient {
                                           const uint64_t *keys,
                                           size_t num,
                                           bool is_training);
+  std::future<int32_t> PullSparsePipelined(float **select_values,
+                                           size_t table_id,
+                                           const uint64_t *keys,
+                                           size_t num,
+                                           bool is_training) override;
   virtual std::future<int32_t> PullSparseParam(float **select_values,
                                                size_t table_id,
                                                const uint64_t *keys,
@@ -368,6 +387,10 @@ class BrpcPsClient : public PSClient {
   std::unordered_map<uint32_t, paddle::framework::Channel<SparseAsyncTask *>>
       _push_sparse_task_queue_map;
   std::unordered_map<uint32_t, uint32_t> _push_sparse_merge_count_map;
+  // 异步pull sparse task, 合并后发送, 不等待返回
+  std::thread _async_pull_sparse_thread;
+  typedef AsyncRequestTask<SparsePullTaskData> SparsePullAsyncTask;
+  paddle::framework::Channel<SparsePullAsyncTask *> _pull_sparse_task_queue;
 
   std::thread _print_thread;
 
@@ -386,6 +409,18 @@ class BrpcPsClient : public PSClient {
       DownpourBrpcClosure *closure,
       ValueAccessor *accessor);
 
+  void PullSparseTaskConsume();
+  // 合并task_list[begin, end)的keys, 按server分片发送
+  void PullSparseMergedTasks(std::vector<SparsePullAsyncTask *> &task_list,
+                             size_t begin,
+                             size_t end);
+  uint64_t GetSparseShardNum(size_t table_id);
+  void PullSparseSendRequests(
+      DownpourBrpcClosure *closure,
+      std::vector<std::vector<std::pair<uint64_t, float *>>> &shard_sorted_kvs,
+      size_t table_id,
+      bool is_training);
+
   SparseTaskPool _sparse_task_pool;
 
   std::vector<std::shared_ptr<brpc::Channel>>
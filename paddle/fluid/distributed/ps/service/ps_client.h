@@ -137,6 +137,17 @@ class PSClient {
                                           size_t num,
                                           bool is_training) = 0;
 
+  // 流水线版本的PullSparse: 调用方无需等待上一批返回即可发起下一批,
+  // 并发请求同一table的keys会合并去重后发送. select_values和keys须保持有效,
+  // 直到返回的future就绪.
+  virtual std::future<int32_t> PullSparsePipelined(float **select_values,
+                                                   size_t table_id,
+                                                   const uint64_t *keys,
+                                                   size_t num,
+                                                   bool is_training) {
+    return PullSparse(select_values, table_id, keys, num, is_training);
+  }
+
   virtual std::future<int32_t> PullSparseParam(float **select_values UNUSED,
                                                size_t table_id UNUSED,
                                                const uint64_t *keys UNUSED,
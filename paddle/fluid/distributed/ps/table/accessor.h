@@ -155,6 +155,11 @@ class ValueAccessor {
   virtual std::string ParseToString(const float* value, int param) = 0;
   //  parse value from string, used to load model
   virtual int32_t ParseFromString(const std::string& data, float* value) = 0;
+  // number of leading floats of value kept in the binary shard file, which
+  // should drop the same fields as ParseToString
+  virtual int ParseToBinarySize(const float* value UNUSED, int size) {
+    return size;
+  }
 
   virtual FsDataConverter Converter(int param) {
     FsDataConverter data_convert;
@@ -14,6 +14,8 @@
 
 #include "paddle/fluid/distributed/ps/table/ctr_accessor.h"
 
+#include <algorithm>
+
 #include "glog/logging.h"
 #include "paddle/common/flags.h"
 #include "paddle/fluid/platform/enforce.h"
@@ -333,6 +335,18 @@ std::string CtrCommonAccessor::ParseToString(const float* v, int param) {
   return os.str();
 }
 
+int CtrCommonAccessor::ParseToBinarySize(const float* v, int size) {
+  // Same as ParseToString, embedx is dropped if the score is low.
+  auto show = common_feature_value.Show(const_cast<float*>(v));
+  auto click = common_feature_value.Click(const_cast<float*>(v));
+  auto score = ShowClickScore(show, click);
+  if (score >= _config.embedx_threshold() &&
+      size > common_feature_value.EmbedxWIndex()) {
+    return size;
+  }
+  return std::min(size, common_feature_value.EmbedxWIndex());
+}
+
 int CtrCommonAccessor::ParseFromString(const std::string& str, float* value) {
   _embedx_sgd_rule->InitValue(value + common_feature_value.EmbedxWIndex(),
                               value + common_feature_value.EmbedxG2SumIndex());
@@ -176,6 +176,7 @@ class CtrCommonAccessor : public ValueAccessor {
 
   std::string ParseToString(const float* value, int param) override;
   int32_t ParseFromString(const std::string& str, float* v) override;
+  int ParseToBinarySize(const float* value, int size) override;
   virtual bool CreateValue(int type, const float* value);
 
   // 这个接口目前只用来取show
@@ -0,0 +1,463 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <thread>
+#include <utility>
+
+#include "paddle/fluid/distributed/common/chunk_allocator.h"
+#include "paddle/fluid/distributed/ps/table/depends/feature_value.h"
+#include "paddle/phi/core/memory/allocation/spin_lock.h"
+
+namespace paddle {
+namespace distributed {
+
+// An open-addressing hash map from feasign to feature value, which could be
+// read and updated by several threads at the same time.
+//
+// Like SparseTableShard, keys are split into CTR_SPARSE_SHARD_BUCKET_NUM
+// segments by the high bits of their hash, each segment is a linear probing
+// table. Lookups, inserts and value updates hold the segment lock in shared
+// mode, only growing the table, erasing and clearing hold it exclusively.
+// Accesses to a value are serialized by a spin lock embedded in its slot, so
+// threads working on different keys of the same shard do not block each
+// other. Values are never moved once created.
+//
+// Erased slots are left as tombstones until the segment is rehashed, so
+// erasing while iterating with the sequential interface (begin/end/erase)
+// is safe. The sequential interface itself must not race with concurrent
+// inserts, as is the case with SparseTableShard.
+template <class KEY, class VALUE, class ALLOC = ChunkAllocator<VALUE>>
+class alignas(64) ConcurrentSparseTableShard {
+ private:
+  static constexpr uint32_t kEmpty = 0;
+  static constexpr uint32_t kInserting = 1;
+  static constexpr uint32_t kFull = 2;
+  static constexpr uint32_t kDeleted = 3;
+  static constexpr uint32_t kStateMask = 3;
+  static constexpr uint32_t kLocked = 4;
+  static constexpr size_t kMinCapacity = 16;
+
+  struct Slot {
+    std::atomic<uint32_t> state{kEmpty};
+    KEY key;
+    VALUE* value{nullptr};
+  };
+
+  struct alignas(64) Segment {
+    // Writer preferred shared spin lock.
+    std::atomic<int32_t> readers{0};
+    std::atomic<bool> writer{false};
+    std::unique_ptr<Slot[]> slots;
+    size_t capacity{0};
+    std::atomic<size_t> size{0};
+    // Number of occupied slots, including the reserved and deleted ones.
+    std::atomic<size_t> used{0};
+    memory::SpinLock alloc_lock;
+    ALLOC alloc;
+  };
+
+  class SharedGuard {
+   public:
+    explicit SharedGuard(Segment* seg) : seg_(seg) {
+      for (;;) {
+        while (seg_->writer.load()) {
+          memory::CpuRelax();
+        }
+        seg_->readers.fetch_add(1);
+        if (!seg_->writer.load()) {
+          return;
+        }
+        seg_->readers.fetch_sub(1);
+      }
+    }
+    ~SharedGuard() { seg_->readers.fetch_sub(1); }
+
+   private:
+    Segment* seg_;
+  };
+
+  class ExclusiveGuard {
+   public:
+    explicit ExclusiveGuard(Segment* seg) : seg_(seg) {
+      while (seg_->writer.exchange(true)) {
+        std::this_thread::yield();
+      }
+      while (seg_->readers.load() != 0) {
+        memory::CpuRelax();
+      }
+    }
+    ~ExclusiveGuard() { seg_->writer.store(false); }
+
+   private:
+    Segment* seg_;
+  };
+
+  class SlotGuard {
+   public:
+    explicit SlotGuard(Slot* slot, bool locked = false) : slot_(slot) {
+      if (locked) {
+        return;
+      }
+      for (;;) {
+        uint32_t state = slot_->state.load(std::memory_order_relaxed);
+        if (!(state & kLocked) &&
+            slot_->state.compare_exchange_weak(state,
+                                               state | kLocked,
+                                               std::memory_order_acquire,
+                                               std::memory_order_relaxed)) {
+          return;
+        }
+        memory::CpuRelax();
+      }
+    }
+    ~SlotGuard() {
+      slot_->state.fetch_and(~kLocked, std::memory_order_release);
+    }
+
+   private:
+    Slot* slot_;
+  };
+
+ public:
+  struct iterator {
+    ConcurrentSparseTableShard* shard;
+    size_t segment;
+    size_t pos;
+    friend bool operator==(const iterator& a, const iterator& b) {
+      return a.segment == b.segment && a.pos == b.pos;
+    }
+    friend bool operator!=(const iterator& a, const iterator& b) {
+      return !(a == b);
+    }
+    const KEY& key() const { return slot().key; }
+    VALUE& value() const { return *slot().value; }
+    VALUE* value_ptr() const { return slot().value; }
+    iterator& operator++() {
+      ++pos;
+      shard->skip_empty(this);
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator ret = *this;
+      ++*this;
+      return ret;
+    }
+
+   private:
+    Slot& slot() const { return shard->_segments[segment].slots[pos]; }
+  };
+
+  ConcurrentSparseTableShard() = default;
+  ConcurrentSparseTableShard(const ConcurrentSparseTableShard&) = delete;
+  ConcurrentSparseTableShard& operator=(const ConcurrentSparseTableShard&) =
+      delete;
+  ~ConcurrentSparseTableShard() { clear(); }
+
+  bool empty() { return size() == 0; }
+  size_t size() {
+    size_t total = 0;
+    for (auto& seg : _segments) {
+      total += seg.size.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+  // Must be set before the shard is used.
+  void set_max_load_factor(float x) {
+    PADDLE_ENFORCE_EQ(
+        x > 0.0f && x < 1.0f,
+        true,
+        common::errors::InvalidArgument(
+            "The max load factor of ConcurrentSparseTableShard must be in "
+            "(0, 1), but received %f.",
+            x));
+    _max_load_factor = x;
+  }
+
+  // Only for the allocators of fixed size values, must be called before the
+  // shard is used.
+  void set_value_capacity(size_t capacity) {
+    for (auto& seg : _segments) {
+      seg.alloc.set_value_capacity(capacity);
+    }
+  }
+
+  void clear() {
+    for (auto& seg : _segments) {
+      ExclusiveGuard guard(&seg);
+      for (size_t pos = 0; pos < seg.capacity; ++pos) {
+        Slot& slot = seg.slots[pos];
+        if ((slot.state.load(std::memory_order_relaxed) & kStateMask) ==
+            kFull) {
+          seg.alloc.release(slot.value);
+        }
+      }
+      seg.slots.reset();
+      seg.capacity = 0;
+      seg.size.store(0, std::memory_order_relaxed);
+      seg.used.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  // Call fn(VALUE&) with the value of key locked, returns false if key does
+  // not exist.
+  template <class FN>
+  bool apply_if_exists(const KEY& key, FN&& fn) {
+    size_t hash = compute_hash(key);
+    Segment* seg = &_segments[compute_bucket(hash)];
+    SharedGuard guard(seg);
+    Slot* slot = find_slot(seg, key, hash);
+    if (slot == nullptr) {
+      return false;
+    }
+    SlotGuard slot_guard(slot);
+    fn(*slot->value);
+    return true;
+  }
+
+  // Like apply_if_exists, but creates the value if key does not exist, and
+  // calls init(VALUE&) on it before fn. Other threads are not able to access
+  // the value until init returns. Returns whether the value is created.
+  template <class INIT, class FN>
+  bool apply_or_create(const KEY& key, INIT&& init, FN&& fn) {
+    size_t hash = compute_hash(key);
+    Segment* seg = &_segments[compute_bucket(hash)];
+    for (;;) {
+      {
+        SharedGuard guard(seg);
+        Slot* slot = find_slot(seg, key, hash);
+        if (slot != nullptr) {
+          SlotGuard slot_guard(slot);
+          fn(*slot->value);
+          return false;
+        }
+        bool inserted = false;
+        slot = insert_slot(seg, key, hash, &inserted);
+        if (slot != nullptr) {
+          // A newly inserted slot is published locked.
+          SlotGuard slot_guard(slot, inserted);
+          if (inserted) {
+            init(*slot->value);
+          }
+          fn(*slot->value);
+          return inserted;
+        }
+      }
+      grow(seg);
+    }
+  }
+
+  // Sequential interface, compatible with SparseTableShard.
+  VALUE& operator[](const KEY& key) {
+    VALUE* value = nullptr;
+    apply_or_create(
+        key, [](VALUE&) {}, [&value](VALUE& v) { value = &v; });
+    return *value;
+  }
+  iterator begin() {
+    iterator it{this, 0, 0};
+    skip_empty(&it);
+    return it;
+  }
+  iterator end() { return {this, CTR_SPARSE_SHARD_BUCKET_NUM, 0}; }
+  iterator find(const KEY& key) {
+    size_t hash = compute_hash(key);
+    size_t bucket = compute_bucket(hash);
+    Segment* seg = &_segments[bucket];
+    SharedGuard guard(seg);
+    Slot* slot = find_slot(seg, key, hash);
+    if (slot == nullptr) {
+      return end();
+    }
+    return {this, bucket, static_cast<size_t>(slot - seg->slots.get())};
+  }
+  iterator erase(iterator it) {
+    Segment* seg = &_segments[it.segment];
+    {
+      ExclusiveGuard guard(seg);
+      Slot& slot = seg->slots[it.pos];
+      seg->alloc.release(slot.value);
+      slot.value = nullptr;
+      slot.state.store(kDeleted, std::memory_order_relaxed);
+      seg->size.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return ++it;
+  }
+  size_t erase(const KEY& key) {
+    auto it = find(key);
+    if (it == end()) {
+      return 0;
+    }
+    erase(it);
+    return 1;
+  }
+
+ private:
+  static size_t compute_hash(const KEY& key) {
+    // std::hash of integers is the identity, mix the bits so that both the
+    // high bits (segment) and the low bits (slot) are well distributed.
+    uint64_t h = std::hash<KEY>()(key);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return static_cast<size_t>(h);
+  }
+  static size_t compute_bucket(size_t hash) {
+    if (CTR_SPARSE_SHARD_BUCKET_NUM == 1) {
+      return 0;
+    }
+    return hash >> (sizeof(size_t) * 8 - CTR_SPARSE_SHARD_BUCKET_NUM_BITS);
+  }
+  size_t max_used(size_t capacity) const {
+    return static_cast<size_t>(capacity * _max_load_factor);
+  }
+
+  // Wait for a slot being inserted by another thread to become readable.
+  static uint32_t stable_state(const Slot& slot) {
+    uint32_t state = slot.state.load(std::memory_order_acquire);
+    while ((state & kStateMask) == kInserting) {
+      memory::CpuRelax();
+      state = slot.state.load(std::memory_order_acquire);
+    }
+    return state & kStateMask;
+  }
+
+  // Requires the segment lock in shared mode.
+  Slot* find_slot(Segment* seg, const KEY& key, size_t hash) {
+    size_t mask = seg->capacity - 1;
+    for (size_t i = 0, pos = hash & mask; i < seg->capacity;
+         ++i, pos = (pos + 1) & mask) {
+      Slot& slot = seg->slots[pos];
+      uint32_t state = stable_state(slot);
+      if (state == kEmpty) {
+        return nullptr;
+      }
+      if (state == kFull && slot.key == key) {
+        return &slot;
+      }
+    }
+    return nullptr;
+  }
+
+  // Requires the segment lock in shared mode. Returns nullptr if the segment
+  // has to grow first.
+  Slot* insert_slot(Segment* seg, const KEY& key, size_t hash, bool* inserted) {
+    // Reserve a slot first so that an empty slot always exists to end the
+    // probing of other threads.
+    if (seg->used.fetch_add(1, std::memory_order_relaxed) + 1 >
+        max_used(seg->capacity)) {
+      seg->used.fetch_sub(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    size_t mask = seg->capacity - 1;
+    size_t pos = hash & mask;
+    for (;;) {
+      Slot& slot = seg->slots[pos];
+      uint32_t state = stable_state(slot);
+      if (state == kEmpty) {
+        uint32_t expected = kEmpty;
+        if (!slot.state.compare_exchange_strong(expected,
+                                                kInserting,
+                                                std::memory_order_acquire,
+                                                std::memory_order_relaxed)) {
+          continue;  // Lost the race, check the slot again.
+        }
+        slot.key = key;
+        {
+          std::lock_guard<memory::SpinLock> guard(seg->alloc_lock);
+          slot.value = seg->alloc.acquire();
+        }
+        slot.state.store(kFull | kLocked, std::memory_order_release);
+        seg->size.fetch_add(1, std::memory_order_relaxed);
+        *inserted = true;
+        return &slot;
+      }
+      if (state == kFull && slot.key == key) {
+        // Inserted by another thread in the meantime.
+        seg->used.fetch_sub(1, std::memory_order_relaxed);
+        *inserted = false;
+        return &slot;
+      }
+      pos = (pos + 1) & mask;
+    }
+  }
+
+  void grow(Segment* seg) {
+    ExclusiveGuard guard(seg);
+    size_t used = seg->used.load(std::memory_order_relaxed);
+    if (seg->capacity != 0 && used + 1 <= max_used(seg->capacity)) {
+      return;  // Grown by another thread.
+    }
+    size_t size = seg->size.load(std::memory_order_relaxed);
+    // Tombstones are dropped by rehash, so rehash in place if they take up
+    // a lot of the segment, otherwise double the capacity.
+    size_t capacity = std::max(seg->capacity, kMinCapacity);
+    if (size + 1 > max_used(capacity) / 2) {
+      capacity *= 2;
+    }
+    while (size + 1 > max_used(capacity)) {
+      capacity *= 2;
+    }
+    std::unique_ptr<Slot[]> slots(new Slot[capacity]);
+    size_t mask = capacity - 1;
+    for (size_t i = 0; i < seg->capacity; ++i) {
+      Slot& old_slot = seg->slots[i];
+      if ((old_slot.state.load(std::memory_order_relaxed) & kStateMask) !=
+          kFull) {
+        continue;
+      }
+      size_t pos = compute_hash(old_slot.key) & mask;
+      while (slots[pos].state.load(std::memory_order_relaxed) != kEmpty) {
+        pos = (pos + 1) & mask;
+      }
+      slots[pos].key = old_slot.key;
+      slots[pos].value = old_slot.value;
+      slots[pos].state.store(kFull, std::memory_order_relaxed);
+    }
+    VLOG(5) << "Rehash concurrent sparse table segment from " << seg->capacity
+            << " to " << capacity << " slots, size " << size;
+    seg->slots = std::move(slots);
+    seg->capacity = capacity;
+    seg->used.store(size, std::memory_order_relaxed);
+  }
+
+  void skip_empty(iterator* it) {
+    while (it->segment < CTR_SPARSE_SHARD_BUCKET_NUM) {
+      Segment& seg = _segments[it->segment];
+      while (it->pos < seg.capacity) {
+        if ((seg.slots[it->pos].state.load(std::memory_order_relaxed) &
+             kStateMask) == kFull) {
+          return;
+        }
+        ++it->pos;
+      }
+      ++it->segment;
+      it->pos = 0;
+    }
+  }
+
+  Segment _segments[CTR_SPARSE_SHARD_BUCKET_NUM];
+  float _max_load_factor{0.75f};
+};
+
+}  // namespace distributed
+}  // namespace paddle
@@ -41,7 +41,9 @@ class FixedFeatureValue {
   std::vector<float> _data;
 };
 
-template <class KEY, class VALUE>
+// ALLOC allocates the values, e.g., ChunkAllocator<FixedFeatureValue> or
+// SlabFeatureValueAllocator.
+template <class KEY, class VALUE, class ALLOC = ChunkAllocator<VALUE>>
 struct alignas(64) SparseTableShard {
  public:
   typedef typename mct::closed_hash_map<KEY, mct::Pointer, std::hash<KEY>>
@@ -100,6 +102,11 @@ struct alignas(64) SparseTableShard {
       _buckets[bucket].max_load_factor(x);
     }
   }
+  // Only for the allocators of fixed size values, must be called before the
+  // shard is used.
+  void set_value_capacity(size_t capacity) {
+    _alloc.set_value_capacity(capacity);
+  }
   size_t bucket_count() { return CTR_SPARSE_SHARD_BUCKET_NUM; }
   size_t bucket_size(size_t bucket) { return _buckets[bucket].size(); }
   void clear() {
@@ -195,7 +202,7 @@ struct alignas(64) SparseTableShard {
 
  private:
   map_type _buckets[CTR_SPARSE_SHARD_BUCKET_NUM];
-  ChunkAllocator<VALUE> _alloc;
+  ALLOC _alloc;
   std::hash<KEY> _hasher;
 };
 
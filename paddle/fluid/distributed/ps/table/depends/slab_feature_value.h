@@ -0,0 +1,165 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#include "paddle/fluid/platform/enforce.h"
+
+namespace paddle {
+namespace distributed {
+
+// A feature value stored inline in a fixed-stride slot of a slab, see
+// SlabFeatureValueAllocator. It has the same interface as FixedFeatureValue,
+// but the floats follow the header directly instead of living in a separate
+// heap block, and resize never reallocates, the capacity of every value is
+// the full dim of the accessor.
+class SlabFeatureValue {
+ public:
+  SlabFeatureValue(const SlabFeatureValue&) = delete;
+  SlabFeatureValue& operator=(const SlabFeatureValue&) = delete;
+
+  // The floats are stored right after the header in the slot.
+  float* data() { return reinterpret_cast<float*>(this + 1); }
+  size_t size() { return _size; }
+  size_t capacity() { return _capacity; }
+  void resize(size_t size) {
+    PADDLE_ENFORCE_LE(
+        size,
+        _capacity,
+        common::errors::OutOfRange(
+            "The size (%d) of SlabFeatureValue exceeds its capacity (%d).",
+            size,
+            _capacity));
+    // Like FixedFeatureValue, the grown floats are zeros.
+    if (size > _size) {
+      std::fill(data() + _size, data() + size, 0.0f);
+    }
+    _size = static_cast<uint32_t>(size);
+  }
+  void shrink_to_fit() {}
+
+ private:
+  friend class SlabFeatureValueAllocator;
+  explicit SlabFeatureValue(uint32_t capacity)
+      : _size(0), _capacity(capacity) {}
+  ~SlabFeatureValue() {}
+
+  uint32_t _size;
+  uint32_t _capacity;
+};
+
+static_assert(sizeof(SlabFeatureValue) % alignof(float) == 0,
+              "The floats of SlabFeatureValue must follow it aligned.");
+
+// Allocates SlabFeatureValue in chunks of fixed-stride slots, which is a
+// drop-in replacement of ChunkAllocator<SlabFeatureValue> for the shards.
+// set_value_capacity must be called before the first acquire.
+class SlabFeatureValueAllocator {
+ public:
+  explicit SlabFeatureValueAllocator(size_t chunk_size = 64)
+      : _chunk_size(chunk_size) {}
+  SlabFeatureValueAllocator(const SlabFeatureValueAllocator&) = delete;
+  ~SlabFeatureValueAllocator() {
+    while (_chunks != nullptr) {
+      Chunk* x = _chunks;
+      _chunks = _chunks->next;
+      free(x);  // NOLINT
+    }
+  }
+
+  // Number of floats of every value.
+  void set_value_capacity(size_t capacity) {
+    PADDLE_ENFORCE_EQ(_chunks,
+                      nullptr,
+                      common::errors::PreconditionNotMet(
+                          "The value capacity of SlabFeatureValueAllocator "
+                          "must be set before allocation."));
+    _capacity = static_cast<uint32_t>(capacity);
+    size_t bytes = sizeof(SlabFeatureValue) + capacity * sizeof(float);
+    _stride = (bytes + kAlignment - 1) / kAlignment * kAlignment;
+  }
+  size_t value_capacity() const { return _capacity; }
+  size_t stride() const { return _stride; }
+
+  SlabFeatureValue* acquire() {
+    if (_free_nodes == nullptr) {
+      create_new_chunk();
+    }
+    Node* node = _free_nodes;
+    _free_nodes = node->next;
+    _counter++;
+    return new (node) SlabFeatureValue(_capacity);
+  }
+  void release(SlabFeatureValue* x) {
+    x->~SlabFeatureValue();
+    Node* node = reinterpret_cast<Node*>(x);
+    node->next = _free_nodes;
+    _free_nodes = node;
+    _counter--;
+  }
+  size_t size() const { return _counter; }
+
+ private:
+  static constexpr size_t kAlignment = sizeof(void*);
+
+  struct Node {
+    Node* next;
+  };
+  struct Chunk {
+    Chunk* next;
+  };
+
+  void create_new_chunk() {
+    PADDLE_ENFORCE_GT(
+        _stride,
+        0,
+        common::errors::PreconditionNotMet(
+            "The value capacity of SlabFeatureValueAllocator is not set."));
+    Chunk* chunk;
+    size_t alloc_size = kAlignment + _stride * _chunk_size;
+    int error = posix_memalign(
+        reinterpret_cast<void**>(&chunk), kAlignment, alloc_size);
+    PADDLE_ENFORCE_EQ(error,
+                      0,
+                      common::errors::ResourceExhausted(
+                          "Fail to alloc memory of %ld size, error code is %d.",
+                          alloc_size,
+                          error));
+    chunk->next = _chunks;
+    _chunks = chunk;
+
+    char* slots = reinterpret_cast<char*>(chunk) + kAlignment;
+    for (size_t i = _chunk_size; i > 0; --i) {
+      Node* node = reinterpret_cast<Node*>(slots + (i - 1) * _stride);
+      node->next = _free_nodes;
+      _free_nodes = node;
+    }
+  }
+
+  size_t _chunk_size;          // how many values in one chunk
+  size_t _stride{0};           // bytes of one slot
+  uint32_t _capacity{0};       // floats of one value
+  Chunk* _chunks{nullptr};     // a list
+  Node* _free_nodes{nullptr};  // a list
+  size_t _counter{0};          // how many values are acquired
+};
+
+}  // namespace distributed
+}  // namespace paddle
@@ -0,0 +1,228 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace paddle {
+namespace distributed {
+
+// A count-min sketch of the access frequency of the features, with counters
+// saturating at 15 which are halved every _sample_size increments, so that
+// the frequency of the recent accesses dominates (TinyLFU). Every row has 4
+// counters per cached feature, which costs 16 bytes per feature.
+class SparseFrequencySketch {
+ public:
+  explicit SparseFrequencySketch(size_t capacity) {
+    size_t width = 64;
+    while (width < 4 * capacity) {
+      width <<= 1;
+    }
+    _mask = width - 1;
+    _counters.assign(kDepth * width, 0);
+    _sample_size = 10 * width;
+  }
+
+  void Increment(uint64_t key) {
+    bool added = false;
+    for (size_t i = 0; i < kDepth; ++i) {
+      uint8_t& counter = _counters[Index(key, i)];
+      if (counter < kMaxCount) {
+        ++counter;
+        added = true;
+      }
+    }
+    if (added && ++_additions >= _sample_size) {
+      Age();
+    }
+  }
+
+  uint32_t Estimate(uint64_t key) const {
+    uint32_t frequency = kMaxCount;
+    for (size_t i = 0; i < kDepth; ++i) {
+      uint32_t counter = _counters[Index(key, i)];
+      frequency = counter < frequency ? counter : frequency;
+    }
+    return frequency;
+  }
+
+ private:
+  static constexpr size_t kDepth = 4;
+  static constexpr uint8_t kMaxCount = 15;
+
+  size_t Index(uint64_t key, size_t row) const {
+    // splitmix64 with a different seed for every row
+    uint64_t x = key + (row + 1) * 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    x = x ^ (x >> 31);
+    return row * (_mask + 1) + (x & _mask);
+  }
+
+  void Age() {
+    for (auto& counter : _counters) {
+      counter >>= 1;
+    }
+    _additions /= 2;
+  }
+
+  std::vector<uint8_t> _counters;
+  size_t _mask;
+  size_t _sample_size;
+  size_t _additions{0};
+};
+
+// Hit and miss counters of the in-memory tier of one shard. They are written
+// by the task of the shard and read by PrintTableStat.
+struct SparseCacheStat {
+  std::atomic<uint64_t> mem_hits{0};
+  std::atomic<uint64_t> ssd_hits{0};
+  std::atomic<uint64_t> misses{0};
+  std::atomic<uint64_t> rejects{0};
+  std::atomic<uint64_t> evictions{0};
+};
+
+// Decides which features of one shard stay in memory when the in-memory tier
+// of SSDSparseTable is bounded.
+//
+// The resident features are kept in a CLOCK ring with a 2-bit reference count
+// per slot, every access bumps the count and the hand decrements it, so the
+// victim is a feature which has not been accessed for a whole sweep. A
+// feature read from ssd is only admitted when the sketch estimates it is
+// accessed more often than the victim it would replace, which keeps a scan
+// of cold features from flushing the hot ones.
+//
+// Not thread safe, it is used by the task of its shard just like the shard.
+class SparseCachePolicy {
+ public:
+  explicit SparseCachePolicy(size_t capacity)
+      : _capacity(capacity), _sketch(capacity) {}
+
+  size_t capacity() const { return _capacity; }
+  size_t size() const { return _index.size(); }
+  bool Contains(uint64_t key) const { return _index.count(key) > 0; }
+
+  // Records an access of a key, and starts to track it if it is resident but
+  // not tracked yet, e.g. loaded from a checkpoint.
+  void RecordResident(uint64_t key) {
+    _sketch.Increment(key);
+    auto it = _index.find(key);
+    if (it == _index.end()) {
+      Insert(key);
+    } else {
+      uint8_t& ref = _ring[it->second].ref;
+      ref = ref < kMaxRef ? ref + 1 : kMaxRef;
+    }
+  }
+
+  // Records an access of a key which is not resident.
+  void RecordMiss(uint64_t key) { _sketch.Increment(key); }
+
+  // Whether a key which is not resident should be brought into memory.
+  bool Admit(uint64_t key) {
+    if (_index.size() < _capacity) {
+      return true;
+    }
+    size_t slot = Advance();
+    return _sketch.Estimate(key) > _sketch.Estimate(_ring[slot].key);
+  }
+
+  void Insert(uint64_t key) {
+    if (_index.count(key) > 0) {
+      return;
+    }
+    size_t slot;
+    if (!_free_slots.empty()) {
+      slot = _free_slots.back();
+      _free_slots.pop_back();
+    } else {
+      slot = _ring.size();
+      _ring.emplace_back();
+    }
+    _ring[slot].key = key;
+    _ring[slot].ref = 0;
+    _ring[slot].used = true;
+    _index[key] = slot;
+  }
+
+  void Erase(uint64_t key) {
+    auto it = _index.find(key);
+    if (it == _index.end()) {
+      return;
+    }
+    _ring[it->second].used = false;
+    _free_slots.push_back(it->second);
+    _index.erase(it);
+  }
+
+  // Pops the next victim when there are more than capacity keys.
+  bool Evict(uint64_t* key) {
+    if (_index.size() <= _capacity) {
+      return false;
+    }
+    size_t slot = Advance();
+    *key = _ring[slot].key;
+    Erase(*key);
+    return true;
+  }
+
+  void Clear() {
+    _ring.clear();
+    _free_slots.clear();
+    _index.clear();
+    _hand = 0;
+  }
+
+ private:
+  static constexpr uint8_t kMaxRef = 3;
+
+  struct Slot {
+    uint64_t key{0};
+    uint8_t ref{0};
+    bool used{false};
+  };
+
+  // Moves the hand to the next slot whose reference count is 0, which must
+  // only be called when there is at least one used slot.
+  size_t Advance() {
+    while (true) {
+      if (_hand >= _ring.size()) {
+        _hand = 0;
+      }
+      Slot& slot = _ring[_hand];
+      if (slot.used) {
+        if (slot.ref == 0) {
+          return _hand;
+        }
+        --slot.ref;
+      }
+      ++_hand;
+    }
+  }
+
+  size_t _capacity;
+  SparseFrequencySketch _sketch;
+  std::vector<Slot> _ring;
+  std::vector<size_t> _free_slots;
+  std::unordered_map<uint64_t, size_t> _index;
+  size_t _hand{0};
+};
+
+}  // namespace distributed
+}  // namespace paddle
@@ -0,0 +1,411 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <fcntl.h>
+#include <glog/logging.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "paddle/fluid/distributed/common/afs_wrapper.h"
+
+namespace paddle {
+namespace distributed {
+
+// Binary shard file of MemorySparseTable. Values are stored as raw floats,
+// so loading them is a copy instead of parsing text. The layout is
+//
+//   SparseShardFileHeader
+//   SparseShardBlockHeader, records of block 0
+//   ...
+//   SparseShardBlockHeader, records of block n - 1
+//   SparseShardBlockHeader{kSparseShardIndexMark}, SparseShardBlockIndex * n
+//   SparseShardFileFooter
+//
+// where a record is {uint64_t key, uint32_t size, float value[size]}.
+// Records are grouped into blocks of about kSparseShardBlockBytes, so that a
+// mapped file is loaded by several threads block by block, and a file which
+// could not be mapped (e.g., on hdfs) is streamed block by block.
+constexpr char kSparseShardFileMagic[8] = {
+    'P', 'D', 'S', 'H', 'A', 'R', 'D', '\0'};
+constexpr uint32_t kSparseShardFileVersion = 1;
+constexpr char kSparseShardFileSuffix[] = ".bin";
+constexpr size_t kSparseShardBlockBytes = 4UL << 20;
+constexpr uint64_t kSparseShardIndexMark = ~0ULL;
+constexpr size_t kSparseShardRecordHeaderBytes =
+    sizeof(uint64_t) + sizeof(uint32_t);
+
+struct SparseShardFileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t value_dim;  // dim of a full value of the accessor
+};
+
+struct SparseShardBlockHeader {
+  uint64_t num_records;
+  uint64_t bytes;  // bytes of the records
+};
+
+struct SparseShardBlockIndex {
+  uint64_t offset;  // file offset of the records
+  uint64_t num_records;
+  uint64_t bytes;
+};
+
+struct SparseShardFileFooter {
+  uint64_t num_blocks;
+  uint64_t num_records;
+  uint64_t index_offset;  // file offset of the block header of the index
+  char magic[8];
+};
+
+inline bool IsSparseShardFile(const std::string& path) {
+  size_t suffix_len = sizeof(kSparseShardFileSuffix) - 1;
+  return path.size() >= suffix_len &&
+         path.compare(path.size() - suffix_len,
+                      suffix_len,
+                      kSparseShardFileSuffix) == 0;
+}
+
+// Call fn(key, const float* value, size) for each record of a block, returns
+// -1 if the block is corrupted.
+template <typename Fn>
+int ForEachSparseShardRecord(const char* data,
+                             uint64_t bytes,
+                             uint64_t num_records,
+                             Fn&& fn) {
+  const char* end = data + bytes;
+  for (uint64_t i = 0; i < num_records; ++i) {
+    if (static_cast<size_t>(end - data) < kSparseShardRecordHeaderBytes) {
+      return -1;
+    }
+    uint64_t key = 0;
+    uint32_t size = 0;
+    memcpy(&key, data, sizeof(key));
+    memcpy(&size, data + sizeof(key), sizeof(size));
+    data += kSparseShardRecordHeaderBytes;
+    if (static_cast<size_t>(end - data) / sizeof(float) < size) {
+      return -1;
+    }
+    // Records are 4-byte aligned, see SparseShardFileWriter.
+    fn(key, reinterpret_cast<const float*>(data), size);
+    data += size * sizeof(float);
+  }
+  return data == end ? 0 : -1;
+}
+
+// Write a binary shard file to a channel. The channel is written
+// sequentially, so any fs supported by AfsClient works.
+class SparseShardFileWriter {
+ public:
+  SparseShardFileWriter(FsWriteChannel* channel,
+                        uint32_t value_dim,
+                        size_t block_bytes = kSparseShardBlockBytes)
+      : _channel(channel), _value_dim(value_dim), _block_bytes(block_bytes) {
+    _buffer.reserve(_block_bytes);
+  }
+
+  int Append(uint64_t key, const float* value, uint32_t size) {
+    if (_offset == 0 && WriteHeader() != 0) {
+      return -1;
+    }
+    _buffer.append(reinterpret_cast<const char*>(&key), sizeof(key));
+    _buffer.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    _buffer.append(reinterpret_cast<const char*>(value), size * sizeof(float));
+    ++_block_records;
+    ++_num_records;
+    if (_buffer.size() >= _block_bytes) {
+      return FlushBlock();
+    }
+    return 0;
+  }
+
+  // Write the last block and the index, must be called once after the last
+  // Append.
+  int Finish() {
+    if (_offset == 0 && WriteHeader() != 0) {
+      return -1;
+    }
+    if (FlushBlock() != 0) {
+      return -1;
+    }
+    SparseShardFileFooter footer;
+    footer.num_blocks = _blocks.size();
+    footer.num_records = _num_records;
+    footer.index_offset = _offset;
+    memcpy(footer.magic, kSparseShardFileMagic, sizeof(footer.magic));
+    SparseShardBlockHeader index_header;
+    index_header.num_records = kSparseShardIndexMark;
+    index_header.bytes = _blocks.size() * sizeof(SparseShardBlockIndex);
+    if (Write(reinterpret_cast<const char*>(&index_header),
+              sizeof(index_header)) != 0 ||
+        Write(reinterpret_cast<const char*>(_blocks.data()),
+              index_header.bytes) != 0 ||
+        Write(reinterpret_cast<const char*>(&footer), sizeof(footer)) != 0) {
+      return -1;
+    }
+    return 0;
+  }
+
+  uint64_t num_records() const { return _num_records; }
+
+ private:
+  int Write(const char* data, size_t size) {
+    if (size != 0 && _channel->write(data, size) != 0) {
+      return -1;
+    }
+    _offset += size;
+    return 0;
+  }
+
+  int WriteHeader() {
+    SparseShardFileHeader header;
+    memcpy(header.magic, kSparseShardFileMagic, sizeof(header.magic));
+    header.version = kSparseShardFileVersion;
+    header.value_dim = _value_dim;
+    return Write(reinterpret_cast<const char*>(&header), sizeof(header));
+  }
+
+  int FlushBlock() {
+    if (_block_records == 0) {
+      return 0;
+    }
+    SparseShardBlockHeader header;
+    header.num_records = _block_records;
+    header.bytes = _buffer.size();
+    if (Write(reinterpret_cast<const char*>(&header), sizeof(header)) != 0) {
+      return -1;
+    }
+    _blocks.push_back({_offset, header.num_records, header.bytes});
+    if (Write(_buffer.data(), _buffer.size()) != 0) {
+      return -1;
+    }
+    _buffer.clear();
+    _block_records = 0;
+    return 0;
+  }
+
+  FsWriteChannel* _channel;
+  uint32_t _value_dim;
+  size_t _block_bytes;
+  std::string _buffer;  // records of the current block
+  uint64_t _block_records{0};
+  uint64_t _num_records{0};
+  uint64_t _offset{0};
+  std::vector<SparseShardBlockIndex> _blocks;
+};
+
+// A binary shard file on the local fs mapped into memory. Blocks are
+// independent of each other, so they could be loaded in parallel.
+class SparseShardFileMapping {
+ public:
+  SparseShardFileMapping() = default;
+  SparseShardFileMapping(const SparseShardFileMapping&) = delete;
+  SparseShardFileMapping& operator=(const SparseShardFileMapping&) = delete;
+  ~SparseShardFileMapping() { Close(); }
+
+  // Map the file and check its index, returns -1 on failure.
+  int Open(const std::string& path) {
+    Close();
+    _fd = open(path.c_str(), O_RDONLY);
+    if (_fd == -1) {
+      LOG(ERROR) << "Fail to open sparse shard file " << path << ", "
+                 << strerror(errno);
+      return -1;
+    }
+    struct stat sb = {};
+    if (fstat(_fd, &sb) != 0) {
+      LOG(ERROR) << "Fail to stat sparse shard file " << path << ", "
+                 << strerror(errno);
+      Close();
+      return -1;
+    }
+    _size = static_cast<size_t>(sb.st_size);
+    if (_size < sizeof(SparseShardFileHeader) + sizeof(SparseShardFileFooter)) {
+      LOG(ERROR) << "Sparse shard file " << path << " is truncated.";
+      Close();
+      return -1;
+    }
+    void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _fd, 0);
+    if (data == MAP_FAILED) {
+      LOG(ERROR) << "Fail to mmap sparse shard file " << path << ", "
+                 << strerror(errno);
+      _size = 0;
+      Close();
+      return -1;
+    }
+    _data = static_cast<const char*>(data);
+    madvise(data, _size, MADV_WILLNEED);
+    if (ParseIndex() != 0) {
+      LOG(ERROR) << "Sparse shard file " << path << " is corrupted.";
+      Close();
+      return -1;
+    }
+    return 0;
+  }
+
+  void Close() {
+    if (_data != nullptr) {
+      munmap(const_cast<char*>(_data), _size);
+      _data = nullptr;
+    }
+    if (_fd != -1) {
+      close(_fd);
+      _fd = -1;
+    }
+    _size = 0;
+    _blocks.clear();
+  }
+
+  uint32_t value_dim() const { return _value_dim; }
+  uint64_t num_records() const { return _num_records; }
+  size_t num_blocks() const { return _blocks.size(); }
+
+  // Call fn(key, const float* value, size) for each record of the block.
+  template <typename Fn>
+  int ForEachRecord(size_t block, Fn&& fn) const {
+    const SparseShardBlockIndex& index = _blocks[block];
+    return ForEachSparseShardRecord(_data + index.offset,
+                                    index.bytes,
+                                    index.num_records,
+                                    std::forward<Fn>(fn));
+  }
+
+ private:
+  int ParseIndex() {
+    SparseShardFileHeader header;
+    SparseShardFileFooter footer;
+    memcpy(&header, _data, sizeof(header));
+    memcpy(&footer, _data + _size - sizeof(footer), sizeof(footer));
+    if (memcmp(header.magic, kSparseShardFileMagic, sizeof(header.magic)) !=
+            0 ||
+        memcmp(footer.magic, kSparseShardFileMagic, sizeof(footer.magic)) !=
+            0 ||
+        header.version != kSparseShardFileVersion) {
+      return -1;
+    }
+    if (footer.num_blocks > _size / sizeof(SparseShardBlockIndex)) {
+      return -1;
+    }
+    size_t index_bytes = footer.num_blocks * sizeof(SparseShardBlockIndex);
+    if (footer.index_offset < sizeof(header) ||
+        footer.index_offset + sizeof(SparseShardBlockHeader) + index_bytes +
+                sizeof(footer) !=
+            _size) {
+      return -1;
+    }
+    SparseShardBlockHeader index_header;
+    memcpy(&index_header, _data + footer.index_offset, sizeof(index_header));
+    if (index_header.num_records != kSparseShardIndexMark ||
+        index_header.bytes != index_bytes) {
+      return -1;
+    }
+    _blocks.resize(footer.num_blocks);
+    if (index_bytes != 0) {
+      memcpy(_blocks.data(),
+             _data + footer.index_offset + sizeof(index_header),
+             index_bytes);
+    }
+    uint64_t num_records = 0;
+    for (auto& block : _blocks) {
+      if (block.offset < sizeof(header) + sizeof(SparseShardBlockHeader) ||
+          block.offset > footer.index_offset ||
+          block.bytes > footer.index_offset - block.offset) {
+        return -1;
+      }
+      num_records += block.num_records;
+    }
+    if (num_records != footer.num_records) {
+      return -1;
+    }
+    _value_dim = header.value_dim;
+    _num_records = num_records;
+    return 0;
+  }
+
+  int _fd{-1};
+  const char* _data{nullptr};
+  size_t _size{0};
+  uint32_t _value_dim{0};
+  uint64_t _num_records{0};
+  std::vector<SparseShardBlockIndex> _blocks;
+};
+
+// Read a binary shard file from a channel sequentially, for the files which
+// could not be mapped.
+class SparseShardFileReader {
+ public:
+  explicit SparseShardFileReader(FsReadChannel* channel) : _channel(channel) {}
+
+  int ReadHeader() {
+    SparseShardFileHeader header;
+    if (Read(reinterpret_cast<char*>(&header), sizeof(header)) != 0 ||
+        memcmp(header.magic, kSparseShardFileMagic, sizeof(header.magic)) !=
+            0 ||
+        header.version != kSparseShardFileVersion) {
+      return -1;
+    }
+    _value_dim = header.value_dim;
+    return 0;
+  }
+
+  uint32_t value_dim() const { return _value_dim; }
+
+  // Call fn(key, const float* value, size) for each record of the file, must
+  // be called after ReadHeader.
+  template <typename Fn>
+  int ForEachRecord(Fn&& fn) {
+    std::vector<float> buffer;
+    for (;;) {
+      SparseShardBlockHeader header;
+      if (Read(reinterpret_cast<char*>(&header), sizeof(header)) != 0) {
+        return -1;
+      }
+      if (header.num_records == kSparseShardIndexMark) {
+        return 0;  // The index is only used by mapped files.
+      }
+      buffer.resize((header.bytes + sizeof(float) - 1) / sizeof(float));
+      char* data = reinterpret_cast<char*>(buffer.data());
+      if (Read(data, header.bytes) != 0 ||
+          ForEachSparseShardRecord(data, header.bytes, header.num_records, fn) !=
+              0) {
+        return -1;
+      }
+    }
+  }
+
+ private:
+  int Read(char* data, size_t size) {
+    if (size != 0 &&
+        static_cast<size_t>(_channel->read(data, size)) != size) {
+      return -1;
+    }
+    return 0;
+  }
+
+  FsReadChannel* _channel;
+  uint32_t _value_dim{0};
+};
+
+}  // namespace distributed
+}  // namespace paddle
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <omp.h>
+#include <algorithm>
 #include <sstream>
 
 #include "glog/logging.h"
@@ -20,6 +21,7 @@
 #include "paddle/fluid/distributed/common/local_random.h"
 #include "paddle/fluid/distributed/common/topk_calculator.h"
 #include "paddle/fluid/distributed/ps/table/memory_sparse_table.h"
+#include "paddle/fluid/distributed/ps/table/depends/sparse_shard_file.h"
 #include "paddle/fluid/framework/archive.h"
 #include "paddle/fluid/framework/io/fs.h"
 
@@ -41,6 +43,34 @@ PD_DEFINE_int32(pserver_table_save_max_retry,
 
 namespace paddle::distributed {
 
+namespace {
+
+// Overwrite the value of key, which is not thread safe for the shards other
+// than ConcurrentSparseTableShard.
+template <typename Shard>
+void AssignSparseValue(Shard *shard,
+                       uint64_t key,
+                       const float *data,
+                       size_t size) {
+  auto &value = (*shard)[key];
+  value.resize(size);
+  memcpy(value.data(), data, size * sizeof(float));
+}
+
+template <class KEY, class VALUE, class ALLOC>
+void AssignSparseValue(ConcurrentSparseTableShard<KEY, VALUE, ALLOC> *shard,
+                       uint64_t key,
+                       const float *data,
+                       size_t size) {
+  auto assign = [data, size](VALUE &value) {
+    value.resize(size);
+    memcpy(value.data(), data, size * sizeof(float));
+  };
+  shard->apply_or_create(key, [](VALUE &) {}, assign);
+}
+
+}  // namespace
+
 int32_t MemorySparseTable::Initialize() {
   auto &profiler = CostProfiler::instance();
   profiler.register_profiler("pserver_sparse_update_all");
@@ -76,7 +106,44 @@ int32_t MemorySparseTable::InitializeValue() {
           << " _task_pool_size:" << _task_pool_size
           << " _use_gpu_graph:" << _use_gpu_graph;
 
-  _local_shards.reset(new shard_type[_real_local_shard_num]);
+  _use_concurrent_shard = _config.shard_backend() == CONCURRENT_HASH_MAP;
+  _use_slab_value = _config.enable_slab_value();
+  if (_use_concurrent_shard) {
+    PADDLE_ENFORCE_EQ(
+        _config.enable_revert() || _use_gpu_graph,
+        false,
+        common::errors::Unimplemented(
+            "The CONCURRENT_HASH_MAP shard backend of MemorySparseTable does "
+            "not support enable_revert or use_gpu_graph yet."));
+  }
+  if (_use_slab_value) {
+    PADDLE_ENFORCE_EQ(
+        _config.enable_revert() || _use_gpu_graph,
+        false,
+        common::errors::Unimplemented(
+            "The slab value store of MemorySparseTable does not support "
+            "enable_revert or use_gpu_graph yet."));
+  }
+  // The slots of slab values hold the full dim of the accessor.
+  const size_t value_capacity =
+      _value_accessor->GetAccessorInfo().size / sizeof(float);
+  if (_use_concurrent_shard && _use_slab_value) {
+    _concurrent_slab_shards.reset(
+        new concurrent_slab_shard_type[_real_local_shard_num]);  // NOLINT
+    for (int i = 0; i < _real_local_shard_num; ++i) {
+      _concurrent_slab_shards[i].set_value_capacity(value_capacity);
+    }
+  } else if (_use_concurrent_shard) {
+    _concurrent_shards.reset(
+        new concurrent_shard_type[_real_local_shard_num]);  // NOLINT
+  } else if (_use_slab_value) {
+    _slab_shards.reset(new slab_shard_type[_real_local_shard_num]);
+    for (int i = 0; i < _real_local_shard_num; ++i) {
+      _slab_shards[i].set_value_capacity(value_capacity);
+    }
+  } else {
+    _local_shards.reset(new shard_type[_real_local_shard_num]);
+  }
 
   if (_config.enable_revert()) {
     // calculate merged shard number based on config param;
@@ -152,6 +219,10 @@ int32_t MemorySparseTable::Load(const std::string &path,
     return 0;
   }
 
+  if (IsSparseShardFile(file_list[file_start_idx])) {
+    return LoadBinary(file_list, file_start_idx);
+  }
+
   size_t feature_value_size =
       _value_accessor->GetAccessorInfo().size / sizeof(float);
   size_t mf_value_size =
@@ -186,22 +257,23 @@ int32_t MemorySparseTable::Load(const std::string &path,
       std::string line_data;
       auto read_channel = _afs_client.open_r(channel_config, 0, &err_no);
       char *end = nullptr;
-      auto &shard = _local_shards[i];
       try {
-        while (read_channel->read_line(line_data) == 0 &&
-               line_data.size() > 1) {
-          uint64_t key = std::strtoul(line_data.data(), &end, 10);
-          auto &value = shard[key];
-          value.resize(feature_value_size);
-          int parse_size =
-              _value_accessor->ParseFromString(++end, value.data());
-          mem_count++;
-          value.resize(parse_size);
-          if (parse_size >
-              static_cast<int>(feature_value_size - mf_value_size)) {
-            mem_mf_count++;
+        VisitLocalShard(i, [&](auto &shard) {
+          while (read_channel->read_line(line_data) == 0 &&
+                 line_data.size() > 1) {
+            uint64_t key = std::strtoul(line_data.data(), &end, 10);
+            auto &value = shard[key];
+            value.resize(feature_value_size);
+            int parse_size =
+                _value_accessor->ParseFromString(++end, value.data());
+            mem_count++;
+            value.resize(parse_size);
+            if (parse_size >
+                static_cast<int>(feature_value_size - mf_value_size)) {
+              mem_mf_count++;
+            }
           }
-        }
+        });
         read_channel->close();
         if (err_no == -1) {
           ++retry_num;
@@ -230,6 +302,128 @@ int32_t MemorySparseTable::Load(const std::string &path,
   return 0;
 }
 
+int32_t MemorySparseTable::LoadBinary(
+    const std::vector<std::string> &file_list, size_t file_start_idx) {
+  const uint32_t value_dim =
+      _value_accessor->GetAccessorInfo().size / sizeof(float);
+  const uint32_t mf_value_dim =
+      _value_accessor->GetAccessorInfo().mf_size / sizeof(float);
+
+  // Files on the local fs are mapped, and their blocks are loaded in parallel
+  // if the shards support concurrent insertion. Other files are streamed.
+  struct LoadTask {
+    int shard_id;
+    size_t block_begin;
+    size_t block_end;
+  };
+  std::vector<std::unique_ptr<SparseShardFileMapping>> mappings(
+      _real_local_shard_num);
+  std::vector<LoadTask> tasks;
+  for (int i = 0; i < _real_local_shard_num; ++i) {
+    const std::string &path = file_list[file_start_idx + i];
+    if (!IsSparseShardFile(path)) {
+      LOG(ERROR) << "MemorySparseTable binary load found text file: " << path;
+      return -1;
+    }
+    if (::paddle::framework::fs_select_internal(path) != 0) {
+      tasks.push_back({i, 0, 0});
+      continue;
+    }
+    mappings[i] = std::make_unique<SparseShardFileMapping>();
+    if (mappings[i]->Open(path) != 0) {
+      return -1;
+    }
+    if (mappings[i]->value_dim() != value_dim) {
+      LOG(ERROR) << "MemorySparseTable value dim of " << path << " is "
+                 << mappings[i]->value_dim() << ", but the accessor expects "
+                 << value_dim;
+      return -1;
+    }
+    if (_use_concurrent_shard) {
+      for (size_t block = 0; block < mappings[i]->num_blocks(); ++block) {
+        tasks.push_back({i, block, block + 1});
+      }
+    } else {
+      tasks.push_back({i, 0, mappings[i]->num_blocks()});
+    }
+  }
+
+  std::atomic<uint64_t> mem_count{0};
+  std::atomic<uint64_t> mem_mf_count{0};
+  std::atomic<bool> is_load_failed{false};
+  auto load_record = [&](auto *shard) {
+    return [&, shard](uint64_t key, const float *data, uint32_t size) {
+      if (size > value_dim) {
+        is_load_failed = true;
+        return;
+      }
+      AssignSparseValue(shard, key, data, size);
+      ++mem_count;
+      if (size > value_dim - mf_value_dim) {
+        ++mem_mf_count;
+      }
+    };
+  };
+
+  int thread_num = std::min(static_cast<int>(tasks.size()), _task_pool_size);
+  omp_set_num_threads(thread_num > 0 ? thread_num : 1);
+#pragma omp parallel for schedule(dynamic)
+  for (int t = 0; t < static_cast<int>(tasks.size()); ++t) {
+    const LoadTask &task = tasks[t];
+    const std::string &path = file_list[file_start_idx + task.shard_id];
+    VisitLocalShard(task.shard_id, [&](auto &shard) {
+      auto fn = load_record(&shard);
+      auto *mapping = mappings[task.shard_id].get();
+      if (mapping != nullptr) {
+        for (size_t block = task.block_begin; block < task.block_end;
+             ++block) {
+          if (mapping->ForEachRecord(block, fn) != 0) {
+            LOG(ERROR) << "MemorySparseTable load corrupted block " << block
+                       << " of " << path;
+            is_load_failed = true;
+            return;
+          }
+        }
+        return;
+      }
+      int retry_num = 0;
+      bool is_read_failed = false;
+      do {
+        is_read_failed = false;
+        int err_no = 0;
+        FsChannelConfig channel_config = {};
+        channel_config.path = path;
+        auto read_channel = _afs_client.open_r(channel_config, 0, &err_no);
+        SparseShardFileReader reader(read_channel.get());
+        if (reader.ReadHeader() != 0 || reader.value_dim() != value_dim ||
+            reader.ForEachRecord(fn) != 0 || err_no == -1) {
+          ++retry_num;
+          is_read_failed = true;
+          LOG(ERROR) << "MemorySparseTable binary load failed, retry it! path:"
+                     << path << " , retry_num=" << retry_num;
+        }
+        read_channel->close();
+      } while (is_read_failed &&
+               retry_num <= FLAGS_pserver_table_save_max_retry);
+      if (is_read_failed) {
+        is_load_failed = true;
+      }
+    });
+  }
+  if (is_load_failed) {
+    LOG(ERROR) << "MemorySparseTable binary load failed, path from "
+               << file_list[file_start_idx] << " to "
+               << file_list[file_start_idx + _real_local_shard_num - 1];
+    return -1;
+  }
+  VLOG(0) << "Table>> binary load done. ALL[" << mem_count << "] MEM["
+          << mem_count << "] MEM_MF[" << mem_mf_count << "]";
+  LOG(INFO) << "MemorySparseTable load success, path from "
+            << file_list[file_start_idx] << " to "
+            << file_list[file_start_idx + _real_local_shard_num - 1];
+  return 0;
+}
+
 int32_t MemorySparseTable::LoadPatch(const std::vector<std::string> &file_list,
                                      int load_param) {
   if (!_config.enable_revert()) {
@@ -380,6 +574,17 @@ int32_t MemorySparseTable::Save(const std::string &dirname,
 
   size_t file_start_idx = _avg_local_shard_num * _shard_idx;
 
+  // The converters work on text lines, so the binary shard files are only
+  // written for the save_param without converter.
+  bool save_binary = _config.enable_binary_checkpoint() &&
+                     _value_accessor->Converter(save_param).converter.empty();
+  if (_config.enable_binary_checkpoint() && !save_binary) {
+    LOG(WARNING) << "MemorySparseTable save text files for save_param "
+                 << save_param << " which has a converter";
+  }
+  const uint32_t value_dim =
+      _value_accessor->GetAccessorInfo().size / sizeof(float);
+
 #ifdef PADDLE_WITH_HETERPS
   int thread_num = _real_local_shard_num;
 #else
@@ -389,7 +594,15 @@ int32_t MemorySparseTable::Save(const std::string &dirname,
 #pragma omp parallel for schedule(dynamic)
   for (int i = 0; i < _real_local_shard_num; ++i) {
     FsChannelConfig channel_config = {};
-    if (_config.compress_in_save() && (save_param == 0 || save_param == 3)) {
+    if (save_binary) {
+      channel_config.path =
+          ::paddle::string::format_string("%s/part-%03d-%05d%s",
+                                          table_path.c_str(),
+                                          _shard_idx,
+                                          file_start_idx + i,
+                                          kSparseShardFileSuffix);
+    } else if (_config.compress_in_save() &&
+               (save_param == 0 || save_param == 3)) {
       channel_config.path =
           ::paddle::string::format_string("%s/part-%03d-%05d.gz",
                                           table_path.c_str(),
@@ -408,70 +621,92 @@ int32_t MemorySparseTable::Save(const std::string &dirname,
     int feasign_size = 0;
     int retry_num = 0;
     int err_no = 0;
-    auto &shard = _local_shards[i];
+    VisitLocalShard(i, [&](auto &shard) {
 #if defined(PADDLE_WITH_HETERPS) && defined(PADDLE_WITH_PSCORE)
-    // for incremental training, batch_model increase unseenday before save
-    if (_use_gpu_graph && save_param == 3) {
-      for (auto it = shard.begin(); it != shard.end(); ++it) {
-        _value_accessor->UpdateStatAfterSave(it.value().data(), save_param);
+      // for incremental training, batch_model increase unseenday before save
+      if (_use_gpu_graph && save_param == 3) {
+        for (auto it = shard.begin(); it != shard.end(); ++it) {
+          _value_accessor->UpdateStatAfterSave(it.value().data(), save_param);
+        }
       }
-    }
 #endif
-    do {
-      err_no = 0;
-      feasign_size = 0;
-      is_write_failed = false;
-      auto write_channel =
-          _afs_client.open_w(channel_config, 1024 * 1024 * 40, &err_no);
-      for (auto it = shard.begin(); it != shard.end(); ++it) {
-        if (_config.enable_sparse_table_cache() &&
-            (save_param == 1 || save_param == 2) &&
-            _value_accessor->Save(it.value().data(), 4)) {
-          CostTimer timer10("sprase table top push");
-          tk.push(i, _value_accessor->GetField(it.value().data(), "show"));
+      do {
+        err_no = 0;
+        feasign_size = 0;
+        is_write_failed = false;
+        auto write_channel =
+            _afs_client.open_w(channel_config, 1024 * 1024 * 40, &err_no);
+        std::unique_ptr<SparseShardFileWriter> binary_writer;
+        if (save_binary) {
+          binary_writer = std::make_unique<SparseShardFileWriter>(
+              write_channel.get(), value_dim);
         }
+        for (auto it = shard.begin(); it != shard.end(); ++it) {
+          if (_config.enable_sparse_table_cache() &&
+              (save_param == 1 || save_param == 2) &&
+              _value_accessor->Save(it.value().data(), 4)) {
+            CostTimer timer10("sprase table top push");
+            tk.push(i, _value_accessor->GetField(it.value().data(), "show"));
+          }
 
-        if (_value_accessor->Save(it.value().data(), save_param)) {
-          std::string format_value = _value_accessor->ParseToString(
-              it.value().data(), it.value().size());
-          if (0 != write_channel->write_line(::paddle::string::format_string(
-                       "%lu %s", it.key(), format_value.c_str()))) {
-            ++retry_num;
-            is_write_failed = true;
-            LOG(ERROR)
-                << "MemorySparseTable save prefix failed, retry it! path:"
-                << channel_config.path << " , retry_num=" << retry_num;
-            break;
+          if (_value_accessor->Save(it.value().data(), save_param)) {
+            int ret = 0;
+            if (save_binary) {
+              ret = binary_writer->Append(
+                  it.key(),
+                  it.value().data(),
+                  _value_accessor->ParseToBinarySize(it.value().data(),
+                                                     it.value().size()));
+            } else {
+              std::string format_value = _value_accessor->ParseToString(
+                  it.value().data(), it.value().size());
+              ret = write_channel->write_line(::paddle::string::format_string(
+                  "%lu %s", it.key(), format_value.c_str()));
+            }
+            if (0 != ret) {
+              ++retry_num;
+              is_write_failed = true;
+              LOG(ERROR)
+                  << "MemorySparseTable save prefix failed, retry it! path:"
+                  << channel_config.path << " , retry_num=" << retry_num;
+              break;
+            }
+            ++feasign_size;
           }
-          ++feasign_size;
+        }
+        if (save_binary && !is_write_failed && binary_writer->Finish() != 0) {
+          ++retry_num;
+          is_write_failed = true;
+          LOG(ERROR) << "MemorySparseTable save index failed, retry it! path:"
+                     << channel_config.path << " , retry_num=" << retry_num;
+        }
+        write_channel->close();
+        if (err_no == -1) {
+          ++retry_num;
+          is_write_failed = true;
+          LOG(ERROR)
+              << "MemorySparseTable save prefix failed after write, retry it! "
+              << "path:" << channel_config.path << " , retry_num=" << retry_num;
+        }
+        if (is_write_failed) {
+          _afs_client.remove(channel_config.path);
+        }
+        if (retry_num > FLAGS_pserver_table_save_max_retry) {
+          LOG(ERROR) << "MemorySparseTable save prefix failed reach max limit!";
+          exit(-1);
+        }
+      } while (is_write_failed);
+      feasign_size_all += feasign_size;
+      if (!_use_gpu_graph) {
+        for (auto it = shard.begin(); it != shard.end(); ++it) {
+          _value_accessor->UpdateStatAfterSave(it.value().data(), save_param);
+        }
+      } else if (save_param != 3) {
+        for (auto it = shard.begin(); it != shard.end(); ++it) {
+          _value_accessor->UpdateStatAfterSave(it.value().data(), save_param);
         }
       }
-      write_channel->close();
-      if (err_no == -1) {
-        ++retry_num;
-        is_write_failed = true;
-        LOG(ERROR)
-            << "MemorySparseTable save prefix failed after write, retry it! "
-            << "path:" << channel_config.path << " , retry_num=" << retry_num;
-      }
-      if (is_write_failed) {
-        _afs_client.remove(channel_config.path);
-      }
-      if (retry_num > FLAGS_pserver_table_save_max_retry) {
-        LOG(ERROR) << "MemorySparseTable save prefix failed reach max limit!";
-        exit(-1);
-      }
-    } while (is_write_failed);
-    feasign_size_all += feasign_size;
-    if (!_use_gpu_graph) {
-      for (auto it = shard.begin(); it != shard.end(); ++it) {
-        _value_accessor->UpdateStatAfterSave(it.value().data(), save_param);
-      }
-    } else if (save_param != 3) {
-      for (auto it = shard.begin(); it != shard.end(); ++it) {
-        _value_accessor->UpdateStatAfterSave(it.value().data(), save_param);
-      }
-    }
+    });
     LOG(INFO) << "MemorySparseTable save prefix success, path: "
               << channel_config.path << " feasign_size: " << feasign_size;
   }
@@ -936,7 +1171,7 @@ int32_t MemorySparseTable::SaveCache(
 int64_t MemorySparseTable::LocalSize() {
   int64_t local_size = 0;
   for (int i = 0; i < _real_local_shard_num; ++i) {
-    local_size += _local_shards[i].size();
+    VisitLocalShard(i, [&](auto &shard) { local_size += shard.size(); });
   }
   return local_size;
 }
@@ -949,13 +1184,14 @@ int64_t MemorySparseTable::LocalMFSize() {
     tasks[shard_id] =
         _shards_task_pool[shard_id % _shards_task_pool.size()]->enqueue(
             [this, shard_id, &size_arr]() -> int {
-              auto &local_shard = _local_shards[shard_id];
-              for (auto it = local_shard.begin(); it != local_shard.end();
-                   ++it) {
-                if (_value_accessor->HasMF(it.value().size())) {
-                  size_arr[shard_id] += 1;
+              VisitLocalShard(shard_id, [&](auto &local_shard) {
+                for (auto it = local_shard.begin(); it != local_shard.end();
+                     ++it) {
+                  if (_value_accessor->HasMF(it.value().size())) {
+                    size_arr[shard_id] += 1;
+                  }
                 }
-              }
+              });
               return 0;
             });
   }
@@ -1012,6 +1248,14 @@ int32_t MemorySparseTable::Push(TableContext &context) {
 
 int32_t MemorySparseTable::PullSparse(float *pull_values,
                                       const PullSparseValue &pull_value) {
+  if (_use_concurrent_shard) {
+    if (_use_slab_value) {
+      return PullSparseConcurrent(
+          _concurrent_slab_shards.get(), pull_values, pull_value);
+    }
+    return PullSparseConcurrent(
+        _concurrent_shards.get(), pull_values, pull_value);
+  }
   CostTimer timer("pserver_sparse_select_all");
   std::vector<std::future<int>> tasks(_real_local_shard_num);
 
@@ -1041,42 +1285,43 @@ int32_t MemorySparseTable::PullSparse(float *pull_values,
              pull_values,
              mf_value_size,
              select_value_size]() -> int {
-              auto &local_shard = _local_shards[shard_id];
-              float data_buffer[value_size];  // NOLINT
-              float *data_buffer_ptr = data_buffer;
-
-              auto &keys = task_keys[shard_id];
-              for (auto &item : keys) {
-                uint64_t key = item.first;
-                auto itr = local_shard.find(key);
-                size_t data_size = value_size - mf_value_size;
-                if (itr == local_shard.end()) {
-                  // ++missed_keys;
-                  if (FLAGS_pserver_create_value_when_push) {
-                    memset(data_buffer, 0, sizeof(float) * data_size);
+              VisitLocalShard(shard_id, [&](auto &local_shard) {
+                float data_buffer[value_size];  // NOLINT
+                float *data_buffer_ptr = data_buffer;
+
+                auto &keys = task_keys[shard_id];
+                for (auto &item : keys) {
+                  uint64_t key = item.first;
+                  auto itr = local_shard.find(key);
+                  size_t data_size = value_size - mf_value_size;
+                  if (itr == local_shard.end()) {
+                    // ++missed_keys;
+                    if (FLAGS_pserver_create_value_when_push) {
+                      memset(data_buffer, 0, sizeof(float) * data_size);
+                    } else {
+                      auto &feature_value = local_shard[key];
+                      feature_value.resize(data_size);
+                      float *data_ptr = feature_value.data();
+                      _value_accessor->Create(&data_buffer_ptr, 1);
+                      memcpy(
+                          data_ptr, data_buffer_ptr, data_size * sizeof(float));
+                    }
                   } else {
-                    auto &feature_value = local_shard[key];
-                    feature_value.resize(data_size);
-                    float *data_ptr = feature_value.data();
-                    _value_accessor->Create(&data_buffer_ptr, 1);
-                    memcpy(
-                        data_ptr, data_buffer_ptr, data_size * sizeof(float));
+                    data_size = itr.value().size();
+                    memcpy(data_buffer_ptr,
+                           itr.value().data(),
+                           data_size * sizeof(float));
                   }
-                } else {
-                  data_size = itr.value().size();
-                  memcpy(data_buffer_ptr,
-                         itr.value().data(),
-                         data_size * sizeof(float));
-                }
-                for (size_t mf_idx = data_size; mf_idx < value_size; ++mf_idx) {
-                  data_buffer[mf_idx] = 0.0;
+                  for (size_t mf_idx = data_size; mf_idx < value_size;
+                       ++mf_idx) {
+                    data_buffer[mf_idx] = 0.0;
+                  }
+                  auto offset = item.second;
+                  float *select_data = pull_values + select_value_size * offset;
+                  _value_accessor->Select(
+                      &select_data, (const float **)&data_buffer_ptr, 1);
                 }
-                auto offset = item.second;
-                float *select_data = pull_values + select_value_size * offset;
-                _value_accessor->Select(
-                    &select_data, (const float **)&data_buffer_ptr, 1);
-              }
-
+              });
               return 0;
             });
   }
@@ -1092,6 +1337,16 @@ int32_t MemorySparseTable::PullSparsePtr(int shard_id,  // fake num
                                          const uint64_t *keys,
                                          size_t num,
                                          uint16_t pass_id) {
+  PADDLE_ENFORCE_EQ(_use_concurrent_shard,
+                    false,
+                    common::errors::Unimplemented(
+                        "PullSparsePtr is not supported by the shards of "
+                        "CONCURRENT_HASH_MAP backend."));
+  PADDLE_ENFORCE_EQ(_use_slab_value,
+                    false,
+                    common::errors::Unimplemented(
+                        "PullSparsePtr is not supported when "
+                        "enable_slab_value is set."));
   CostTimer timer("pscore_sparse_select_all");
   size_t value_size = _value_accessor->GetAccessorInfo().size / sizeof(float);
   size_t mf_value_size =
@@ -1149,6 +1404,19 @@ int32_t MemorySparseTable::PullSparsePtr(int shard_id,  // fake num
 int32_t MemorySparseTable::PushSparse(const uint64_t *keys,
                                       const float *values,
                                       size_t num) {
+  if (_use_concurrent_shard) {
+    size_t update_value_col =
+        _value_accessor->GetAccessorInfo().update_size / sizeof(float);
+    auto get_update_data = [values, update_value_col](size_t i) {
+      return values + i * update_value_col;
+    };
+    if (_use_slab_value) {
+      return PushSparseConcurrent(
+          _concurrent_slab_shards.get(), keys, num, get_update_data);
+    }
+    return PushSparseConcurrent(
+        _concurrent_shards.get(), keys, num, get_update_data);
+  }
   CostTimer timer("pserver_sparse_update_all");
   std::vector<std::future<int>> tasks(_real_local_shard_num);
   std::vector<std::vector<std::pair<uint64_t, int>>> task_keys(
@@ -1175,58 +1443,59 @@ int32_t MemorySparseTable::PushSparse(const uint64_t *keys,
          values,
          &task_keys]() -> int {
           auto &keys = task_keys[shard_id];
-          auto &local_shard = _local_shards[shard_id];
-          auto &local_shard_new = _local_shards_new[shard_id];
-          float data_buffer[value_col];  // NOLINT
-          float *data_buffer_ptr = data_buffer;
-          for (auto &item : keys) {
-            uint64_t key = item.first;
-            uint64_t push_data_idx = item.second;
-            const float *update_data =
-                values + push_data_idx * update_value_col;
-            auto itr = local_shard.find(key);
-            if (itr == local_shard.end()) {
-              if (FLAGS_pserver_enable_create_feasign_randomly &&
-                  !_value_accessor->CreateValue(1, update_data)) {
-                continue;
+          VisitLocalShard(shard_id, [&](auto &local_shard) {
+            auto &local_shard_new = _local_shards_new[shard_id];
+            float data_buffer[value_col];  // NOLINT
+            float *data_buffer_ptr = data_buffer;
+            for (auto &item : keys) {
+              uint64_t key = item.first;
+              uint64_t push_data_idx = item.second;
+              const float *update_data =
+                  values + push_data_idx * update_value_col;
+              auto itr = local_shard.find(key);
+              if (itr == local_shard.end()) {
+                if (FLAGS_pserver_enable_create_feasign_randomly &&
+                    !_value_accessor->CreateValue(1, update_data)) {
+                  continue;
+                }
+                auto value_size = value_col - mf_value_col;
+                auto &feature_value = local_shard[key];
+                feature_value.resize(value_size);
+                _value_accessor->Create(&data_buffer_ptr, 1);
+                memcpy(feature_value.data(),
+                       data_buffer_ptr,
+                       value_size * sizeof(float));
+                itr = local_shard.find(key);
               }
-              auto value_size = value_col - mf_value_col;
-              auto &feature_value = local_shard[key];
-              feature_value.resize(value_size);
-              _value_accessor->Create(&data_buffer_ptr, 1);
-              memcpy(feature_value.data(),
-                     data_buffer_ptr,
-                     value_size * sizeof(float));
-              itr = local_shard.find(key);
-            }
-
-            auto &feature_value = itr.value();
-            float *value_data = feature_value.data();
-            size_t value_size = feature_value.size();
 
-            if (value_size == value_col) {  // 已拓展到最大size, 则就地update
-              _value_accessor->Update(&value_data, &update_data, 1);
-            } else {
-              // 拷入buffer区进行update，然后再回填，不需要的mf则回填时抛弃了
-              memcpy(data_buffer_ptr, value_data, value_size * sizeof(float));
-              _value_accessor->Update(&data_buffer_ptr, &update_data, 1);
-
-              if (_value_accessor->NeedExtendMF(data_buffer)) {
-                feature_value.resize(value_col);
-                value_data = feature_value.data();
-                _value_accessor->Create(&value_data, 1);
+              auto &feature_value = itr.value();
+              float *value_data = feature_value.data();
+              size_t value_size = feature_value.size();
+
+              if (value_size == value_col) {  // 已拓展到最大size, 则就地update
+                _value_accessor->Update(&value_data, &update_data, 1);
+              } else {
+                // 拷入buffer区进行update，然后再回填，不需要的mf则回填时抛弃了
+                memcpy(data_buffer_ptr, value_data, value_size * sizeof(float));
+                _value_accessor->Update(&data_buffer_ptr, &update_data, 1);
+
+                if (_value_accessor->NeedExtendMF(data_buffer)) {
+                  feature_value.resize(value_col);
+                  value_data = feature_value.data();
+                  _value_accessor->Create(&value_data, 1);
+                }
+                memcpy(value_data, data_buffer_ptr, value_size * sizeof(float));
+              }
+              if (_config.enable_revert()) {
+                FixedFeatureValue *feature_value_new = &(local_shard_new[key]);
+                auto new_size = feature_value.size();
+                feature_value_new->resize(new_size);
+                memcpy(feature_value_new->data(),
+                       value_data,
+                       new_size * sizeof(float));
               }
-              memcpy(value_data, data_buffer_ptr, value_size * sizeof(float));
-            }
-            if (_config.enable_revert()) {
-              FixedFeatureValue *feature_value_new = &(local_shard_new[key]);
-              auto new_size = feature_value.size();
-              feature_value_new->resize(new_size);
-              memcpy(feature_value_new->data(),
-                     value_data,
-                     new_size * sizeof(float));
             }
-          }
+          });
           return 0;
         });
   }
@@ -1240,6 +1509,15 @@ int32_t MemorySparseTable::PushSparse(const uint64_t *keys,
 int32_t MemorySparseTable::PushSparse(const uint64_t *keys,
                                       const float **values,
                                       size_t num) {
+  if (_use_concurrent_shard) {
+    auto get_update_data = [values](size_t i) { return values[i]; };
+    if (_use_slab_value) {
+      return PushSparseConcurrent(
+          _concurrent_slab_shards.get(), keys, num, get_update_data);
+    }
+    return PushSparseConcurrent(
+        _concurrent_shards.get(), keys, num, get_update_data);
+  }
   std::vector<std::future<int>> tasks(_real_local_shard_num);
   std::vector<std::vector<std::pair<uint64_t, int>>> task_keys(
       _real_local_shard_num);
@@ -1256,45 +1534,46 @@ int32_t MemorySparseTable::PushSparse(const uint64_t *keys,
     tasks[shard_id] = _shards_task_pool[shard_id % _task_pool_size]->enqueue(
         [this, shard_id, value_col, mf_value_col, values, &task_keys]() -> int {
           auto &keys = task_keys[shard_id];
-          auto &local_shard = _local_shards[shard_id];
-          float data_buffer[value_col];  // NOLINT
-          float *data_buffer_ptr = data_buffer;
-          for (auto &item : keys) {
-            uint64_t key = item.first;
-            uint64_t push_data_idx = item.second;
-            const float *update_data = values[push_data_idx];
-            auto itr = local_shard.find(key);
-            if (itr == local_shard.end()) {
-              if (FLAGS_pserver_enable_create_feasign_randomly &&
-                  !_value_accessor->CreateValue(1, update_data)) {
-                continue;
+          VisitLocalShard(shard_id, [&](auto &local_shard) {
+            float data_buffer[value_col];  // NOLINT
+            float *data_buffer_ptr = data_buffer;
+            for (auto &item : keys) {
+              uint64_t key = item.first;
+              uint64_t push_data_idx = item.second;
+              const float *update_data = values[push_data_idx];
+              auto itr = local_shard.find(key);
+              if (itr == local_shard.end()) {
+                if (FLAGS_pserver_enable_create_feasign_randomly &&
+                    !_value_accessor->CreateValue(1, update_data)) {
+                  continue;
+                }
+                auto value_size = value_col - mf_value_col;
+                auto &feature_value = local_shard[key];
+                feature_value.resize(value_size);
+                _value_accessor->Create(&data_buffer_ptr, 1);
+                memcpy(feature_value.data(),
+                       data_buffer_ptr,
+                       value_size * sizeof(float));
+                itr = local_shard.find(key);
               }
-              auto value_size = value_col - mf_value_col;
-              auto &feature_value = local_shard[key];
-              feature_value.resize(value_size);
-              _value_accessor->Create(&data_buffer_ptr, 1);
-              memcpy(feature_value.data(),
-                     data_buffer_ptr,
-                     value_size * sizeof(float));
-              itr = local_shard.find(key);
-            }
-            auto &feature_value = itr.value();
-            float *value_data = feature_value.data();
-            size_t value_size = feature_value.size();
-            if (value_size == value_col) {  // 已拓展到最大size, 则就地update
-              _value_accessor->Update(&value_data, &update_data, 1);
-            } else {
-              // 拷入buffer区进行update，然后再回填，不需要的mf则回填时抛弃了
-              memcpy(data_buffer_ptr, value_data, value_size * sizeof(float));
-              _value_accessor->Update(&data_buffer_ptr, &update_data, 1);
-              if (_value_accessor->NeedExtendMF(data_buffer)) {
-                feature_value.resize(value_col);
-                value_data = feature_value.data();
-                _value_accessor->Create(&value_data, 1);
+              auto &feature_value = itr.value();
+              float *value_data = feature_value.data();
+              size_t value_size = feature_value.size();
+              if (value_size == value_col) {  // 已拓展到最大size, 则就地update
+                _value_accessor->Update(&value_data, &update_data, 1);
+              } else {
+                // 拷入buffer区进行update，然后再回填，不需要的mf则回填时抛弃了
+                memcpy(data_buffer_ptr, value_data, value_size * sizeof(float));
+                _value_accessor->Update(&data_buffer_ptr, &update_data, 1);
+                if (_value_accessor->NeedExtendMF(data_buffer)) {
+                  feature_value.resize(value_col);
+                  value_data = feature_value.data();
+                  _value_accessor->Create(&value_data, 1);
+                }
+                memcpy(value_data, data_buffer_ptr, value_size * sizeof(float));
               }
-              memcpy(value_data, data_buffer_ptr, value_size * sizeof(float));
             }
-          }
+          });
           return 0;
         });
   }
@@ -1305,6 +1584,138 @@ int32_t MemorySparseTable::PushSparse(const uint64_t *keys,
   return 0;
 }
 
+template <typename Fn>
+void MemorySparseTable::RunConcurrentTasks(size_t num, Fn &&fn) {
+  // Small tasks do not pay off the cost of scheduling.
+  constexpr size_t kMinKeysPerTask = 256;
+  size_t task_num = std::min(_shards_task_pool.size(),
+                             (num + kMinKeysPerTask - 1) / kMinKeysPerTask);
+  if (task_num <= 1) {
+    fn(0, num);
+    return;
+  }
+  size_t keys_per_task = (num + task_num - 1) / task_num;
+  std::vector<std::future<int>> tasks;
+  tasks.reserve(task_num);
+  for (size_t task_id = 0; task_id < task_num; ++task_id) {
+    size_t begin = task_id * keys_per_task;
+    size_t end = std::min(num, begin + keys_per_task);
+    if (begin >= end) {
+      break;
+    }
+    tasks.push_back(_shards_task_pool[task_id]->enqueue([&fn, begin, end]() {
+      fn(begin, end);
+      return 0;
+    }));
+  }
+  for (auto &task : tasks) {
+    task.wait();
+  }
+}
+
+template <typename ShardType>
+int32_t MemorySparseTable::PullSparseConcurrent(
+    ShardType *shards, float *pull_values, const PullSparseValue &pull_value) {
+  CostTimer timer("pserver_sparse_select_all");
+  const size_t value_size =
+      _value_accessor->GetAccessorInfo().size / sizeof(float);
+  size_t mf_value_size =
+      _value_accessor->GetAccessorInfo().mf_size / sizeof(float);
+  size_t select_value_size =
+      _value_accessor->GetAccessorInfo().select_size / sizeof(float);
+
+  RunConcurrentTasks(pull_value.numel_, [&](size_t begin, size_t end) {
+    float data_buffer[value_size];  // NOLINT
+    float *data_buffer_ptr = data_buffer;
+    size_t data_size = 0;
+    auto init_value = [&](auto &feature_value) {
+      size_t size = value_size - mf_value_size;
+      feature_value.resize(size);
+      _value_accessor->Create(&data_buffer_ptr, 1);
+      memcpy(feature_value.data(), data_buffer_ptr, size * sizeof(float));
+    };
+    auto copy_value = [&](auto &feature_value) {
+      data_size = feature_value.size();
+      memcpy(data_buffer_ptr, feature_value.data(), data_size * sizeof(float));
+    };
+    for (size_t i = begin; i < end; ++i) {
+      uint64_t key = pull_value.feasigns_[i];
+      int shard_id = (key % _sparse_table_shard_num) % _avg_local_shard_num;
+      auto &local_shard = shards[shard_id];
+      if (FLAGS_pserver_create_value_when_push) {
+        if (!local_shard.apply_if_exists(key, copy_value)) {
+          data_size = value_size - mf_value_size;
+          memset(data_buffer, 0, sizeof(float) * data_size);
+        }
+      } else {
+        local_shard.apply_or_create(key, init_value, copy_value);
+      }
+      for (size_t mf_idx = data_size; mf_idx < value_size; ++mf_idx) {
+        data_buffer[mf_idx] = 0.0;
+      }
+      float *select_data = pull_values + select_value_size * i;
+      _value_accessor->Select(
+          &select_data, (const float **)&data_buffer_ptr, 1);
+    }
+  });
+  return 0;
+}
+
+template <typename ShardType, typename GetUpdateData>
+int32_t MemorySparseTable::PushSparseConcurrent(ShardType *shards,
+                                                const uint64_t *keys,
+                                                size_t num,
+                                                GetUpdateData get_update_data) {
+  CostTimer timer("pserver_sparse_update_all");
+  size_t value_col = _value_accessor->GetAccessorInfo().size / sizeof(float);
+  size_t mf_value_col =
+      _value_accessor->GetAccessorInfo().mf_size / sizeof(float);
+
+  RunConcurrentTasks(num, [&](size_t begin, size_t end) {
+    float data_buffer[value_col];  // NOLINT
+    float *data_buffer_ptr = data_buffer;
+    const float *update_data = nullptr;
+    auto init_value = [&](auto &feature_value) {
+      size_t value_size = value_col - mf_value_col;
+      feature_value.resize(value_size);
+      _value_accessor->Create(&data_buffer_ptr, 1);
+      memcpy(
+          feature_value.data(), data_buffer_ptr, value_size * sizeof(float));
+    };
+    auto update_value = [&](auto &feature_value) {
+      float *value_data = feature_value.data();
+      size_t value_size = feature_value.size();
+      if (value_size == value_col) {
+        _value_accessor->Update(&value_data, &update_data, 1);
+      } else {
+        memcpy(data_buffer_ptr, value_data, value_size * sizeof(float));
+        _value_accessor->Update(&data_buffer_ptr, &update_data, 1);
+        if (_value_accessor->NeedExtendMF(data_buffer)) {
+          feature_value.resize(value_col);
+          value_data = feature_value.data();
+          _value_accessor->Create(&value_data, 1);
+        }
+        memcpy(value_data, data_buffer_ptr, value_size * sizeof(float));
+      }
+    };
+    for (size_t i = begin; i < end; ++i) {
+      uint64_t key = keys[i];
+      int shard_id = (key % _sparse_table_shard_num) % _avg_local_shard_num;
+      auto &local_shard = shards[shard_id];
+      update_data = get_update_data(i);
+      if (local_shard.apply_if_exists(key, update_value)) {
+        continue;
+      }
+      if (FLAGS_pserver_enable_create_feasign_randomly &&
+          !_value_accessor->CreateValue(1, update_data)) {
+        continue;
+      }
+      local_shard.apply_or_create(key, init_value, update_value);
+    }
+  });
+  return 0;
+}
+
 int32_t MemorySparseTable::Flush() { return 0; }
 
 int32_t MemorySparseTable::Shrink(const std::string &param) {
@@ -1316,15 +1727,16 @@ int32_t MemorySparseTable::Shrink(const std::string &param) {
   for (int shard_id = 0; shard_id < _real_local_shard_num; ++shard_id) {
     // Shrink
     int feasign_size = 0;
-    auto &shard = _local_shards[shard_id];
-    for (auto it = shard.begin(); it != shard.end();) {
-      if (_value_accessor->Shrink(it.value().data())) {
-        it = shard.erase(it);
-        ++feasign_size;
-      } else {
-        ++it;
+    VisitLocalShard(shard_id, [&](auto &shard) {
+      for (auto it = shard.begin(); it != shard.end();) {
+        if (_value_accessor->Shrink(it.value().data())) {
+          it = shard.erase(it);
+          ++feasign_size;
+        } else {
+          ++it;
+        }
       }
-    }
+    });
     shrink_size_all += feasign_size;
   }
   VLOG(0) << "MemorySparseTable::Shrink success, shrink size:"
@@ -28,7 +28,9 @@
 #include "Eigen/Dense"
 #include "paddle/fluid/distributed/ps/table/accessor.h"
 #include "paddle/fluid/distributed/ps/table/common_table.h"
+#include "paddle/fluid/distributed/ps/table/depends/concurrent_feature_value.h"
 #include "paddle/fluid/distributed/ps/table/depends/feature_value.h"
+#include "paddle/fluid/distributed/ps/table/depends/slab_feature_value.h"
 #include "paddle/utils/string/string_helper.h"
 
 #define PSERVER_SAVE_SUFFIX ".shard"
@@ -39,6 +41,16 @@ namespace distributed {
 class MemorySparseTable : public Table {
  public:
   typedef SparseTableShard<uint64_t, FixedFeatureValue> shard_type;
+  typedef ConcurrentSparseTableShard<uint64_t, FixedFeatureValue>
+      concurrent_shard_type;
+  typedef SparseTableShard<uint64_t,
+                           SlabFeatureValue,
+                           SlabFeatureValueAllocator>
+      slab_shard_type;
+  typedef ConcurrentSparseTableShard<uint64_t,
+                                     SlabFeatureValue,
+                                     SlabFeatureValueAllocator>
+      concurrent_slab_shard_type;
   MemorySparseTable() {}
   virtual ~MemorySparseTable() {}
 
@@ -108,6 +120,16 @@ class MemorySparseTable : public Table {
   void Clear() override;
 
   void* GetShard(size_t shard_idx) override {
+    PADDLE_ENFORCE_EQ(_use_concurrent_shard,
+                      false,
+                      common::errors::Unimplemented(
+                          "GetShard is not supported by the shards of "
+                          "CONCURRENT_HASH_MAP backend."));
+    PADDLE_ENFORCE_EQ(
+        _use_slab_value,
+        false,
+        common::errors::Unimplemented(
+            "GetShard is not supported when enable_slab_value is set."));
     return &_local_shards[shard_idx];
   }
 
@@ -118,6 +140,43 @@ class MemorySparseTable : public Table {
   virtual int32_t SavePatch(const std::string& path, int save_param);
   virtual int32_t LoadPatch(const std::vector<std::string>& file_list,
                             int save_param);
+  // Load the binary shard files written with enable_binary_checkpoint.
+  int32_t LoadBinary(const std::vector<std::string>& file_list,
+                     size_t file_start_idx);
+
+  // Call fn with the local shard of shard_id, of any backend and value
+  // store.
+  template <typename Fn>
+  void VisitLocalShard(int shard_id, Fn&& fn) {
+    if (_use_concurrent_shard) {
+      if (_use_slab_value) {
+        fn(_concurrent_slab_shards[shard_id]);
+      } else {
+        fn(_concurrent_shards[shard_id]);
+      }
+    } else {
+      if (_use_slab_value) {
+        fn(_slab_shards[shard_id]);
+      } else {
+        fn(_local_shards[shard_id]);
+      }
+    }
+  }
+
+  // Pull and push of the CONCURRENT_HASH_MAP backend. Keys are split into
+  // even tasks regardless of their shards, so a hot shard is served by
+  // several threads.
+  template <typename ShardType>
+  int32_t PullSparseConcurrent(ShardType* shards,
+                               float* values,
+                               const PullSparseValue& pull_value);
+  template <typename ShardType, typename GetUpdateData>
+  int32_t PushSparseConcurrent(ShardType* shards,
+                               const uint64_t* keys,
+                               size_t num,
+                               GetUpdateData get_update_data);
+  template <typename Fn>
+  void RunConcurrentTasks(size_t num, Fn&& fn);
 
   int _task_pool_size = 24;
   int _avg_local_shard_num;
@@ -125,6 +184,13 @@ class MemorySparseTable : public Table {
   int _sparse_table_shard_num;
   std::vector<std::shared_ptr<::ThreadPool>> _shards_task_pool;
   std::unique_ptr<shard_type[]> _local_shards;
+  bool _use_concurrent_shard = false;
+  std::unique_ptr<concurrent_shard_type[]> _concurrent_shards;
+  // Values are stored in fixed-stride slabs sized by the accessor, instead of
+  // a std::vector per value.
+  bool _use_slab_value = false;
+  std::unique_ptr<slab_shard_type[]> _slab_shards;
+  std::unique_ptr<concurrent_slab_shard_type[]> _concurrent_slab_shards;
 
   // for patch model
   int _m_avg_local_shard_num;
@@ -14,6 +14,8 @@
 
 #include "paddle/fluid/distributed/ps/table/ssd_sparse_table.h"
 
+#include <algorithm>
+
 #include "paddle/common/flags.h"
 #include "paddle/fluid/distributed/common/cost_timer.h"
 #include "paddle/fluid/distributed/common/local_random.h"
@@ -33,8 +35,31 @@ namespace paddle::distributed {
 
 int32_t SSDSparseTable::Initialize() {
   MemorySparseTable::Initialize();
+  PADDLE_ENFORCE_EQ(_use_concurrent_shard,
+                    false,
+                    common::errors::Unimplemented(
+                        "SSDSparseTable does not support the "
+                        "CONCURRENT_HASH_MAP shard backend."));
+  PADDLE_ENFORCE_EQ(_use_slab_value,
+                    false,
+                    common::errors::Unimplemented(
+                        "SSDSparseTable does not support the slab value "
+                        "store."));
   _db = ::paddle::distributed::RocksDBHandler::GetInstance();
   _db->initialize(FLAGS_rocksdb_path, _real_local_shard_num);
+  _cache_stats = std::vector<SparseCacheStat>(_real_local_shard_num);
+  _cache_policies.clear();
+  if (_config.memory_cache_capacity() > 0) {
+    size_t shard_capacity =
+        (_config.memory_cache_capacity() + _real_local_shard_num - 1) /
+        _real_local_shard_num;
+    _cache_policies.reserve(_real_local_shard_num);
+    for (int i = 0; i < _real_local_shard_num; ++i) {
+      _cache_policies.emplace_back(shard_capacity);
+    }
+    VLOG(0) << "SSDSparseTable keeps at most " << shard_capacity
+            << " features in memory per shard";
+  }
   VLOG(0) << "initialize SSDSparseTable succ";
   VLOG(0) << "SSD FLAGS_pserver_print_missed_key_num_every_push:"
           << FLAGS_pserver_print_missed_key_num_every_push;
@@ -122,62 +147,106 @@ int32_t SSDSparseTable::PullSparse(float* pull_values,
                &missed_keys]() -> int {
                 auto& keys = task_keys[shard_id];
                 auto& local_shard = _local_shards[shard_id];
+                auto& stat = _cache_stats[shard_id];
+                SparseCachePolicy* policy = CachePolicy(shard_id);
                 float data_buffer[value_size];  // NOLINT
                 float* data_buffer_ptr = data_buffer;
+                auto select = [&](size_t data_size, int pull_data_idx) {
+                  for (size_t mf_idx = data_size; mf_idx < value_size;
+                       ++mf_idx) {
+                    data_buffer_ptr[mf_idx] = 0.0;
+                  }
+                  float* select_data =
+                      pull_values + pull_data_idx * select_value_size;
+                  _value_accessor->Select(
+                      &select_data, (const float**)&data_buffer_ptr, 1);
+                };
+                // select the keys in memory first, the others are read from
+                // rocksdb in one batch
+                std::vector<std::pair<uint64_t, int>> ssd_keys;
                 for (size_t i = 0; i < keys.size(); ++i) {
                   uint64_t key = keys[i].first;
                   auto itr = local_shard.find(key);
-                  size_t data_size = value_size - mf_value_size;
                   if (itr == local_shard.end()) {
-                    // pull rocksdb
-                    std::string tmp_string("");
-                    if (_db->get(shard_id,
+                    ssd_keys.push_back(keys[i]);
+                    continue;
+                  }
+                  if (policy != nullptr) {
+                    policy->RecordResident(key);
+                  }
+                  size_t data_size = itr.value().size();
+                  memcpy(data_buffer_ptr,
+                         itr.value().data(),
+                         data_size * sizeof(float));
+                  select(data_size, keys[i].second);
+                }
+                stat.mem_hits += keys.size() - ssd_keys.size();
+                if (ssd_keys.empty()) {
+                  if (policy != nullptr) {
+                    EvictColdValues(shard_id);
+                  }
+                  return 0;
+                }
+
+                std::sort(ssd_keys.begin(), ssd_keys.end());
+                std::vector<uint64_t> unique_keys;
+                unique_keys.reserve(ssd_keys.size());
+                for (auto& kv : ssd_keys) {
+                  if (unique_keys.empty() || unique_keys.back() != kv.first) {
+                    unique_keys.push_back(kv.first);
+                  }
+                }
+                std::vector<rocksdb::PinnableSlice> ssd_values;
+                std::vector<rocksdb::Status> status;
+                MultiGetFromSSD(shard_id, unique_keys, &ssd_values, &status);
+
+                size_t pos = 0;
+                for (size_t k = 0; k < unique_keys.size(); ++k) {
+                  uint64_t key = unique_keys[k];
+                  size_t data_size = value_size - mf_value_size;
+                  bool in_ssd = !status[k].IsNotFound();
+                  if (in_ssd) {
+                    ++stat.ssd_hits;
+                    data_size = ssd_values[k].size() / sizeof(float);
+                    memcpy(data_buffer_ptr,
+                           ssd_values[k].data(),
+                           data_size * sizeof(float));
+                  } else {
+                    ++missed_keys;
+                    ++stat.misses;
+                    if (FLAGS_pserver_create_value_when_push) {
+                      memset(data_buffer, 0, sizeof(float) * data_size);
+                    } else {
+                      _value_accessor->Create(&data_buffer_ptr, 1);
+                    }
+                  }
+                  if (policy != nullptr) {
+                    policy->RecordMiss(key);
+                  }
+                  if (in_ssd || !FLAGS_pserver_create_value_when_push) {
+                    if (policy == nullptr || policy->Admit(key)) {
+                      // from rocksdb to mem
+                      PromoteValue(
+                          shard_id, key, data_buffer_ptr, data_size, in_ssd);
+                    } else {
+                      // colder than the victim, keep it in rocksdb
+                      ++stat.rejects;
+                      if (!in_ssd) {
+                        _db->put(shard_id,
                                  reinterpret_cast<char*>(&key),
                                  sizeof(uint64_t),
-                                 tmp_string) > 0) {
-                      ++missed_keys;
-                      if (FLAGS_pserver_create_value_when_push) {
-                        memset(data_buffer, 0, sizeof(float) * data_size);
-                      } else {
-                        auto& feature_value = local_shard[key];
-                        feature_value.resize(data_size);
-                        float* data_ptr =
-                            const_cast<float*>(feature_value.data());
-                        _value_accessor->Create(&data_buffer_ptr, 1);
-                        memcpy(data_ptr,
-                               data_buffer_ptr,
-                               data_size * sizeof(float));
+                                 reinterpret_cast<char*>(data_buffer_ptr),
+                                 data_size * sizeof(float));
                       }
-                    } else {
-                      data_size = tmp_string.size() / sizeof(float);
-                      memcpy(data_buffer_ptr,
-                             ::paddle::string::str_to_float(tmp_string),
-                             data_size * sizeof(float));
-                      // from rocksdb to mem
-                      auto& feature_value = local_shard[key];
-                      feature_value.resize(data_size);
-                      memcpy(const_cast<float*>(feature_value.data()),
-                             data_buffer_ptr,
-                             data_size * sizeof(float));
-                      _db->del_data(shard_id,
-                                    reinterpret_cast<char*>(&key),
-                                    sizeof(uint64_t));
                     }
-                  } else {
-                    data_size = itr.value().size();
-                    memcpy(data_buffer_ptr,
-                           itr.value().data(),
-                           data_size * sizeof(float));
                   }
-                  for (size_t mf_idx = data_size; mf_idx < value_size;
-                       ++mf_idx) {
-                    data_buffer[mf_idx] = 0.0;
+                  for (; pos < ssd_keys.size() && ssd_keys[pos].first == key;
+                       ++pos) {
+                    select(data_size, ssd_keys[pos].second);
                   }
-                  int pull_data_idx = keys[i].second;
-                  float* select_data =
-                      pull_values + pull_data_idx * select_value_size;
-                  _value_accessor->Select(
-                      &select_data, (const float**)&data_buffer_ptr, 1);
+                }
+                if (policy != nullptr) {
+                  EvictColdValues(shard_id);
                 }
                 return 0;
               });
@@ -198,6 +267,12 @@ int32_t SSDSparseTable::PullSparsePtr(int shard_id,
                                       const uint64_t* pull_keys,
                                       size_t num,
                                       uint16_t pass_id) {
+  PADDLE_ENFORCE_EQ(_cache_policies.empty(),
+                    true,
+                    common::errors::Unimplemented(
+                        "PullSparsePtr of SSDSparseTable does not support the "
+                        "bounded memory_cache_capacity, the pulled pointers "
+                        "must outlive the eviction."));
   CostTimer timer("pserver_ssd_sparse_select_all");
   size_t value_size = _value_accessor->GetAccessorInfo().size / sizeof(float);
   size_t mf_value_size =
@@ -344,14 +419,71 @@ int32_t SSDSparseTable::PullSparsePtr(int shard_id,
   return 0;
 }
 
+template <typename UpdateData>
+void SSDSparseTable::PushSparseShard(
+    int shard_id,
+    const std::vector<std::pair<uint64_t, int>>& keys,
+    UpdateData update_data_of) {
+  size_t value_col = _value_accessor->GetAccessorInfo().size / sizeof(float);
+  size_t mf_value_col =
+      _value_accessor->GetAccessorInfo().mf_size / sizeof(float);
+  auto& local_shard = _local_shards[shard_id];
+  SparseCachePolicy* policy = CachePolicy(shard_id);
+  if (policy != nullptr) {
+    // the value may have been evicted after it was pulled
+    PromoteFromSSD(shard_id, keys);
+  }
+  float data_buffer[value_col];  // NOLINT
+  float* data_buffer_ptr = data_buffer;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    uint64_t key = keys[i].first;
+    const float* update_data = update_data_of(keys[i].second);
+    auto itr = local_shard.find(key);
+    if (itr == local_shard.end()) {
+      if (FLAGS_pserver_enable_create_feasign_randomly &&
+          !_value_accessor->CreateValue(1, update_data)) {
+        continue;
+      }
+      auto value_size = value_col - mf_value_col;
+      auto& feature_value = local_shard[key];
+      feature_value.resize(value_size);
+      _value_accessor->Create(&data_buffer_ptr, 1);
+      memcpy(const_cast<float*>(feature_value.data()),
+             data_buffer_ptr,
+             value_size * sizeof(float));
+      itr = local_shard.find(key);
+      if (policy != nullptr) {
+        policy->Insert(key);
+      }
+    }
+    auto& feature_value = itr.value();
+    float* value_data = const_cast<float*>(feature_value.data());
+    size_t value_size = feature_value.size();
+
+    if (value_size == value_col) {  // 已拓展到最大size, 则就地update
+      _value_accessor->Update(&value_data, &update_data, 1);
+    } else {
+      // 拷入buffer区进行update，然后再回填，不需要的mf则回填时抛弃了
+      memcpy(data_buffer_ptr, value_data, value_size * sizeof(float));
+      _value_accessor->Update(&data_buffer_ptr, &update_data, 1);
+      if (_value_accessor->NeedExtendMF(data_buffer)) {
+        feature_value.resize(value_col);
+        value_data = const_cast<float*>(feature_value.data());
+        _value_accessor->Create(&value_data, 1);
+      }
+      memcpy(value_data, data_buffer_ptr, value_size * sizeof(float));
+    }
+  }
+  if (policy != nullptr) {
+    EvictColdValues(shard_id);
+  }
+}
+
 int32_t SSDSparseTable::PushSparse(const uint64_t* keys,
                                    const float* values,
                                    size_t num) {
   CostTimer timer("pserver_downpour_sparse_update_all");
   // 构造value push_value的数据指针
-  size_t value_col = _value_accessor->GetAccessorInfo().size / sizeof(float);
-  size_t mf_value_col =
-      _value_accessor->GetAccessorInfo().mf_size / sizeof(float);
   size_t update_value_col =
       _value_accessor->GetAccessorInfo().update_size / sizeof(float);
   {
@@ -365,60 +497,11 @@ int32_t SSDSparseTable::PushSparse(const uint64_t* keys,
     for (int shard_id = 0; shard_id < _real_local_shard_num; ++shard_id) {
       tasks[shard_id] =
           _shards_task_pool[shard_id % _shards_task_pool.size()]->enqueue(
-              [this,
-               shard_id,
-               value_col,
-               mf_value_col,
-               update_value_col,
-               values,
-               &task_keys]() -> int {
-                auto& keys = task_keys[shard_id];
-                auto& local_shard = _local_shards[shard_id];
-                float data_buffer[value_col];  // NOLINT
-                float* data_buffer_ptr = data_buffer;
-                for (size_t i = 0; i < keys.size(); ++i) {
-                  uint64_t key = keys[i].first;
-                  uint64_t push_data_idx = keys[i].second;
-                  const float* update_data =
-                      values + push_data_idx * update_value_col;
-                  auto itr = local_shard.find(key);
-                  if (itr == local_shard.end()) {
-                    if (FLAGS_pserver_enable_create_feasign_randomly &&
-                        !_value_accessor->CreateValue(1, update_data)) {
-                      continue;
-                    }
-                    auto value_size = value_col - mf_value_col;
-                    auto& feature_value = local_shard[key];
-                    feature_value.resize(value_size);
-                    _value_accessor->Create(&data_buffer_ptr, 1);
-                    memcpy(const_cast<float*>(feature_value.data()),
-                           data_buffer_ptr,
-                           value_size * sizeof(float));
-                    itr = local_shard.find(key);
-                  }
-                  auto& feature_value = itr.value();
-                  float* value_data = const_cast<float*>(feature_value.data());
-                  size_t value_size = feature_value.size();
-
-                  if (value_size ==
-                      value_col) {  // 已拓展到最大size, 则就地update
-                    _value_accessor->Update(&value_data, &update_data, 1);
-                  } else {
-                    // 拷入buffer区进行update，然后再回填，不需要的mf则回填时抛弃了
-                    memcpy(data_buffer_ptr,
-                           value_data,
-                           value_size * sizeof(float));
-                    _value_accessor->Update(&data_buffer_ptr, &update_data, 1);
-                    if (_value_accessor->NeedExtendMF(data_buffer)) {
-                      feature_value.resize(value_col);
-                      value_data = const_cast<float*>(feature_value.data());
-                      _value_accessor->Create(&value_data, 1);
-                    }
-                    memcpy(value_data,
-                           data_buffer_ptr,
-                           value_size * sizeof(float));
-                  }
-                }
+              [this, shard_id, update_value_col, values, &task_keys]() -> int {
+                PushSparseShard(
+                    shard_id, task_keys[shard_id], [&](int push_data_idx) {
+                      return values + push_data_idx * update_value_col;
+                    });
                 return 0;
               });
     }
@@ -455,11 +538,6 @@ int32_t SSDSparseTable::PushSparse(const uint64_t* keys,
                                    size_t num) {
   CostTimer timer("pserver_downpour_sparse_update_all");
   // 构造value push_value的数据指针
-  size_t value_col = _value_accessor->GetAccessorInfo().size / sizeof(float);
-  size_t mf_value_col =
-      _value_accessor->GetAccessorInfo().mf_size / sizeof(float);
-  // size_t update_value_col =
-  // _value_accessor->GetAccessorInfo().update_size / sizeof(float);
   {
     std::vector<std::future<int>> tasks(_real_local_shard_num);
     std::vector<std::vector<std::pair<uint64_t, int>>> task_keys(
@@ -471,54 +549,11 @@ int32_t SSDSparseTable::PushSparse(const uint64_t* keys,
     for (int shard_id = 0; shard_id < _real_local_shard_num; ++shard_id) {
       tasks[shard_id] =
           _shards_task_pool[shard_id % _shards_task_pool.size()]->enqueue(
-              [this, shard_id, value_col, mf_value_col, values, &task_keys]()
-                  -> int {
-                auto& keys = task_keys[shard_id];
-                auto& local_shard = _local_shards[shard_id];
-                float data_buffer[value_col];  // NOLINT
-                float* data_buffer_ptr = data_buffer;
-                for (size_t i = 0; i < keys.size(); ++i) {
-                  uint64_t key = keys[i].first;
-                  uint64_t push_data_idx = keys[i].second;
-                  const float* update_data = values[push_data_idx];
-                  auto itr = local_shard.find(key);
-                  if (itr == local_shard.end()) {
-                    if (FLAGS_pserver_enable_create_feasign_randomly &&
-                        !_value_accessor->CreateValue(1, update_data)) {
-                      continue;
-                    }
-                    auto value_size = value_col - mf_value_col;
-                    auto& feature_value = local_shard[key];
-                    feature_value.resize(value_size);
-                    _value_accessor->Create(&data_buffer_ptr, 1);
-                    memcpy(const_cast<float*>(feature_value.data()),
-                           data_buffer_ptr,
-                           value_size * sizeof(float));
-                    itr = local_shard.find(key);
-                  }
-                  auto& feature_value = itr.value();
-                  float* value_data = const_cast<float*>(feature_value.data());
-                  size_t value_size = feature_value.size();
-
-                  if (value_size ==
-                      value_col) {  // 已拓展到最大size, 则就地update
-                    _value_accessor->Update(&value_data, &update_data, 1);
-                  } else {
-                    // 拷入buffer区进行update，然后再回填，不需要的mf则回填时抛弃了
-                    memcpy(data_buffer_ptr,
-                           value_data,
-                           value_size * sizeof(float));
-                    _value_accessor->Update(&data_buffer_ptr, &update_data, 1);
-                    if (_value_accessor->NeedExtendMF(data_buffer)) {
-                      feature_value.resize(value_col);
-                      value_data = const_cast<float*>(feature_value.data());
-                      _value_accessor->Create(&value_data, 1);
-                    }
-                    memcpy(value_data,
-                           data_buffer_ptr,
-                           value_size * sizeof(float));
-                  }
-                }
+              [this, shard_id, values, &task_keys]() -> int {
+                PushSparseShard(
+                    shard_id, task_keys[shard_id], [&](int push_data_idx) {
+                      return values[push_data_idx];
+                    });
                 return 0;
               });
     }
@@ -529,6 +564,109 @@ int32_t SSDSparseTable::PushSparse(const uint64_t* keys,
   return 0;
 }
 
+void SSDSparseTable::MultiGetFromSSD(
+    int shard_id,
+    const std::vector<uint64_t>& keys,
+    std::vector<rocksdb::PinnableSlice>* values,
+    std::vector<rocksdb::Status>* status) {
+  std::vector<rocksdb::Slice> batch_keys;
+  batch_keys.reserve(keys.size());
+  for (auto& key : keys) {
+    batch_keys.emplace_back(reinterpret_cast<const char*>(&key),
+                            sizeof(uint64_t));
+  }
+  values->resize(keys.size());
+  status->resize(keys.size());
+  _db->multi_get(shard_id,
+                 batch_keys.size(),
+                 batch_keys.data(),
+                 values->data(),
+                 status->data());
+}
+
+void SSDSparseTable::PromoteValue(int shard_id,
+                                  uint64_t key,
+                                  const float* value,
+                                  size_t size,
+                                  bool in_ssd) {
+  auto& feature_value = _local_shards[shard_id][key];
+  feature_value.resize(size);
+  memcpy(feature_value.data(), value, size * sizeof(float));
+  if (in_ssd) {
+    _db->del_data(shard_id, reinterpret_cast<char*>(&key), sizeof(uint64_t));
+  }
+  SparseCachePolicy* policy = CachePolicy(shard_id);
+  if (policy != nullptr) {
+    policy->Insert(key);
+  }
+}
+
+void SSDSparseTable::PromoteFromSSD(
+    int shard_id, const std::vector<std::pair<uint64_t, int>>& keys) {
+  auto& local_shard = _local_shards[shard_id];
+  auto& policy = _cache_policies[shard_id];
+  std::vector<uint64_t> ssd_keys;
+  for (auto& kv : keys) {
+    if (local_shard.find(kv.first) == local_shard.end()) {
+      ssd_keys.push_back(kv.first);
+    } else {
+      policy.RecordResident(kv.first);
+    }
+  }
+  if (ssd_keys.empty()) {
+    return;
+  }
+  std::sort(ssd_keys.begin(), ssd_keys.end());
+  ssd_keys.erase(std::unique(ssd_keys.begin(), ssd_keys.end()),
+                 ssd_keys.end());
+  std::vector<rocksdb::PinnableSlice> ssd_values;
+  std::vector<rocksdb::Status> status;
+  MultiGetFromSSD(shard_id, ssd_keys, &ssd_values, &status);
+  for (size_t k = 0; k < ssd_keys.size(); ++k) {
+    uint64_t key = ssd_keys[k];
+    policy.RecordMiss(key);
+    if (status[k].IsNotFound()) {
+      continue;
+    }
+    PromoteValue(shard_id,
+                 key,
+                 reinterpret_cast<const float*>(ssd_values[k].data()),
+                 ssd_values[k].size() / sizeof(float),
+                 true);
+  }
+}
+
+void SSDSparseTable::EvictColdValues(int shard_id) {
+  auto& local_shard = _local_shards[shard_id];
+  auto& policy = _cache_policies[shard_id];
+  std::vector<uint64_t> victims;
+  uint64_t key = 0;
+  while (policy.Evict(&key)) {
+    // the key may have been shrunk or saved to ssd already
+    if (local_shard.find(key) != local_shard.end()) {
+      victims.push_back(key);
+    }
+  }
+  if (victims.empty()) {
+    return;
+  }
+  std::vector<std::pair<char*, int>> ssd_keys;
+  std::vector<std::pair<char*, int>> ssd_values;
+  ssd_keys.reserve(victims.size());
+  ssd_values.reserve(victims.size());
+  for (auto& victim : victims) {
+    auto& feature_value = local_shard.find(victim).value();
+    ssd_keys.emplace_back(reinterpret_cast<char*>(&victim), sizeof(uint64_t));
+    ssd_values.emplace_back(reinterpret_cast<char*>(feature_value.data()),
+                            feature_value.size() * sizeof(float));
+  }
+  _db->put_batch(shard_id, ssd_keys, ssd_values, ssd_keys.size());
+  for (auto& victim : victims) {
+    local_shard.erase(victim);
+  }
+  _cache_stats[shard_id].evictions += victims.size();
+}
+
 int32_t SSDSparseTable::Shrink(const std::string& param) {
   int thread_num = _real_local_shard_num < 20 ? _real_local_shard_num : 20;
   omp_set_num_threads(thread_num);
@@ -541,6 +679,9 @@ int32_t SSDSparseTable::Shrink(const std::string& param) {
     auto& shard = _local_shards[i];
     for (auto it = shard.begin(); it != shard.end();) {
       if (_value_accessor->Shrink(it.value().data())) {
+        if (!_cache_policies.empty()) {
+          _cache_policies[i].Erase(it.key());
+        }
         it = shard.erase(it);
         mem_count++;
       } else {
@@ -582,6 +723,9 @@ int32_t SSDSparseTable::UpdateTable() {
                  reinterpret_cast<const char*>(it.value().data()),
                  it.value().size() * sizeof(float));
         count++;
+        if (!_cache_policies.empty()) {
+          _cache_policies[i].Erase(it.key());
+        }
         it = shard.erase(it);
       } else {
         ++it;
@@ -2685,6 +2829,7 @@ int32_t SSDSparseTable::LoadWithString(
     char* end = nullptr;
     int local_shard_id = i % _avg_local_shard_num;
     auto& shard = _local_shards[local_shard_id];
+    SparseCachePolicy* policy = CachePolicy(local_shard_id);
     float data_buffer[FLAGS_pserver_load_batch_size *  // NOLINT
                       feature_value_size];
     float* data_buffer_ptr = data_buffer;
@@ -2740,6 +2885,13 @@ int32_t SSDSparseTable::LoadWithString(
           value.resize(value_size);
           _value_accessor->ParseFromString(end, value.data());
           mem_count++;
+          if (policy != nullptr) {
+            policy->Insert(key);
+            // keeps the memory of the load bounded as well
+            if (mem_count % FLAGS_pserver_load_batch_size == 0) {
+              EvictColdValues(local_shard_id);
+            }
+          }
           if (value_size > feature_value_size - mf_value_size) {
             mem_mf_count++;
           }
@@ -2753,6 +2905,9 @@ int32_t SSDSparseTable::LoadWithString(
     if (!ssd_keys.empty()) {
       _db->put_batch(local_shard_id, ssd_keys, ssd_values, ssd_keys.size());
     }
+    if (policy != nullptr) {
+      EvictColdValues(local_shard_id);
+    }
 
     _db->flush(local_shard_id);
     VLOG(0) << "Table>> load done. ALL[" << mem_count + ssd_count << "] MEM["
@@ -2846,6 +3001,7 @@ int32_t SSDSparseTable::LoadWithBinary(const std::string& path, int param) {
           read_channel = _afs_client.open_r(channel_config, 0, &err_no);
         }
         auto& shard = _local_shards[shard_idx];
+        SparseCachePolicy* policy = CachePolicy(shard_idx);
         rocksdb::Options options;
         options.comparator = _db->get_comparator();
         rocksdb::BlockBasedTableOptions bbto;
@@ -2974,6 +3130,10 @@ int32_t SSDSparseTable::LoadWithBinary(const std::string& path, int param) {
                   if (dim > feature_value_size - mf_value_size) {
                     mem_mf_count++;
                   }
+                  // only the task of the first split loads into memory
+                  if (policy != nullptr) {
+                    policy->Insert(k);
+                  }
                 }
                 cursor += len;
                 convert_cursor += dim * sizeof(float);
@@ -3036,6 +3196,12 @@ int32_t SSDSparseTable::LoadWithBinary(const std::string& path, int param) {
       }
     }
   }
+  if (!_cache_policies.empty()) {
+    // after the ingest, which would overwrite the evicted values in ssd
+    for (int shard_idx = 0; shard_idx < _real_local_shard_num; shard_idx++) {
+      EvictColdValues(shard_idx);
+    }
+  }
   uint64_t ssd_key_num = 0;
   _db->get_estimate_key_num(ssd_key_num);
   _cache_tk_size =
@@ -3046,6 +3212,26 @@ int32_t SSDSparseTable::LoadWithBinary(const std::string& path, int param) {
 
 std::pair<int64_t, int64_t> SSDSparseTable::PrintTableStat() {
   int64_t feasign_size = LocalSize();
+  uint64_t mem_hits = 0;
+  uint64_t ssd_hits = 0;
+  uint64_t misses = 0;
+  uint64_t rejects = 0;
+  uint64_t evictions = 0;
+  for (auto& stat : _cache_stats) {
+    mem_hits += stat.mem_hits.exchange(0);
+    ssd_hits += stat.ssd_hits.exchange(0);
+    misses += stat.misses.exchange(0);
+    rejects += stat.rejects.exchange(0);
+    evictions += stat.evictions.exchange(0);
+  }
+  uint64_t pulls = mem_hits + ssd_hits + misses;
+  if (pulls > 0) {
+    LOG(INFO) << "SSDSparseTable pulled keys:" << pulls
+              << " mem_hit_rate:" << static_cast<double>(mem_hits) / pulls
+              << " ssd_hit_rate:" << static_cast<double>(ssd_hits) / pulls
+              << " miss_rate:" << static_cast<double>(misses) / pulls
+              << " rejected:" << rejects << " evicted:" << evictions;
+  }
   return {feasign_size, -1};
 }
 
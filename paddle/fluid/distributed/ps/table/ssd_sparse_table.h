@@ -16,6 +16,7 @@
 
 #include "paddle/common/flags.h"
 #include "paddle/fluid/distributed/ps/table/depends/rocksdb_wrapper.h"
+#include "paddle/fluid/distributed/ps/table/depends/sparse_cache_policy.h"
 #include "paddle/fluid/distributed/ps/table/memory_sparse_table.h"
 
 #if defined(PADDLE_WITH_HETERPS) && defined(PADDLE_WITH_PSCORE)
@@ -91,6 +92,9 @@ class SSDSparseTable : public MemorySparseTable {
     for (int i = 0; i < _real_local_shard_num; ++i) {
       _local_shards[i].clear();
     }
+    for (auto& policy : _cache_policies) {
+      policy.Clear();
+    }
   }
 
   int32_t Save(const std::string& path, const std::string& param) override;
@@ -135,7 +139,42 @@ class SSDSparseTable : public MemorySparseTable {
   void SetDayId(int day_id) override;
 
  private:
+  // Reads the values of the sorted unique keys from ssd in one batch.
+  void MultiGetFromSSD(int shard_id,
+                       const std::vector<uint64_t>& keys,
+                       std::vector<rocksdb::PinnableSlice>* values,
+                       std::vector<rocksdb::Status>* status);
+  // The cache policy of the shard, nullptr if the in-memory tier is
+  // unbounded.
+  SparseCachePolicy* CachePolicy(int shard_id) {
+    return _cache_policies.empty() ? nullptr : &_cache_policies[shard_id];
+  }
+  // Puts the value of size floats into memory and registers its key with the
+  // cache policy, the copy in ssd is deleted if in_ssd.
+  void PromoteValue(int shard_id,
+                    uint64_t key,
+                    const float* value,
+                    size_t size,
+                    bool in_ssd);
+  // Moves the values of the keys which are not in memory from ssd into
+  // memory, used by push when the in-memory tier is bounded.
+  void PromoteFromSSD(int shard_id,
+                      const std::vector<std::pair<uint64_t, int>>& keys);
+  // Applies the updates of the keys of one shard of a push,
+  // update_data_of(i) is the update of the i-th key of the request.
+  template <typename UpdateData>
+  void PushSparseShard(int shard_id,
+                       const std::vector<std::pair<uint64_t, int>>& keys,
+                       UpdateData update_data_of);
+  // Moves the victims of the cache policy from memory to ssd until the
+  // in-memory tier fits its capacity, after a push or a load.
+  void EvictColdValues(int shard_id);
+
   RocksDBHandler* _db;
+  // One per shard when the in-memory tier is bounded, see
+  // TableParameter.memory_cache_capacity.
+  std::vector<SparseCachePolicy> _cache_policies;
+  std::vector<SparseCacheStat> _cache_stats;
   int64_t _cache_tk_size;
   double _local_show_threshold{0.0};
   std::vector<paddle::framework::Channel<std::string>> _fs_channel;
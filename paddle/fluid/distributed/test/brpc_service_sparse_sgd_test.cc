@@ -301,6 +301,45 @@ void RunBrpcPushSparse() {
     EXPECT_FLOAT_EQ(fea_temp_values[idx], fea_values[idx] - 1.0);
   }
 
+  // pipelined pull, the two batches share half of the keys
+  LOG(INFO) << "Run pull_sparse_pipelined";
+  std::vector<uint64_t> pipelined_keys[2];
+  std::vector<float> pipelined_values[2];
+  std::vector<float*> pipelined_value_ptr[2];
+  for (size_t batch = 0; batch < 2; ++batch) {
+    for (size_t idx = batch * 5; idx < batch * 5 + 10; ++idx) {
+      pipelined_keys[batch].push_back(idx % fea_keys.size());
+    }
+    pipelined_values[batch].resize(pipelined_keys[batch].size() * 10);
+    for (size_t idx = 0; idx < pipelined_keys[batch].size(); ++idx) {
+      pipelined_value_ptr[batch].push_back(pipelined_values[batch].data() +
+                                           idx * 10);
+    }
+  }
+  auto pipelined_status0 =
+      worker_ptr_->PullSparsePipelined(pipelined_value_ptr[0].data(),
+                                       0,
+                                       pipelined_keys[0].data(),
+                                       pipelined_keys[0].size(),
+                                       true);
+  auto pipelined_status1 =
+      worker_ptr_->PullSparsePipelined(pipelined_value_ptr[1].data(),
+                                       0,
+                                       pipelined_keys[1].data(),
+                                       pipelined_keys[1].size(),
+                                       true);
+  EXPECT_EQ(pipelined_status0.get(), 0);
+  EXPECT_EQ(pipelined_status1.get(), 0);
+  for (size_t batch = 0; batch < 2; ++batch) {
+    for (size_t idx = 0; idx < pipelined_keys[batch].size(); ++idx) {
+      uint64_t key = pipelined_keys[batch][idx];
+      for (size_t col = 0; col < 10; ++col) {
+        EXPECT_FLOAT_EQ(pipelined_values[batch][idx * 10 + col],
+                        fea_temp_values[key * 10 + col]);
+      }
+    }
+  }
+
   LOG(INFO) << "Run stop_server";
   worker_ptr_->StopServer();
   LOG(INFO) << "Run finalize_worker";
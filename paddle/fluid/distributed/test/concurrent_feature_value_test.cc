@@ -0,0 +1,174 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/distributed/ps/table/depends/concurrent_feature_value.h"
+
+#include <chrono>  // NOLINT
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "glog/logging.h"
+#include "gtest/gtest.h"
+
+namespace paddle::distributed {
+
+typedef ConcurrentSparseTableShard<uint64_t, FixedFeatureValue>
+    concurrent_shard_type;
+typedef SparseTableShard<uint64_t, FixedFeatureValue> shard_type;
+
+TEST(ConcurrentSparseTableShard, Sequential) {
+  concurrent_shard_type shard;
+  ASSERT_TRUE(shard.find(1) == shard.end());
+
+  for (uint64_t key = 0; key < 1000; ++key) {
+    auto& value = shard[key];
+    value.resize(2);
+    value.data()[0] = static_cast<float>(key);
+  }
+  ASSERT_EQ(shard.size(), 1000UL);
+  auto itr = shard.find(10);
+  ASSERT_TRUE(itr != shard.end());
+  ASSERT_FLOAT_EQ(itr.value().data()[0], 10.0);
+
+  size_t count = 0;
+  for (auto it = shard.begin(); it != shard.end();) {
+    ASSERT_FLOAT_EQ(it.value().data()[0], static_cast<float>(it.key()));
+    ++count;
+    if (it.key() % 2 == 0) {
+      it = shard.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  ASSERT_EQ(count, 1000UL);
+  ASSERT_EQ(shard.size(), 500UL);
+  ASSERT_TRUE(shard.find(10) == shard.end());
+  ASSERT_TRUE(shard.find(11) != shard.end());
+
+  shard.clear();
+  ASSERT_TRUE(shard.empty());
+}
+
+TEST(ConcurrentSparseTableShard, Concurrent) {
+  concurrent_shard_type shard;
+  const int thread_num = 8;
+  const uint64_t key_num = 10000;
+  const int round = 10;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < thread_num; ++t) {
+    threads.emplace_back([&shard, key_num, round]() {
+      for (int r = 0; r < round; ++r) {
+        for (uint64_t key = 0; key < key_num; ++key) {
+          shard.apply_or_create(
+              key,
+              [key](FixedFeatureValue& value) {
+                value.resize(2);
+                value.data()[0] = static_cast<float>(key);
+                value.data()[1] = 0;
+              },
+              [](FixedFeatureValue& value) { value.data()[1] += 1; });
+          bool found = shard.apply_if_exists(key, [key](FixedFeatureValue& v) {
+            EXPECT_FLOAT_EQ(v.data()[0], static_cast<float>(key));
+          });
+          EXPECT_TRUE(found);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(shard.size(), key_num);
+  for (auto it = shard.begin(); it != shard.end(); ++it) {
+    ASSERT_FLOAT_EQ(it.value().data()[1], thread_num * round);
+  }
+}
+
+// Pull/push throughput of one hot shard. The mct backend serves a shard by
+// one thread at a time, which is emulated by a mutex here.
+TEST(BENCHMARK, ConcurrentSparseTableShard) {
+  const int thread_num = 8;
+  const uint64_t key_num = 200000;
+  const size_t dim = 16;
+  auto now = []() { return std::chrono::steady_clock::now(); };
+  auto run = [thread_num](auto&& fn) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_num; ++t) {
+      threads.emplace_back([&fn, t]() { fn(t); });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  };
+  auto push_value = [dim](FixedFeatureValue& value) {
+    if (value.size() != dim) {
+      value.resize(dim);
+    }
+    for (size_t i = 0; i < dim; ++i) {
+      value.data()[i] += 0.1;
+    }
+  };
+
+  shard_type mct_shard;
+  std::mutex mct_mutex;
+  auto start = now();
+  run([&](int t) {
+    for (uint64_t key = t; key < key_num; key += thread_num) {
+      std::lock_guard<std::mutex> guard(mct_mutex);
+      push_value(mct_shard[key]);
+    }
+  });
+  double mct_push = std::chrono::duration<double>(now() - start).count();
+  start = now();
+  run([&](int t) {
+    float buffer[dim];  // NOLINT
+    for (uint64_t key = t; key < key_num; key += thread_num) {
+      std::lock_guard<std::mutex> guard(mct_mutex);
+      auto it = mct_shard.find(key);
+      memcpy(buffer, it.value().data(), sizeof(buffer));
+    }
+  });
+  double mct_pull = std::chrono::duration<double>(now() - start).count();
+
+  concurrent_shard_type shard;
+  start = now();
+  run([&](int t) {
+    for (uint64_t key = t; key < key_num; key += thread_num) {
+      shard.apply_or_create(key, [](FixedFeatureValue&) {}, push_value);
+    }
+  });
+  double concurrent_push = std::chrono::duration<double>(now() - start).count();
+  start = now();
+  run([&](int t) {
+    float buffer[dim];  // NOLINT
+    for (uint64_t key = t; key < key_num; key += thread_num) {
+      shard.apply_if_exists(key, [&buffer](FixedFeatureValue& value) {
+        memcpy(buffer, value.data(), sizeof(buffer));
+      });
+    }
+  });
+  double concurrent_pull =
+      std::chrono::duration<double>(now() - start).count();
+
+  ASSERT_EQ(mct_shard.size(), shard.size());
+  LOG(INFO) << "push " << key_num << " keys by " << thread_num
+            << " threads, mct: " << mct_push
+            << "s, concurrent: " << concurrent_push << "s";
+  LOG(INFO) << "pull " << key_num << " keys by " << thread_num
+            << " threads, mct: " << mct_pull
+            << "s, concurrent: " << concurrent_pull << "s";
+}
+
+}  // namespace paddle::distributed
@@ -16,6 +16,8 @@ limitations under the License. */
 
 #include <vector>
 
+#include "paddle/fluid/distributed/ps/table/depends/slab_feature_value.h"
+
 #include "gtest/gtest.h"
 
 namespace paddle::distributed {
@@ -45,4 +47,91 @@ TEST(BENCHMARK, LargeScaleKV) {
   ASSERT_FLOAT_EQ(value_data[3], 0.3);
 }
 
+TEST(SlabFeatureValue, SparseTableShard) {
+  typedef SparseTableShard<uint64_t,
+                           SlabFeatureValue,
+                           SlabFeatureValueAllocator>
+      shard_type;
+  const size_t capacity = 5;
+  shard_type shard;
+  shard.set_value_capacity(capacity);
+
+  const uint64_t key_num = 1000;
+  for (uint64_t key = 0; key < key_num; ++key) {
+    auto& feature_value = shard[key];
+    ASSERT_EQ(feature_value.size(), 0UL);
+    ASSERT_EQ(feature_value.capacity(), capacity);
+    feature_value.resize(key % 2 == 0 ? capacity - 2 : capacity);
+    for (size_t i = 0; i < feature_value.size(); ++i) {
+      feature_value.data()[i] = static_cast<float>(key * 10 + i);
+    }
+  }
+  ASSERT_EQ(shard.size(), key_num);
+
+  // Growing within the capacity keeps the value in place.
+  auto itr = shard.find(0);
+  ASSERT_TRUE(itr != shard.end());
+  float* data = itr.value().data();
+  itr.value().resize(capacity);
+  ASSERT_EQ(itr.value().data(), data);
+  // The grown floats are zeros, whatever the slot held before.
+  for (size_t i = capacity - 2; i < capacity; ++i) {
+    ASSERT_EQ(data[i], 0.0f);
+  }
+  data[1] = 7.0f;
+  itr.value().resize(1);
+  itr.value().resize(capacity);
+  ASSERT_EQ(data[1], 0.0f);
+
+  for (uint64_t key = 1; key < key_num; ++key) {
+    auto it = shard.find(key);
+    ASSERT_TRUE(it != shard.end());
+    auto& feature_value = it.value();
+    ASSERT_EQ(feature_value.size(), key % 2 == 0 ? capacity - 2 : capacity);
+    for (size_t i = 0; i < feature_value.size(); ++i) {
+      ASSERT_FLOAT_EQ(feature_value.data()[i],
+                      static_cast<float>(key * 10 + i));
+    }
+  }
+
+  // Erase half of the values and create new ones in the released slots.
+  for (uint64_t key = 0; key < key_num; key += 2) {
+    ASSERT_EQ(shard.erase(key), 1UL);
+  }
+  ASSERT_EQ(shard.size(), key_num / 2);
+  for (uint64_t key = key_num; key < key_num + key_num / 2; ++key) {
+    auto& feature_value = shard[key];
+    feature_value.resize(capacity);
+    for (size_t i = 0; i < capacity; ++i) {
+      ASSERT_EQ(feature_value.data()[i], 0.0f);
+    }
+  }
+  ASSERT_EQ(shard.size(), key_num);
+  for (uint64_t key = 1; key < key_num; key += 2) {
+    ASSERT_FLOAT_EQ(shard.find(key).value().data()[capacity - 1],
+                    static_cast<float>(key * 10 + capacity - 1));
+  }
+}
+
+TEST(SlabFeatureValue, Allocator) {
+  SlabFeatureValueAllocator alloc(4);
+  alloc.set_value_capacity(3);
+  ASSERT_EQ(alloc.stride() % sizeof(void*), 0UL);
+  ASSERT_GE(alloc.stride(), sizeof(SlabFeatureValue) + 3 * sizeof(float));
+
+  std::vector<SlabFeatureValue*> values;
+  for (int i = 0; i < 10; ++i) {
+    values.push_back(alloc.acquire());
+  }
+  ASSERT_EQ(alloc.size(), 10UL);
+  // Values in one chunk are laid out with a fixed stride.
+  ASSERT_EQ(reinterpret_cast<char*>(values[1]) -
+                reinterpret_cast<char*>(values[0]),
+            static_cast<std::ptrdiff_t>(alloc.stride()));
+  for (auto* value : values) {
+    alloc.release(value);
+  }
+  ASSERT_EQ(alloc.size(), 0UL);
+}
+
 }  // namespace paddle::distributed
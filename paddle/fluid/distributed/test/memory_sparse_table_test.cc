@@ -17,6 +17,7 @@ limitations under the License. */
 #include <ThreadPool.h>
 #include <unistd.h>
 
+#include <memory>
 #include <string>
 #include <thread>  // NOLINT
 
@@ -24,6 +25,7 @@ limitations under the License. */
 #include "gtest/gtest.h"
 #include "paddle/fluid/distributed/ps/table/table.h"
 #include "paddle/fluid/distributed/the_one_ps.pb.h"
+#include "paddle/fluid/framework/io/fs.h"
 
 namespace paddle::distributed {
 
@@ -151,4 +153,208 @@ TEST(MemorySparseTable, SGD) {
   }
 }
 
+TEST(MemorySparseTable, ShardBackendsAndSlabValue) {
+  int emb_dim = 8;
+  auto create_table = [emb_dim](SparseShardBackend backend, bool slab_value) {
+    TableParameter table_config;
+    table_config.set_table_class("MemorySparseTable");
+    table_config.set_shard_num(4);
+    table_config.set_shard_backend(backend);
+    table_config.set_enable_slab_value(slab_value);
+    TableAccessorParameter *accessor_config = table_config.mutable_accessor();
+    accessor_config->set_accessor_class("CtrCommonAccessor");
+    accessor_config->set_fea_dim(11);
+    accessor_config->set_embedx_dim(emb_dim);
+    accessor_config->set_embedx_threshold(5);
+    accessor_config->mutable_ctr_accessor_param()->set_nonclk_coeff(0.2);
+    accessor_config->mutable_ctr_accessor_param()->set_click_coeff(1);
+    accessor_config->mutable_ctr_accessor_param()->set_base_threshold(0.5);
+    accessor_config->mutable_ctr_accessor_param()->set_delta_threshold(0.2);
+    accessor_config->mutable_ctr_accessor_param()->set_delta_keep_days(16);
+    accessor_config->mutable_ctr_accessor_param()->set_show_click_decay_rate(
+        0.99);
+    for (auto *sgd_param : {accessor_config->mutable_embed_sgd_param(),
+                            accessor_config->mutable_embedx_sgd_param()}) {
+      sgd_param->set_name("SparseNaiveSGDRule");
+      auto *naive_param = sgd_param->mutable_naive();
+      naive_param->set_learning_rate(0.1);
+      // Deterministic initial values, so that all tables are comparable.
+      naive_param->set_initial_range(0.0);
+      naive_param->add_weight_bounds(-10.0);
+      naive_param->add_weight_bounds(10.0);
+    }
+    FsClientParameter fs_config;
+    auto table = std::make_unique<MemorySparseTable>();
+    table->SetShard(0, 1);
+    EXPECT_EQ(table->Initialize(table_config, fs_config), 0);
+    return table;
+  };
+  auto mct_table = create_table(MCT_HASH_MAP, false);
+  std::vector<std::unique_ptr<MemorySparseTable>> tables;
+  tables.push_back(create_table(CONCURRENT_HASH_MAP, false));
+  tables.push_back(create_table(MCT_HASH_MAP, true));
+  tables.push_back(create_table(CONCURRENT_HASH_MAP, true));
+
+  // Enough keys to be split into several tasks, most of them in one shard.
+  std::vector<uint64_t> keys;
+  for (uint64_t i = 0; i < 4096; ++i) {
+    keys.push_back(i % 8 == 0 ? i * 4 + 1 : i * 4);
+  }
+  std::vector<uint32_t> fres(keys.size(), 1);
+  std::vector<float> gradients;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    // slot, show, click, embed_g, embedx_g
+    gradients.push_back(0);
+    gradients.push_back(1);
+    gradients.push_back(i % 2);
+    for (int k = 0; k < emb_dim + 1; ++k) {
+      gradients.push_back(0.01 * (k + 1));
+    }
+  }
+
+  auto pull = [&](Table *table) {
+    std::vector<float> values(keys.size() * (emb_dim + 3));
+    auto pull_value = PullSparseValue(keys, fres, emb_dim);
+    TableContext table_context;
+    table_context.value_type = Sparse;
+    table_context.pull_context.pull_value = pull_value;
+    table_context.pull_context.values = values.data();
+    table->Pull(table_context);
+    return values;
+  };
+  auto push = [&](Table *table) {
+    TableContext table_context;
+    table_context.value_type = Sparse;
+    table_context.push_context.keys = keys.data();
+    table_context.push_context.values = gradients.data();
+    table_context.num = keys.size();
+    table->Push(table_context);
+  };
+
+  auto train = [&](Table *table) {
+    pull(table);
+    for (int round = 0; round < 3; ++round) {
+      push(table);
+    }
+  };
+  train(mct_table.get());
+  auto mct_values = pull(mct_table.get());
+  for (auto &table : tables) {
+    train(table.get());
+    auto values = pull(table.get());
+    ASSERT_EQ(mct_values.size(), values.size());
+    for (size_t i = 0; i < mct_values.size(); ++i) {
+      ASSERT_NEAR(mct_values[i], values[i], 1e-5);
+    }
+    ASSERT_EQ(mct_table->LocalSize(), table->LocalSize());
+    ASSERT_EQ(mct_table->LocalMFSize(), table->LocalMFSize());
+  }
+}
+
+TEST(MemorySparseTable, BinaryCheckpoint) {
+  int emb_dim = 8;
+  auto create_table = [emb_dim](SparseShardBackend backend, bool binary) {
+    TableParameter table_config;
+    table_config.set_table_class("MemorySparseTable");
+    table_config.set_shard_num(4);
+    table_config.set_shard_backend(backend);
+    table_config.set_compress_in_save(false);
+    table_config.set_enable_binary_checkpoint(binary);
+    TableAccessorParameter *accessor_config = table_config.mutable_accessor();
+    accessor_config->set_accessor_class("CtrCommonAccessor");
+    accessor_config->set_fea_dim(11);
+    accessor_config->set_embedx_dim(emb_dim);
+    accessor_config->set_embedx_threshold(1);
+    accessor_config->mutable_ctr_accessor_param()->set_nonclk_coeff(0.2);
+    accessor_config->mutable_ctr_accessor_param()->set_click_coeff(1);
+    accessor_config->mutable_ctr_accessor_param()->set_base_threshold(0.5);
+    accessor_config->mutable_ctr_accessor_param()->set_delta_threshold(0.2);
+    accessor_config->mutable_ctr_accessor_param()->set_delta_keep_days(16);
+    accessor_config->mutable_ctr_accessor_param()->set_show_click_decay_rate(
+        0.99);
+    for (auto *sgd_param : {accessor_config->mutable_embed_sgd_param(),
+                            accessor_config->mutable_embedx_sgd_param()}) {
+      sgd_param->set_name("SparseNaiveSGDRule");
+      auto *naive_param = sgd_param->mutable_naive();
+      naive_param->set_learning_rate(0.1);
+      naive_param->set_initial_range(0.0);
+      naive_param->add_weight_bounds(-10.0);
+      naive_param->add_weight_bounds(10.0);
+    }
+    FsClientParameter fs_config;
+    auto table = std::make_unique<MemorySparseTable>();
+    table->SetShard(0, 1);
+    EXPECT_EQ(table->Initialize(table_config, fs_config), 0);
+    return table;
+  };
+
+  std::vector<uint64_t> keys;
+  for (uint64_t i = 0; i < 2048; ++i) {
+    keys.push_back(i * 3);
+  }
+  std::vector<uint32_t> fres(keys.size(), 1);
+  std::vector<float> gradients;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    // slot, show, click, embed_g, embedx_g, only some keys get embedx
+    gradients.push_back(0);
+    gradients.push_back(i % 4 == 0 ? 2 : 0.1);
+    gradients.push_back(i % 2);
+    for (int k = 0; k < emb_dim + 1; ++k) {
+      gradients.push_back(0.01 * (k + 1));
+    }
+  }
+  auto pull = [&](Table *table) {
+    std::vector<float> values(keys.size() * (emb_dim + 3));
+    auto pull_value = PullSparseValue(keys, fres, emb_dim);
+    TableContext table_context;
+    table_context.value_type = Sparse;
+    table_context.pull_context.pull_value = pull_value;
+    table_context.pull_context.values = values.data();
+    table->Pull(table_context);
+    return values;
+  };
+  auto push = [&](Table *table) {
+    TableContext table_context;
+    table_context.value_type = Sparse;
+    table_context.push_context.keys = keys.data();
+    table_context.push_context.values = gradients.data();
+    table_context.num = keys.size();
+    table->Push(table_context);
+  };
+
+  std::string dirname =
+      "./memory_sparse_table_test_" + std::to_string(getpid());
+  auto text_table = create_table(MCT_HASH_MAP, false);
+  auto binary_table = create_table(MCT_HASH_MAP, true);
+  for (auto *table : {text_table.get(), binary_table.get()}) {
+    pull(table);
+    for (int round = 0; round < 3; ++round) {
+      push(table);
+    }
+  }
+  ASSERT_EQ(text_table->Save(dirname + "/text", "0"), 0);
+  ASSERT_EQ(binary_table->Save(dirname + "/binary", "0"), 0);
+
+  auto loaded_text_table = create_table(MCT_HASH_MAP, false);
+  ASSERT_EQ(loaded_text_table->Load(dirname + "/text", "0"), 0);
+  ASSERT_EQ(loaded_text_table->LocalSize(), text_table->LocalSize());
+  auto text_values = pull(loaded_text_table.get());
+
+  // The binary files are loaded by both backends, block by block in parallel
+  // by the concurrent one.
+  for (auto backend : {MCT_HASH_MAP, CONCURRENT_HASH_MAP}) {
+    auto loaded_table = create_table(backend, true);
+    ASSERT_EQ(loaded_table->Load(dirname + "/binary", "0"), 0);
+    ASSERT_EQ(loaded_table->LocalSize(), binary_table->LocalSize());
+    ASSERT_EQ(loaded_table->LocalMFSize(), loaded_text_table->LocalMFSize());
+    auto values = pull(loaded_table.get());
+    ASSERT_EQ(values.size(), text_values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+      // The text files only keep 6 significant digits.
+      ASSERT_NEAR(values[i], text_values[i], 1e-4);
+    }
+  }
+  ::paddle::framework::fs_remove(dirname);
+}
+
 }  // namespace paddle::distributed
@@ -0,0 +1,101 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include "paddle/fluid/distributed/ps/table/depends/sparse_cache_policy.h"
+
+#include <set>
+
+#include "gtest/gtest.h"
+
+namespace paddle::distributed {
+
+TEST(SparseCachePolicy, Sketch) {
+  SparseFrequencySketch sketch(1024);
+  for (int i = 0; i < 10; ++i) {
+    sketch.Increment(7);
+  }
+  sketch.Increment(8);
+  ASSERT_EQ(sketch.Estimate(7), 10U);
+  ASSERT_GE(sketch.Estimate(8), 1U);
+  ASSERT_LT(sketch.Estimate(8), 10U);
+  // saturated at 15
+  for (int i = 0; i < 100; ++i) {
+    sketch.Increment(7);
+  }
+  ASSERT_EQ(sketch.Estimate(7), 15U);
+}
+
+TEST(SparseCachePolicy, EvictBeyondCapacity) {
+  SparseCachePolicy policy(100);
+  for (uint64_t key = 0; key < 150; ++key) {
+    policy.RecordMiss(key);
+    policy.Insert(key);
+  }
+  ASSERT_EQ(policy.size(), 150UL);
+  std::set<uint64_t> victims;
+  uint64_t key = 0;
+  while (policy.Evict(&key)) {
+    ASSERT_FALSE(policy.Contains(key));
+    victims.insert(key);
+  }
+  ASSERT_EQ(victims.size(), 50UL);
+  ASSERT_EQ(policy.size(), 100UL);
+
+  // freed slots are reused
+  policy.Erase(policy.Contains(0) ? 0 : 100);
+  ASSERT_EQ(policy.size(), 99UL);
+  policy.Insert(1000);
+  ASSERT_EQ(policy.size(), 100UL);
+  ASSERT_FALSE(policy.Evict(&key));
+
+  policy.Clear();
+  ASSERT_EQ(policy.size(), 0UL);
+}
+
+TEST(SparseCachePolicy, HotKeysSurviveScan) {
+  const uint64_t capacity = 64;
+  SparseCachePolicy policy(capacity);
+  // hot keys accessed many times
+  for (int round = 0; round < 8; ++round) {
+    for (uint64_t key = 0; key < capacity; ++key) {
+      if (policy.Contains(key)) {
+        policy.RecordResident(key);
+      } else {
+        policy.RecordMiss(key);
+        ASSERT_TRUE(policy.Admit(key));
+        policy.Insert(key);
+      }
+    }
+  }
+  // a scan of keys accessed once is not admitted, while the hot keys keep
+  // being accessed
+  size_t admitted = 0;
+  for (uint64_t key = 1000; key < 2000; ++key) {
+    policy.RecordResident(key % capacity);
+    policy.RecordMiss(key);
+    if (policy.Admit(key)) {
+      policy.Insert(key);
+      ++admitted;
+    }
+    uint64_t victim = 0;
+    while (policy.Evict(&victim)) {
+    }
+  }
+  ASSERT_EQ(admitted, 0UL);
+  for (uint64_t key = 0; key < capacity; ++key) {
+    ASSERT_TRUE(policy.Contains(key));
+  }
+}
+
+}  // namespace paddle::distributed
@@ -0,0 +1,148 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include "paddle/fluid/distributed/ps/table/depends/sparse_shard_file.h"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace paddle::distributed {
+
+namespace {
+
+std::shared_ptr<FILE> OpenFile(const std::string& path, const char* mode) {
+  FILE* fp = fopen(path.c_str(), mode);
+  if (fp == nullptr) {
+    return nullptr;
+  }
+  return std::shared_ptr<FILE>(fp, [](FILE* fp) { fclose(fp); });
+}
+
+// Values of different sizes, the key decides the value.
+std::map<uint64_t, std::vector<float>> MakeValues(size_t num, size_t dim) {
+  std::map<uint64_t, std::vector<float>> values;
+  for (uint64_t key = 0; key < num; ++key) {
+    std::vector<float> value(key % 3 == 0 ? dim : dim / 2);
+    for (size_t i = 0; i < value.size(); ++i) {
+      value[i] = static_cast<float>(key) + 0.001f * i;
+    }
+    values[key * 7 + 1] = value;
+  }
+  return values;
+}
+
+void WriteValues(const std::string& path,
+                 const std::map<uint64_t, std::vector<float>>& values,
+                 uint32_t dim,
+                 size_t block_bytes) {
+  FsWriteChannel channel;
+  FsChannelConfig config;
+  auto fp = OpenFile(path, "wb");
+  ASSERT_TRUE(fp != nullptr);
+  channel.open(fp, config);
+  SparseShardFileWriter writer(&channel, dim, block_bytes);
+  for (auto& kv : values) {
+    ASSERT_EQ(writer.Append(kv.first, kv.second.data(), kv.second.size()), 0);
+  }
+  ASSERT_EQ(writer.Finish(), 0);
+  ASSERT_EQ(writer.num_records(), values.size());
+  channel.close();
+}
+
+}  // namespace
+
+TEST(SparseShardFile, Suffix) {
+  ASSERT_TRUE(IsSparseShardFile("/path/part-000-00001.bin"));
+  ASSERT_FALSE(IsSparseShardFile("/path/part-000-00001"));
+  ASSERT_FALSE(IsSparseShardFile("/path/part-000-00001.gz"));
+}
+
+TEST(SparseShardFile, MappedAndStreamed) {
+  const uint32_t dim = 17;
+  const std::string path =
+      "./sparse_shard_file_test_" + std::to_string(getpid()) + ".bin";
+  auto values = MakeValues(1000, dim);
+  // Small blocks, so that the file has many of them.
+  WriteValues(path, values, dim, 1024);
+
+  SparseShardFileMapping mapping;
+  ASSERT_EQ(mapping.Open(path), 0);
+  ASSERT_EQ(mapping.value_dim(), dim);
+  ASSERT_EQ(mapping.num_records(), values.size());
+  ASSERT_GT(mapping.num_blocks(), 1UL);
+  std::map<uint64_t, std::vector<float>> mapped_values;
+  for (size_t block = 0; block < mapping.num_blocks(); ++block) {
+    ASSERT_EQ(mapping.ForEachRecord(block,
+                                    [&](uint64_t key,
+                                        const float* value,
+                                        uint32_t size) {
+                                      mapped_values[key].assign(value,
+                                                                value + size);
+                                    }),
+              0);
+  }
+  ASSERT_EQ(mapped_values, values);
+  mapping.Close();
+
+  FsReadChannel channel;
+  FsChannelConfig config;
+  auto fp = OpenFile(path, "rb");
+  ASSERT_TRUE(fp != nullptr);
+  channel.open(fp, config);
+  SparseShardFileReader reader(&channel);
+  ASSERT_EQ(reader.ReadHeader(), 0);
+  ASSERT_EQ(reader.value_dim(), dim);
+  std::map<uint64_t, std::vector<float>> streamed_values;
+  ASSERT_EQ(reader.ForEachRecord(
+                [&](uint64_t key, const float* value, uint32_t size) {
+                  streamed_values[key].assign(value, value + size);
+                }),
+            0);
+  ASSERT_EQ(streamed_values, values);
+  channel.close();
+
+  remove(path.c_str());
+}
+
+TEST(SparseShardFile, EmptyAndCorrupted) {
+  const uint32_t dim = 9;
+  const std::string path =
+      "./sparse_shard_file_test_empty_" + std::to_string(getpid()) + ".bin";
+  WriteValues(path, {}, dim, 1024);
+  SparseShardFileMapping mapping;
+  ASSERT_EQ(mapping.Open(path), 0);
+  ASSERT_EQ(mapping.num_blocks(), 0UL);
+  ASSERT_EQ(mapping.num_records(), 0UL);
+  mapping.Close();
+
+  WriteValues(path, MakeValues(100, dim), dim, 256);
+  auto fp = OpenFile(path, "rb");
+  ASSERT_TRUE(fp != nullptr);
+  fseek(fp.get(), 0, SEEK_END);
+  long size = ftell(fp.get());  // NOLINT
+  fp.reset();
+  ASSERT_EQ(truncate(path.c_str(), size - 1), 0);
+  ASSERT_NE(mapping.Open(path), 0);
+
+  remove(path.c_str());
+}
+
+}  // namespace paddle::distributed
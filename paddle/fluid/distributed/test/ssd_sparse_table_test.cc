@@ -0,0 +1,132 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include "paddle/fluid/distributed/ps/table/ssd_sparse_table.h"
+
+#include <unistd.h>
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/common/flags.h"
+#include "paddle/fluid/distributed/ps/table/table.h"
+#include "paddle/fluid/distributed/the_one_ps.pb.h"
+#include "paddle/fluid/framework/io/fs.h"
+
+PHI_DECLARE_string(rocksdb_path);
+PD_DECLARE_int32(pserver_load_batch_size);
+
+namespace paddle::distributed {
+
+TEST(SSDSparseTable, MemoryCacheCapacityAfterLoad) {
+  int emb_dim = 8;
+  size_t capacity = 64;
+  std::string dirname = "./ssd_sparse_table_test_" + std::to_string(getpid());
+  FLAGS_rocksdb_path = dirname + "/rocksdb";
+  // evicts during the load as well
+  FLAGS_pserver_load_batch_size = 100;
+
+  TableParameter table_config;
+  table_config.set_table_class("SSDSparseTable");
+  table_config.set_shard_num(1);
+  table_config.set_memory_cache_capacity(capacity);
+  TableAccessorParameter *accessor_config = table_config.mutable_accessor();
+  accessor_config->set_accessor_class("CtrCommonAccessor");
+  accessor_config->set_fea_dim(11);
+  accessor_config->set_embedx_dim(emb_dim);
+  accessor_config->set_embedx_threshold(5);
+  accessor_config->mutable_ctr_accessor_param()->set_nonclk_coeff(0.2);
+  accessor_config->mutable_ctr_accessor_param()->set_click_coeff(1);
+  accessor_config->mutable_ctr_accessor_param()->set_base_threshold(0.5);
+  accessor_config->mutable_ctr_accessor_param()->set_delta_threshold(0.2);
+  accessor_config->mutable_ctr_accessor_param()->set_delta_keep_days(16);
+  accessor_config->mutable_ctr_accessor_param()->set_show_click_decay_rate(
+      0.99);
+  for (auto *sgd_param : {accessor_config->mutable_embed_sgd_param(),
+                          accessor_config->mutable_embedx_sgd_param()}) {
+    sgd_param->set_name("SparseNaiveSGDRule");
+    auto *naive_param = sgd_param->mutable_naive();
+    naive_param->set_learning_rate(0.1);
+    naive_param->set_initial_range(0.0);
+    naive_param->add_weight_bounds(-10.0);
+    naive_param->add_weight_bounds(10.0);
+  }
+  FsClientParameter fs_config;
+  auto table = std::make_unique<SSDSparseTable>();
+  table->SetShard(0, 1);
+  ASSERT_EQ(table->Initialize(table_config, fs_config), 0);
+
+  // features seen today, which are all loaded into memory:
+  // key slot unseen_days delta_score show click embed_w
+  std::vector<uint64_t> keys;
+  for (uint64_t i = 0; i < 1000; ++i) {
+    keys.push_back(i);
+  }
+  std::string table_dir = dirname + "/model/000";
+  ::paddle::framework::localfs_mkdir(table_dir);
+  {
+    std::ofstream part(table_dir + "/part-000-00000");
+    for (auto key : keys) {
+      part << key << " 0 0 0 1 0 " << key * 0.001 << "\n";
+    }
+  }
+  ASSERT_EQ(table->Load(dirname + "/model", "4"), 0);
+  ASSERT_LE(table->LocalSize(), capacity);
+
+  // the evicted features are pulled from ssd
+  std::vector<uint32_t> fres(keys.size(), 1);
+  std::vector<float> values(keys.size() * (emb_dim + 3));
+  auto pull_value = PullSparseValue(keys, fres, emb_dim);
+  TableContext pull_context;
+  pull_context.value_type = Sparse;
+  pull_context.pull_context.pull_value = pull_value;
+  pull_context.pull_context.values = values.data();
+  ASSERT_EQ(table->Pull(pull_context), 0);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    // show, click, embed_w, embedx_w
+    ASSERT_NEAR(values[i * (emb_dim + 3) + 2], keys[i] * 0.001, 1e-5);
+  }
+  ASSERT_LE(table->LocalSize(), capacity);
+
+  std::vector<float> gradients;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    // slot, show, click, embed_g, embedx_g
+    gradients.push_back(0);
+    gradients.push_back(1);
+    gradients.push_back(0);
+    for (int k = 0; k < emb_dim + 1; ++k) {
+      gradients.push_back(0.01);
+    }
+  }
+  TableContext push_context;
+  push_context.value_type = Sparse;
+  push_context.push_context.keys = keys.data();
+  push_context.push_context.values = gradients.data();
+  push_context.num = keys.size();
+  ASSERT_EQ(table->Push(push_context), 0);
+  ASSERT_LE(table->LocalSize(), capacity);
+
+  ASSERT_EQ(table->Pull(pull_context), 0);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    ASSERT_NEAR(
+        values[i * (emb_dim + 3) + 2], keys[i] * 0.001 - 0.1 * 0.01, 1e-5);
+  }
+  table.reset();
+  ::paddle::framework::fs_remove(dirname);
+}
+
+}  // namespace paddle::distributed
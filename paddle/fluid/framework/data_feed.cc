@@ -21,6 +21,7 @@ limitations under the License. */
 
 #include "paddle/fluid/framework/fleet/ps_gpu_wrapper.h"
 #ifdef _LINUX
+#include <fcntl.h>
 #include <stdio_ext.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
@@ -2598,6 +2599,311 @@ bool SlotRecordInMemoryDataFeed::ParseOneInstance(const std::string& line,
   return (uint64_total_slot_num > 0);
 }
 
+void SlotRecordMmapInMemoryDataFeed::LoadIntoMemory() {
+  VLOG(3) << "SlotRecord mmap LoadIntoMemory() begin, thread_id="
+          << thread_id_;
+  if (CanLoadByMmap()) {
+    LoadIntoMemoryByMmap();
+  } else {
+    SlotRecordInMemoryDataFeed::LoadIntoMemory();
+  }
+}
+
+bool SlotRecordMmapInMemoryDataFeed::CanLoadByMmap() {
+#ifdef _LINUX
+  if (!so_parser_name_.empty()) {
+    return false;
+  }
+  if (!pipe_command_.empty() && paddle::string::trim_spaces(pipe_command_) !=
+                                    std::string("cat")) {
+    return false;
+  }
+  for (auto& filename : filelist_) {
+    if (fs_select_internal(filename) != 0 ||
+        paddle::string::ends_with(filename, ".gz")) {
+      return false;
+    }
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+void SlotRecordMmapInMemoryDataFeed::LoadIntoMemoryByMmap() {
+#ifdef _LINUX
+  platform::Timer timeline;
+  timeline.Start();
+  // all the files are seen as one byte stream, which is split evenly
+  std::vector<size_t> file_sizes(filelist_.size(), 0);
+  size_t total_size = 0;
+  for (size_t i = 0; i < filelist_.size(); ++i) {
+    struct stat sb;
+    PADDLE_ENFORCE_EQ(stat(filelist_[i].c_str(), &sb),
+                      0,
+                      common::errors::NotFound("Fail to stat file %s.",
+                                               filelist_[i].c_str()));
+    file_sizes[i] = static_cast<size_t>(sb.st_size);
+    total_size += file_sizes[i];
+  }
+  size_t thread_num = static_cast<size_t>(std::max(thread_num_, 1));
+  size_t thread_id = static_cast<size_t>(thread_id_);
+  auto range_offset = [total_size, thread_num](size_t id) {
+    return total_size / thread_num * id + std::min(id, total_size % thread_num);
+  };
+  size_t range_begin = range_offset(thread_id);
+  size_t range_end = range_offset(thread_id + 1);
+
+  std::default_random_engine random_engine(std::random_device{}());
+  std::uniform_real_distribution<float> uniform_distribution(0.0f, 1.0f);
+  bool sample_all = std::abs(sample_rate_ - 1.0f) < 1e-5f;
+
+  std::vector<SlotRecord> record_vec;
+  SlotRecordPool().get(&record_vec, OBJPOOL_BLOCK_SIZE);
+  int offset = 0;
+  size_t lines = 0;
+  size_t error_lines = 0;
+  auto parse_line = [&](const char* str, const char* end) {
+    ++lines;
+    if (!sample_all && uniform_distribution(random_engine) >= sample_rate_) {
+      return;
+    }
+    if (!ParseOneInstanceFromBuffer(str, end, &record_vec[offset])) {
+      ++error_lines;
+      LOG(WARNING) << "mmap file item error, thread_id=" << thread_id_
+                   << ", line:[" << std::string(str, end - str) << "]";
+      return;
+    }
+    if (++offset >= OBJPOOL_BLOCK_SIZE) {
+      input_channel_->Write(std::move(record_vec));
+      record_vec.clear();
+      SlotRecordPool().get(&record_vec, OBJPOOL_BLOCK_SIZE);
+      offset = 0;
+    }
+  };
+
+  size_t file_begin = 0;
+  for (size_t i = 0; i < filelist_.size(); ++i) {
+    size_t file_size = file_sizes[i];
+    size_t file_end = file_begin + file_size;
+    if (file_size == 0 || file_end <= range_begin ||
+        file_begin >= range_end) {
+      file_begin = file_end;
+      continue;
+    }
+    const std::string& filename = filelist_[i];
+    int fd = open(filename.c_str(), O_RDONLY);
+    PADDLE_ENFORCE_NE(
+        fd,
+        -1,
+        common::errors::Unavailable("Fail to open file: %s", filename.c_str()));
+    char* buffer = reinterpret_cast<char*>(
+        mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0));
+    close(fd);
+    PADDLE_ENFORCE_NE(
+        buffer,
+        MAP_FAILED,
+        common::errors::Unavailable("Memory map failed when load file %s.",
+                                    filename.c_str()));
+    madvise(buffer, file_size, MADV_SEQUENTIAL);
+
+    // a line belongs to the thread whose range holds its first byte
+    size_t pos = std::max(range_begin, file_begin) - file_begin;
+    size_t stop = std::min(range_end, file_end) - file_begin;
+    if (pos > 0 && buffer[pos - 1] != '\n') {
+      const char* eol = reinterpret_cast<const char*>(
+          memchr(buffer + pos, '\n', file_size - pos));
+      pos = eol == nullptr ? file_size : eol - buffer + 1;
+    }
+    while (pos < stop) {
+      const char* str = buffer + pos;
+      const char* eol =
+          reinterpret_cast<const char*>(memchr(str, '\n', file_size - pos));
+      // the parsing is bounded by the end of the line, so the last line
+      // without '\n' is parsed in place too
+      const char* end = eol != nullptr ? eol : buffer + file_size;
+      parse_line(str, end);
+      pos = end - buffer + 1;
+    }
+    munmap(buffer, file_size);
+    file_begin = file_end;
+  }
+
+  if (offset > 0) {
+    input_channel_->WriteMove(offset, &record_vec[0]);
+    if (offset < OBJPOOL_BLOCK_SIZE) {
+      SlotRecordPool().put(&record_vec[offset], (OBJPOOL_BLOCK_SIZE - offset));
+    }
+  } else {
+    SlotRecordPool().put(&record_vec);
+  }
+  record_vec.clear();
+  record_vec.shrink_to_fit();
+  timeline.Pause();
+  VLOG(3) << "LoadIntoMemoryByMmap() end, thread_id=" << thread_id_
+          << ", range=[" << range_begin << ", " << range_end
+          << "), lines=" << lines << ", error lines=" << error_lines
+          << ", cost time=" << timeline.ElapsedSec() << " seconds";
+#endif
+}
+
+namespace {
+
+inline const char* SkipSpaces(const char* str, const char* end) {
+  while (str < end && (*str == ' ' || *str == '\t')) {
+    ++str;
+  }
+  return str;
+}
+
+// parses a decimal integer in [*str, end) and moves *str after it
+inline bool ParseUint64(const char** str, const char* end, uint64_t* value) {
+  const char* p = SkipSpaces(*str, end);
+  if (p == end || *p < '0' || *p > '9') {
+    return false;
+  }
+  uint64_t v = 0;
+  while (p < end && *p >= '0' && *p <= '9') {
+    v = v * 10 + static_cast<uint64_t>(*p - '0');
+    ++p;
+  }
+  *value = v;
+  *str = p;
+  return true;
+}
+
+// parses a float in [*str, end) and moves *str after it. strtof is run on a
+// copy of the token, since it would skip '\n' and read past end.
+inline bool ParseFloat(const char** str, const char* end, float* value) {
+  const char* p = SkipSpaces(*str, end);
+  const char* q = p;
+  while (q < end && *q != ' ' && *q != '\t') {
+    ++q;
+  }
+  char buf[64];
+  size_t len = q - p;
+  if (len == 0 || len >= sizeof(buf)) {
+    return false;
+  }
+  memcpy(buf, p, len);
+  buf[len] = '\0';
+  char* endptr = nullptr;
+  *value = strtof(buf, &endptr);
+  if (endptr == buf) {
+    return false;
+  }
+  *str = p + (endptr - buf);
+  return true;
+}
+
+// the next token in [*str, end) separated by spaces
+inline bool ParseToken(const char** str, const char* end, std::string* token) {
+  const char* p = SkipSpaces(*str, end);
+  const char* q = p;
+  while (q < end && *q != ' ' && *q != '\t') {
+    ++q;
+  }
+  if (q == p) {
+    return false;
+  }
+  token->assign(p, q - p);
+  *str = q;
+  return true;
+}
+
+}  // namespace
+
+bool SlotRecordMmapInMemoryDataFeed::ParseOneInstanceFromBuffer(
+    const char* str, const char* end, SlotRecord* ins) {
+  SlotRecord& rec = (*ins);
+  const char* pos = str;
+  uint64_t num = 0;
+
+  if (parse_ins_id_) {
+    if (!ParseUint64(&pos, end, &num) || num != 1 ||
+        !ParseToken(&pos, end, &rec->ins_id_)) {
+      return false;
+    }
+  }
+  if (parse_logkey_) {
+    std::string log_key;
+    if (!ParseUint64(&pos, end, &num) || num != 1 ||
+        !ParseToken(&pos, end, &log_key)) {
+      return false;
+    }
+    uint64_t search_id = 0;
+    uint32_t cmatch = 0;
+    uint32_t rank = 0;
+    parser_log_key(log_key, &search_id, &cmatch, &rank);
+    rec->ins_id_ = log_key;
+    rec->search_id = search_id;
+    rec->cmatch = cmatch;
+    rec->rank = rank;
+  }
+
+  // the values are appended to the record directly, the used slots of every
+  // type are visited in the order of their slot_value_idx
+  auto& float_feasigns = rec->slot_float_feasigns_;
+  auto& uint64_feasigns = rec->slot_uint64_feasigns_;
+  float_feasigns.slot_values.clear();
+  uint64_feasigns.slot_values.clear();
+  float_feasigns.slot_offsets.resize(float_use_slot_size_ + 1);
+  uint64_feasigns.slot_offsets.resize(uint64_use_slot_size_ + 1);
+
+  for (auto& info : all_slots_info_) {
+    if (!ParseUint64(&pos, end, &num)) {
+      return false;
+    }
+    PADDLE_ENFORCE(num,
+                   "The number of ids can not be zero, you need padding "
+                   "it in data generator; or if there is something wrong with "
+                   "the data, please check if the data contains unresolvable "
+                   "characters.\nplease check this error line: %s",
+                   std::string(str, end - str));
+    if (info.used_idx != -1 && info.type[0] == 'f') {  // float
+      float_feasigns.slot_offsets[info.slot_value_idx] =
+          static_cast<uint32_t>(float_feasigns.slot_values.size());
+      bool dense = used_slots_info_[info.used_idx].dense;
+      for (uint64_t j = 0; j < num; ++j) {
+        float feasign = 0;
+        if (!ParseFloat(&pos, end, &feasign)) {
+          return false;
+        }
+        if (fabs(feasign) < 1e-6 && !dense) {
+          continue;
+        }
+        float_feasigns.slot_values.push_back(feasign);
+      }
+    } else if (info.used_idx != -1 && info.type[0] == 'u') {  // uint64
+      uint64_feasigns.slot_offsets[info.slot_value_idx] =
+          static_cast<uint32_t>(uint64_feasigns.slot_values.size());
+      for (uint64_t j = 0; j < num; ++j) {
+        uint64_t feasign = 0;
+        if (!ParseUint64(&pos, end, &feasign)) {
+          return false;
+        }
+        uint64_feasigns.slot_values.push_back(feasign);
+      }
+    } else {
+      for (uint64_t j = 0; j < num; ++j) {
+        pos = SkipSpaces(pos, end);
+        if (pos == end) {
+          return false;
+        }
+        while (pos < end && *pos != ' ' && *pos != '\t') {
+          ++pos;
+        }
+      }
+    }
+  }
+  float_feasigns.slot_offsets[float_use_slot_size_] =
+      static_cast<uint32_t>(float_feasigns.slot_values.size());
+  uint64_feasigns.slot_offsets[uint64_use_slot_size_] =
+      static_cast<uint32_t>(uint64_feasigns.slot_values.size());
+
+  return !uint64_feasigns.slot_values.empty();
+}
+
 void SlotRecordInMemoryDataFeed::AssignFeedVar(const Scope& scope) {
   CheckInit();
 #if defined(PADDLE_WITH_CUDA) && defined(PADDLE_WITH_HETERPS)
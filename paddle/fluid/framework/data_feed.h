@@ -2079,6 +2079,27 @@ class SlotRecordInMemoryDataFeed : public InMemoryDataFeed<SlotRecord> {
 #endif
 };
 
+// Loads local plain text files by mmap instead of through a pipe. The bytes
+// of the whole file list are split evenly among the loading threads at line
+// boundaries, and every line is parsed in place into the pooled SlotRecords,
+// without copying it into a std::string. It falls back to
+// SlotRecordInMemoryDataFeed when the files are remote or compressed, or a
+// pipe command other than cat or a parser library is set.
+class SlotRecordMmapInMemoryDataFeed : public SlotRecordInMemoryDataFeed {
+ public:
+  SlotRecordMmapInMemoryDataFeed() = default;
+  virtual ~SlotRecordMmapInMemoryDataFeed() {}
+  void LoadIntoMemory() override;
+
+ protected:
+  virtual bool CanLoadByMmap();
+  virtual void LoadIntoMemoryByMmap(void);
+  // parses the line [str, end), which does not contain '\n'
+  bool ParseOneInstanceFromBuffer(const char* str,
+                                  const char* end,
+                                  SlotRecord* rec);
+};
+
 class PaddleBoxDataFeed : public MultiSlotInMemoryDataFeed {
  public:
   PaddleBoxDataFeed() {}
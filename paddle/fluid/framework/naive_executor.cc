@@ -14,6 +14,7 @@
 
 #include "paddle/fluid/framework/naive_executor.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -22,6 +23,7 @@
 #include "paddle/fluid/framework/op_registry.h"
 #include "paddle/fluid/framework/scope.h"
 #include "paddle/fluid/framework/variable_helper.h"
+#include "paddle/phi/core/memory/malloc.h"
 #include "paddle/phi/core/platform/denormal.h"
 #ifdef PADDLE_WITH_DNNL
 #include "paddle/fluid/platform/onednn_helper.h"
@@ -102,6 +104,9 @@ void NaiveExecutor::Run() {
 #ifdef PADDLE_WITH_NVTX
   platform::CudaNvtxRangePush("model", platform::NvtxRangeColor::Yellow);
 #endif
+  if (!static_slices_.empty()) {
+    BindStaticMemory();
+  }
   for (auto &op : ops_) {
     VLOG(4) << std::this_thread::get_id() << " run "
             << op->DebugStringEx(scope_) << " on scope " << scope_;
@@ -295,6 +300,55 @@ void NaiveExecutor::MakeReusePlan(
   }
 }
 
+void NaiveExecutor::MakeStaticMemoryPlan(
+    const std::unordered_map<std::string, std::pair<size_t, size_t>>
+        &static_plan) {
+  size_t arena_size = 0;
+  for (auto &it : static_plan) {
+    arena_size = std::max(arena_size, it.second.first + it.second.second);
+  }
+  if (arena_size == 0) return;
+  static_arena_ = memory::AllocShared(place_, arena_size);
+  auto *base = static_cast<uint8_t *>(static_arena_->ptr());
+  static_slices_.clear();
+  for (auto &it : static_plan) {
+    auto *var = scope_->FindVar(it.first);
+    if (var == nullptr || !var->IsType<phi::DenseTensor>()) continue;
+    // the slices do not own their memory, which the arena holds
+    static_slices_.emplace_back(
+        var->GetMutable<phi::DenseTensor>(),
+        std::make_shared<phi::Allocation>(
+            base + it.second.first, it.second.second, place_));
+  }
+  VLOG(3) << "Bind " << static_slices_.size()
+          << " tensors to a static memory arena of " << arena_size
+          << " bytes";
+  BindStaticMemory();
+}
+
+void NaiveExecutor::BindStaticMemory() {
+  for (size_t i = 0; i < static_slices_.size();) {
+    auto *tensor = static_slices_[i].first;
+    const auto &slice = static_slices_[i].second;
+    if (tensor->Holder() == slice) {
+      ++i;
+      continue;
+    }
+    if (tensor->Holder() && tensor->Holder()->size() > slice->size()) {
+      // the tensor is larger than planned, it keeps its own allocation
+      VLOG(3) << "A tensor of " << tensor->Holder()->size()
+              << " bytes outgrows its static slice of " << slice->size()
+              << " bytes";
+      static_slices_[i] = std::move(static_slices_.back());
+      static_slices_.pop_back();
+      continue;
+    }
+    tensor->clear();
+    tensor->ResetHolder(slice);
+    ++i;
+  }
+}
+
 NaiveExecutor::~NaiveExecutor() {
 #ifdef PADDLE_WITH_DNNL
   // Clear mkl-dnn cache,
@@ -18,6 +18,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "paddle/fluid/framework/operator.h"
@@ -93,6 +94,14 @@ class NaiveExecutor {
   void MakeReusePlan(
       const std::unordered_map<std::string, std::string>& reuse_table);
 
+  // Binds every tensor of static_plan, whose values are its offset and size,
+  // to its slice of one buffer allocated here. Run() binds them again if an
+  // operator has replaced their allocations, unless a tensor has outgrown its
+  // slice.
+  void MakeStaticMemoryPlan(
+      const std::unordered_map<std::string, std::pair<size_t, size_t>>&
+          static_plan);
+
   void ResetTrtOps(int num);
 
   void RegisterOutputHook(const HookFunc& hookfunc);
@@ -103,6 +112,8 @@ class NaiveExecutor {
  private:
   void CreateOps(const ProgramDesc& desc, int block_id);
 
+  void BindStaticMemory();
+
  private:
   const phi::Place place_;
   // Catch the required resource to avoid recreate.
@@ -120,6 +131,11 @@ class NaiveExecutor {
       reuse_cache_;
   std::vector<phi::DenseTensor*> cluster_buffer_;
 
+  // The buffer of the static memory plan and the slices of its tensors.
+  std::shared_ptr<phi::Allocation> static_arena_;
+  std::vector<std::pair<phi::DenseTensor*, std::shared_ptr<phi::Allocation>>>
+      static_slices_;
+
   std::unique_ptr<framework::InterpreterCore> interpreter_core_;
 };
 
@@ -15,6 +15,7 @@
 #include "paddle/fluid/framework/new_executor/interpreter/interpreter_util.h"
 
 #include <algorithm>
+#include <atomic>
 
 #include "paddle/common/flags.h"
 #include "paddle/fluid/distributed/auto_parallel/dist_attr.h"
@@ -34,6 +35,7 @@
 #include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
 #include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
 #include "paddle/fluid/pir/dialect/operator/utils/op_yaml_info_parser.h"
+#include "paddle/phi/backends/cpu/cpu_parallel.h"
 #include "paddle/phi/core/distributed/comm_context_manager.h"
 #include "paddle/phi/core/framework/framework.pb.h"
 #include "paddle/phi/core/kernel_context.h"
@@ -57,6 +59,14 @@ COMMON_DECLARE_bool(check_nan_inf);
 COMMON_DECLARE_string(static_runtime_data_save_path);
 COMMON_DECLARE_bool(save_static_runtime_data);
 
+PHI_DEFINE_EXPORTED_bool(
+    new_executor_bind_host_threads,
+    false,
+    "Pin the host threads of new executor to the available cpus, and let "
+    "idle threads steal tasks from their nearest neighbours first. Every "
+    "executor takes the next cpus, so that concurrent executors do not share "
+    "cores until all of them are taken.");
+
 namespace paddle::framework::interpreter {
 
 using VariableIdMap = std::map<std::string, std::vector<int>>;
@@ -93,6 +103,21 @@ class SingleStreamGuard {
   std::shared_ptr<OperatorBase> op_;
 };
 
+// The cpus to pin the host threads of a new interpreter to. The interpreters
+// of a process take consecutive slices of the available cpus, so that they do
+// not all stack onto the first ones. The slices wrap around once every cpu is
+// taken.
+static std::vector<int> HostThreadCpus(size_t host_num_threads) {
+  static std::atomic<size_t> next_cpu{0};
+  std::vector<int> cpus = GetAvailableCpus();
+  if (cpus.empty()) {
+    return cpus;
+  }
+  size_t first = next_cpu.fetch_add(host_num_threads) % cpus.size();
+  std::rotate(cpus.begin(), cpus.begin() + first, cpus.end());
+  return cpus;
+}
+
 const std::vector<WorkQueueOptions> ConstructWorkQueueOptions(
     size_t host_num_threads, size_t device_num_threads, EventsWaiter* waiter) {
   std::vector<WorkQueueOptions> group_options;
@@ -104,6 +129,17 @@ const std::vector<WorkQueueOptions> ConstructWorkQueueOptions(
                              /*track_task*/ false,
                              /*detached*/ true,
                              /*events_waiter*/ waiter);
+  if (FLAGS_new_executor_bind_host_threads) {
+    group_options.back().cpu_affinity = HostThreadCpus(host_num_threads);
+  }
+  // the host threads run cpu kernels concurrently, and share the threads of
+  // their parallel loops
+  if (host_num_threads > 1) {
+    group_options.back().cpu_parallel_threads = std::max<int>(
+        1,
+        phi::backends::cpu::CPUParallelMaxThreads() /
+            static_cast<int>(host_num_threads));
+  }
   // for launch device Kernel
   group_options.emplace_back(/*name*/ "DeviceKernelLaunch",
                              /*num_threads*/ device_num_threads,
@@ -123,12 +159,44 @@ AsyncWorkQueue::AsyncWorkQueue(size_t host_num_threads,
           host_num_threads, device_num_threads, waiter))) {}
 
 void AsyncWorkQueue::AddTask(const OpFuncType& op_func_type,
-                             std::function<void()> fn) {
+                             WorkQueueTask fn) {
   // queue_idx=0 : kCpuSync or kGpuSync
   // queue_idx=1 : kGPUAsync
   queue_group_->AddTask(op_func_type == OpFuncType::kGpuAsync, std::move(fn));
 }
 
+void AsyncWorkQueue::AddTask(const OpFuncType& op_func_type,
+                             WorkQueueTask fn,
+                             int preferred_worker) {
+  queue_group_->AddTask(op_func_type == OpFuncType::kGpuAsync,
+                        std::move(fn),
+                        preferred_worker);
+}
+
+int AsyncWorkQueue::CurrentWorkerId(const OpFuncType& op_func_type) const {
+  return queue_group_->QueueCurrentWorkerId(op_func_type ==
+                                            OpFuncType::kGpuAsync);
+}
+
+void InstructionWorkers::Reset(size_t instr_num) {
+  producers_.assign(instr_num, {});
+  workers_.reset(new std::atomic<int>[instr_num]);
+  for (size_t i = 0; i < instr_num; ++i) {
+    workers_[i].store(-1, std::memory_order_relaxed);
+  }
+}
+
+int InstructionWorkers::PreferredWorker(size_t instr_id,
+                                        int current_worker) const {
+  for (size_t producer_id : producers_[instr_id]) {
+    int worker = workers_[producer_id].load(std::memory_order_relaxed);
+    if (worker >= 0 && worker != current_worker) {
+      return worker;
+    }
+  }
+  return -1;
+}
+
 bool IsCommunicationOp(const OperatorBase* op) {
   const std::string& op_name = op->Type();
   const std::set<std::string> special_comm_op_set = {
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <iostream>
 #include <map>
@@ -53,7 +54,17 @@ class AsyncWorkQueue {
 
   // void WaitEmpty() { queue_group_->WaitQueueGroupEmpty(); }
 
-  void AddTask(const OpFuncType& op_func_type, std::function<void()> fn);
+  void AddTask(const OpFuncType& op_func_type, WorkQueueTask fn);
+
+  // Prefer to run fn on worker `preferred_worker` of the queue serving
+  // op_func_type, see WorkQueue::AddTask for details.
+  void AddTask(const OpFuncType& op_func_type,
+               WorkQueueTask fn,
+               int preferred_worker);
+
+  // The worker id of the calling thread in the queue serving op_func_type,
+  // -1 if the calling thread is not one of its workers.
+  int CurrentWorkerId(const OpFuncType& op_func_type) const;
 
   void Cancel() { queue_group_->Cancel(); }
 
@@ -66,6 +77,33 @@ class AsyncWorkQueue {
   std::unique_ptr<WorkQueueGroup> queue_group_;
 };
 
+// InstructionWorkers records the worker which ran every instruction. An
+// instruction scheduled on another thread prefers a worker which ran one of
+// its producers, since the outputs of the producer are still in its caches,
+// while the scheduling worker goes on with the instructions of its own
+// thread.
+class InstructionWorkers {
+ public:
+  void Reset(size_t instr_num);
+
+  // producer_id produces the inputs of instr_id, and runs on the same queue.
+  void AddProducer(size_t instr_id, size_t producer_id) {
+    producers_[instr_id].push_back(producer_id);
+  }
+
+  void Record(size_t instr_id, int worker_id) {
+    workers_[instr_id].store(worker_id, std::memory_order_relaxed);
+  }
+
+  // The worker of a producer of instr_id other than current_worker, -1 if
+  // there is none.
+  int PreferredWorker(size_t instr_id, int current_worker) const;
+
+ private:
+  std::vector<std::vector<size_t>> producers_;
+  std::unique_ptr<std::atomic<int>[]> workers_;
+};
+
 bool IsCommunicationOp(const OperatorBase* op);
 
 bool IsCommunicationOp(const Instruction& instr);
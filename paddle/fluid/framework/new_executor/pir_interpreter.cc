@@ -1122,6 +1122,8 @@ void PirInterpreter::BuildInstructionDependences() {
   }
   auto downstream_map = ir_dependency_builder_.Build(instructions_ptr);
 
+  instr_workers_.Reset(instr_num);
+
   for (size_t instr_id = 0; instr_id < instr_num; ++instr_id) {
     InstructionBase* cur_instr = vec_instruction_base_[instr_id].get();
     const std::set<size_t>& next_instr_ids = downstream_map[instr_id];
@@ -1155,6 +1157,14 @@ void PirInterpreter::BuildInstructionDependences() {
       }
     }
 
+    const bool is_device = cur_instr->KernelType() == OpFuncType::kGpuAsync;
+    for (size_t next_instr_id : next_instr_ids) {
+      if ((vec_instruction_base_[next_instr_id]->KernelType() ==
+           OpFuncType::kGpuAsync) == is_device) {
+        instr_workers_.AddProducer(next_instr_id, instr_id);
+      }
+    }
+
     if (!is_shared_results_build_) {
       for (size_t next_instr_id : next_instr_ids) {
         ++(*dependency_count_)[next_instr_id];
@@ -1875,6 +1885,8 @@ void PirInterpreter::RunInstructionBaseAsync(size_t instr_id) {
     instr_id = ready_ops.top();
     ready_ops.pop();
     auto* instr_node = vec_instruction_base_.at(instr_id).get();
+    instr_workers_.Record(
+        instr_id, async_work_queue_->CurrentWorkerId(instr_node->KernelType()));
 
     RunInstructionBase(instr_node);
 
@@ -1911,9 +1923,15 @@ void PirInterpreter::RunNextInstructions(InstructionBase* instr,
 
   for (size_t next_instr_id : instr->NextInstrsInDifferenceThread()) {
     if (IsReady(next_instr_id)) {
+      // Prefer a worker which produced the inputs, to reuse its caches.
+      OpFuncType kernel_type =
+          vec_instruction_base_[next_instr_id]->KernelType();
+      int worker = instr_workers_.PreferredWorker(
+          next_instr_id, async_work_queue_->CurrentWorkerId(kernel_type));
       async_work_queue_->AddTask(
-          vec_instruction_base_[next_instr_id]->KernelType(),
-          [this, next_instr_id]() { RunInstructionBaseAsync(next_instr_id); });
+          kernel_type,
+          [this, next_instr_id]() { RunInstructionBaseAsync(next_instr_id); },
+          worker);
     }
   }
 
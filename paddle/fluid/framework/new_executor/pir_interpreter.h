@@ -200,6 +200,10 @@ class PirInterpreter : public InterpreterBaseImpl {
   std::vector<std::shared_ptr<interpreter::OpDepInfo>> deps_;
   std::vector<std::shared_ptr<interpreter::VarRefInfo>> refs_;
 
+  // the workers which ran the instructions, to schedule an instruction on the
+  // worker which produced its inputs
+  interpreter::InstructionWorkers instr_workers_;
+
   // used for Trace
   int64_t sync_op_num_{-1};
   int64_t nccl_op_num_{-1};
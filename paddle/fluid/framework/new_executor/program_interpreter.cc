@@ -625,6 +625,8 @@ void ProgramInterpreter::BuildOperatorDependences() {
 
   auto downstream_map = dependency_builder_.Build(vec_instruction_);
 
+  instr_workers_.Reset(instr_num);
+
   for (size_t instr_id = 0; instr_id < instr_num; ++instr_id) {
     Instruction& cur_instr = vec_instruction_[instr_id];
     const std::set<size_t>& next_instr_ids = downstream_map[instr_id];
@@ -658,6 +660,14 @@ void ProgramInterpreter::BuildOperatorDependences() {
       }
     }
 
+    const bool is_device = cur_instr.KernelType() == OpFuncType::kGpuAsync;
+    for (size_t next_instr_id : next_instr_ids) {
+      if ((vec_instruction_[next_instr_id].KernelType() ==
+           OpFuncType::kGpuAsync) == is_device) {
+        instr_workers_.AddProducer(next_instr_id, instr_id);
+      }
+    }
+
     if (!is_shared_results_build_) {
       for (size_t next_instr_id : next_instr_ids) {
         ++(*dependency_count_)[next_instr_id];
@@ -1368,9 +1378,14 @@ void ProgramInterpreter::RunNextInstructions(
 
   for (size_t next_instr_id : instr.NextInstrsInDifferenceThread()) {
     if (IsReady(next_instr_id)) {
+      // Prefer a worker which produced the inputs, to reuse its caches.
+      OpFuncType kernel_type = vec_instruction_[next_instr_id].KernelType();
+      int worker = instr_workers_.PreferredWorker(
+          next_instr_id, async_work_queue_->CurrentWorkerId(kernel_type));
       async_work_queue_->AddTask(
-          vec_instruction_[next_instr_id].KernelType(),
-          [this, next_instr_id]() { RunInstructionAsync(next_instr_id); });
+          kernel_type,
+          [this, next_instr_id]() { RunInstructionAsync(next_instr_id); },
+          worker);
     }
   }
 
@@ -1392,6 +1407,8 @@ void ProgramInterpreter::RunInstructionAsync(size_t instr_id) {
     instr_id = ready_ops.top();
     ready_ops.pop();
     auto& instr_node = vec_instruction_.at(instr_id);
+    instr_workers_.Record(
+        instr_id, async_work_queue_->CurrentWorkerId(instr_node.KernelType()));
 
     RunInstruction(instr_node);
 
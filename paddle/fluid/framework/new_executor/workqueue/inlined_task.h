@@ -0,0 +1,155 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace paddle {
+namespace framework {
+
+// A move-only `void()` callable with inline storage of `Capacity` bytes.
+//
+// Unlike std::function, a callable that fits into the inline storage (and
+// is nothrow move constructible) is never put on the heap, and the callable
+// itself does not need to be copyable, so move-only captures such as
+// std::promise or std::unique_ptr could be used directly. Larger callables
+// fall back to a heap allocation.
+template <size_t Capacity>
+class InlinedTask {
+ public:
+  InlinedTask() noexcept = default;
+
+  InlinedTask(std::nullptr_t) noexcept {}  // NOLINT
+
+  template <typename F,
+            typename Fn = typename std::decay<F>::type,
+            typename = typename std::enable_if<
+                !std::is_same<Fn, InlinedTask>::value>::type>
+  InlinedTask(F&& f) {  // NOLINT
+    if (IsNull(f)) {
+      return;
+    }
+    if constexpr (FitsInline<Fn>()) {
+      new (&storage_) Fn(std::forward<F>(f));
+      ops_ = &InlineOps<Fn>::kOps;
+    } else {
+      *reinterpret_cast<Fn**>(&storage_) = new Fn(std::forward<F>(f));
+      ops_ = &HeapOps<Fn>::kOps;
+    }
+  }
+
+  InlinedTask(InlinedTask&& other) noexcept : ops_(other.ops_) {
+    if (ops_ != nullptr) {
+      ops_->move(&storage_, &other.storage_);
+      other.ops_ = nullptr;
+    }
+  }
+
+  InlinedTask& operator=(InlinedTask&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      if (other.ops_ != nullptr) {
+        ops_ = other.ops_;
+        ops_->move(&storage_, &other.storage_);
+        other.ops_ = nullptr;
+      }
+    }
+    return *this;
+  }
+
+  InlinedTask(const InlinedTask&) = delete;
+  InlinedTask& operator=(const InlinedTask&) = delete;
+
+  ~InlinedTask() { Reset(); }
+
+  explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+  void operator()() { ops_->invoke(&storage_); }
+
+  // Whether the callable of type F is stored without heap allocation.
+  template <typename F>
+  static constexpr bool FitsInline() {
+    return sizeof(F) <= Capacity && alignof(F) <= alignof(Storage) &&
+           std::is_nothrow_move_constructible<F>::value;
+  }
+
+ private:
+  using Storage =
+      typename std::aligned_storage<Capacity, alignof(void*)>::type;
+
+  struct Ops {
+    void (*invoke)(void*);
+    // Move construct into dst from src, and destroy src.
+    void (*move)(void* dst, void* src);
+    void (*destroy)(void*);
+  };
+
+  template <typename Fn>
+  struct InlineOps {
+    static void Invoke(void* p) { (*static_cast<Fn*>(p))(); }
+    static void Move(void* dst, void* src) {
+      new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+      static_cast<Fn*>(src)->~Fn();
+    }
+    static void Destroy(void* p) { static_cast<Fn*>(p)->~Fn(); }
+    static constexpr Ops kOps = {&Invoke, &Move, &Destroy};
+  };
+
+  template <typename Fn>
+  struct HeapOps {
+    static void Invoke(void* p) { (**static_cast<Fn**>(p))(); }
+    static void Move(void* dst, void* src) {
+      *static_cast<Fn**>(dst) = *static_cast<Fn**>(src);
+    }
+    static void Destroy(void* p) { delete *static_cast<Fn**>(p); }
+    static constexpr Ops kOps = {&Invoke, &Move, &Destroy};
+  };
+
+  template <typename F>
+  static bool IsNull(const F&) {
+    return false;
+  }
+  template <typename R, typename... Args>
+  static bool IsNull(const std::function<R(Args...)>& f) {
+    return !f;
+  }
+  template <typename R, typename... Args>
+  static bool IsNull(R (*f)(Args...)) {
+    return f == nullptr;
+  }
+
+  void Reset() {
+    if (ops_ != nullptr) {
+      ops_->destroy(&storage_);
+      ops_ = nullptr;
+    }
+  }
+
+  Storage storage_;
+  const Ops* ops_{nullptr};
+};
+
+// The task type stored in the queues of WorkQueue. Its size is chosen so
+// that an element of RunQueue fits into one cache line, and a
+// std::function<void()> or a lambda capturing a few pointers is stored
+// inline.
+using WorkQueueTask = InlinedTask<48>;
+
+}  // namespace framework
+}  // namespace paddle
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <cstdlib>
 #include <vector>
@@ -17,6 +18,8 @@
 #include "paddle/fluid/framework/new_executor/workqueue/event_count.h"
 #include "paddle/fluid/framework/new_executor/workqueue/run_queue.h"
 #include "paddle/fluid/framework/new_executor/workqueue/thread_environment.h"
+#include "paddle/fluid/framework/new_executor/workqueue/workqueue_utils.h"
+#include "paddle/phi/backends/cpu/cpu_parallel.h"
 #include "paddle/phi/core/os_info.h"
 #include "paddle/phi/core/platform/profiler/event_tracing.h"
 
@@ -33,6 +36,8 @@ class ThreadPoolTempl {
                   int num_threads,
                   bool allow_spinning,
                   bool always_spinning,
+                  const std::vector<int>& cpu_affinity = {},
+                  int cpu_parallel_threads = 0,
                   Environment env = Environment())
       : env_(env),
         allow_spinning_(allow_spinning),
@@ -44,6 +49,8 @@ class ThreadPoolTempl {
         ec_(num_threads),
         num_threads_(num_threads),
         thread_data_(num_threads),
+        cpu_affinity_(cpu_affinity),
+        cpu_parallel_threads_(cpu_parallel_threads),
         name_(name) {
     // Calculate coprimes of all numbers [1, num_threads].
     // Coprimes are used for random walks over all threads in Steal
@@ -58,6 +65,9 @@ class ThreadPoolTempl {
       all_coprimes_.emplace_back(i);
       ComputeCoprimes(i, &(all_coprimes_.back()));
     }
+    if (!cpu_affinity_.empty()) {
+      ComputeStealOrders();
+    }
     for (int i = 0; i < num_threads_; i++) {
       SetStealPartition(i, EncodePartition(0, num_threads_));
       thread_data_[i].thread.reset(
@@ -76,9 +86,7 @@ class ThreadPoolTempl {
     } else {
       // Since we were cancelled, there might be entries in the queues.
       // Empty them to prevent their destructor from asserting.
-      for (size_t i = 0; i < thread_data_.size(); i++) {
-        thread_data_[i].queue.Flush();
-      }
+      DropTasks();
     }
     // Join threads explicitly (by destroying) to avoid destruction order within
     // this class.
@@ -101,11 +109,41 @@ class ThreadPoolTempl {
     }
   }
 
-  void AddTask(std::function<void()> fn) {
+  void AddTask(WorkQueueTask fn) {
     AddTaskWithHint(std::move(fn), 0, num_threads_);
   }
 
-  void AddTaskWithHint(std::function<void()> fn, int start, int limit) {
+  // Called by the worker after each task finishes. Must be set before any
+  // task is added.
+  void SetTaskDoneHook(std::function<void()> hook) {
+    task_done_hook_ = std::move(hook);
+  }
+
+  // Push the task onto the queue of `preferred_worker`, e.g., the worker which
+  // produced the data the task consumes, so that the task is likely to run
+  // with hot caches. Falls back to AddTask if `preferred_worker` is invalid.
+  void AddTaskWithAffinity(WorkQueueTask fn, int preferred_worker) {
+    if (preferred_worker < 0 || preferred_worker >= num_threads_) {
+      AddTask(std::move(fn));
+      return;
+    }
+    Task t = env_.CreateTask(std::move(fn));
+    PerThread* pt = GetPerThread();
+    Queue& q = thread_data_[preferred_worker].queue;
+    if (pt->pool == this && pt->thread_id == preferred_worker) {
+      t = q.PushFront(std::move(t));
+    } else {
+      t = q.PushBack(std::move(t));
+    }
+    if (!t.f) {
+      VLOG(6) << "Add task with affinity " << preferred_worker << ", Notify";
+      ec_.Notify(false);
+    } else {
+      RunTask(&t);  // Push failed, execute directly.
+    }
+  }
+
+  void AddTaskWithHint(WorkQueueTask fn, int start, int limit) {
     Task t = env_.CreateTask(std::move(fn));
     PerThread* pt = GetPerThread();
     if (pt->pool == this) {
@@ -136,7 +174,7 @@ class ThreadPoolTempl {
       VLOG(6) << "Add task, Notify";
       ec_.Notify(false);
     } else {
-      env_.ExecuteTask(t);  // Push failed, execute directly.
+      RunTask(&t);  // Push failed, execute directly.
     }
   }
 
@@ -148,6 +186,20 @@ class ThreadPoolTempl {
     ec_.Notify(true);
   }
 
+  // Drops the tasks left in the queues of a cancelled pool. Each of them
+  // counts as done, so that the waiters of the task tracker wake up.
+  void DropTasks() {
+    for (size_t i = 0; i < thread_data_.size(); i++) {
+      Queue& q = thread_data_[i].queue;
+      while (!q.Empty()) {
+        Task t = q.PopBack();
+        if (t.f && task_done_hook_) {
+          task_done_hook_();
+        }
+      }
+    }
+  }
+
   void WaitThreadsExit() {
     for (size_t i = 0; i < thread_data_.size(); ++i) {
       thread_data_[i].thread->WaitExit();
@@ -243,13 +295,78 @@ class ThreadPoolTempl {
   EventCount ec_;
   const int num_threads_;
   std::vector<ThreadData> thread_data_;
+  const std::vector<int> cpu_affinity_;
+  const int cpu_parallel_threads_;
+  // Victims of each worker ordered by topology distance, only computed if
+  // workers are pinned.
+  std::vector<std::vector<unsigned>> steal_orders_;
+  std::function<void()> task_done_hook_;
   std::string name_;
 
+  void RunTask(Task* t) {
+    env_.ExecuteTask(*t);
+    if (task_done_hook_) {
+      task_done_hook_();
+    }
+  }
+
+  int WorkerCpu(int thread_id) const {
+    return cpu_affinity_[thread_id % cpu_affinity_.size()];
+  }
+
+  // Order the victims of each worker by the distance between the cpus they
+  // are pinned to: sharing the L2 cache first, then the same NUMA node, then
+  // the others. Ties are broken by starting from the next worker, so that
+  // workers do not all hit the same victim first.
+  void ComputeStealOrders() {
+    std::vector<int> l2_ids(num_threads_), numa_nodes(num_threads_);
+    for (int i = 0; i < num_threads_; ++i) {
+      l2_ids[i] = GetCpuL2CacheId(WorkerCpu(i));
+      numa_nodes[i] = GetCpuNumaNode(WorkerCpu(i));
+    }
+    auto distance = [&](int i, int j) {
+      if (l2_ids[i] >= 0 && l2_ids[i] == l2_ids[j]) return 0;
+      if (numa_nodes[i] == numa_nodes[j]) return 1;
+      return 2;
+    };
+    steal_orders_.resize(num_threads_);
+    for (int i = 0; i < num_threads_; ++i) {
+      auto& order = steal_orders_[i];
+      for (int k = 1; k < num_threads_; ++k) {
+        order.push_back((i + k) % num_threads_);
+      }
+      std::stable_sort(
+          order.begin(), order.end(), [&](unsigned a, unsigned b) {
+            return distance(i, a) < distance(i, b);
+          });
+    }
+  }
+
+  // Steals work from other workers, nearest first.
+  Task TopologySteal(int thread_id) {
+    for (unsigned victim : steal_orders_[thread_id]) {
+      Task t = thread_data_[victim].queue.PopBack();
+      if (t.f) {
+        return t;
+      }
+    }
+    return Task();
+  }
+
   // Main worker thread loop.
   void WorkerLoop(int thread_id) {
     std::string thr_name = name_ + "_thread_" + std::to_string(thread_id);
     VLOG(1) << thr_name << " started ";
     phi::SetCurrentThreadName(thr_name);
+    if (!cpu_affinity_.empty()) {
+      int cpu = WorkerCpu(thread_id);
+      if (!BindCurrentThreadToCpu(cpu)) {
+        LOG(WARNING) << "Failed to bind " << thr_name << " to cpu " << cpu;
+      }
+    }
+    if (cpu_parallel_threads_ > 0) {
+      phi::backends::cpu::SetCPUParallelThreadBudget(cpu_parallel_threads_);
+    }
     PerThread* pt = GetPerThread();
     pt->pool = this;
     pt->rand = GlobalThreadIdHash();
@@ -282,12 +399,15 @@ class ThreadPoolTempl {
           }
         }
         if (t.f) {
-          env_.ExecuteTask(t);
+          RunTask(&t);
         }
       }
     } else {
       while (!cancelled_) {
         Task t = q.PopFront();
+        if (!t.f && !steal_orders_.empty()) {
+          t = TopologySteal(thread_id);
+        }
         if (!t.f) {
           t = LocalSteal();
           if (!t.f) {
@@ -311,7 +431,7 @@ class ThreadPoolTempl {
           }
         }
         if (t.f) {
-          env_.ExecuteTask(t);
+          RunTask(&t);
         }
       }
     }
@@ -0,0 +1,114 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/new_executor/workqueue/task_completion.h"
+
+#include "paddle/phi/core/memory/allocation/spin_lock.h"
+
+namespace paddle::framework {
+
+namespace {
+
+class CompletionStatePool {
+ public:
+  static CompletionStatePool& Instance() {
+    // Never destructed, states may be released during static destruction.
+    static auto* pool = new CompletionStatePool();
+    return *pool;
+  }
+
+  CompletionState* Acquire() {
+    CompletionState* state = nullptr;
+    {
+      std::lock_guard<memory::SpinLock> guard(spinlock_);
+      if (free_list_ != nullptr) {
+        state = free_list_;
+        free_list_ = state->next;
+        --num_free_;
+      }
+    }
+    if (state == nullptr) {
+      state = new CompletionState();
+    }
+    state->next = nullptr;
+    state->done.store(false, std::memory_order_relaxed);
+    // One reference for the handle and one for the notifier.
+    state->refs.store(2, std::memory_order_relaxed);
+    return state;
+  }
+
+  void Release(CompletionState* state) {
+    {
+      std::lock_guard<memory::SpinLock> guard(spinlock_);
+      if (num_free_ < kMaxFreeStates) {
+        state->next = free_list_;
+        free_list_ = state;
+        ++num_free_;
+        return;
+      }
+    }
+    delete state;
+  }
+
+ private:
+  static constexpr size_t kMaxFreeStates = 4096;
+
+  memory::SpinLock spinlock_;
+  CompletionState* free_list_{nullptr};
+  size_t num_free_{0};
+};
+
+}  // namespace
+
+CompletionState* AcquireCompletionState() {
+  return CompletionStatePool::Instance().Acquire();
+}
+
+void ReleaseCompletionState(CompletionState* state) {
+  if (state->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    CompletionStatePool::Instance().Release(state);
+  }
+}
+
+void CompletionNotifier::Notify() {
+  if (state_ == nullptr) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->done.store(true, std::memory_order_release);
+  }
+  state_->cv.notify_all();
+  ReleaseCompletionState(state_);
+  state_ = nullptr;
+}
+
+void CompletionHandle::Wait() {
+  if (state_ == nullptr) {
+    return;
+  }
+  // Short tasks are likely to finish soon, spin for a while before blocking.
+  constexpr int kSpinCount = 256;
+  for (int i = 0; i < kSpinCount; ++i) {
+    if (state_->done.load(std::memory_order_acquire)) {
+      return;
+    }
+    memory::CpuRelax();
+  }
+  std::unique_lock<std::mutex> lock(state_->mutex);
+  state_->cv.wait(
+      lock, [this] { return state_->done.load(std::memory_order_acquire); });
+}
+
+}  // namespace paddle::framework
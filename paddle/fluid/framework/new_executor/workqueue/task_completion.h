@@ -0,0 +1,125 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+
+namespace paddle {
+namespace framework {
+
+// The shared state between a CompletionHandle and its CompletionNotifier.
+// States are recycled by a global pool instead of being allocated for each
+// task, which is what std::promise/std::future does.
+struct CompletionState {
+  std::atomic<int> refs{0};
+  std::atomic<bool> done{false};
+  std::mutex mutex;
+  std::condition_variable cv;
+  CompletionState* next{nullptr};  // next free state in the pool
+};
+
+CompletionState* AcquireCompletionState();
+
+void ReleaseCompletionState(CompletionState* state);
+
+// Held by the task, signals the handle when the task finishes. If it is
+// destroyed without Notify (e.g., the task is dropped), the handle is still
+// signaled so that waiters are never blocked forever.
+class CompletionNotifier {
+ public:
+  explicit CompletionNotifier(CompletionState* state) : state_(state) {}
+
+  CompletionNotifier(CompletionNotifier&& other) noexcept
+      : state_(other.state_) {
+    other.state_ = nullptr;
+  }
+
+  CompletionNotifier& operator=(CompletionNotifier&& other) noexcept {
+    if (this != &other) {
+      Notify();
+      state_ = other.state_;
+      other.state_ = nullptr;
+    }
+    return *this;
+  }
+
+  CompletionNotifier(const CompletionNotifier&) = delete;
+  CompletionNotifier& operator=(const CompletionNotifier&) = delete;
+
+  ~CompletionNotifier() { Notify(); }
+
+  void Notify();
+
+ private:
+  CompletionState* state_;
+};
+
+// Held by the caller to wait for the completion of a task, see
+// WorkQueue::AddTaskWithCompletion.
+class CompletionHandle {
+ public:
+  CompletionHandle() = default;
+
+  explicit CompletionHandle(CompletionState* state) : state_(state) {}
+
+  CompletionHandle(CompletionHandle&& other) noexcept : state_(other.state_) {
+    other.state_ = nullptr;
+  }
+
+  CompletionHandle& operator=(CompletionHandle&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      state_ = other.state_;
+      other.state_ = nullptr;
+    }
+    return *this;
+  }
+
+  CompletionHandle(const CompletionHandle&) = delete;
+  CompletionHandle& operator=(const CompletionHandle&) = delete;
+
+  ~CompletionHandle() { Reset(); }
+
+  bool Valid() const { return state_ != nullptr; }
+
+  bool IsDone() const {
+    return state_ == nullptr || state_->done.load(std::memory_order_acquire);
+  }
+
+  // Block until the task finishes.
+  void Wait();
+
+ private:
+  void Reset() {
+    if (state_ != nullptr) {
+      ReleaseCompletionState(state_);
+      state_ = nullptr;
+    }
+  }
+
+  CompletionState* state_{nullptr};
+};
+
+// Create a handle and the notifier of the same completion.
+inline std::pair<CompletionHandle, CompletionNotifier> MakeCompletion() {
+  CompletionState* state = AcquireCompletionState();
+  return std::make_pair(CompletionHandle(state), CompletionNotifier(state));
+}
+
+}  // namespace framework
+}  // namespace paddle
@@ -12,12 +12,14 @@
 #include <functional>
 #include <thread>
 
+#include "paddle/fluid/framework/new_executor/workqueue/inlined_task.h"
+
 namespace paddle {
 namespace framework {
 
 struct StlThreadEnvironment {
   struct Task {
-    std::function<void()> f;
+    WorkQueueTask f;
   };
 
   // EnvThread constructor must start the thread,
@@ -43,8 +45,8 @@ struct StlThreadEnvironment {
   EnvThread* CreateThread(std::function<void()> f) {
     return new EnvThread(std::move(f));
   }
-  Task CreateTask(std::function<void()> f) { return Task{std::move(f)}; }
-  void ExecuteTask(const Task& t) { t.f(); }
+  Task CreateTask(WorkQueueTask f) { return Task{std::move(f)}; }
+  void ExecuteTask(Task& t) { t.f(); }
 };
 
 }  // namespace framework
@@ -49,7 +49,14 @@ class WorkQueueImpl : public WorkQueue {
     queue_ = new NonblockingThreadPool(options_.name,
                                        static_cast<int>(options_.num_threads),
                                        options_.allow_spinning,
-                                       options_.always_spinning);
+                                       options_.always_spinning,
+                                       options_.cpu_affinity,
+                                       options_.cpu_parallel_threads);
+    if (tracker_ != nullptr) {
+      // Count down in the pool instead of wrapping each task with a
+      // CounterGuard, which would push the task out of its inline storage.
+      queue_->SetTaskDoneHook([tracker = tracker_] { tracker->SubCounter(); });
+    }
   }
 
   ~WorkQueueImpl() override {
@@ -63,23 +70,34 @@ class WorkQueueImpl : public WorkQueue {
     }
   }
 
-  void AddTask(std::function<void()> fn) override {
+  void AddTask(WorkQueueTask fn) override {
     phi::RecordEvent record(
         "WorkQueue::AddTask", phi::TracerEventType::UserDefined, 10 /*level*/);
     if (tracker_ != nullptr) {
-      fn = [task = std::move(fn),
-            raii = CounterGuard<TaskTracker>(tracker_)]() mutable { task(); };
+      tracker_->AddCounter();
     }
     queue_->AddTask(std::move(fn));
   }
 
+  void AddTask(WorkQueueTask fn, int preferred_worker) override {
+    phi::RecordEvent record(
+        "WorkQueue::AddTask", phi::TracerEventType::UserDefined, 10 /*level*/);
+    if (tracker_ != nullptr) {
+      tracker_->AddCounter();
+    }
+    queue_->AddTaskWithAffinity(std::move(fn), preferred_worker);
+  }
+
   void Cancel() override {
     queue_->Cancel();
     queue_->WaitThreadsExit();
+    queue_->DropTasks();
   }
 
   size_t NumThreads() const override { return queue_->NumThreads(); }
 
+  int CurrentWorkerId() const override { return queue_->CurrentThreadId(); }
+
  private:
   NonblockingThreadPool* queue_{nullptr};
   TaskTracker* tracker_{nullptr};
@@ -94,12 +112,18 @@ class WorkQueueGroupImpl : public WorkQueueGroup {
 
   ~WorkQueueGroupImpl() override;
 
-  void AddTask(size_t queue_idx, std::function<void()> fn) override;
+  void AddTask(size_t queue_idx, WorkQueueTask fn) override;
+
+  void AddTask(size_t queue_idx,
+               WorkQueueTask fn,
+               int preferred_worker) override;
 
   size_t QueueNumThreads(size_t queue_idx) const override;
 
   size_t QueueGroupNumThreads() const override;
 
+  int QueueCurrentWorkerId(size_t queue_idx) const override;
+
   void Cancel() override;
 
  private:
@@ -141,7 +165,17 @@ WorkQueueGroupImpl::WorkQueueGroupImpl(
         NonblockingThreadPool(options.name,
                               static_cast<int>(options.num_threads),
                               options.allow_spinning,
-                              options.always_spinning);
+                              options.always_spinning,
+                              options.cpu_affinity,
+                              options.cpu_parallel_threads);
+  }
+  if (tracker_ != nullptr) {
+    for (size_t idx = 0; idx < num_queues; ++idx) {
+      if (queues_[idx] != nullptr && queues_options_[idx].track_task) {
+        queues_[idx]->SetTaskDoneHook(
+            [tracker = tracker_] { tracker->SubCounter(); });
+      }
+    }
   }
 }
 
@@ -161,7 +195,7 @@ WorkQueueGroupImpl::~WorkQueueGroupImpl() {
   }
 }
 
-void WorkQueueGroupImpl::AddTask(size_t queue_idx, std::function<void()> fn) {
+void WorkQueueGroupImpl::AddTask(size_t queue_idx, WorkQueueTask fn) {
   phi::RecordEvent record(
       "WorkQueue::AddTask", phi::TracerEventType::UserDefined, 10 /*level*/);
   assert(queue_idx < queues_.size());
@@ -169,13 +203,28 @@ void WorkQueueGroupImpl::AddTask(size_t queue_idx, std::function<void()> fn) {
       queues_.at(queue_idx),
       common::errors::NotFound("Workqueue of index %d is not initialized.",
                                queue_idx));
-  if (queues_options_.at(queue_idx).track_task) {
-    fn = [task = std::move(fn),
-          raii = CounterGuard<TaskTracker>(tracker_)]() mutable { task(); };
+  if (queues_options_.at(queue_idx).track_task && tracker_ != nullptr) {
+    tracker_->AddCounter();
   }
   queues_[queue_idx]->AddTask(std::move(fn));
 }
 
+void WorkQueueGroupImpl::AddTask(size_t queue_idx,
+                                 WorkQueueTask fn,
+                                 int preferred_worker) {
+  phi::RecordEvent record(
+      "WorkQueue::AddTask", phi::TracerEventType::UserDefined, 10 /*level*/);
+  assert(queue_idx < queues_.size());
+  PADDLE_ENFORCE_NOT_NULL(
+      queues_.at(queue_idx),
+      common::errors::NotFound("Workqueue of index %d is not initialized.",
+                               queue_idx));
+  if (queues_options_.at(queue_idx).track_task && tracker_ != nullptr) {
+    tracker_->AddCounter();
+  }
+  queues_[queue_idx]->AddTaskWithAffinity(std::move(fn), preferred_worker);
+}
+
 size_t WorkQueueGroupImpl::QueueNumThreads(size_t queue_idx) const {
   assert(queue_idx < queues_.size());
   if (!queues_.at(queue_idx)) {
@@ -192,6 +241,14 @@ size_t WorkQueueGroupImpl::QueueGroupNumThreads() const {
   return total_num;
 }
 
+int WorkQueueGroupImpl::QueueCurrentWorkerId(size_t queue_idx) const {
+  assert(queue_idx < queues_.size());
+  if (!queues_.at(queue_idx)) {
+    return -1;
+  }
+  return queues_.at(queue_idx)->CurrentThreadId();
+}
+
 void WorkQueueGroupImpl::Cancel() {
   for (auto queue : queues_) {
     if (queue) {
@@ -201,6 +258,7 @@ void WorkQueueGroupImpl::Cancel() {
   for (auto queue : queues_) {
     if (queue) {
       queue->WaitThreadsExit();
+      queue->DropTasks();
     }
   }
 }
@@ -21,6 +21,8 @@
 #include <type_traits>
 #include <vector>
 
+#include "paddle/fluid/framework/new_executor/workqueue/inlined_task.h"
+#include "paddle/fluid/framework/new_executor/workqueue/task_completion.h"
 #include "paddle/fluid/platform/enforce.h"
 
 namespace paddle {
@@ -102,6 +104,14 @@ struct WorkQueueOptions {
   // false and set events_waiter.
   bool detached{true};
   EventsWaiter* events_waiter{nullptr};  // not owned
+  // If not empty, worker i is pinned to cpu_affinity[i % cpu_affinity.size()],
+  // and idle workers steal from the workers sharing the L2 cache or the NUMA
+  // node with them first.
+  std::vector<int> cpu_affinity;
+  // If positive, the CPU parallel loops of the kernels run by a worker use at
+  // most this many threads, so that the workers running kernels together do
+  // not oversubscribe the cores.
+  int cpu_parallel_threads{0};
 };
 
 class WorkQueue {
@@ -114,28 +124,49 @@ class WorkQueue {
 
   virtual ~WorkQueue() = default;
 
-  virtual void AddTask(std::function<void()> fn) = 0;
+  // Small closures (see WorkQueueTask) are passed to the workers without
+  // any heap allocation.
+  virtual void AddTask(WorkQueueTask fn) = 0;
+
+  // Prefer to run fn on worker `preferred_worker`, e.g., the worker which
+  // produced the inputs of fn. A negative value means no preference.
+  virtual void AddTask(WorkQueueTask fn, int preferred_worker) = 0;
 
   // Higher cost than AddTask
   template <typename F, typename... Args>
   std::future<typename std::result_of<F(Args...)>::type> AddAwaitableTask(
       F&& f, Args&&... args) {
     using ReturnType = typename std::result_of<F(Args...)>::type;
-    std::function<ReturnType()> task =
-        std::bind(std::forward<F>(f), std::forward<Args>(args)...);
     std::promise<ReturnType> prom;
     std::future<ReturnType> res = prom.get_future();
-    AddTask([t = std::move(task),
-             p = FakeCopyable<std::promise<ReturnType>>(
-                 std::move(prom))]() mutable { p.Get().set_value(t()); });
+    AddTask([t = std::bind(std::forward<F>(f), std::forward<Args>(args)...),
+             p = std::move(prom)]() mutable { p.set_value(t()); });
     return res;
   }
 
+  // Cheaper than AddAwaitableTask, the returned handle is recycled instead
+  // of allocating a promise/future pair for each task. Use it to wait for
+  // tasks without return value.
+  template <typename F>
+  CompletionHandle AddTaskWithCompletion(F&& f) {
+    auto completion = MakeCompletion();
+    AddTask([f = std::forward<F>(f),
+             notifier = std::move(completion.second)]() mutable {
+      f();
+      notifier.Notify();
+    });
+    return std::move(completion.first);
+  }
+
   // See WorkQueueOptions.track_task for details
   // virtual void WaitQueueEmpty() = 0;
 
   virtual size_t NumThreads() const = 0;
 
+  // The worker id of the calling thread, -1 if it is not a worker of this
+  // queue.
+  virtual int CurrentWorkerId() const = 0;
+
   virtual void Cancel() = 0;
 
  protected:
@@ -153,24 +184,39 @@ class WorkQueueGroup {
 
   virtual ~WorkQueueGroup() = default;
 
-  virtual void AddTask(size_t queue_idx, std::function<void()> fn) = 0;
+  virtual void AddTask(size_t queue_idx, WorkQueueTask fn) = 0;
+
+  // See WorkQueue::AddTask(fn, preferred_worker) for details
+  virtual void AddTask(size_t queue_idx,
+                       WorkQueueTask fn,
+                       int preferred_worker) = 0;
 
   // Higher cost than AddTask
   template <typename F, typename... Args>
   std::future<typename std::result_of<F(Args...)>::type> AddAwaitableTask(
       size_t queue_idx, F&& f, Args&&... args) {
     using ReturnType = typename std::result_of<F(Args...)>::type;
-    std::function<ReturnType()> task =
-        std::bind(std::forward<F>(f), std::forward<Args>(args)...);
     std::promise<ReturnType> prom;
     std::future<ReturnType> res = prom.get_future();
     AddTask(queue_idx,
-            [t = std::move(task),
-             p = FakeCopyable<std::promise<ReturnType>>(
-                 std::move(prom))]() mutable { p.Get().set_value(t()); });
+            [t = std::bind(std::forward<F>(f), std::forward<Args>(args)...),
+             p = std::move(prom)]() mutable { p.set_value(t()); });
     return res;
   }
 
+  // See WorkQueue::AddTaskWithCompletion for details
+  template <typename F>
+  CompletionHandle AddTaskWithCompletion(size_t queue_idx, F&& f) {
+    auto completion = MakeCompletion();
+    AddTask(queue_idx,
+            [f = std::forward<F>(f),
+             notifier = std::move(completion.second)]() mutable {
+              f();
+              notifier.Notify();
+            });
+    return std::move(completion.first);
+  }
+
   // See WorkQueueOptions.track_task for details
   // virtual void WaitQueueGroupEmpty() = 0;
 
@@ -178,6 +224,9 @@ class WorkQueueGroup {
 
   virtual size_t QueueGroupNumThreads() const = 0;
 
+  // See WorkQueue::CurrentWorkerId for details
+  virtual int QueueCurrentWorkerId(size_t queue_idx) const = 0;
+
   virtual void Cancel() = 0;
 
  protected:
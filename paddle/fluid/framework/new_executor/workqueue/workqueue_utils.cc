@@ -16,6 +16,13 @@
 
 #include <cstdint>
 #include <cstdlib>
+#include <fstream>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 namespace paddle::framework {
 
@@ -55,4 +62,110 @@ void AlignedFree(void* mem_ptr) {
 #endif
 }
 
+#if defined(__linux__)
+namespace {
+
+std::string ReadFirstLine(const std::string& path) {
+  std::ifstream fin(path);
+  std::string line;
+  if (fin.is_open()) {
+    std::getline(fin, line);
+  }
+  return line;
+}
+
+// Parse a cpulist such as "0-3,8-11" and return its smallest cpu id.
+int FirstCpuInList(const std::string& list) {
+  int first = -1;
+  size_t pos = 0;
+  while (pos < list.size()) {
+    size_t end = list.find(',', pos);
+    if (end == std::string::npos) end = list.size();
+    try {
+      int cpu = std::stoi(list.substr(pos, end - pos));
+      if (first < 0 || cpu < first) first = cpu;
+    } catch (...) {
+      // ignore malformed entries
+    }
+    pos = end + 1;
+  }
+  return first;
+}
+
+}  // namespace
+#endif
+
+std::vector<int> GetAvailableCpus() {
+  std::vector<int> cpus;
+#if defined(__linux__)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &cpu_set)) {
+        cpus.push_back(cpu);
+      }
+    }
+    return cpus;
+  }
+#endif
+  int num_cpus = static_cast<int>(std::thread::hardware_concurrency());
+  for (int cpu = 0; cpu < num_cpus; ++cpu) {
+    cpus.push_back(cpu);
+  }
+  return cpus;
+}
+
+bool BindCurrentThreadToCpu(int cpu) {
+#if defined(__linux__)
+  if (cpu < 0 || cpu >= CPU_SETSIZE) {
+    return false;
+  }
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(cpu, &cpu_set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) ==
+         0;
+#else
+  return false;
+#endif
+}
+
+int GetCpuNumaNode(int cpu) {
+#if defined(__linux__)
+  // cpuN/nodeM is a link to the NUMA node M the cpu belongs to.
+  const std::string cpu_dir =
+      "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/";
+  for (int node = 0;; ++node) {
+    const std::string node_name = "node" + std::to_string(node);
+    if (!std::ifstream("/sys/devices/system/node/" + node_name + "/cpulist")
+             .is_open()) {
+      break;
+    }
+    if (std::ifstream(cpu_dir + node_name + "/cpulist").is_open()) {
+      return node;
+    }
+  }
+#endif
+  return 0;
+}
+
+int GetCpuL2CacheId(int cpu) {
+#if defined(__linux__)
+  const std::string cache_dir = "/sys/devices/system/cpu/cpu" +
+                                std::to_string(cpu) + "/cache/index";
+  for (int index = 0;; ++index) {
+    std::string dir = cache_dir + std::to_string(index) + "/";
+    std::string level = ReadFirstLine(dir + "level");
+    if (level.empty()) {
+      break;
+    }
+    if (level == "2" && ReadFirstLine(dir + "type") != "Instruction") {
+      return FirstCpuInList(ReadFirstLine(dir + "shared_cpu_list"));
+    }
+  }
+#endif
+  return -1;
+}
+
 }  // namespace paddle::framework
@@ -21,6 +21,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "paddle/fluid/framework/new_executor/workqueue/events_waiter.h"
 #include "paddle/fluid/platform/enforce.h"
@@ -69,6 +70,20 @@ void* AlignedMalloc(size_t size, size_t alignment);
 
 void AlignedFree(void* memory_ptr);
 
+// The cpus the current process is allowed to run on.
+std::vector<int> GetAvailableCpus();
+
+// Pin the calling thread to `cpu`, returns false if it is not supported or
+// failed.
+bool BindCurrentThreadToCpu(int cpu);
+
+// The NUMA node of `cpu`, 0 if unknown.
+int GetCpuNumaNode(int cpu);
+
+// An id shared by all cpus sharing the same L2 cache with `cpu` (the
+// smallest cpu id among them), -1 if unknown.
+int GetCpuL2CacheId(int cpu);
+
 template <typename Notifier>
 class TaskTracker {
  public:
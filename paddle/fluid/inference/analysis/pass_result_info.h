@@ -28,10 +28,11 @@ namespace analysis {
 
 class PassResultInfoForRuntime {
  public:
-  using PassInfo =
-      paddle::variant<std::string,
-                      std::vector<std::string>,
-                      std::unordered_map<std::string, std::string>>;
+  using PassInfo = paddle::variant<
+      std::string,
+      std::vector<std::string>,
+      std::unordered_map<std::string, std::string>,
+      std::unordered_map<std::string, std::pair<size_t, size_t>>>;
 
   static PassResultInfoForRuntime* Instance() {
     static PassResultInfoForRuntime info;
@@ -14,16 +14,21 @@
 
 #include "paddle/fluid/inference/analysis/passes/memory_optimize_pass.h"
 
+#include <algorithm>
+#include <limits>
 #include <string>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "glog/logging.h"
+#include "paddle/common/flags.h"
 #include "paddle/fluid/framework/ir/graph_helper.h"
 #include "paddle/fluid/inference/analysis/pass_result_info.h"
 #include "paddle/fluid/platform/enforce.h"
 
+COMMON_DECLARE_bool(inference_static_memory_plan);
+
 namespace paddle::framework::ir {
 class Graph;
 class Node;
@@ -35,6 +40,7 @@ using framework::ir::Graph;
 using framework::ir::Node;
 using framework::ir::TopologyVariantSort;
 using space_table_t = MemoryOptimizePass::space_table_t;
+using static_plan_t = MemoryOptimizePass::static_plan_t;
 
 typedef struct {
   std::string name;
@@ -116,7 +122,9 @@ void MemoryOptimizePass::CollectLifeCycle(
 }
 
 void MemoryOptimizePass::CollectVarMemorySize(
-    Graph* graph, space_table_t* space_table) const {
+    Graph* graph,
+    space_table_t* space_table,
+    std::unordered_set<std::string>* dynamic_vars) const {
   const int fake_batch_size = 1;
 
   auto valid_var = [&](framework::ir::Node* node) -> bool {
@@ -184,7 +192,10 @@ void MemoryOptimizePass::CollectVarMemorySize(
       if (node->Var()->Persistable()) continue;
       auto shape = node->Var()->GetShape();
       for (auto& v : shape) {
-        if (v < 0) v = fake_batch_size;
+        if (v < 0) {
+          v = fake_batch_size;
+          if (dynamic_vars) dynamic_vars->insert(node->Var()->Name());
+        }
       }
 
       int size =
@@ -252,6 +263,98 @@ void MakeSimpleReusePlan(
   }
 }
 
+// The vars are placed from the largest, each one into the smallest gap
+// between the placed vars overlapping with it that fits, or after all of them.
+void MakeStaticMemoryPlan(
+    const std::unordered_map<std::string, std::pair<int, int>>& lifecycles,
+    const space_table_t& space_table,
+    static_plan_t* plan,
+    size_t* arena_size) {
+  struct Block {
+    std::string name;
+    size_t size;
+    std::pair<int, int> lifetime;
+    size_t offset;
+  };
+  std::vector<Block> blocks;
+  for (auto& data : lifecycles) {
+    auto it = space_table.find(data.first);
+    if (it == space_table.end() || it->second == 0) continue;
+    // the feed vars are filled by the users
+    if (data.second.second == std::numeric_limits<int>::max()) continue;
+    size_t size = (it->second + kStaticMemoryAlignment - 1) /
+                  kStaticMemoryAlignment * kStaticMemoryAlignment;
+    blocks.push_back({data.first, size, data.second, 0});
+  }
+  std::sort(blocks.begin(), blocks.end(), [](const Block& a, const Block& b) {
+    if (a.size != b.size) return a.size > b.size;
+    if (a.lifetime != b.lifetime) return a.lifetime < b.lifetime;
+    return a.name < b.name;
+  });
+
+  auto overlap = [](std::pair<int, int> a, std::pair<int, int> b) -> bool {
+    return b.second >= a.first && a.second >= b.first;
+  };
+  // the placed blocks in the order of their offsets
+  std::vector<const Block*> placed;
+  *arena_size = 0;
+  for (auto& block : blocks) {
+    size_t end = 0;
+    size_t best_offset = 0;
+    size_t best_gap = std::numeric_limits<size_t>::max();
+    for (const Block* other : placed) {
+      if (!overlap(block.lifetime, other->lifetime)) continue;
+      if (other->offset >= end) {
+        size_t gap = other->offset - end;
+        if (gap >= block.size && gap < best_gap) {
+          best_gap = gap;
+          best_offset = end;
+        }
+      }
+      end = std::max(end, other->offset + other->size);
+    }
+    block.offset =
+        best_gap == std::numeric_limits<size_t>::max() ? end : best_offset;
+    auto pos = std::upper_bound(
+        placed.begin(),
+        placed.end(),
+        block.offset,
+        [](size_t offset, const Block* b) { return offset < b->offset; });
+    placed.insert(pos, &block);
+    *arena_size = std::max(*arena_size, block.offset + block.size);
+    (*plan)[block.name] = std::make_pair(block.offset, block.size);
+  }
+
+  // the clusters of the reuse plan laid end to end are used instead when
+  // the placement above is larger
+  std::unordered_map<std::string, std::pair<int, int>> block_lifecycles;
+  space_table_t block_sizes;
+  for (auto& block : blocks) {
+    block_lifecycles[block.name] = block.lifetime;
+    block_sizes[block.name] = block.size;
+  }
+  std::unordered_map<std::string, std::string> node2cluster;
+  std::unordered_map<std::string, int> cluster_size;
+  MakeSimpleReusePlan(
+      block_lifecycles, block_sizes, &node2cluster, &cluster_size);
+  size_t clusters_end = 0;
+  std::unordered_map<std::string, size_t> cluster_offset;
+  for (auto& cluster : cluster_size) {
+    cluster_offset[cluster.first] = clusters_end;
+    clusters_end += cluster.second;
+  }
+  if (clusters_end < *arena_size) {
+    for (auto& block : blocks) {
+      (*plan)[block.name].first =
+          cluster_offset.at(node2cluster.at(block.name));
+    }
+    *arena_size = clusters_end;
+  }
+  LOG(INFO) << "Static memory plan: " << blocks.size()
+            << " vars in an arena of "
+            << static_cast<double>(*arena_size) / (1 << 20) << "MB";
+}
+
 std::string MemoryOptimizePass::repr() const { return "memory_optimize_pass"; }
 
 void MemoryOptimizePass::RunImpl(Argument* argument) {
@@ -274,14 +377,35 @@ void MemoryOptimizePass::RunImpl(Argument* argument) {
   int sort_kind = 0;
   std::unordered_map<std::string, lifecycle_t> lifecycles;
   space_table_t space_table;
+  std::unordered_set<std::string> dynamic_vars;
   std::unordered_map<std::string, std::string> node2cluster;
   std::unordered_map<std::string, int> cluster_size;
 
   CollectLifeCycle(graph, &lifecycles, sort_kind);
-  CollectVarMemorySize(graph, &space_table);
-  MakeSimpleReusePlan(lifecycles, space_table, &node2cluster, &cluster_size);
+  CollectVarMemorySize(graph, &space_table, &dynamic_vars);
 
   auto* pass_res_info = PassResultInfoForRuntime::Instance();
+  if (FLAGS_inference_static_memory_plan) {
+    // the vars of fixed shapes go to the arena, the others are reused
+    space_table_t static_table;
+    space_table_t dynamic_table;
+    for (auto& it : space_table) {
+      if (dynamic_vars.count(it.first)) {
+        dynamic_table.insert(it);
+      } else {
+        static_table.insert(it);
+      }
+    }
+    static_plan_t static_plan;
+    size_t arena_size = 0;
+    MakeStaticMemoryPlan(lifecycles, static_table, &static_plan, &arena_size);
+    pass_res_info->Set(argument->root_predictor_id(),
+                       "memory_optimize_pass_static_plan",
+                       static_plan);
+    space_table = std::move(dynamic_table);
+  }
+  MakeSimpleReusePlan(lifecycles, space_table, &node2cluster, &cluster_size);
+
   pass_res_info->Set(
       argument->root_predictor_id(), "memory_optimize_pass", node2cluster);
 
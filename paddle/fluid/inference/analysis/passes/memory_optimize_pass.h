@@ -15,6 +15,7 @@
 #pragma once
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "paddle/common/enforce.h"
@@ -41,11 +42,19 @@ namespace analysis {
  * current name of var.
  * 3. Perform reuse plan: Replace all var's name in the model according to the
  * mapping table.
+ *
+ * If FLAGS_inference_static_memory_plan is set, the vars of fixed shapes are
+ * planned into one arena instead: every var gets a fixed offset, and the vars
+ * whose lifetimes overlap never overlap in the arena. The vars of dynamic
+ * shapes are still reused by the mapping table.
  */
 class MemoryOptimizePass : public AnalysisPass {
  public:
   using space_table_t = std::unordered_map<std::string, size_t>;
   using lifecycle_t = std::pair<int, int>;
+  // The offset and the size of every var in the arena.
+  using static_plan_t =
+      std::unordered_map<std::string, std::pair<size_t, size_t>>;
 
   virtual ~MemoryOptimizePass() = default;
 
@@ -58,13 +67,38 @@ class MemoryOptimizePass : public AnalysisPass {
       std::unordered_map<std::string, lifecycle_t> *lifecycles,
       int sort_kind) const;
 
-  void CollectVarMemorySize(framework::ir::Graph *graph,
-                            space_table_t *space_table) const;
+  // The vars with unknown dims are sized with a batch of 1, and put in
+  // dynamic_vars if it is not nullptr.
+  void CollectVarMemorySize(
+      framework::ir::Graph *graph,
+      space_table_t *space_table,
+      std::unordered_set<std::string> *dynamic_vars = nullptr) const;
 
  public:
   std::string repr() const override;
 };
 
+// The alignment of the offsets of the static memory plan, which fits every
+// device.
+constexpr size_t kStaticMemoryAlignment = 256;
+
+// Groups the vars whose lifetimes do not overlap into clusters, every one of
+// which is sized by its largest var.
+void MakeSimpleReusePlan(
+    const std::unordered_map<std::string, std::pair<int, int>>& lifecycles,
+    const std::unordered_map<std::string, size_t>& space_table,
+    std::unordered_map<std::string, std::string>* node2cluster,
+    std::unordered_map<std::string, int>* cluster_size);
+
+// Gives every var of space_table an aligned offset and size in one arena, so
+// that the vars whose lifetimes overlap never overlap in the arena. The arena
+// is no larger than the clusters of MakeSimpleReusePlan laid end to end.
+void MakeStaticMemoryPlan(
+    const std::unordered_map<std::string, std::pair<int, int>>& lifecycles,
+    const MemoryOptimizePass::space_table_t& space_table,
+    MemoryOptimizePass::static_plan_t* plan,
+    size_t* arena_size);
+
 }  // namespace analysis
 }  // namespace inference
 }  // namespace paddle
@@ -480,6 +480,7 @@ AnalysisConfig::AnalysisConfig(const AnalysisConfig &other) {
                                   // params_file_ fields.
   CP_MEMBER(save_optimized_model_);
   CP_MEMBER(opt_cache_dir_);
+  CP_MEMBER(optimized_model_cache_dir_);
   CP_MEMBER(prog_file_);
   CP_MEMBER(params_file_);
 
@@ -575,6 +576,7 @@ AnalysisConfig::AnalysisConfig(const AnalysisConfig &other) {
   CP_MEMBER(specify_input_name_);
 
   CP_MEMBER(use_optimized_model_);
+  CP_MEMBER(lightweight_clone_);
 
   CP_MEMBER(cpu_math_library_num_threads_);
 
@@ -1161,6 +1163,7 @@ std::string AnalysisConfig::SerializeInfoCache() {
   ss << ir_debug_;
 
   ss << use_optimized_model_;
+  ss << lightweight_clone_;
 
   ss << specify_input_name_;
   ss << cpu_math_library_num_threads_;
@@ -1461,6 +1464,10 @@ std::string AnalysisConfig::Summary() {
   os.InsertRow({"ir_debug", ir_debug_ ? "true" : "false"});
   os.InsertRow(
       {"use_optimized_model", use_optimized_model_ ? "true" : "false"});
+  os.InsertRow({"lightweight_clone", lightweight_clone_ ? "true" : "false"});
+  if (!optimized_model_cache_dir_.empty()) {
+    os.InsertRow({"optimized_model_cache_dir", optimized_model_cache_dir_});
+  }
   os.InsertRow({"memory_optim", enable_memory_optim_ ? "true" : "false"});
   os.InsertRow({"enable_profile", with_profile_ ? "true" : "false"});
   os.InsertRow({"enable_log", with_glog_info_ ? "true" : "false"});
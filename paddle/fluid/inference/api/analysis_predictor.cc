@@ -15,13 +15,18 @@
 #include "paddle/fluid/inference/api/analysis_predictor.h"
 
 #include <glog/logging.h>
+#include <xxhash.h>
 
 #include <algorithm>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <iomanip>
 #include <memory>
+#include <mutex>
+#include <random>
 #include <set>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -59,6 +64,7 @@
 #include "paddle/phi/api/include/context_pool.h"
 #include "paddle/phi/api/include/tensor.h"
 #include "paddle/phi/backends/context_pool.h"
+#include "paddle/phi/backends/cpu/cpu_info.h"
 #include "paddle/phi/common/backend.h"
 #include "paddle/phi/common/data_type.h"
 #include "paddle/phi/common/place.h"
@@ -71,6 +77,7 @@
 
 #include "paddle/phi/core/generator.h"
 #include "paddle/phi/kernels/funcs/data_type_transform.h"
+#include "paddle/phi/kernels/funcs/jit/kernel_cache.h"
 #include "paddle/utils/string/split.h"
 
 #ifdef PADDLE_WITH_MKLML
@@ -135,6 +142,7 @@
 
 COMMON_DECLARE_bool(pir_apply_inplace_pass);
 COMMON_DECLARE_bool(enable_auto_layout_pass);
+COMMON_DECLARE_bool(inference_static_memory_plan);
 namespace paddle {
 namespace {
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
@@ -211,6 +219,18 @@ bool IsPersistable(const framework::VarDesc *var) {
   return false;
 }
 
+// The memory allocated on the host and the device of place, for the logs.
+int64_t AllocatedMemory(const phi::Place &place) {
+  int64_t bytes = memory::HostMemoryStatCurrentValue("Allocated", 0);
+#ifdef PADDLE_WITH_CUDA
+  if (phi::is_gpu_place(place)) {
+    bytes +=
+        memory::DeviceMemoryStatCurrentValue("Allocated", place.GetDeviceId());
+  }
+#endif
+  return bytes;
+}
+
 phi::DataType ConvertPrecision(AnalysisConfig::Precision precision) {
   switch (precision) {
     case AnalysisConfig::Precision::kFloat32:
@@ -440,6 +460,11 @@ bool AnalysisPredictor::Init(
   // no matter with or without OneDNN
   paddle::platform::SetNumThreads(config_.cpu_math_library_num_threads());
 
+  // the jitcode recorded in FLAGS_jit_kernel_cache_file is shared by all the
+  // threads, so it is generated once per process, before any request
+  static std::once_flag jit_warm_up_flag;
+  std::call_once(jit_warm_up_flag, [] { phi::jit::WarmUpJitKernels(); });
+
   std::string model_path = config_.prog_file();
   if (!model_path.empty()) {
     load_pir_model_ =
@@ -461,6 +486,16 @@ bool AnalysisPredictor::Init(
     config_.use_new_executor_ = true;
   }
 
+  // Look up the optimized model cache by the key of the model
+  if (!status_is_cloned_ && !config_.optimized_model_cache_dir_.empty()) {
+    inference::analysis::MakeDirIfNotExists(
+        config_.optimized_model_cache_dir_);
+    optimized_model_key_ = GetOptimizedModelKey();
+    optimized_model_path_ =
+        config_.optimized_model_cache_dir_ + "/" + optimized_model_key_;
+    config_.UseOptimizedModel(true);
+  }
+
   // Use Optimized model to inference
   if (config_.use_optimized_model_) {
     std::string optimized_model_path = GetOptimizedModelPath();
@@ -473,6 +508,10 @@ bool AnalysisPredictor::Init(
     std::string optimized_params =
         optimized_model_path + "/" + "_optimized.pdiparams";
     if (FileExists(optimized_model) && FileExists(optimized_params)) {
+      // The optimized model is a combined model in files, whatever the
+      // original model is.
+      config_.model_dir_.clear();
+      config_.model_from_memory_ = false;
       config_.SetModel(optimized_model, optimized_params);
       if (config_.new_ir_enabled()) {
         load_pir_model_ = true;
@@ -487,6 +526,12 @@ bool AnalysisPredictor::Init(
              "can be available next time.";
       config_.EnableSaveOptimModel(true);
       config_.UseOptimizedModel(false);
+      if (!optimized_model_key_.empty()) {
+        std::random_device rd;
+        std::stringstream ss;
+        ss << ".tmp" << std::hex << rd() << rd();
+        optimized_model_path_ += ss.str();
+      }
     }
   }
 
@@ -508,6 +553,9 @@ bool AnalysisPredictor::Init(
       return false;
     }
   }
+  if (!optimized_model_key_.empty() && config_.save_optimized_model_) {
+    CommitOptimizedModel();
+  }
 
   // Get the feed_target_names and fetch_target_names
 
@@ -607,6 +655,12 @@ void AnalysisPredictor::InitPlace() {
 }
 
 std::string AnalysisPredictor::GetOptimizedModelPath() {
+  if (!optimized_model_path_.empty()) {
+    if (config_.save_optimized_model_) {
+      inference::analysis::MakeDirIfNotExists(optimized_model_path_);
+    }
+    return optimized_model_path_;
+  }
   std::string model_opt_cache_dir = config_.opt_cache_dir_;
   if (!model_opt_cache_dir.empty()) {
     if (!PathExists(model_opt_cache_dir)) {
@@ -627,6 +681,129 @@ std::string AnalysisPredictor::GetOptimizedModelPath() {
   return model_opt_cache_dir;
 }
 
+std::string AnalysisPredictor::GetOptimizedModelKey() {
+  std::unique_ptr<XXH64_state_t, decltype(&XXH64_freeState)> state(
+      XXH64_createState(), &XXH64_freeState);
+  XXH64_reset(state.get(), 0);
+  auto Hash = [&state](const std::string &str) {
+    uint64_t size = str.size();
+    XXH64_update(state.get(), &size, sizeof(size));
+    XXH64_update(state.get(), str.data(), str.size());
+  };
+  auto HashFile = [&state, &Hash](const std::string &path) {
+    std::ifstream fin(path, std::ios::in | std::ios::binary);
+    PADDLE_ENFORCE_EQ(
+        fin.is_open(),
+        true,
+        common::errors::NotFound("Cannot open file %s, please confirm whether "
+                                 "the file is normal.",
+                                 path));
+    std::vector<char> buffer(1 << 20);
+    while (fin) {
+      fin.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      XXH64_update(
+          state.get(), buffer.data(), static_cast<size_t>(fin.gcount()));
+    }
+    Hash(path.substr(path.find_last_of("/\\") + 1));
+  };
+
+  // The contents of the model rather than its paths.
+  if (config_.model_from_memory_) {
+    Hash(config_.prog_file_);
+    Hash(config_.params_file_);
+  } else if (!config_.model_dir().empty()) {
+    std::vector<std::string> files;
+    for (const auto &entry :
+         std::filesystem::directory_iterator(config_.model_dir())) {
+      std::string name = entry.path().filename().string();
+      if (entry.is_regular_file() && name.rfind("_optimized.", 0) != 0) {
+        files.push_back(entry.path().string());
+      }
+    }
+    std::sort(files.begin(), files.end());
+    for (const auto &file : files) {
+      HashFile(file);
+    }
+  } else {
+    HashFile(config_.prog_file());
+    if (!config_.params_file().empty()) {
+      HashFile(config_.params_file());
+    }
+  }
+
+  // The config, except the paths of the model and the optimized model.
+  AnalysisConfig config(config_);
+  config.model_dir_.clear();
+  config.prog_file_.clear();
+  config.params_file_.clear();
+  config.save_optimized_model_ = false;
+  config.use_optimized_model_ = false;
+  Hash(config.SerializeInfoCache());
+  std::stringstream ss;
+  ss << config_.use_pir_ << config_.use_cinn_ << config_.pm_opt_level_
+     << config_.custom_pass_only_ << config_.enable_low_precision_io_;
+  Hash(ss.str());
+
+  // The passes, and the version of Paddle that implements them.
+  for (const auto &passes : {config_.pass_builder()->AllPasses(),
+                             kPirGpuPasses,
+                             kPirCpuPasses,
+                             kPirXpuPasses,
+                             kPirMkldnnPasses,
+                             kPirMkldnnBf16Passes,
+                             config_.custom_passes_,
+                             config_.deleted_passes_}) {
+    for (const auto &pass : passes) {
+      Hash(pass);
+    }
+    Hash(";");
+  }
+  Hash(paddle::get_version());
+
+  // The hardware the passes choose the kernels and fusions for.
+  std::string isa;
+  for (auto cpu_isa : {phi::backends::cpu::avx2,
+                       phi::backends::cpu::avx512f,
+                       phi::backends::cpu::avx512_core,
+                       phi::backends::cpu::avx512_core_vnni,
+                       phi::backends::cpu::avx512_bf16}) {
+    isa += phi::backends::cpu::MayIUse(cpu_isa) ? "1" : "0";
+  }
+  Hash(isa);
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  if (config_.use_gpu()) {
+    Hash(std::to_string(
+        platform::GetGPUComputeCapability(config_.gpu_device_id())));
+  }
+#endif
+
+  std::stringstream key;
+  key << std::hex << std::setw(16) << std::setfill('0')
+      << XXH64_digest(state.get());
+  return key.str();
+}
+
+void AnalysisPredictor::CommitOptimizedModel() {
+  std::string optimized_model_path =
+      config_.optimized_model_cache_dir_ + "/" + optimized_model_key_;
+  std::string model_file =
+      optimized_model_path_ + "/" +
+      (config_.new_ir_enabled() ? "_optimized.json" : "_optimized.pdmodel");
+  std::string params_file = optimized_model_path_ + "/_optimized.pdiparams";
+  std::error_code ec;
+  if (FileExists(model_file) && FileExists(params_file)) {
+    // Another process may have published the same key meanwhile, and the
+    // rename fails to replace it.
+    std::filesystem::rename(optimized_model_path_, optimized_model_path, ec);
+    if (!ec) {
+      LOG(INFO) << "Optimized model cached to " << optimized_model_path;
+    }
+  }
+  std::filesystem::remove_all(optimized_model_path_, ec);
+  optimized_model_path_ = optimized_model_path;
+  config_.EnableSaveOptimModel(false);
+}
+
 void AnalysisPredictor::ClearExtraParams() {
   auto var_names = scope_->LocalVarNames();
   std::vector<std::string> trt_repetitive_params;
@@ -814,7 +991,18 @@ bool AnalysisPredictor::PrepareScope(
     scope_ = std::make_unique<paddle::framework::Scope>();
     status_is_cloned_ = false;
   }
+  if (IsLightweightClone()) {
+    // finds the weights of the root predictor in its sub scope
+    sub_scope_ = &param_scope_->NewScope();
+    return true;
+  }
   sub_scope_ = &scope_->NewScope();
+  if (config_.lightweight_clone_enabled()) {
+    param_scope_ = std::shared_ptr<framework::Scope>(
+        sub_scope_, [scope = scope_](framework::Scope *sub_scope) {
+          scope->DeleteScope(sub_scope);
+        });
+  }
   return true;
 }
 
@@ -1334,6 +1522,11 @@ bool AnalysisPredictor::PreparePirProgram() {
   pir::IrContext *ctx = pir::IrContext::Instance();
   ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
 
+  if (IsLightweightClone()) {
+    // the program and its feeds and fetches are shared by Clone()
+    return true;
+  }
+
   PADDLE_ENFORCE_EQ(
       pir_program_,
       nullptr,
@@ -1398,7 +1591,8 @@ bool AnalysisPredictor::PrepareProgram(
 
   executor_->CreateVariables(*inference_program_, 0, false, sub_scope_);
 
-  if (config_.new_ir_enabled()) {
+  // a lightweight clone runs the pir program of its parent, see Clone()
+  if (config_.new_ir_enabled() && !IsLightweightClone()) {
     PADDLE_ENFORCE_EQ(
         pir_program_,
         nullptr,
@@ -1479,6 +1673,14 @@ bool AnalysisPredictor::PrepareExecutor() {
     execution_config.skip_gc_vars.insert(output_names.begin(),
                                          output_names.end());
 
+    if (config_.new_ir_enabled() && IsLightweightClone()) {
+      // The interpreter binds the feeds to the variables of their names in
+      // the scope and its ancestors, which hold the feeds of the root.
+      for (auto &input_name : input_names) {
+        sub_scope_->Var(input_name)->GetMutable<phi::DenseTensor>();
+      }
+    }
+
     if (config_.new_ir_enabled()) {
       executor_->PrepareInterpreterCore(
           sub_scope_, *pir_program_, execution_config);
@@ -1495,6 +1697,15 @@ bool AnalysisPredictor::PrepareExecutor() {
         pass_res_info->Get<std::unordered_map<std::string, std::string>>(
             root_predictor_id_, "memory_optimize_pass");
     executor_->MakeReusePlan(reuse_table);
+    // the static plan follows the order of the naive executor, which the
+    // interpreter core does not keep
+    if (FLAGS_inference_static_memory_plan &&
+        !config_.new_executor_enabled()) {
+      auto static_plan = pass_res_info->Get<
+          std::unordered_map<std::string, std::pair<size_t, size_t>>>(
+          root_predictor_id_, "memory_optimize_pass_static_plan");
+      executor_->MakeStaticMemoryPlan(static_plan);
+    }
   }
   return true;
 }
@@ -3141,7 +3352,13 @@ AnalysisPredictor::~AnalysisPredictor() {  // NOLINT
       }
     }
 
-    scope_->DeleteScope(sub_scope_);
+    // the sub scope of a root with lightweight clones is deleted with the
+    // last of them by param_scope_
+    if (param_scope_ == nullptr) {
+      scope_->DeleteScope(sub_scope_);
+    } else if (param_scope_.get() != sub_scope_) {
+      param_scope_->DeleteScope(sub_scope_);
+    }
   }
 
   if (config_.shape_range_info_collected()) {
@@ -3169,6 +3386,9 @@ AnalysisPredictor::~AnalysisPredictor() {  // NOLINT
 std::unique_ptr<PaddlePredictor> AnalysisPredictor::Clone(void *stream) {
   VLOG(3) << "AnalysisPredictor::Clone";
   std::lock_guard<std::mutex> lk(clone_mutex_);
+  inference::Timer timer;
+  timer.tic();
+  const int64_t allocated = AllocatedMemory(place_);
   auto *x = new AnalysisPredictor(config_);
   x->status_is_cloned_ = true;
   x->root_predictor_id_ = this->root_predictor_id_;
@@ -3183,10 +3403,29 @@ std::unique_ptr<PaddlePredictor> AnalysisPredictor::Clone(void *stream) {
         "function has received a stream parameter."));
   }
   x->predictor_stream_ = stream;
+  if (config_.lightweight_clone_enabled()) {
+    x->param_scope_ = param_scope_;
+    x->pir_program_ = pir_program_;
+    if (load_pir_model_) {
+      x->pir_feeds_ = pir_feeds_;
+      x->feed_names_ = feed_names_;
+      x->idx2feeds_ = idx2feeds_;
+      x->feed_name2shapes_ = feed_name2shapes_;
+      x->pir_fetches_ = pir_fetches_;
+      x->idx2fetches_ = idx2fetches_;
+      x->fetch_name2shapes_ = fetch_name2shapes_;
+    }
+  }
   x->Init(scope_, inference_program_);
 #ifdef PADDLE_WITH_TENSORRT
   x->executor_->ResetTrtOps(++AnalysisPredictor::clone_num_);
 #endif
+  LOG(INFO) << "Cloned predictor " << x->predictor_id_
+            << (config_.lightweight_clone_enabled() ? " (lightweight)" : "")
+            << " in " << timer.toc() << " ms, allocating "
+            << static_cast<double>(AllocatedMemory(place_) - allocated) /
+                   (1 << 20)
+            << " MB";
   return std::unique_ptr<PaddlePredictor>(x);
 }
 
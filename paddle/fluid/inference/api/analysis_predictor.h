@@ -355,6 +355,14 @@ class AnalysisPredictor : public PaddlePredictor {
   /// \return Whether the function executed successfully
   ///
   bool PrepareScope(const std::shared_ptr<framework::Scope> &parent_scope);
+
+  ///
+  /// \brief Whether the predictor is a lightweight clone, which shares the
+  /// optimized program and the weights of its root predictor.
+  ///
+  bool IsLightweightClone() const {
+    return status_is_cloned_ && param_scope_ != nullptr;
+  }
   ///
   /// \brief Create an Executor object
   ///
@@ -507,6 +515,8 @@ class AnalysisPredictor : public PaddlePredictor {
   void InitDeviceContexts();
   void InitResourceManager(void *stream);
   std::string GetOptimizedModelPath();
+  std::string GetOptimizedModelKey();
+  void CommitOptimizedModel();
   void ClearExtraParams();
 
  private:
@@ -517,9 +527,19 @@ class AnalysisPredictor : public PaddlePredictor {
   phi::Place place_;
   std::shared_ptr<framework::Scope> scope_;
   framework::Scope *sub_scope_{nullptr};
+  // With lightweight clones, the sub scope of the root predictor, which holds
+  // the weights loaded and transformed for the optimized program. The sub
+  // scopes of the clones are its kids, and it lives until all of them are
+  // destroyed.
+  std::shared_ptr<framework::Scope> param_scope_;
   std::shared_ptr<framework::ProgramDesc> inference_program_;
   std::shared_ptr<pir::Program> pir_program_;
   bool load_pir_model_{false};
+  // The key of the model in the optimized model cache, and the directory the
+  // optimized model is loaded from or saved to. A model missing in the cache
+  // is saved to a private directory, and renamed to the key once complete.
+  std::string optimized_model_key_;
+  std::string optimized_model_path_;
   std::vector<framework::OpDesc *> feeds_;
   std::vector<pir::Operation *> pir_feeds_;
   std::map<std::string, size_t> feed_names_;
@@ -0,0 +1,582 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#include "glog/logging.h"
+#include "paddle/fluid/inference/api/batching_predictor.h"
+#include "paddle/fluid/inference/api/paddle_inference_api.h"
+#include "paddle/fluid/platform/enforce.h"
+#include "paddle/phi/common/bfloat16.h"
+#include "paddle/phi/common/float16.h"
+
+namespace paddle_infer::services {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ElapsedUs(Clock::time_point start, Clock::time_point end) {
+  return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+void AddSample(double us, double* total, double* max) {
+  *total += us;
+  *max = std::max(*max, us);
+}
+
+int64_t NumElements(const std::vector<int>& shape) {
+  int64_t numel = 1;
+  for (int dim : shape) {
+    numel *= dim;
+  }
+  return numel;
+}
+
+// Calls visitor with a null pointer of the type of dtype.
+template <typename Visitor>
+void VisitDataType(DataType dtype, Visitor&& visitor) {
+  switch (dtype) {
+    case DataType::FLOAT32:
+      return visitor(static_cast<float*>(nullptr));
+    case DataType::FLOAT64:
+      return visitor(static_cast<double*>(nullptr));
+    case DataType::INT64:
+      return visitor(static_cast<int64_t*>(nullptr));
+    case DataType::INT32:
+      return visitor(static_cast<int32_t*>(nullptr));
+    case DataType::UINT8:
+      return visitor(static_cast<uint8_t*>(nullptr));
+    case DataType::INT8:
+      return visitor(static_cast<int8_t*>(nullptr));
+    case DataType::FLOAT16:
+      return visitor(static_cast<phi::dtype::float16*>(nullptr));
+    case DataType::BFLOAT16:
+      return visitor(static_cast<phi::dtype::bfloat16*>(nullptr));
+    case DataType::BOOL:
+      return visitor(static_cast<bool*>(nullptr));
+    default:
+      PADDLE_THROW(common::errors::Unimplemented(
+          "BatchingPredictor does not support the data type %d.",
+          static_cast<int>(dtype)));
+  }
+}
+
+struct BatchingRequest {
+  // the inputs in the order of the model inputs
+  std::vector<const paddle::PaddleTensor*> inputs;
+  std::vector<paddle::PaddleTensor>* outputs{nullptr};
+  int rows{0};
+  // the length of the padded inputs before padding
+  int length{0};
+  Clock::time_point submit_time;
+  // set by the worker of the batch under the mutex
+  bool finished{false};
+  bool success{false};
+  std::exception_ptr error;
+};
+
+// The requests of the same input shapes except dim 0.
+struct BatchingQueue {
+  // the input shapes, dim 0 is -1 and dim 1 of the padded inputs is the
+  // bucket bound
+  std::vector<std::vector<int>> shapes;
+  std::vector<DataType> dtypes;
+  // the bucket bound of the padded inputs
+  int length{0};
+  std::deque<BatchingRequest*> requests;
+  int rows{0};
+  // the batches being run, which keep the queue
+  int running{0};
+  Clock::time_point last_used;
+  BatchingStats stats;
+};
+
+void AddStats(const BatchingStats& stats, BatchingStats* total) {
+  total->requests += stats.requests;
+  total->batches += stats.batches;
+  total->rows += stats.rows;
+  total->pending += stats.pending;
+  total->total_queue_us += stats.total_queue_us;
+  total->max_queue_us = std::max(total->max_queue_us, stats.max_queue_us);
+  total->total_batch_us += stats.total_batch_us;
+  total->max_batch_us = std::max(total->max_batch_us, stats.max_batch_us);
+  total->total_latency_us += stats.total_latency_us;
+  total->max_latency_us = std::max(total->max_latency_us, stats.max_latency_us);
+}
+
+}  // namespace
+
+struct BatchingPredictor::Impl {
+  BatchingOptions options;
+  std::unique_ptr<PredictorPool> pool;
+  std::vector<std::string> input_names;
+  std::vector<bool> padded;
+  std::vector<std::string> output_names;
+  std::vector<bool> padded_output;
+
+  mutable std::mutex mutex;
+  // notifies the workers of new requests
+  std::condition_variable cond;
+  // notifies the requests of finished batches
+  std::condition_variable done_cond;
+  std::map<std::string, BatchingQueue> queues;
+  // the metrics of the pruned queues
+  BatchingStats pruned_stats;
+  bool stopped{false};
+  std::vector<std::thread> workers;
+
+  // The queue to batch now, which is full or has waited long enough, or the
+  // earliest time one will be. The queues idle for queue_idle_timeout_us are
+  // pruned on the way.
+  BatchingQueue* NextQueue(Clock::time_point* deadline);
+  void WorkerLoop(Predictor* predictor);
+  bool RunBatch(Predictor* predictor,
+                const BatchingQueue& queue,
+                const std::vector<BatchingRequest*>& batch,
+                int rows);
+};
+
+BatchingQueue* BatchingPredictor::Impl::NextQueue(
+    Clock::time_point* deadline) {
+  const auto timeout = std::chrono::microseconds(options.batch_timeout_us);
+  const auto idle_timeout =
+      std::chrono::microseconds(options.queue_idle_timeout_us);
+  const auto now = Clock::now();
+  BatchingQueue* next = nullptr;
+  for (auto it = queues.begin(); it != queues.end();) {
+    BatchingQueue& queue = it->second;
+    if (queue.requests.empty()) {
+      if (queue.running == 0 && now >= queue.last_used + idle_timeout) {
+        AddStats(queue.stats, &pruned_stats);
+        it = queues.erase(it);
+      } else {
+        ++it;
+      }
+      continue;
+    }
+    ++it;
+    const auto submit_time = queue.requests.front()->submit_time;
+    const bool ready = stopped || now >= submit_time + timeout ||
+                       queue.rows >= static_cast<int>(options.max_batch_size);
+    if (!ready) {
+      *deadline = std::min(*deadline, submit_time + timeout);
+    } else if (next == nullptr ||
+               submit_time < next->requests.front()->submit_time) {
+      next = &queue;
+    }
+  }
+  return next;
+}
+
+void BatchingPredictor::Impl::WorkerLoop(Predictor* predictor) {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    auto deadline = Clock::time_point::max();
+    BatchingQueue* queue = NextQueue(&deadline);
+    if (queue == nullptr) {
+      if (stopped) {
+        return;
+      }
+      if (deadline == Clock::time_point::max()) {
+        cond.wait(lock);
+      } else {
+        cond.wait_until(lock, deadline);
+      }
+      continue;
+    }
+
+    std::vector<BatchingRequest*> batch;
+    int rows = 0;
+    while (!queue->requests.empty()) {
+      BatchingRequest* request = queue->requests.front();
+      if (!batch.empty() && rows + request->rows >
+                                static_cast<int>(options.max_batch_size)) {
+        break;
+      }
+      batch.push_back(request);
+      rows += request->rows;
+      queue->requests.pop_front();
+    }
+    queue->rows -= rows;
+    queue->running += 1;
+    const auto start = Clock::now();
+    for (BatchingRequest* request : batch) {
+      AddSample(ElapsedUs(request->submit_time, start),
+                &queue->stats.total_queue_us,
+                &queue->stats.max_queue_us);
+    }
+    lock.unlock();
+
+    bool success = false;
+    std::exception_ptr error;
+    try {
+      success = RunBatch(predictor, *queue, batch, rows);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    const auto end = Clock::now();
+    VLOG(3) << "BatchingPredictor ran a batch of " << batch.size()
+            << " requests and " << rows << " rows in "
+            << ElapsedUs(start, end) << " us";
+
+    lock.lock();
+    queue->running -= 1;
+    queue->last_used = end;
+    BatchingStats& stats = queue->stats;
+    stats.batches += 1;
+    stats.rows += rows;
+    stats.requests += batch.size();
+    AddSample(
+        ElapsedUs(start, end), &stats.total_batch_us, &stats.max_batch_us);
+    for (BatchingRequest* request : batch) {
+      AddSample(ElapsedUs(request->submit_time, end),
+                &stats.total_latency_us,
+                &stats.max_latency_us);
+      request->finished = true;
+      request->success = success;
+      request->error = error;
+    }
+    done_cond.notify_all();
+  }
+}
+
+bool BatchingPredictor::Impl::RunBatch(
+    Predictor* predictor,
+    const BatchingQueue& queue,
+    const std::vector<BatchingRequest*>& batch,
+    int rows) {
+  // concatenate the inputs, padding dim 1 of the padded ones with zeros
+  std::vector<char> buffer;
+  for (size_t i = 0; i < input_names.size(); ++i) {
+    std::vector<int> shape = queue.shapes[i];
+    shape[0] = rows;
+    const int64_t size = GetNumBytesOfDataType(queue.dtypes[i]);
+    const int64_t row_bytes = NumElements(shape) / rows * size;
+    buffer.assign(rows * row_bytes, 0);
+    char* dst = buffer.data();
+    for (BatchingRequest* request : batch) {
+      const paddle::PaddleTensor& input = *request->inputs[i];
+      const int64_t src_row_bytes = NumElements(input.shape) / request->rows *
+                                    size;
+      CopyBatchingRows(static_cast<const char*>(input.data.data()),
+                       src_row_bytes,
+                       dst,
+                       row_bytes,
+                       request->rows);
+      dst += request->rows * row_bytes;
+    }
+    auto tensor = predictor->GetInputHandle(input_names[i]);
+    tensor->Reshape(shape);
+    VisitDataType(queue.dtypes[i], [&](auto* type) {
+      using T = std::remove_pointer_t<decltype(type)>;
+      tensor->CopyFromCpu(reinterpret_cast<const T*>(buffer.data()));
+    });
+  }
+
+  if (!predictor->Run()) {
+    return false;
+  }
+
+  // split the outputs along dim 0
+  for (BatchingRequest* request : batch) {
+    request->outputs->resize(output_names.size());
+  }
+  for (size_t i = 0; i < output_names.size(); ++i) {
+    auto tensor = predictor->GetOutputHandle(output_names[i]);
+    const std::vector<int> shape = tensor->shape();
+    PADDLE_ENFORCE_EQ(
+        !shape.empty() && shape[0] == rows,
+        true,
+        common::errors::InvalidArgument(
+            "BatchingPredictor needs dim 0 of every output to be the batch "
+            "size %d, but the shape of output %s is %s.",
+            rows,
+            output_names[i],
+            BatchingShapeToString(shape)));
+    if (padded_output[i]) {
+      PADDLE_ENFORCE_EQ(
+          shape.size() >= 2 && shape[1] == queue.length,
+          true,
+          common::errors::InvalidArgument(
+              "BatchingPredictor needs dim 1 of the padded output %s to be "
+              "the padded length %d, but its shape is %s.",
+              output_names[i],
+              queue.length,
+              BatchingShapeToString(shape)));
+    }
+    const DataType dtype = tensor->type();
+    const int64_t row_bytes =
+        NumElements(shape) / rows * GetNumBytesOfDataType(dtype);
+    buffer.resize(rows * row_bytes);
+    VisitDataType(dtype, [&](auto* type) {
+      using T = std::remove_pointer_t<decltype(type)>;
+      tensor->CopyToCpu(reinterpret_cast<T*>(buffer.data()));
+    });
+    const char* src = buffer.data();
+    for (BatchingRequest* request : batch) {
+      paddle::PaddleTensor& output = (*request->outputs)[i];
+      output.name = output_names[i];
+      output.shape = shape;
+      output.shape[0] = request->rows;
+      // cut the padded outputs back to the length of the request
+      if (padded_output[i]) {
+        output.shape[1] = request->length;
+      }
+      const int64_t dst_row_bytes = NumElements(output.shape) /
+                                    request->rows *
+                                    GetNumBytesOfDataType(dtype);
+      output.dtype = dtype;
+      output.lod.clear();
+      output.data.Resize(request->rows * dst_row_bytes);
+      CopyBatchingRows(src,
+                       row_bytes,
+                       static_cast<char*>(output.data.data()),
+                       dst_row_bytes,
+                       request->rows);
+      src += request->rows * row_bytes;
+    }
+  }
+  return true;
+}
+
+BatchingPredictor::BatchingPredictor(const Config& config,
+                                     const BatchingOptions& options)
+    : impl_(new Impl) {
+  PADDLE_ENFORCE_GE(options.max_batch_size,
+                    1UL,
+                    common::errors::InvalidArgument(
+                        "The max batch size should be at least 1, but it's %d.",
+                        options.max_batch_size));
+  PADDLE_ENFORCE_GE(options.batch_timeout_us,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The batch timeout should not be negative, but it's "
+                        "%d.",
+                        options.batch_timeout_us));
+  PADDLE_ENFORCE_GE(options.queue_idle_timeout_us,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The queue idle timeout should not be negative, but "
+                        "it's %d.",
+                        options.queue_idle_timeout_us));
+  PADDLE_ENFORCE_EQ(
+      options.padded_outputs.empty() || !options.padded_inputs.empty(),
+      true,
+      common::errors::InvalidArgument(
+          "The padded outputs follow the length of the padded inputs, which "
+          "are not given."));
+  for (size_t i = 0; i < options.length_buckets.size(); ++i) {
+    PADDLE_ENFORCE_EQ(
+        options.length_buckets[i] > 0 &&
+            (i == 0 ||
+             options.length_buckets[i] > options.length_buckets[i - 1]),
+        true,
+        common::errors::InvalidArgument(
+            "The length buckets should be positive and ascending, but they "
+            "are %s.",
+            BatchingShapeToString(options.length_buckets)));
+  }
+  impl_->options = options;
+  impl_->pool = std::make_unique<PredictorPool>(config, options.num_workers);
+
+  Predictor* predictor = impl_->pool->Retrieve(0);
+  impl_->input_names = predictor->GetInputNames();
+  impl_->output_names = predictor->GetOutputNames();
+  for (const std::string& name : options.padded_inputs) {
+    PADDLE_ENFORCE_EQ(
+        std::find(impl_->input_names.begin(),
+                  impl_->input_names.end(),
+                  name) != impl_->input_names.end(),
+        true,
+        common::errors::NotFound("The padded input %s is not an input of "
+                                 "the model.",
+                                 name));
+  }
+  for (const std::string& name : impl_->input_names) {
+    impl_->padded.push_back(std::find(options.padded_inputs.begin(),
+                                      options.padded_inputs.end(),
+                                      name) != options.padded_inputs.end());
+  }
+  for (const std::string& name : options.padded_outputs) {
+    PADDLE_ENFORCE_EQ(
+        std::find(impl_->output_names.begin(),
+                  impl_->output_names.end(),
+                  name) != impl_->output_names.end(),
+        true,
+        common::errors::NotFound("The padded output %s is not an output of "
+                                 "the model.",
+                                 name));
+  }
+  for (const std::string& name : impl_->output_names) {
+    impl_->padded_output.push_back(
+        std::find(options.padded_outputs.begin(),
+                  options.padded_outputs.end(),
+                  name) != options.padded_outputs.end());
+  }
+
+  for (size_t i = 0; i < options.num_workers; ++i) {
+    impl_->workers.emplace_back(
+        &Impl::WorkerLoop, impl_.get(), impl_->pool->Retrieve(i));
+  }
+}
+
+BatchingPredictor::~BatchingPredictor() {
+  {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    impl_->stopped = true;
+  }
+  impl_->cond.notify_all();
+  for (std::thread& worker : impl_->workers) {
+    worker.join();
+  }
+}
+
+bool BatchingPredictor::Run(const std::vector<paddle::PaddleTensor>& inputs,
+                            std::vector<paddle::PaddleTensor>* outputs) {
+  PADDLE_ENFORCE_NOT_NULL(
+      outputs,
+      common::errors::InvalidArgument("The outputs should not be nullptr."));
+  const std::vector<std::string>& input_names = impl_->input_names;
+  PADDLE_ENFORCE_EQ(inputs.size(),
+                    input_names.size(),
+                    common::errors::InvalidArgument(
+                        "The model has %d inputs, but %d are given.",
+                        input_names.size(),
+                        inputs.size()));
+
+  BatchingRequest request;
+  request.outputs = outputs;
+  for (size_t i = 0; i < input_names.size(); ++i) {
+    const paddle::PaddleTensor* input = &inputs[i];
+    if (!inputs[i].name.empty()) {
+      auto it = std::find_if(
+          inputs.begin(), inputs.end(), [&](const paddle::PaddleTensor& t) {
+            return t.name == input_names[i];
+          });
+      PADDLE_ENFORCE_EQ(it != inputs.end(),
+                        true,
+                        common::errors::NotFound(
+                            "The input %s is not given.", input_names[i]));
+      input = &*it;
+    }
+    request.inputs.push_back(input);
+  }
+
+  // the length of the padded inputs
+  int length = 0;
+  std::vector<std::vector<int>> input_shapes;
+  for (size_t i = 0; i < input_names.size(); ++i) {
+    const paddle::PaddleTensor& input = *request.inputs[i];
+    PADDLE_ENFORCE_EQ(
+        !input.shape.empty() && input.shape[0] > 0,
+        true,
+        common::errors::InvalidArgument(
+            "Dim 0 of input %s should be its rows, but its shape is %s.",
+            input_names[i],
+            BatchingShapeToString(input.shape)));
+    if (i == 0) {
+      request.rows = input.shape[0];
+    }
+    PADDLE_ENFORCE_EQ(input.shape[0],
+                      request.rows,
+                      common::errors::InvalidArgument(
+                          "The inputs should have the same rows, but input "
+                          "%s has %d rows and input %s has %d.",
+                          input_names[0],
+                          request.rows,
+                          input_names[i],
+                          input.shape[0]));
+    PADDLE_ENFORCE_GE(
+        input.data.length(),
+        NumElements(input.shape) * GetNumBytesOfDataType(input.dtype),
+        common::errors::InvalidArgument(
+            "The data of input %s is smaller than its shape %s.",
+            input_names[i],
+            BatchingShapeToString(input.shape)));
+    if (impl_->padded[i]) {
+      PADDLE_ENFORCE_GE(input.shape.size(),
+                        2UL,
+                        common::errors::InvalidArgument(
+                            "The padded input %s should have a dim 1, but "
+                            "its shape is %s.",
+                            input_names[i],
+                            BatchingShapeToString(input.shape)));
+      length = std::max(length, input.shape[1]);
+    }
+    input_shapes.push_back(input.shape);
+  }
+  request.length = length;
+  const int padded_length =
+      BatchingPaddedLength(impl_->options.length_buckets, length);
+  std::vector<std::vector<int>> shapes;
+  const std::string key = BatchingQueueKey(
+      input_names, input_shapes, impl_->padded, padded_length, &shapes);
+
+  std::unique_lock<std::mutex> lock(impl_->mutex);
+  BatchingQueue& queue = impl_->queues[key];
+  if (queue.shapes.empty()) {
+    queue.shapes = std::move(shapes);
+    queue.length = padded_length;
+    for (const paddle::PaddleTensor* input : request.inputs) {
+      queue.dtypes.push_back(input->dtype);
+    }
+  }
+  for (size_t i = 0; i < input_names.size(); ++i) {
+    PADDLE_ENFORCE_EQ(request.inputs[i]->dtype,
+                      queue.dtypes[i],
+                      common::errors::InvalidArgument(
+                          "The data type of input %s differs from that of "
+                          "the earlier requests.",
+                          input_names[i]));
+  }
+  request.submit_time = Clock::now();
+  queue.requests.push_back(&request);
+  queue.rows += request.rows;
+  impl_->cond.notify_all();
+  impl_->done_cond.wait(lock, [&] { return request.finished; });
+  if (request.error) {
+    std::rethrow_exception(request.error);
+  }
+  return request.success;
+}
+
+BatchingStats BatchingPredictor::GetStats() const {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  BatchingStats total = impl_->pruned_stats;
+  for (const auto& item : impl_->queues) {
+    AddStats(item.second.stats, &total);
+    total.pending += item.second.requests.size();
+  }
+  return total;
+}
+
+std::map<std::string, BatchingStats> BatchingPredictor::GetQueueStats() const {
+  std::map<std::string, BatchingStats> stats;
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  for (const auto& item : impl_->queues) {
+    BatchingStats& queue_stats = stats[item.first];
+    queue_stats = item.second.stats;
+    queue_stats.pending = item.second.requests.size();
+  }
+  return stats;
+}
+
+}  // namespace paddle_infer::services
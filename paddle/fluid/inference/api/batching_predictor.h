@@ -0,0 +1,85 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// The routing and the padding of the requests of BatchingPredictor.
+
+namespace paddle_infer {
+namespace services {
+
+inline std::string BatchingShapeToString(const std::vector<int>& shape) {
+  std::string str = "[";
+  for (size_t i = 0; i < shape.size(); ++i) {
+    str += (i ? "," : "") + std::to_string(shape[i]);
+  }
+  return str + "]";
+}
+
+// The length a request is padded to, which is the least bucket not below its
+// length, or its length beyond the last bucket.
+inline int BatchingPaddedLength(const std::vector<int>& buckets, int length) {
+  auto bucket = std::lower_bound(buckets.begin(), buckets.end(), length);
+  return bucket == buckets.end() ? length : *bucket;
+}
+
+// Sets the shapes of the queue of a request, whose dim 0 is -1 and dim 1 of
+// the padded inputs is padded_length, and returns the key of the queue, such
+// as "ids:[-1,16];x:[-1,3]".
+inline std::string BatchingQueueKey(
+    const std::vector<std::string>& names,
+    const std::vector<std::vector<int>>& input_shapes,
+    const std::vector<bool>& padded,
+    int padded_length,
+    std::vector<std::vector<int>>* shapes) {
+  std::string key;
+  shapes->clear();
+  for (size_t i = 0; i < names.size(); ++i) {
+    std::vector<int> shape = input_shapes[i];
+    shape[0] = -1;
+    if (padded[i]) {
+      shape[1] = padded_length;
+    }
+    key += (i ? ";" : "") + names[i] + ":" + BatchingShapeToString(shape);
+    shapes->push_back(std::move(shape));
+  }
+  return key;
+}
+
+// Copies rows of src_row_bytes to rows of dst_row_bytes, which pads every row
+// with zeros or cuts it.
+inline void CopyBatchingRows(const char* src,
+                             int64_t src_row_bytes,
+                             char* dst,
+                             int64_t dst_row_bytes,
+                             int64_t rows) {
+  if (src_row_bytes == dst_row_bytes) {
+    std::memcpy(dst, src, rows * src_row_bytes);
+    return;
+  }
+  const int64_t bytes = std::min(src_row_bytes, dst_row_bytes);
+  for (int64_t r = 0; r < rows; ++r) {
+    std::memcpy(dst + r * dst_row_bytes, src + r * src_row_bytes, bytes);
+    std::memset(dst + r * dst_row_bytes + bytes, 0, dst_row_bytes - bytes);
+  }
+}
+
+}  // namespace services
+}  // namespace paddle_infer
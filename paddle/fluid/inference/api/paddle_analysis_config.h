@@ -216,6 +216,27 @@ struct PD_INFER_DECL AnalysisConfig {
     opt_cache_dir_ = opt_cache_dir;
   }
   ///
+  /// \brief Set the directory of the optimized model cache. A predictor looks
+  /// up the cache by the hash of its model files, config, passes, Paddle
+  /// version and CPU ISA. On a hit it loads the optimized program and the
+  /// transformed parameters without running the analysis passes, and on a
+  /// miss it optimizes the model and adds it to the cache.
+  ///
+  /// \param cache_dir the path of the cache directory, which may be shared by
+  /// many processes.
+  ///
+  void SetOptimizedModelCacheDir(const std::string& cache_dir) {
+    optimized_model_cache_dir_ = cache_dir;
+  }
+  ///
+  /// \brief Get the directory of the optimized model cache.
+  ///
+  /// \return const std::string& The cache directory, empty if not cached.
+  ///
+  const std::string& optimized_model_cache_dir() const {
+    return optimized_model_cache_dir_;
+  }
+  ///
   /// \brief Get the model directory path.
   ///
   /// \return const std::string& The model directory path.
@@ -856,6 +877,23 @@ struct PD_INFER_DECL AnalysisConfig {
   ///
   void UseOptimizedModel(bool x = true) { use_optimized_model_ = x; }
 
+  ///
+  /// \brief Control whether the clones of the predictor are lightweight. A
+  /// lightweight clone runs the optimized program of its parent and reads the
+  /// weights its parent loaded and transformed, keeping only its own
+  /// activations, feeds and fetches.
+  ///
+  /// \param x whether to make lightweight clones.
+  ///
+  void EnableLightweightClone(bool x = true) { lightweight_clone_ = x; }
+
+  ///
+  /// \brief A boolean state telling whether the clones are lightweight.
+  ///
+  /// \return bool Whether the clones are lightweight.
+  ///
+  bool lightweight_clone_enabled() const { return lightweight_clone_; }
+
   ///
   /// \brief Control whether to debug IR graph analysis phase.
   /// This will generate DOT files for visualizing the computation graph after
@@ -1258,6 +1296,8 @@ struct PD_INFER_DECL AnalysisConfig {
 
   bool use_optimized_model_{false};
 
+  bool lightweight_clone_{false};
+
   bool use_new_executor_{false};
 
   bool specify_input_name_{false};
@@ -1328,6 +1368,7 @@ struct PD_INFER_DECL AnalysisConfig {
   mutable bool is_valid_{true};
   bool save_optimized_model_{false};
   std::string opt_cache_dir_;
+  std::string optimized_model_cache_dir_;
   friend class paddle_infer::experimental::InternalUtils;
 
   // jit engine related
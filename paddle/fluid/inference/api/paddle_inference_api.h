@@ -272,6 +272,114 @@ class PD_INFER_DECL PredictorPool {
   std::shared_ptr<Predictor> main_pred_;
   std::vector<std::unique_ptr<Predictor>> preds_;
 };
+
+///
+/// \brief The options of BatchingPredictor.
+///
+struct PD_INFER_DECL BatchingOptions {
+  /// The most rows of a batch. A request of more rows runs alone.
+  size_t max_batch_size{16};
+  /// How long the first request of a batch waits for more requests, in
+  /// microseconds.
+  int64_t batch_timeout_us{1000};
+  /// The predictors running batches concurrently.
+  size_t num_workers{1};
+  /// The inputs of variable lengths in dim 1, such as token ids and their
+  /// masks. They are padded with zeros to the length bucket of a request.
+  std::vector<std::string> padded_inputs;
+  /// The ascending bounds of the length buckets. A request of length l is
+  /// padded to the least bound not below l, or not padded beyond the last
+  /// bound.
+  std::vector<int> length_buckets;
+  /// The outputs whose dim 1 is the padded length, such as the logits of
+  /// every token. They are cut back to the length of a request.
+  std::vector<std::string> padded_outputs;
+  /// How long a queue without requests is kept, in microseconds. The metrics
+  /// of a pruned queue stay in GetStats().
+  int64_t queue_idle_timeout_us{60000000};
+};
+
+///
+/// \brief The metrics of the requests of a queue of BatchingPredictor, or of
+/// all the queues. The means are the totals divided by the counts.
+///
+struct PD_INFER_DECL BatchingStats {
+  /// the requests served
+  uint64_t requests{0};
+  /// the batches run
+  uint64_t batches{0};
+  /// the rows of the batches
+  uint64_t rows{0};
+  /// the requests waiting now
+  uint64_t pending{0};
+  /// the time the requests waited for their batches
+  double total_queue_us{0.0};
+  double max_queue_us{0.0};
+  /// the time of the batches, from concatenating the inputs to scattering the
+  /// outputs
+  double total_batch_us{0.0};
+  double max_batch_us{0.0};
+  /// the time of the requests, from submitting to returning
+  double total_latency_us{0.0};
+  double max_latency_us{0.0};
+};
+
+///
+/// \class BatchingPredictor
+///
+/// \brief BatchingPredictor serves requests of many threads by batching them.
+/// The requests of the same input shapes except dim 0 are queued together.
+/// Their inputs are concatenated along dim 0, run at once, and the outputs are
+/// split along dim 0 back to the requests. A batch runs when it has
+/// max_batch_size rows or its first request has waited batch_timeout_us.
+///
+/// A request gets the outputs it gets when run alone, with its padded inputs
+/// padded to its bucket and its padded outputs cut back to its length. Every
+/// output must keep the batch dim.
+///
+/// Usage:
+///
+/// \code{.cpp}
+/// services::BatchingOptions options;
+/// options.max_batch_size = 32;
+/// services::BatchingPredictor predictor(config, options);
+/// // in every serving thread
+/// std::vector<PaddleTensor> outputs;
+/// predictor.Run(inputs, &outputs);
+/// \endcode
+///
+class PD_INFER_DECL BatchingPredictor {
+ public:
+  BatchingPredictor() = delete;
+  BatchingPredictor(const BatchingPredictor&) = delete;
+  BatchingPredictor& operator=(const BatchingPredictor&) = delete;
+
+  BatchingPredictor(const Config& config, const BatchingOptions& options);
+  ~BatchingPredictor();
+
+  ///
+  /// \brief Run a request, blocking until its batch has run. Thread safe.
+  ///
+  /// \param[in] inputs The inputs, matched to the model inputs by their names,
+  /// or by their order if unnamed. Dim 0 of all of them is the rows of the
+  /// request.
+  /// \param[out] outputs The outputs, in the order of the model outputs.
+  /// \return Whether the run is successful
+  ///
+  bool Run(const std::vector<paddle::PaddleTensor>& inputs,
+           std::vector<paddle::PaddleTensor>* outputs);
+
+  /// \brief The metrics of all the queues.
+  BatchingStats GetStats() const;
+
+  /// \brief The metrics of every queue not pruned yet, keyed by its input
+  /// shapes, such as "x:[-1,3,224,224]".
+  std::map<std::string, BatchingStats> GetQueueStats() const;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
 }  // namespace services
 
 }  // namespace paddle_infer
@@ -0,0 +1,113 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "paddle/fluid/pir/serialize_deserialize/include/third_party.h"
+
+namespace pir {
+/**
+ * The binary format of PIR programs encodes the same schema as the JSON
+ * format, so the patches of version compatibility apply to both of them.
+ * A binary file is
+ *
+ *   magic "PIRB" | format version | string table | value table |
+ *   base code | program
+ *
+ * Integers are LEB128 varints. Strings, including the keys of objects, are
+ * indices into the string table. The types and the attribute values of the
+ * ops, which repeat all over a program, are tagged indices into the value
+ * table, which are read as value references {"@": index}.
+ *
+ * The program is streamed: a region is its number of blocks followed by
+ * the blocks; a block is its header object (ID, BLOCKARGS and
+ * KEYWORDBLOCKARGS), the max value id of its ops, its number of ops and the
+ * ops; an op is its object, whose REGIONS are placeholders, followed by its
+ * regions. So a reader builds the ops one by one without the document of
+ * the whole program.
+ */
+#define BINARY_MAGIC "PIRB"
+#define BINARY_FORMAT_VERSION 1
+#define BINARY_VALUE_REF "@"
+
+/** BinaryEncoder encodes json objects into the binary format. */
+class BinaryEncoder {
+ public:
+  BinaryEncoder() = default;
+  BinaryEncoder(const BinaryEncoder&) = delete;
+  BinaryEncoder& operator=(const BinaryEncoder&) = delete;
+
+  void WriteVarint(uint64_t value, std::string* out);
+  void WriteSignedVarint(int64_t value, std::string* out);
+  /** WriteJson writes the types and attribute values of json to the value
+   * table, and their indices to out. */
+  void WriteJson(const Json& json, std::string* out);
+
+  /** Finish returns the file of the base code and the program. */
+  std::string Finish(const Json& base_code, const std::string& program);
+
+ private:
+  void WriteJson(const Json& json, bool intern_values, std::string* out);
+  uint64_t InternString(const std::string& str);
+  uint64_t InternValue(const Json& json);
+
+  std::unordered_map<std::string, uint64_t> string_ids_;
+  std::vector<const std::string*> strings_;
+  std::unordered_map<std::string, uint64_t> value_ids_;
+  std::vector<const std::string*> values_;
+};
+
+/** BinaryDecoder decodes a file of the binary format. */
+class BinaryDecoder {
+ public:
+  /** data is the whole file, and the decoder reads its tables and base
+   * code. */
+  explicit BinaryDecoder(std::string data);
+  BinaryDecoder(const BinaryDecoder&) = delete;
+  BinaryDecoder& operator=(const BinaryDecoder&) = delete;
+
+  /** IsBinary tells whether the file beginning with head is binary. */
+  static bool IsBinary(const std::string& head);
+
+  uint64_t ReadVarint();
+  int64_t ReadSignedVarint();
+  /** ReadJson reads the types and attribute values of the value table as
+   * value references. */
+  Json ReadJson();
+
+  /** IsValueRef tells whether json is a value reference, and sets idx to
+   * the index of its value. */
+  static bool IsValueRef(const Json& json, uint64_t* idx);
+
+  const Json& base_code() const { return base_code_; }
+  size_t num_values() const { return values_.size(); }
+  const Json& Value(uint64_t idx) const;
+  /** ExpandValues replaces the value references of json with their
+   * values. */
+  void ExpandValues(Json* json) const;
+
+ private:
+  uint8_t ReadByte();
+
+  std::string data_;
+  size_t pos_ = 0;
+  std::vector<std::string> strings_;
+  std::vector<Json> values_;
+  Json base_code_;
+};
+
+}  // namespace pir
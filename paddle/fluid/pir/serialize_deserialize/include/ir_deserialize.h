@@ -15,6 +15,7 @@
 
 #include <fstream>
 #include "paddle/common/enforce.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/ir_binary.h"
 #include "paddle/fluid/pir/serialize_deserialize/include/schema.h"
 #include "paddle/fluid/pir/serialize_deserialize/include/third_party.h"
 #include "paddle/fluid/pir/serialize_deserialize/include/version_compat.h"
@@ -37,6 +38,11 @@ class ProgramReader {
   void IR_API RecoverProgram(Json* program_json,
                              pir::Program* recover_program,
                              pir::PatchBuilder* builder);
+  /** RecoverProgram of the binary format, which reads the ops one by one
+   * from decoder. */
+  void IR_API RecoverProgram(BinaryDecoder* decoder,
+                             pir::Program* recover_program,
+                             pir::PatchBuilder* builder);
   pir::Type RecoverType(Json* type_json);
   pir::AttributeMap RecoverOpAttributesMap(Json* attrs_json);
   ~ProgramReader() = default;
@@ -46,9 +52,19 @@ class ProgramReader {
   std::map<int64_t, pir::Value> id_value_map;
   pir::PatchBuilder* patch_builder = nullptr;
 
+  /** binary_decoder_ is set when reading the binary format, whose types and
+   * attributes of the value table are read once and cached by their
+   * indices. */
+  BinaryDecoder* binary_decoder_ = nullptr;
+  std::vector<pir::Type> value_types_;
+  std::vector<pir::Attribute> value_attrs_;
+
   void ReadProgram(Json* program_json, pir::Program* program);
   void ReadRegion(Json* region_json, pir::Region* region);
   void ReadBlock(Json* block_json, pir::Block* block);
+  void ReadRegion(pir::Region* region);
+  void ReadBlock(pir::Block* block);
+  void ReadBlockArgs(Json* block_json, pir::Block* block);
   pir::Operation* ReadOp(Json* op_json);
   pir::AttributeMap ReadAttributesMap(
       Json* attrs_json,
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #pragma once
+#include "paddle/fluid/pir/serialize_deserialize/include/ir_binary.h"
 #include "paddle/fluid/pir/serialize_deserialize/include/third_party.h"
 #include "paddle/pir/include/core/program.h"
 
@@ -34,6 +35,9 @@ class ProgramWriter {
 
   /** GetProgramJson is used by writeModulde api*/
   Json GetProgramJson(const pir::Program* program);
+  /** GetProgramBinary is used by writeModulde api for the binary format */
+  std::string GetProgramBinary(const pir::Program* program,
+                               const Json& base_code);
   Json GetTypeJson(const pir::Type& type);
   Json GetAttributesMapJson(const AttributeMap& attr_map);
 
@@ -61,9 +65,21 @@ class ProgramWriter {
 
   bool trainable_ = true;
 
+  /** binary_encoder_ is set when writing the binary format, in which the
+   * regions of an op follow the op rather than nest in it. */
+  BinaryEncoder* binary_encoder_ = nullptr;
+
   Json WriteProgram(const pir::Program* program);
   Json WriteRegion(const pir::Region* region, const std::string& region_name);
   Json WriteBlock(pir::Block* block, const std::string& block_name);
+  void WriteRegion(const pir::Region* region,
+                   const std::string& region_name,
+                   std::string* out);
+  void WriteBlock(pir::Block* block,
+                  const std::string& block_name,
+                  std::string* out);
+  Json WriteBlockArgs(pir::Block* block, const std::string& block_name);
+  void DeleteStackOps(pir::Block* block);
   Json WriteOp(const pir::Operation& op);
   Json WriteBlockArg(const pir::Value& value);
   Json WriteValue(const pir::Value& value);
@@ -14,11 +14,16 @@
 
 #include "paddle/fluid/pir/serialize_deserialize/include/interface.h"
 #include <stdio.h>
+#include <cstring>
+#include <iterator>
 #include "paddle/common/enforce.h"
+#include "paddle/common/flags.h"
 #include "paddle/fluid/pir/serialize_deserialize/include/ir_deserialize.h"
 #include "paddle/fluid/pir/serialize_deserialize/include/ir_serialize.h"
 #include "paddle/phi/common/port.h"
 
+COMMON_DECLARE_bool(save_pir_as_binary);
+
 namespace pir {
 #define PROGRAM "program"
 #define BASE_CODE "base_code"
@@ -47,13 +52,18 @@ void WriteModule(const pir::Program& program,
       {MAGIC, PIR}, {PIRVERSION, pir_version}, {TRAINABLE, trainable}};
 
   ProgramWriter writer(pir_version, trainable);
-  // write program
-  total[PROGRAM] = writer.GetProgramJson(&program);
   std::string total_str;
-  if (readable) {
-    total_str = total.dump(4);
+  if (FLAGS_save_pir_as_binary && !readable) {
+    // write program in the binary format
+    total_str = writer.GetProgramBinary(&program, total[BASE_CODE]);
   } else {
-    total_str = total.dump();
+    // write program
+    total[PROGRAM] = writer.GetProgramJson(&program);
+    if (readable) {
+      total_str = total.dump(4);
+    } else {
+      total_str = total.dump();
+    }
   }
 
   MkDirRecursively(DirName(file_path).c_str());
@@ -66,24 +76,15 @@ void WriteModule(const pir::Program& program,
   fout.close();
 }
 
-bool ReadModule(const std::string& file_path,
-                pir::Program* program,
-                int64_t pir_version) {
-  std::ifstream f(file_path);
-  Json data = Json::parse(f);
-  if (pir_version < 0) {
-    pir_version = DEVELOP_VERSION;
-    VLOG(6) << "pir_version is null, get pir_version: " << pir_version;
-  }
-
-  PatchBuilder builder(pir_version);
-
-  if (data.contains(BASE_CODE) && data[BASE_CODE].contains(MAGIC) &&
-      data[BASE_CODE][MAGIC] == PIR) {
-    uint64_t file_version =
-        data.at(BASE_CODE).at(PIRVERSION).template get<uint64_t>();
+namespace {
+// Builds the patches from the version of the file to pir_version.
+void BuildPatch(const Json& base_code,
+                int64_t pir_version,
+                PatchBuilder* builder) {
+  if (base_code.contains(MAGIC) && base_code[MAGIC] == PIR) {
+    uint64_t file_version = base_code.at(PIRVERSION).template get<uint64_t>();
     if (file_version != (uint64_t)pir_version) {
-      builder.SetFileVersion(file_version);
+      builder->SetFileVersion(file_version);
       // Set max_version to the max version number of release pir plus 1.
       auto max_version = RELEASE_VERSION + 1;
       // If pir_version_ is not 0, we will build patch from file_version_ to
@@ -93,20 +94,59 @@ bool ReadModule(const std::string& file_path,
       VLOG(6) << "file_version: " << file_version
               << ", pir_version: " << pir_version
               << ", final_version: " << version;
-      builder.BuildPatch(version, max_version);
+      builder->BuildPatch(version, max_version);
     }
   } else {
     PADDLE_THROW(common::errors::InvalidArgument("Invalid model file."));
   }
+}
 
-  ProgramReader reader(pir_version);
-  reader.RecoverProgram(&(data[PROGRAM]), program, &builder);
-
-  if (data[BASE_CODE].contains(TRAINABLE)) {
-    return data[BASE_CODE][TRAINABLE].get<bool>();
+bool IsTrainable(const Json& base_code) {
+  if (base_code.contains(TRAINABLE)) {
+    return base_code[TRAINABLE].get<bool>();
   } else {
     return false;
   }
 }
+}  // namespace
+
+bool ReadModule(const std::string& file_path,
+                pir::Program* program,
+                int64_t pir_version) {
+  std::ifstream f(file_path, std::ios::binary);
+  if (pir_version < 0) {
+    pir_version = DEVELOP_VERSION;
+    VLOG(6) << "pir_version is null, get pir_version: " << pir_version;
+  }
+
+  PatchBuilder builder(pir_version);
+
+  std::string head(std::strlen(BINARY_MAGIC), '\0');
+  f.read(&head[0], static_cast<std::streamsize>(head.size()));
+  if (BinaryDecoder::IsBinary(head)) {
+    // The binary format is decoded op by op, without the json of the whole
+    // program.
+    f.seekg(0);
+    BinaryDecoder decoder(std::string(std::istreambuf_iterator<char>(f),
+                                      std::istreambuf_iterator<char>()));
+    BuildPatch(decoder.base_code(), pir_version, &builder);
+    ProgramReader reader(pir_version);
+    reader.RecoverProgram(&decoder, program, &builder);
+    return IsTrainable(decoder.base_code());
+  }
+  f.clear();
+  f.seekg(0);
+
+  Json data = Json::parse(f);
+  if (!data.contains(BASE_CODE)) {
+    PADDLE_THROW(common::errors::InvalidArgument("Invalid model file."));
+  }
+  BuildPatch(data[BASE_CODE], pir_version, &builder);
+
+  ProgramReader reader(pir_version);
+  reader.RecoverProgram(&(data[PROGRAM]), program, &builder);
+
+  return IsTrainable(data[BASE_CODE]);
+}
 
 }  // namespace pir
@@ -0,0 +1,342 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/pir/serialize_deserialize/include/ir_binary.h"
+
+#include <cstring>
+#include <utility>
+
+#include "paddle/common/enforce.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/schema.h"
+
+namespace pir {
+
+namespace {
+// The tags of json values.
+enum BinaryTag : uint8_t {
+  kNull = 0,
+  kFalse = 1,
+  kTrue = 2,
+  kInt = 3,
+  kUint = 4,
+  kFloat = 5,
+  kString = 6,
+  kArray = 7,
+  kObject = 8,
+  kValueRef = 9,
+};
+
+bool IsValueKey(const std::string& key) {
+  return key == TYPE_TYPE || key == ATTR_TYPE;
+}
+}  // namespace
+
+void BinaryEncoder::WriteVarint(uint64_t value, std::string* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+void BinaryEncoder::WriteSignedVarint(int64_t value, std::string* out) {
+  // zigzag encoding, which keeps small negative numbers short
+  WriteVarint((static_cast<uint64_t>(value) << 1) ^
+                  static_cast<uint64_t>(value >> 63),
+              out);
+}
+
+void BinaryEncoder::WriteJson(const Json& json, std::string* out) {
+  WriteJson(json, true, out);
+}
+
+void BinaryEncoder::WriteJson(const Json& json,
+                              bool intern_values,
+                              std::string* out) {
+  switch (json.type()) {
+    case Json::value_t::null:
+      out->push_back(kNull);
+      break;
+    case Json::value_t::boolean:
+      out->push_back(json.get<bool>() ? kTrue : kFalse);
+      break;
+    case Json::value_t::number_integer: {
+      // Non-negative integers are unsigned, as they are parsed from JSON.
+      int64_t value = json.get<int64_t>();
+      if (value >= 0) {
+        out->push_back(kUint);
+        WriteVarint(static_cast<uint64_t>(value), out);
+      } else {
+        out->push_back(kInt);
+        WriteSignedVarint(value, out);
+      }
+      break;
+    }
+    case Json::value_t::number_unsigned:
+      out->push_back(kUint);
+      WriteVarint(json.get<uint64_t>(), out);
+      break;
+    case Json::value_t::number_float: {
+      double value = json.get<double>();
+      uint64_t bits = 0;
+      std::memcpy(&bits, &value, sizeof(bits));
+      out->push_back(kFloat);
+      for (int i = 0; i < 8; ++i) {
+        out->push_back(static_cast<char>((bits >> (8 * i)) & 0xff));
+      }
+      break;
+    }
+    case Json::value_t::string:
+      out->push_back(kString);
+      WriteVarint(InternString(json.get_ref<const std::string&>()), out);
+      break;
+    case Json::value_t::array:
+      out->push_back(kArray);
+      WriteVarint(json.size(), out);
+      for (auto& item : json) {
+        WriteJson(item, intern_values, out);
+      }
+      break;
+    case Json::value_t::object:
+      out->push_back(kObject);
+      WriteVarint(json.size(), out);
+      for (auto& item : json.items()) {
+        WriteVarint(InternString(item.key()), out);
+        if (intern_values && IsValueKey(item.key()) &&
+            item.value().is_object()) {
+          out->push_back(kValueRef);
+          WriteVarint(InternValue(item.value()), out);
+        } else {
+          WriteJson(item.value(), intern_values, out);
+        }
+      }
+      break;
+    default:
+      PADDLE_THROW(common::errors::Unimplemented(
+          "The json value of type %s can not be saved in the binary format.",
+          json.type_name()));
+  }
+}
+
+uint64_t BinaryEncoder::InternString(const std::string& str) {
+  auto it = string_ids_.find(str);
+  if (it != string_ids_.end()) {
+    return it->second;
+  }
+  it = string_ids_.emplace(str, strings_.size()).first;
+  strings_.push_back(&it->first);
+  return it->second;
+}
+
+uint64_t BinaryEncoder::InternValue(const Json& json) {
+  // The values are deduplicated by their encodings.
+  std::string encoded;
+  WriteJson(json, false, &encoded);
+  auto it = value_ids_.find(encoded);
+  if (it != value_ids_.end()) {
+    return it->second;
+  }
+  it = value_ids_.emplace(std::move(encoded), values_.size()).first;
+  values_.push_back(&it->first);
+  return it->second;
+}
+
+std::string BinaryEncoder::Finish(const Json& base_code,
+                                  const std::string& program) {
+  // The base code is encoded first, for its strings.
+  std::string base_code_str;
+  WriteJson(base_code, false, &base_code_str);
+
+  std::string out(BINARY_MAGIC);
+  WriteVarint(BINARY_FORMAT_VERSION, &out);
+  WriteVarint(strings_.size(), &out);
+  for (auto* str : strings_) {
+    WriteVarint(str->size(), &out);
+    out.append(*str);
+  }
+  WriteVarint(values_.size(), &out);
+  for (auto* value : values_) {
+    out.append(*value);
+  }
+  out.append(base_code_str);
+  out.append(program);
+  VLOG(6) << "Finish binary program: " << strings_.size() << " strings, "
+          << values_.size() << " values, " << out.size() << " bytes.";
+  return out;
+}
+
+BinaryDecoder::BinaryDecoder(std::string data) : data_(std::move(data)) {
+  PADDLE_ENFORCE_EQ(IsBinary(data_),
+                    true,
+                    common::errors::InvalidArgument("Invalid model file."));
+  pos_ = std::strlen(BINARY_MAGIC);
+  uint64_t format_version = ReadVarint();
+  PADDLE_ENFORCE_LE(
+      format_version,
+      static_cast<uint64_t>(BINARY_FORMAT_VERSION),
+      common::errors::Unimplemented(
+          "The binary format version %d of the model file is newer than the "
+          "version %d supported, please upgrade Paddle.",
+          format_version,
+          BINARY_FORMAT_VERSION));
+
+  uint64_t num_strings = ReadVarint();
+  strings_.reserve(num_strings);
+  for (uint64_t i = 0; i < num_strings; ++i) {
+    uint64_t size = ReadVarint();
+    PADDLE_ENFORCE_LE(size,
+                      data_.size() - pos_,
+                      common::errors::InvalidArgument(
+                          "The model file is truncated at %d.", pos_));
+    strings_.emplace_back(data_, pos_, size);
+    pos_ += size;
+  }
+  uint64_t num_values = ReadVarint();
+  values_.reserve(num_values);
+  for (uint64_t i = 0; i < num_values; ++i) {
+    values_.push_back(ReadJson());
+  }
+  base_code_ = ReadJson();
+}
+
+bool BinaryDecoder::IsBinary(const std::string& head) {
+  return head.compare(0, std::strlen(BINARY_MAGIC), BINARY_MAGIC) == 0;
+}
+
+uint8_t BinaryDecoder::ReadByte() {
+  PADDLE_ENFORCE_LT(
+      pos_,
+      data_.size(),
+      common::errors::InvalidArgument("The model file is truncated at %d.",
+                                      pos_));
+  return static_cast<uint8_t>(data_[pos_++]);
+}
+
+uint64_t BinaryDecoder::ReadVarint() {
+  uint64_t value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    uint8_t byte = ReadByte();
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      return value;
+    }
+  }
+  PADDLE_THROW(common::errors::InvalidArgument(
+      "The model file has an invalid varint at %d.", pos_));
+}
+
+int64_t BinaryDecoder::ReadSignedVarint() {
+  uint64_t value = ReadVarint();
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+Json BinaryDecoder::ReadJson() {
+  uint8_t tag = ReadByte();
+  switch (tag) {
+    case kNull:
+      return Json();
+    case kFalse:
+      return Json(false);
+    case kTrue:
+      return Json(true);
+    case kInt:
+      return Json(ReadSignedVarint());
+    case kUint:
+      return Json(ReadVarint());
+    case kFloat: {
+      uint64_t bits = 0;
+      for (int i = 0; i < 8; ++i) {
+        bits |= static_cast<uint64_t>(ReadByte()) << (8 * i);
+      }
+      double value = 0;
+      std::memcpy(&value, &bits, sizeof(value));
+      return Json(value);
+    }
+    case kString: {
+      uint64_t idx = ReadVarint();
+      PADDLE_ENFORCE_LT(idx,
+                        strings_.size(),
+                        common::errors::InvalidArgument(
+                            "The model file has an invalid string %d.", idx));
+      return Json(strings_[idx]);
+    }
+    case kArray: {
+      uint64_t size = ReadVarint();
+      Json json = Json::array();
+      for (uint64_t i = 0; i < size; ++i) {
+        json.push_back(ReadJson());
+      }
+      return json;
+    }
+    case kObject: {
+      uint64_t size = ReadVarint();
+      Json json = Json::object();
+      for (uint64_t i = 0; i < size; ++i) {
+        uint64_t idx = ReadVarint();
+        PADDLE_ENFORCE_LT(
+            idx,
+            strings_.size(),
+            common::errors::InvalidArgument(
+                "The model file has an invalid string %d.", idx));
+        json[strings_[idx]] = ReadJson();
+      }
+      return json;
+    }
+    case kValueRef: {
+      uint64_t idx = ReadVarint();
+      PADDLE_ENFORCE_LT(idx,
+                        values_.size(),
+                        common::errors::InvalidArgument(
+                            "The model file has an invalid value %d.", idx));
+      return Json{{BINARY_VALUE_REF, idx}};
+    }
+    default:
+      PADDLE_THROW(common::errors::InvalidArgument(
+          "The model file has an invalid tag %d at %d.", tag, pos_ - 1));
+  }
+}
+
+const Json& BinaryDecoder::Value(uint64_t idx) const {
+  PADDLE_ENFORCE_LT(
+      idx,
+      values_.size(),
+      common::errors::InvalidArgument("The model file has an invalid value %d.",
+                                      idx));
+  return values_[idx];
+}
+
+bool BinaryDecoder::IsValueRef(const Json& json, uint64_t* idx) {
+  if (!json.is_object() || json.size() != 1) {
+    return false;
+  }
+  auto it = json.find(BINARY_VALUE_REF);
+  if (it == json.end() || !it->is_number_unsigned()) {
+    return false;
+  }
+  *idx = it->get<uint64_t>();
+  return true;
+}
+
+void BinaryDecoder::ExpandValues(Json* json) const {
+  uint64_t idx = 0;
+  if (IsValueRef(*json, &idx)) {
+    *json = Value(idx);
+  } else if (json->is_array() || json->is_object()) {
+    for (auto& item : *json) {
+      ExpandValues(&item);
+    }
+  }
+}
+
+}  // namespace pir
@@ -26,6 +26,36 @@ void ProgramReader::RecoverProgram(Json* program_json,
   return;
 }
 
+void ProgramReader::RecoverProgram(BinaryDecoder* decoder,
+                                   pir::Program* recover_program,
+                                   pir::PatchBuilder* builder) {
+  id_value_map[0] = pir::Value();
+  patch_builder = builder;
+  binary_decoder_ = decoder;
+  value_types_.assign(decoder->num_values(), pir::Type());
+  value_attrs_.assign(decoder->num_values(), pir::Attribute());
+
+  uint64_t num_regions = decoder->ReadVarint();
+  PADDLE_ENFORCE_EQ(
+      num_regions,
+      1,
+      common::errors::InvalidArgument(
+          "The regions size of program module should be 1 but got %d.",
+          num_regions));
+  uint64_t num_blocks = decoder->ReadVarint();
+  PADDLE_ENFORCE_EQ(
+      num_blocks,
+      1,
+      common::errors::InvalidArgument(
+          "The blocks size of program module should be 1 but got %d.",
+          num_blocks));
+  ReadBlock(&recover_program->module_op().block());
+
+  binary_decoder_ = nullptr;
+  VLOG(6) << "Finish binary to program.";
+  return;
+}
+
 pir::Type ProgramReader::RecoverType(Json* type_json) {
   return ReadType(type_json);
 }
@@ -63,9 +93,57 @@ void ProgramReader::ReadRegion(Json* region_json, pir::Region* region) {
   return;
 }
 
+void ProgramReader::ReadRegion(pir::Region* region) {
+  uint64_t num_blocks = binary_decoder_->ReadVarint();
+  for (uint64_t i = 0; i < num_blocks; ++i) {
+    region->emplace_back();
+    ReadBlock(&(region->back()));
+  }
+  VLOG(6) << "Finish Read region.";
+  return;
+}
+
 void ProgramReader::ReadBlock(Json* block_json, pir::Block* block) {
   auto block_name = block_json->at(ID).template get<std::string>();
+  ReadBlockArgs(block_json, block);
 
+  Json& ops_json = block_json->at(BLOCKOPS);
+  if (!ops_json.empty()) {
+    // get value id for op_pair io patch
+    VLOG(6) << "Begin to read value num ...";
+    int64_t max_value_id = 0;
+    for (auto& op_json : ops_json) {
+      if (op_json.at(ID).template get<std::string>() == PARAMETEROP) {
+        int64_t id = op_json.at(OPRESULTS).at(VALUE_ID).template get<int64_t>();
+        max_value_id = std::max(max_value_id, id);
+        continue;
+      }
+      Json& operands_json = op_json.at(OPOPERANDS);
+      for (auto& operand_json : operands_json) {
+        int64_t id = operand_json.at(VALUE_ID).template get<int64_t>();
+        max_value_id = std::max(max_value_id, id);
+      }
+      Json& opresults_json = op_json.at(OPRESULTS);
+      for (auto& opresult_json : opresults_json) {
+        int64_t id = opresult_json.at(VALUE_ID).template get<int64_t>();
+        max_value_id = std::max(max_value_id, id);
+      }
+    }
+    max_value_id += id_value_map.size();
+    VLOG(6) << "max_value_id: " << max_value_id;
+    // Apply op_pair io patch
+    patch_builder->ApplyOpPairPatches(&max_value_id);
+    for (auto& op_json : ops_json) {
+      block->push_back(ReadOp(&op_json));
+    }
+    VLOG(6) << "read block size" << block->size() << ".";
+  }
+
+  VLOG(4) << "Finish Read " << block_name << ".";
+  return;
+}
+
+void ProgramReader::ReadBlockArgs(Json* block_json, pir::Block* block) {
   Json& args_json = block_json->at(BLOCKARGS);
   if (!args_json.empty()) {
     for (auto& arg_json : args_json) {
@@ -90,34 +168,22 @@ void ProgramReader::ReadBlock(Json* block_json, pir::Block* block) {
       VLOG(6) << "Finish Read keyword blockarguments. ";
     }
   }
+}
 
-  Json& ops_json = block_json->at(BLOCKOPS);
-  if (!ops_json.empty()) {
-    // get value id for op_pair io patch
-    VLOG(6) << "Begin to read value num ...";
-    int64_t max_value_id = 0;
-    for (auto& op_json : ops_json) {
-      if (op_json.at(ID).template get<std::string>() == PARAMETEROP) {
-        int64_t id = op_json.at(OPRESULTS).at(VALUE_ID).template get<int64_t>();
-        max_value_id = std::max(max_value_id, id);
-        continue;
-      }
-      Json& operands_json = op_json.at(OPOPERANDS);
-      for (auto& operand_json : operands_json) {
-        int64_t id = operand_json.at(VALUE_ID).template get<int64_t>();
-        max_value_id = std::max(max_value_id, id);
-      }
-      Json& opresults_json = op_json.at(OPRESULTS);
-      for (auto& opresult_json : opresults_json) {
-        int64_t id = opresult_json.at(VALUE_ID).template get<int64_t>();
-        max_value_id = std::max(max_value_id, id);
-      }
-    }
+void ProgramReader::ReadBlock(pir::Block* block) {
+  Json block_json = binary_decoder_->ReadJson();
+  auto block_name = block_json.at(ID).template get<std::string>();
+  ReadBlockArgs(&block_json, block);
+
+  int64_t max_value_id = binary_decoder_->ReadSignedVarint();
+  uint64_t num_ops = binary_decoder_->ReadVarint();
+  if (num_ops > 0) {
     max_value_id += id_value_map.size();
     VLOG(6) << "max_value_id: " << max_value_id;
     // Apply op_pair io patch
     patch_builder->ApplyOpPairPatches(&max_value_id);
-    for (auto& op_json : ops_json) {
+    for (uint64_t i = 0; i < num_ops; ++i) {
+      Json op_json = binary_decoder_->ReadJson();
       block->push_back(ReadOp(&op_json));
     }
     VLOG(6) << "read block size" << block->size() << ".";
@@ -126,6 +192,7 @@ void ProgramReader::ReadBlock(Json* block_json, pir::Block* block) {
   VLOG(4) << "Finish Read " << block_name << ".";
   return;
 }
+
 pir::ArrayAttribute GetOneBoolArrayAttribute(pir::IrContext* ctx,
                                              Json* attr_json) {
   std::vector<pir::Attribute> val;
@@ -138,6 +205,9 @@ pir::Operation* ProgramReader::ReadParameterOp(Json* op_json) {
   // attr is_distributed; is_parameter; need_clip; parameter_name; persistable;
   // stop_gradient; trainable;
   if (patch_builder->HasOpPatch(PARAMETEROP)) {
+    if (binary_decoder_) {
+      binary_decoder_->ExpandValues(op_json);
+    }
     VLOG(8) << PARAMETEROP << " before: " << *op_json;
     Json op_patch = patch_builder->GetJsonOpPatch(PARAMETEROP);
     VLOG(8) << " get op patch:  " << op_patch;
@@ -231,6 +301,10 @@ pir::Operation* ProgramReader::ReadOp(Json* op_json) {
     return ReadParameterOp(op_json);
   }
   if (patch_builder->HasOpPatch(op_name)) {
+    // The patches of the op apply to its types and attributes in place.
+    if (binary_decoder_) {
+      binary_decoder_->ExpandValues(op_json);
+    }
     VLOG(8) << op_name << " before: " << *op_json;
     Json op_patch = patch_builder->GetJsonOpPatch(op_name);
     VLOG(8) << " get op patch:  " << op_patch;
@@ -303,6 +377,11 @@ pir::Operation* ProgramReader::ReadOp(Json* op_json) {
     Json& regions_json = op_json->at(REGIONS);
     VLOG(6) << op->name() << " has " << num_regions << " regions.";
     for (uint64_t i = 0; i < regions_json.size(); i++) {
+      if (binary_decoder_) {
+        // The regions follow the op in the binary format.
+        ReadRegion(&(op->region(i)));
+        continue;
+      }
       auto region_json = regions_json.at(i);
       ReadRegion(&region_json, &(op->region(i)));
     }
@@ -387,6 +466,14 @@ pir::AttributeMap ProgramReader::ReadAttributesMap(
 
 pir::Attribute ProgramReader::ReadAttribute(Json* attr_json) {
   VLOG(6) << "Begin Read Attribute. ";
+  uint64_t idx = 0;
+  if (BinaryDecoder::IsValueRef(attr_json->at(ATTR_TYPE), &idx)) {
+    if (!value_attrs_.at(idx)) {
+      Json value_json = {{ATTR_TYPE, binary_decoder_->Value(idx)}};
+      value_attrs_[idx] = ReadAttribute(&value_json);
+    }
+    return value_attrs_[idx];
+  }
   auto attr_type = attr_json->at(ATTR_TYPE).at(ID).template get<std::string>();
   if (patch_builder && patch_builder->HasAttrPatch(attr_type)) {
     VLOG(8) << attr_type << " before: " << *attr_json;
@@ -400,6 +487,14 @@ pir::Attribute ProgramReader::ReadAttribute(Json* attr_json) {
 
 pir::Type ProgramReader::ReadType(Json* type_json) {
   VLOG(6) << "Begin Read Type. ";
+  uint64_t idx = 0;
+  if (BinaryDecoder::IsValueRef(*type_json, &idx)) {
+    if (!value_types_.at(idx)) {
+      Json value_json = binary_decoder_->Value(idx);
+      value_types_[idx] = ReadType(&value_json);
+    }
+    return value_types_[idx];
+  }
   auto type_name = type_json->at(ID).template get<std::string>();
   VLOG(8) << "Check patches for: " << type_name;
   if (patch_builder && patch_builder->HasTypePatch(type_name)) {
@@ -30,6 +30,22 @@ Json ProgramWriter::GetProgramJson(const pir::Program* program) {
   return program_json;
 }
 
+std::string ProgramWriter::GetProgramBinary(const pir::Program* program,
+                                            const Json& base_code) {
+  BinaryEncoder encoder;
+  binary_encoder_ = &encoder;
+  std::string program_str;
+  auto top_level_op = program->module_op();
+  encoder.WriteVarint(top_level_op->num_regions(), &program_str);
+  for (size_t i = 0; i < top_level_op->num_regions(); ++i) {
+    std::string region_name = "region_" + std::to_string(region_id_++);
+    WriteRegion(&top_level_op->region(i), region_name, &program_str);
+  }
+  binary_encoder_ = nullptr;
+  VLOG(6) << "Finish program to binary.";
+  return encoder.Finish(base_code, program_str);
+}
+
 Json ProgramWriter::GetTypeJson(const pir::Type& type) {
   auto type_json = WriteType(type);
   VLOG(6) << "Finish type to json.";
@@ -75,6 +91,78 @@ Json ProgramWriter::WriteRegion(const pir::Region* region,
 
 Json ProgramWriter::WriteBlock(pir::Block* block,
                                const std::string& block_name) {
+  Json block_json = WriteBlockArgs(block, block_name);
+  Json ops_json = Json::array();
+
+  /* delete cf.stack_create / cf.tuple_push */
+  if (!FLAGS_save_cf_stack_op) {
+    DeleteStackOps(block);
+  }
+  for (auto op : block->ops()) {
+    auto op_json = WriteOp(*op);
+    ops_json.emplace_back(op_json);
+  }
+  block_json[BLOCKOPS] = ops_json;
+
+  VLOG(4) << "Finish write " << block_name << ".";
+  return block_json;
+}
+
+void ProgramWriter::WriteRegion(const pir::Region* region,
+                                const std::string& region_name,
+                                std::string* out) {
+  binary_encoder_->WriteVarint(region->size(), out);
+  for (auto block : region->blocks()) {
+    std::string block_name = "block_" + std::to_string(block_id_++);
+    WriteBlock(block, block_name, out);
+  }
+  VLOG(6) << "Finish write " << region_name;
+}
+
+void ProgramWriter::WriteBlock(pir::Block* block,
+                               const std::string& block_name,
+                               std::string* out) {
+  binary_encoder_->WriteJson(WriteBlockArgs(block, block_name), out);
+
+  /* delete cf.stack_create / cf.tuple_push */
+  if (!FLAGS_save_cf_stack_op) {
+    DeleteStackOps(block);
+  }
+  // The max value id of the ops is written before them, for the op_pair
+  // patches of the reader.
+  int64_t max_value_id = 0;
+  auto MaxValueId = [&max_value_id](const Json& value_json) {
+    max_value_id =
+        std::max(max_value_id, value_json.at(VALUE_ID).get<int64_t>());
+  };
+  std::string ops_str;
+  for (auto op : block->ops()) {
+    Json op_json = WriteOp(*op);
+    if (op_json.at(ID) == PARAMETEROP) {
+      MaxValueId(op_json.at(OPRESULTS));
+    } else {
+      for (auto& operand_json : op_json.at(OPOPERANDS)) {
+        MaxValueId(operand_json);
+      }
+      for (auto& opresult_json : op_json.at(OPRESULTS)) {
+        MaxValueId(opresult_json);
+      }
+    }
+    binary_encoder_->WriteJson(op_json, &ops_str);
+    for (size_t i = 0; i < op->num_regions(); ++i) {
+      std::string region_name = "region_" + std::to_string(region_id_++);
+      WriteRegion(&op->region(i), region_name, &ops_str);
+    }
+  }
+  binary_encoder_->WriteSignedVarint(max_value_id, out);
+  binary_encoder_->WriteVarint(block->size(), out);
+  out->append(ops_str);
+
+  VLOG(4) << "Finish write " << block_name << ".";
+}
+
+Json ProgramWriter::WriteBlockArgs(pir::Block* block,
+                                   const std::string& block_name) {
   Json block_json;
   block_json[ID] = block_name;
   VLOG(4) << "Begin write " << block_name << ".";
@@ -97,43 +185,33 @@ Json ProgramWriter::WriteBlock(pir::Block* block,
     block_json[KEYWORDBLOCKARGS] = args_json;
     VLOG(6) << "Finish Write keyword blockarguments. ";
   }
+  return block_json;
+}
 
-  Json ops_json = Json::array();
-
-  /* delete cf.stack_create / cf.tuple_push */
-  if (!FLAGS_save_cf_stack_op) {
-    std::vector<pir::Operation*> delete_ops;
-    for (auto op : block->ops()) {
-      if (op->isa<pir::StackCreateOp>()) {
-        delete_ops.push_back(op);
-      }
-    }
-    VLOG(6) << "program before delete stack op :" << *(block->parent_program());
-    for (auto op : delete_ops) {
-      VLOG(0) << "Delete cf.stack_create / cf.tuple_push.";
-      auto stack_op = op->dyn_cast<pir::StackCreateOp>();
-      if (stack_op.inlet().HasOneUse()) {
-        auto tuple_push_op = stack_op.tuple_push_op();
-        auto block_in = tuple_push_op->GetParent();
-        block_in->erase(*tuple_push_op);
-      }
-      if (stack_op.outlet().HasOneUse()) {
-        auto tuple_pop_op = stack_op.tuple_pop_op();
-        auto block_in = tuple_pop_op->GetParent();
-        block_in->erase(*tuple_pop_op);
-      }
-      block->erase(*op);
+void ProgramWriter::DeleteStackOps(pir::Block* block) {
+  std::vector<pir::Operation*> delete_ops;
+  for (auto op : block->ops()) {
+    if (op->isa<pir::StackCreateOp>()) {
+      delete_ops.push_back(op);
     }
-    VLOG(6) << "program after delete stack op :" << *(block->parent_program());
   }
-  for (auto op : block->ops()) {
-    auto op_json = WriteOp(*op);
-    ops_json.emplace_back(op_json);
+  VLOG(6) << "program before delete stack op :" << *(block->parent_program());
+  for (auto op : delete_ops) {
+    VLOG(0) << "Delete cf.stack_create / cf.tuple_push.";
+    auto stack_op = op->dyn_cast<pir::StackCreateOp>();
+    if (stack_op.inlet().HasOneUse()) {
+      auto tuple_push_op = stack_op.tuple_push_op();
+      auto block_in = tuple_push_op->GetParent();
+      block_in->erase(*tuple_push_op);
+    }
+    if (stack_op.outlet().HasOneUse()) {
+      auto tuple_pop_op = stack_op.tuple_pop_op();
+      auto block_in = tuple_pop_op->GetParent();
+      block_in->erase(*tuple_pop_op);
+    }
+    block->erase(*op);
   }
-  block_json[BLOCKOPS] = ops_json;
-
-  VLOG(4) << "Finish write " << block_name << ".";
-  return block_json;
+  VLOG(6) << "program after delete stack op :" << *(block->parent_program());
 }
 
 Json ProgramWriter::WriteBlockArg(const pir::Value& value) {
@@ -296,6 +374,11 @@ Json ProgramWriter::WriteOp(const pir::Operation& op) {
   if (op.num_regions() > 0) {
     VLOG(4) << "OP has " << op.num_regions() << " regions ...";
     for (size_t i = 0; i < op.num_regions(); ++i) {
+      if (binary_encoder_) {
+        // The regions follow the op in the binary format.
+        op_json[REGIONS].emplace_back(nullptr);
+        continue;
+      }
       std::string region_name = "region_" + std::to_string(region_id_++);
       auto& region = op.region(i);
       auto region_json = WriteRegion(&region, region_name);
@@ -922,6 +922,11 @@ void BindAnalysisConfig(py::module *m) {
       .def("use_optimized_model",
            &AnalysisConfig::UseOptimizedModel,
            py::arg("x") = true)
+      .def("enable_lightweight_clone",
+           &AnalysisConfig::EnableLightweightClone,
+           py::arg("x") = true)
+      .def("lightweight_clone_enabled",
+           &AnalysisConfig::lightweight_clone_enabled)
       .def("enable_memory_optim",
            &AnalysisConfig::EnableMemoryOptim,
            py::arg("x") = true)
@@ -937,6 +942,10 @@ void BindAnalysisConfig(py::module *m) {
            &AnalysisConfig::EnableSaveOptimModel,
            py::arg("save_optimized_model") = false)
       .def("set_optim_cache_dir", &AnalysisConfig::SetOptimCacheDir)
+      .def("set_optimized_model_cache_dir",
+           &AnalysisConfig::SetOptimizedModelCacheDir)
+      .def("optimized_model_cache_dir",
+           &AnalysisConfig::optimized_model_cache_dir)
       .def("switch_use_feed_fetch_ops",
            &AnalysisConfig::SwitchUseFeedFetchOps,
            py::arg("x") = true)
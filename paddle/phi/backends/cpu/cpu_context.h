@@ -15,7 +15,9 @@ limitations under the License. */
 #pragma once
 
 #include <memory>
+#include <utility>
 
+#include "paddle/phi/backends/cpu/cpu_parallel.h"
 #include "paddle/phi/backends/cpu/forwards.h"
 #include "paddle/phi/core/device_context.h"
 
@@ -35,6 +37,14 @@ class PADDLE_API CPUContext : public DeviceContext,
   Eigen::DefaultDevice* eigen_device() const;
   const Place& GetPlace() const override;
 
+  // Calls fn(begin, end) on ranges covering [0, n) on the threads that the
+  // cost of the loop pays for, cost_per_element is in cycles. An exception
+  // of fn is rethrown on the calling thread, see cpu_parallel.h.
+  template <typename Func>
+  void ParallelFor(int64_t n, double cost_per_element, Func&& fn) const {
+    backends::cpu::CPUParallelFor(n, cost_per_element, std::forward<Func>(fn));
+  }
+
   static const char* name() { return "CPUContext"; }
 
  protected:
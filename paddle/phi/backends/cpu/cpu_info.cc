@@ -24,6 +24,7 @@ limitations under the License. */
 #endif
 #include <windows.h>
 #else
+#include <sched.h>
 #include <unistd.h>
 #endif  // _WIN32
 
@@ -32,6 +33,9 @@ limitations under the License. */
 #endif
 
 #include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
 
 #include "paddle/common/flags.h"
 
@@ -111,6 +115,78 @@ size_t CUDAPinnedMaxChunkSize() {
   return CUDAPinnedMaxAllocSize() / 256;
 }
 
+#if defined(__linux__)
+// Parse a cpulist such as "0-3,8-11" into the cpu ids it contains.
+static std::vector<int> ParseCpuList(const std::string& list) {
+  std::vector<int> cpus;
+  size_t pos = 0;
+  while (pos < list.size()) {
+    size_t end = list.find(',', pos);
+    if (end == std::string::npos) end = list.size();
+    std::string item = list.substr(pos, end - pos);
+    size_t dash = item.find('-');
+    try {
+      if (dash == std::string::npos) {
+        cpus.push_back(std::stoi(item));
+      } else {
+        int lo = std::stoi(item.substr(0, dash));
+        int hi = std::stoi(item.substr(dash + 1));
+        for (int i = lo; i <= hi; ++i) cpus.push_back(i);
+      }
+    } catch (...) {
+      // ignore malformed entries
+    }
+    pos = end + 1;
+  }
+  return cpus;
+}
+
+// cpu id -> NUMA node id, built once from sysfs.
+static const std::vector<int>& CpuToNumaNodeMap() {
+  static const std::vector<int> cpu_to_node = [] {
+    std::vector<int> map;
+    for (int node = 0;; ++node) {
+      std::ifstream fin("/sys/devices/system/node/node" +
+                        std::to_string(node) + "/cpulist");
+      if (!fin.is_open()) break;
+      std::string list;
+      std::getline(fin, list);
+      for (int cpu : ParseCpuList(list)) {
+        if (cpu >= static_cast<int>(map.size())) map.resize(cpu + 1, 0);
+        map[cpu] = node;
+      }
+    }
+    return map;
+  }();
+  return cpu_to_node;
+}
+#endif
+
+int CpuNumaNodeCount() {
+#if defined(__linux__)
+  static const int count = [] {
+    const auto& map = CpuToNumaNodeMap();
+    int max_node = 0;
+    for (int node : map) max_node = std::max(max_node, node);
+    return max_node + 1;
+  }();
+  return count;
+#else
+  return 1;
+#endif
+}
+
+int CpuCurrentNumaNode() {
+#if defined(__linux__)
+  int cpu = sched_getcpu();
+  const auto& map = CpuToNumaNodeMap();
+  if (cpu < 0 || cpu >= static_cast<int>(map.size())) return 0;
+  return map[cpu];
+#else
+  return 0;
+#endif
+}
+
 #ifdef PADDLE_WITH_XBYAK
 static Xbyak::util::Cpu cpu;
 bool MayIUse(const cpu_isa_t cpu_isa) {
@@ -77,6 +77,12 @@ size_t CUDAPinnedMinChunkSize();
 //! Get the maximum chunk size for buddy allocator.
 size_t CUDAPinnedMaxChunkSize();
 
+//! Get the number of NUMA nodes, 1 if NUMA is not available.
+int CpuNumaNodeCount();
+
+//! Get the NUMA node of the cpu the calling thread is running on.
+int CpuCurrentNumaNode();
+
 typedef enum {
   isa_any,
   sse42,
@@ -0,0 +1,150 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/backends/cpu/cpu_parallel.h"
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "glog/logging.h"
+#include "paddle/common/flags.h"
+
+PHI_DEFINE_EXPORTED_bool(
+    cpu_parallel_cost_model,
+    true,
+    "Choose the threads of the CPU parallel loops by their costs. If false, "
+    "every parallel loop runs on all the threads.");
+
+namespace phi::backends::cpu {
+
+namespace {
+
+// The least overhead of a parallel region. The threads of back-to-back
+// regions are still spinning, while those of a kernel run after a while
+// sleep and take a few microseconds to wake up.
+constexpr double kMinForkJoinNs = 2000.0;
+
+thread_local int thread_budget = 0;
+
+double ElapsedNs(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::nano>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// Times a chain of dependent 64-bit multiply-adds, each of which takes 4
+// cycles on x86 and arm64 cores.
+double MeasureNsPerCycle() {
+  constexpr int64_t kSteps = 1 << 18;
+  constexpr double kCyclesPerStep = 4.0;
+  volatile uint64_t seed = 1;
+  double best = 0.0;
+  for (int rep = 0; rep < 3; ++rep) {
+    uint64_t x = seed;
+    auto start = std::chrono::steady_clock::now();
+    for (int64_t i = 0; i < kSteps; ++i) {
+      x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+    }
+    double ns = ElapsedNs(start);
+    seed = x;
+    if (rep == 0 || ns < best) {
+      best = ns;
+    }
+  }
+  return best / (kSteps * kCyclesPerStep);
+}
+
+// The median time of an empty parallel region on all the threads.
+double MeasureForkJoinNs() {
+#ifdef PADDLE_WITH_MKLML
+  constexpr int kWarmups = 4;
+  constexpr int kReps = 15;
+  const int threads = omp_get_max_threads();
+  if (threads <= 1) {
+    return kMinForkJoinNs;
+  }
+  std::vector<double> times;
+  for (int rep = 0; rep < kWarmups + kReps; ++rep) {
+    auto start = std::chrono::steady_clock::now();
+#pragma omp parallel num_threads(threads)
+    {
+    }
+    double ns = ElapsedNs(start);
+    if (rep >= kWarmups) {
+      times.push_back(ns);
+    }
+  }
+  std::nth_element(times.begin(), times.begin() + kReps / 2, times.end());
+  return std::max(times[kReps / 2], kMinForkJoinNs);
+#else
+  return kMinForkJoinNs;
+#endif
+}
+
+}  // namespace
+
+const CPUParallelCostModel& GetCPUParallelCostModel() {
+  static const CPUParallelCostModel model = [] {
+    CPUParallelCostModel m;
+    m.ns_per_cycle = MeasureNsPerCycle();
+    m.fork_join_ns = MeasureForkJoinNs();
+    VLOG(3) << "CPU parallel cost model: " << m.ns_per_cycle
+            << " ns per cycle, " << m.fork_join_ns << " ns per fork/join";
+    return m;
+  }();
+  return model;
+}
+
+void SetCPUParallelThreadBudget(int threads) {
+  thread_budget = std::max(threads, 0);
+}
+
+int GetCPUParallelThreadBudget() { return thread_budget; }
+
+int CPUParallelMaxThreads() {
+  int threads = 1;
+#ifdef PADDLE_WITH_MKLML
+  if (omp_in_parallel()) {
+    return 1;
+  }
+  threads = omp_get_max_threads();
+#endif
+  if (thread_budget > 0) {
+    threads = std::min(threads, thread_budget);
+  }
+  return threads;
+}
+
+int CPUParallelThreads(int64_t n, double cost_per_element) {
+  const int max_threads = CPUParallelMaxThreads();
+  if (max_threads <= 1 || n <= 1) {
+    return 1;
+  }
+  const int64_t limit = std::min<int64_t>(max_threads, n);
+  if (!FLAGS_cpu_parallel_cost_model) {
+    return static_cast<int>(limit);
+  }
+  const CPUParallelCostModel& model = GetCPUParallelCostModel();
+  const double work_ns =
+      static_cast<double>(n) * cost_per_element * model.ns_per_cycle;
+  const double threads =
+      std::floor(work_ns / (kCPUParallelMinTaskRatio * model.fork_join_ns));
+  if (!(threads > 1.0)) {
+    return 1;
+  }
+  return static_cast<int>(std::min<double>(threads, limit));
+}
+
+}  // namespace phi::backends::cpu
@@ -0,0 +1,110 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifdef PADDLE_WITH_MKLML
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+
+#include "paddle/common/macros.h"
+
+namespace phi {
+namespace backends {
+namespace cpu {
+
+// The parallel loops of the CPU kernels.
+//
+// A loop states the cost of every element in cycles, and runs on as many
+// OpenMP threads as its work pays for: every thread gets at least
+// kCPUParallelMinTaskRatio times the fork/join overhead of a parallel region.
+// The overhead and the duration of a cycle are measured once per process.
+// Small loops run on the calling thread, large ones on all the threads.
+
+// The measured costs of the parallel loops.
+struct CPUParallelCostModel {
+  // the duration of a cycle
+  double ns_per_cycle{0.0};
+  // the overhead of a parallel region on all the threads
+  double fork_join_ns{0.0};
+};
+
+constexpr double kCPUParallelMinTaskRatio = 4.0;
+
+// The costs of this machine, measured on the first call.
+PADDLE_API const CPUParallelCostModel& GetCPUParallelCostModel();
+
+// The threads of the parallel loops started by the calling thread, at most
+// the OpenMP threads. 0 means no limit. The threads of a thread pool, which
+// run kernels concurrently, share the cores by their budgets.
+PADDLE_API void SetCPUParallelThreadBudget(int threads);
+PADDLE_API int GetCPUParallelThreadBudget();
+
+// The threads a parallel loop of the calling thread may use, 1 in a parallel
+// region.
+PADDLE_API int CPUParallelMaxThreads();
+
+// The threads of a loop of n elements costing cost_per_element cycles each.
+PADDLE_API int CPUParallelThreads(int64_t n, double cost_per_element);
+
+// Calls fn(begin, end) on ranges covering [0, n), one contiguous range per
+// thread. An exception can not leave a parallel region, so the first one
+// thrown by fn is caught and rethrown on the calling thread after the loop.
+template <typename Func>
+void CPUParallelFor(int64_t n, double cost_per_element, Func&& fn) {
+  if (n <= 0) {
+    return;
+  }
+  const int threads = CPUParallelThreads(n, cost_per_element);
+  if (threads <= 1) {
+    fn(int64_t{0}, n);
+    return;
+  }
+#ifdef PADDLE_WITH_MKLML
+  std::exception_ptr error;
+  std::mutex error_mutex;
+#pragma omp parallel num_threads(threads)
+  {
+    // the team may be smaller than asked
+    const int64_t team = omp_get_num_threads();
+    const int64_t t = omp_get_thread_num();
+    const int64_t begin = n * t / team;
+    const int64_t end = n * (t + 1) / team;
+    if (begin < end) {
+      try {
+        fn(begin, end);
+      } catch (...) {
+        std::lock_guard<std::mutex> guard(error_mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+#else
+  fn(int64_t{0}, n);
+#endif
+}
+
+}  // namespace cpu
+}  // namespace backends
+}  // namespace phi
@@ -25,8 +25,10 @@
 #include "paddle/phi/core/memory/allocation/auto_growth_best_fit_allocator_v2.h"
 #include "paddle/phi/core/memory/allocation/cpu_allocator.h"
 #include "paddle/phi/core/memory/allocation/naive_best_fit_allocator.h"
+#include "paddle/phi/core/memory/allocation/numa_cpu_allocator.h"
 #include "paddle/phi/core/memory/allocation/retry_allocator.h"
 #include "paddle/phi/core/memory/allocation/stat_allocator.h"
+#include "paddle/phi/core/memory/allocation/thread_local_cpu_cache_allocator.h"
 #include "paddle/phi/core/platform/device_context.h"
 
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
@@ -114,6 +116,12 @@ PHI_DEFINE_EXPORTED_bool(
 COMMON_DECLARE_string(allocator_strategy);
 COMMON_DECLARE_uint64(auto_growth_chunk_size_in_mb);
 COMMON_DECLARE_bool(use_auto_growth_pinned_allocator);
+COMMON_DECLARE_bool(use_auto_growth_cpu_allocator);
+COMMON_DECLARE_uint64(cpu_auto_growth_chunk_size_in_mb);
+COMMON_DECLARE_bool(use_cpu_huge_page);
+COMMON_DECLARE_bool(use_thread_local_cpu_cache);
+COMMON_DECLARE_uint64(thread_local_cpu_cache_size_in_mb);
+COMMON_DECLARE_uint64(thread_local_cpu_cache_spill_size_in_mb);
 COMMON_DECLARE_bool(use_cuda_malloc_async_allocator);
 COMMON_DECLARE_bool(auto_free_cudagraph_allocations_on_launch);
 
@@ -243,7 +251,11 @@ class AllocatorFacadePrivate {
       }
 
       case AllocatorStrategy::kAutoGrowth: {
-        InitNaiveBestFitCPUAllocator();
+        if (FLAGS_use_auto_growth_cpu_allocator) {
+          InitAutoGrowthCPUAllocator(allow_free_idle_chunk);
+        } else {
+          InitNaiveBestFitCPUAllocator();
+        }
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
         allow_free_idle_chunk_ = allow_free_idle_chunk;
         for (int dev_id = 0; dev_id < platform::GetGPUDeviceCount(); ++dev_id) {
@@ -344,6 +356,10 @@ class AllocatorFacadePrivate {
             "Unsupported allocator strategy: %d", static_cast<int>(strategy_)));
       }
     }
+    if (FLAGS_use_thread_local_cpu_cache) {
+      WrapThreadLocalCPUCacheAllocator();
+    }
+
     InitZeroSizeAllocators();
     InitSystemAllocators();
 
@@ -834,6 +850,26 @@ class AllocatorFacadePrivate {
 #endif
   }
 
+  void WrapThreadLocalCPUCacheAllocator() {
+    auto& allocator = allocators_[phi::CPUPlace()];
+    allocator = std::make_shared<ThreadLocalCPUCacheAllocator>(
+        allocator,
+        FLAGS_thread_local_cpu_cache_size_in_mb << 20,
+        FLAGS_thread_local_cpu_cache_spill_size_in_mb << 20);
+  }
+
+  void InitAutoGrowthCPUAllocator(bool allow_free_idle_chunk) {
+    auto chunk_size = FLAGS_cpu_auto_growth_chunk_size_in_mb << 20;
+    VLOG(4) << "FLAGS_cpu_auto_growth_chunk_size_in_mb is "
+            << FLAGS_cpu_auto_growth_chunk_size_in_mb;
+    allocators_[phi::CPUPlace()] =
+        std::make_shared<NUMAAutoGrowthCPUAllocator>(
+            NUMAAutoGrowthCPUAllocator::kAlignment,
+            chunk_size,
+            allow_free_idle_chunk,
+            FLAGS_use_cpu_huge_page);
+  }
+
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
   void InitNaiveBestFitCUDAPinnedAllocator() {
     if (FLAGS_use_auto_growth_pinned_allocator) {
@@ -0,0 +1,160 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/memory/allocation/numa_cpu_allocator.h"
+
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "paddle/phi/backends/cpu/cpu_info.h"
+#include "paddle/phi/core/enforce.h"
+#include "paddle/phi/core/memory/allocation/aligned_allocator.h"
+#include "paddle/phi/core/memory/allocation/auto_growth_best_fit_allocator.h"
+#include "paddle/phi/core/memory/allocation/cpu_allocator.h"
+#include "paddle/phi/core/memory/stats.h"
+
+namespace paddle::memory::allocation {
+
+#if defined(__linux__)
+// NOTE: Use the raw syscall to avoid a dependency on libnuma.
+static constexpr int kMPolPreferred = 1;
+
+static void BindToNumaNode(void* ptr, size_t size, int numa_node) {
+#if defined(SYS_mbind)
+  if (numa_node < 0 || numa_node >= 64) return;
+  uint64_t node_mask = 1UL << numa_node;
+  long ret = syscall(SYS_mbind,  // NOLINT
+                     ptr,
+                     size,
+                     kMPolPreferred,
+                     &node_mask,
+                     sizeof(node_mask) * 8,
+                     0);
+  if (ret != 0) {
+    VLOG(4) << "mbind to NUMA node " << numa_node << " failed, errno "
+            << errno;
+  }
+#endif
+}
+#endif
+
+NUMACPUAllocator::NUMACPUAllocator(int numa_node, bool use_huge_page)
+    : numa_node_(numa_node), use_huge_page_(use_huge_page) {}
+
+phi::Allocation* NUMACPUAllocator::AllocateImpl(size_t size) {
+  void* p = nullptr;
+#if defined(__linux__)
+  p = mmap(
+      nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  PADDLE_ENFORCE_NE(p,
+                    MAP_FAILED,
+                    common::errors::ResourceExhausted(
+                        "Fail to alloc memory of %ld size on NUMA node %d, "
+                        "error code is %d.",
+                        size,
+                        numa_node_,
+                        errno));
+#if defined(MADV_HUGEPAGE)
+  if (use_huge_page_) {
+    madvise(p, size, MADV_HUGEPAGE);
+  }
+#endif
+  if (phi::backends::cpu::CpuNumaNodeCount() > 1) {
+    BindToNumaNode(p, size, numa_node_);
+  }
+#elif defined(_WIN32)
+  p = _aligned_malloc(size, CPUAllocator::kAlignment);
+  PADDLE_ENFORCE_NOT_NULL(
+      p,
+      common::errors::ResourceExhausted("Fail to alloc memory of %ld size.",
+                                        size));
+#else
+  int error = posix_memalign(&p, CPUAllocator::kAlignment, size);
+  PADDLE_ENFORCE_EQ(
+      error,
+      0,
+      common::errors::ResourceExhausted(
+          "Fail to alloc memory of %ld size, error code is %d.", size, error));
+#endif
+  HOST_MEMORY_STAT_UPDATE(Reserved, 0, size);
+  return new Allocation(p, size, phi::CPUPlace());
+}
+
+void NUMACPUAllocator::FreeImpl(phi::Allocation* allocation) {
+  auto size = allocation->size();
+  void* p = allocation->ptr();
+#if defined(__linux__)
+  munmap(p, size);
+#elif defined(_WIN32)
+  _aligned_free(p);
+#else
+  free(p);  // NOLINT
+#endif
+  HOST_MEMORY_STAT_UPDATE(Reserved, 0, -size);
+  delete allocation;
+}
+
+NUMAAutoGrowthCPUAllocator::NUMAAutoGrowthCPUAllocator(
+    size_t alignment,
+    size_t chunk_size,
+    bool allow_free_idle_chunk,
+    bool use_huge_page) {
+  int node_count = phi::backends::cpu::CpuNumaNodeCount();
+  VLOG(4) << "Create NUMAAutoGrowthCPUAllocator with " << node_count
+          << " NUMA node(s), chunk_size " << chunk_size << ", use_huge_page "
+          << use_huge_page;
+  node_allocators_.reserve(node_count);
+  for (int node = 0; node < node_count; ++node) {
+    std::shared_ptr<Allocator> underlying_allocator =
+        std::make_shared<NUMACPUAllocator>(node, use_huge_page);
+    if (use_huge_page) {
+      // Make chunks start on a huge page boundary so that the whole chunk
+      // could be backed by huge pages.
+      underlying_allocator = std::make_shared<AlignedAllocator>(
+          underlying_allocator, NUMACPUAllocator::kHugePageSize);
+    }
+    node_allocators_.emplace_back(std::make_shared<AutoGrowthBestFitAllocator>(
+        underlying_allocator, alignment, chunk_size, allow_free_idle_chunk));
+  }
+}
+
+phi::Allocation* NUMAAutoGrowthCPUAllocator::AllocateImpl(size_t size) {
+  int node = 0;
+  if (node_allocators_.size() > 1) {
+    node = phi::backends::cpu::CpuCurrentNumaNode();
+    if (node >= static_cast<int>(node_allocators_.size())) node = 0;
+  }
+  return node_allocators_[node]->Allocate(size).release();
+}
+
+void NUMAAutoGrowthCPUAllocator::FreeImpl(phi::Allocation* allocation) {
+  // The node allocator which served the request is on the top of the
+  // decorated allocator chain now.
+  Allocator::AllocationDeleter(allocation);
+}
+
+uint64_t NUMAAutoGrowthCPUAllocator::ReleaseImpl(const phi::Place& place) {
+  uint64_t released = 0;
+  for (auto& allocator : node_allocators_) {
+    released += allocator->Release(place);
+  }
+  return released;
+}
+
+}  // namespace paddle::memory::allocation
@@ -0,0 +1,81 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "paddle/phi/core/memory/allocation/allocator.h"
+
+namespace paddle {
+namespace memory {
+namespace allocation {
+
+// CPU system allocator which binds the allocated memory to a NUMA node.
+//
+// It is used as the chunk allocator of the CPU auto_growth allocator, so
+// each allocation is expected to be large. On Linux the memory is obtained
+// by mmap, bound to `numa_node` with a preferred policy and, if
+// `use_huge_page` is true, advised to be backed by transparent huge pages.
+// On other platforms it behaves like CPUAllocator.
+class NUMACPUAllocator : public Allocator {
+ public:
+  constexpr static size_t kHugePageSize = 2UL << 20;
+
+  NUMACPUAllocator(int numa_node, bool use_huge_page);
+
+  bool IsAllocThreadSafe() const override { return true; }
+
+  int numa_node() const { return numa_node_; }
+
+ protected:
+  phi::Allocation* AllocateImpl(size_t size) override;
+  void FreeImpl(phi::Allocation* allocation) override;
+
+ private:
+  int numa_node_;
+  bool use_huge_page_;
+};
+
+// Auto-growth best-fit allocator for CPUPlace.
+//
+// It keeps one AutoGrowthBestFitAllocator per NUMA node, and each request is
+// served by the allocator of the node the calling thread is running on.
+// Freed blocks are returned to the allocator they came from, which is
+// recorded in the decorated allocator chain of the allocation.
+class NUMAAutoGrowthCPUAllocator : public Allocator {
+ public:
+  // Alignment of each block, enough for AVX-512 loads and oneDNN.
+  constexpr static size_t kAlignment = 64UL;
+
+  NUMAAutoGrowthCPUAllocator(size_t alignment,
+                             size_t chunk_size,
+                             bool allow_free_idle_chunk,
+                             bool use_huge_page);
+
+  bool IsAllocThreadSafe() const override { return true; }
+
+ protected:
+  phi::Allocation* AllocateImpl(size_t size) override;
+  void FreeImpl(phi::Allocation* allocation) override;
+  uint64_t ReleaseImpl(const phi::Place& place) override;
+
+ private:
+  std::vector<std::shared_ptr<Allocator>> node_allocators_;
+};
+
+}  // namespace allocation
+}  // namespace memory
+}  // namespace paddle
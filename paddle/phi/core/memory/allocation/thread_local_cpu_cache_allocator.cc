@@ -0,0 +1,242 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/memory/allocation/thread_local_cpu_cache_allocator.h"
+
+#include <atomic>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+#include "paddle/phi/core/enforce.h"
+
+namespace paddle::memory::allocation {
+
+size_t CPUBlockCache::SizeClass(size_t size) {
+  size_t size_class = 0;
+  size_t bytes = kMinBlockSize;
+  while (bytes < size) {
+    bytes <<= 1;
+    ++size_class;
+  }
+  return size_class;
+}
+
+DecoratedAllocationPtr CPUBlockCache::Pop(size_t size_class) {
+  std::lock_guard<SpinLock> guard(spinlock_);
+  auto& bucket = buckets_[size_class];
+  if (bucket.empty()) {
+    return nullptr;
+  }
+  DecoratedAllocationPtr block = std::move(bucket.back());
+  bucket.pop_back();
+  cached_bytes_ -= SizeClassBytes(size_class);
+  return block;
+}
+
+DecoratedAllocationPtr CPUBlockCache::Push(size_t size_class,
+                                           DecoratedAllocationPtr block) {
+  size_t bytes = SizeClassBytes(size_class);
+  std::lock_guard<SpinLock> guard(spinlock_);
+  if (cached_bytes_ + bytes > capacity_) {
+    return block;
+  }
+  buckets_[size_class].emplace_back(std::move(block));
+  cached_bytes_ += bytes;
+  return nullptr;
+}
+
+std::vector<std::pair<size_t, DecoratedAllocationPtr>>
+CPUBlockCache::PopAll() {
+  std::vector<std::pair<size_t, DecoratedAllocationPtr>> blocks;
+  std::lock_guard<SpinLock> guard(spinlock_);
+  for (size_t size_class = 0; size_class < kNumSizeClasses; ++size_class) {
+    auto& bucket = buckets_[size_class];
+    for (auto& block : bucket) {
+      blocks.emplace_back(size_class, std::move(block));
+    }
+    bucket.clear();
+  }
+  cached_bytes_ = 0;
+  return blocks;
+}
+
+class ThreadLocalCPUCacheAllocation : public Allocation {
+ public:
+  ThreadLocalCPUCacheAllocation(DecoratedAllocationPtr underlying_allocation,
+                                size_t size_class,
+                                std::weak_ptr<CPUBlockCache> owner)
+      : Allocation(underlying_allocation->ptr(),
+                   underlying_allocation->base_ptr(),
+                   CPUBlockCache::SizeClassBytes(size_class),
+                   underlying_allocation->place()),
+        underlying_allocation_(std::move(underlying_allocation)),
+        size_class_(size_class),
+        owner_(std::move(owner)) {}
+
+  DecoratedAllocationPtr TakeUnderlyingAllocation() {
+    return std::move(underlying_allocation_);
+  }
+
+  size_t SizeClass() const { return size_class_; }
+
+  std::shared_ptr<CPUBlockCache> Owner() const { return owner_.lock(); }
+
+ private:
+  DecoratedAllocationPtr underlying_allocation_;
+  size_t size_class_;
+  std::weak_ptr<CPUBlockCache> owner_;
+};
+
+struct ThreadLocalCPUCacheAllocator::SharedState {
+  SharedState(std::shared_ptr<Allocator> underlying_allocator,
+              size_t thread_cache_capacity,
+              size_t global_pool_capacity)
+      : underlying_allocator(std::move(underlying_allocator)),
+        thread_cache_capacity(thread_cache_capacity),
+        global_pool(global_pool_capacity) {}
+
+  // Returns a block to the global pool, the block is freed to the
+  // underlying allocator if the pool is full.
+  void Spill(size_t size_class, DecoratedAllocationPtr block) {
+    block = global_pool.Push(size_class, std::move(block));
+    if (block) {
+      VLOG(10) << "Global CPU block pool is full, free block of "
+               << block->size() << " bytes";
+    }
+  }
+
+  std::shared_ptr<Allocator> underlying_allocator;
+  size_t thread_cache_capacity;
+  CPUBlockCache global_pool;
+};
+
+namespace {
+
+// Owns the per-thread caches of all ThreadLocalCPUCacheAllocator instances
+// used by a thread, and spills them to the global pool on thread exit.
+class ThreadCacheRegistry {
+ public:
+  template <typename SharedStatePtr>
+  std::shared_ptr<CPUBlockCache> Get(uint64_t allocator_id,
+                                     const SharedStatePtr& shared) {
+    auto it = entries_.find(allocator_id);
+    if (LIKELY(it != entries_.end())) {
+      return it->second.cache;
+    }
+    Entry entry;
+    entry.cache =
+        std::make_shared<CPUBlockCache>(shared->thread_cache_capacity);
+    entry.spill = [shared](CPUBlockCache* cache) {
+      for (auto& pair : cache->PopAll()) {
+        shared->Spill(pair.first, std::move(pair.second));
+      }
+    };
+    auto cache = entry.cache;
+    entries_.emplace(allocator_id, std::move(entry));
+    return cache;
+  }
+
+  ~ThreadCacheRegistry() {
+    for (auto& pair : entries_) {
+      pair.second.spill(pair.second.cache.get());
+    }
+  }
+
+ private:
+  struct Entry {
+    std::shared_ptr<CPUBlockCache> cache;
+    // Holds the shared state alive until the cache is spilled.
+    std::function<void(CPUBlockCache*)> spill;
+  };
+  std::unordered_map<uint64_t, Entry> entries_;
+};
+
+}  // namespace
+
+ThreadLocalCPUCacheAllocator::ThreadLocalCPUCacheAllocator(
+    std::shared_ptr<Allocator> underlying_allocator,
+    size_t thread_cache_capacity,
+    size_t global_pool_capacity)
+    : shared_(std::make_shared<SharedState>(std::move(underlying_allocator),
+                                            thread_cache_capacity,
+                                            global_pool_capacity)) {
+  static std::atomic<uint64_t> next_id{0};
+  id_ = next_id.fetch_add(1);
+  PADDLE_ENFORCE_NOT_NULL(
+      shared_->underlying_allocator,
+      common::errors::InvalidArgument(
+          "Underlying allocator of ThreadLocalCPUCacheAllocator is empty."));
+  VLOG(4) << "Create ThreadLocalCPUCacheAllocator with thread cache capacity "
+          << thread_cache_capacity << ", global pool capacity "
+          << global_pool_capacity;
+}
+
+std::shared_ptr<CPUBlockCache> ThreadLocalCPUCacheAllocator::GetThreadCache() {
+  static thread_local ThreadCacheRegistry registry;
+  return registry.Get(id_, shared_);
+}
+
+phi::Allocation* ThreadLocalCPUCacheAllocator::AllocateImpl(size_t size) {
+  if (size > CPUBlockCache::kMaxBlockSize) {
+    return shared_->underlying_allocator->Allocate(size).release();
+  }
+  size_t size_class = CPUBlockCache::SizeClass(size);
+  auto cache = GetThreadCache();
+  DecoratedAllocationPtr block = cache->Pop(size_class);
+  if (block == nullptr) {
+    block = shared_->global_pool.Pop(size_class);
+  }
+  if (block == nullptr) {
+    block = static_unique_ptr_cast<Allocation>(
+        shared_->underlying_allocator->Allocate(
+            CPUBlockCache::SizeClassBytes(size_class)));
+  }
+  return new ThreadLocalCPUCacheAllocation(
+      std::move(block), size_class, cache);
+}
+
+void ThreadLocalCPUCacheAllocator::FreeImpl(phi::Allocation* allocation) {
+  if (allocation->size() > CPUBlockCache::kMaxBlockSize) {
+    // Served by the underlying allocator directly, which is on the top of
+    // the decorated allocator chain now.
+    Allocator::AllocationDeleter(allocation);
+    return;
+  }
+  auto* tl_allocation = static_cast<ThreadLocalCPUCacheAllocation*>(allocation);
+  size_t size_class = tl_allocation->SizeClass();
+  DecoratedAllocationPtr block = tl_allocation->TakeUnderlyingAllocation();
+  auto owner = tl_allocation->Owner();
+  delete tl_allocation;
+
+  if (owner != nullptr) {
+    block = owner->Push(size_class, std::move(block));
+  }
+  if (block != nullptr) {
+    shared_->Spill(size_class, std::move(block));
+  }
+}
+
+uint64_t ThreadLocalCPUCacheAllocator::ReleaseImpl(const phi::Place& place) {
+  uint64_t released = 0;
+  for (auto& pair : GetThreadCache()->PopAll()) {
+    released += pair.second->size();
+  }
+  for (auto& pair : shared_->global_pool.PopAll()) {
+    released += pair.second->size();
+  }
+  return released + shared_->underlying_allocator->Release(place);
+}
+
+}  // namespace paddle::memory::allocation
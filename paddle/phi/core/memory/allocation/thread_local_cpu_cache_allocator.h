@@ -0,0 +1,104 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "paddle/phi/core/memory/allocation/allocator.h"
+#include "paddle/phi/core/memory/allocation/spin_lock.h"
+
+namespace paddle {
+namespace memory {
+namespace allocation {
+
+// Size-class bucketed cache of free blocks. Used both as the per-thread
+// cache and as the shared spill pool.
+class CPUBlockCache {
+ public:
+  // Size classes are powers of two in [kMinBlockSize, kMaxBlockSize].
+  static constexpr size_t kMinBlockSizeLog2 = 6;
+  static constexpr size_t kMaxBlockSizeLog2 = 20;
+  static constexpr size_t kMinBlockSize = 1UL << kMinBlockSizeLog2;
+  static constexpr size_t kMaxBlockSize = 1UL << kMaxBlockSizeLog2;
+  static constexpr size_t kNumSizeClasses =
+      kMaxBlockSizeLog2 - kMinBlockSizeLog2 + 1;
+
+  explicit CPUBlockCache(size_t capacity) : capacity_(capacity) {}
+
+  // Returns the size class of `size`, `size` must not exceed kMaxBlockSize.
+  static size_t SizeClass(size_t size);
+  static size_t SizeClassBytes(size_t size_class) {
+    return kMinBlockSize << size_class;
+  }
+
+  // Pop a cached block of `size_class`, returns nullptr on miss.
+  DecoratedAllocationPtr Pop(size_t size_class);
+
+  // Push a free block, returns the block back if the cache is full.
+  DecoratedAllocationPtr Push(size_t size_class, DecoratedAllocationPtr block);
+
+  // Move all cached blocks out of the cache, paired with their size class.
+  std::vector<std::pair<size_t, DecoratedAllocationPtr>> PopAll();
+
+  size_t CachedBytes() const { return cached_bytes_; }
+
+ private:
+  SpinLock spinlock_;
+  std::array<std::vector<DecoratedAllocationPtr>, kNumSizeClasses> buckets_;
+  size_t cached_bytes_{0};
+  size_t capacity_;
+};
+
+class ThreadLocalCPUCacheAllocation;
+
+// Allocator which puts a per-thread, size-class bucketed cache in front of
+// the CPU allocator.
+//
+// Small requests (no larger than CPUBlockCache::kMaxBlockSize) are rounded
+// up to a power of two and served from the cache of the calling thread
+// without touching the lock of the underlying allocator. A freed block
+// returns to the cache of the thread that allocated it. When that cache
+// is full, the block spills to a bounded pool shared by all threads, and
+// only when the pool is full as well is it freed to the underlying
+// allocator. The cache of an exiting thread is spilled the same way.
+class ThreadLocalCPUCacheAllocator : public Allocator {
+ public:
+  ThreadLocalCPUCacheAllocator(std::shared_ptr<Allocator> underlying_allocator,
+                               size_t thread_cache_capacity,
+                               size_t global_pool_capacity);
+
+  bool IsAllocThreadSafe() const override { return true; }
+
+ protected:
+  phi::Allocation* AllocateImpl(size_t size) override;
+  void FreeImpl(phi::Allocation* allocation) override;
+  uint64_t ReleaseImpl(const phi::Place& place) override;
+
+ private:
+  struct SharedState;
+
+  std::shared_ptr<CPUBlockCache> GetThreadCache();
+
+  std::shared_ptr<SharedState> shared_;
+  uint64_t id_;
+};
+
+}  // namespace allocation
+}  // namespace memory
+}  // namespace paddle
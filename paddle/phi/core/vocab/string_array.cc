@@ -16,11 +16,45 @@
 #include <utf8proc.h>
 #include <exception>
 #include "glog/logging.h"
+#include "paddle/phi/core/vocab/vocab_trie.h"
 
 namespace phi {
 
 std::wstring_convert<std::codecvt_utf8<wchar_t>> kConverter;
 
+std::shared_ptr<const WordPieceTrie> Vocab::wordpiece_trie() const {
+  auto trie = std::atomic_load(&trie_);
+  if (trie) {
+    return trie;
+  }
+  std::vector<std::pair<std::string, int32_t>> tokens;
+  std::vector<std::pair<std::string, int32_t>> continuations;
+  tokens.reserve(data_.size());
+  for (const auto& item : data_) {
+    std::string token;
+    bool valid = true;
+    for (wchar_t ch : item.first) {
+      valid = valid && AppendUtf8(static_cast<char32_t>(ch), &token);
+    }
+    if (!valid) {
+      VLOG(3) << "The token with id " << item.second
+              << " is not valid unicode and is ignored by WordPiece.";
+      continue;
+    }
+    if (token.size() > 2 && token.compare(0, 2, "##") == 0) {
+      continuations.emplace_back(token.substr(2), item.second);
+    }
+    tokens.emplace_back(std::move(token), item.second);
+  }
+  auto built = std::make_shared<WordPieceTrie>();
+  built->word_start.Build(std::move(tokens));
+  built->continuation.Build(std::move(continuations));
+  trie = built;
+  // concurrent callers may build it at the same time, which is harmless
+  std::atomic_store(&trie_, trie);
+  return trie;
+}
+
 // Convert the std::string type to the std::wstring type.
 bool ConvertStrToWstr(const std::string& src, std::wstring* res) {
   try {
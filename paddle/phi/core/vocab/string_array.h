@@ -17,6 +17,7 @@
 #include <codecvt>
 #include <iostream>
 #include <locale>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -30,6 +31,8 @@ struct PhiVectorType<std::string> {
   const char* type_name = "PhiVectorString";
 };
 
+struct WordPieceTrie;
+
 // Note(YuanRisheng): Vocab is mainly used for faster_tokenizer_op and we don't
 // recommend widely use it. Because faster_tokenizer_op may be deleted in the
 // future and this class will be deleted.
@@ -50,6 +53,7 @@ class Vocab : public phi::ExtendedTensor,
   Vocab& operator=(
       const std::unordered_map<std::wstring, std::int32_t>& other) {
     this->data_ = other;
+    ResetTrie();
     return *this;
   }
 
@@ -63,10 +67,14 @@ class Vocab : public phi::ExtendedTensor,
 
   size_t size() const { return data_.size(); }
 
-  void clear() { data_.clear(); }
+  void clear() {
+    data_.clear();
+    ResetTrie();
+  }
 
   void emplace(const std::wstring& key, std::int32_t value) {
     data_.emplace(key, value);
+    ResetTrie();
   }
 
   std::int32_t at(const std::wstring& key) { return data_.at(key); }
@@ -75,6 +83,7 @@ class Vocab : public phi::ExtendedTensor,
 
   std::unordered_map<std::wstring, std::int32_t>::iterator find(
       const std::wstring& key) {
+    ResetTrie();
     return data_.find(key);
   }
 
@@ -84,6 +93,7 @@ class Vocab : public phi::ExtendedTensor,
   }
 
   std::unordered_map<std::wstring, std::int32_t>::iterator begin() {
+    ResetTrie();
     return data_.begin();
   }
 
@@ -92,6 +102,7 @@ class Vocab : public phi::ExtendedTensor,
   }
 
   std::unordered_map<std::wstring, std::int32_t>::iterator end() {
+    ResetTrie();
     return data_.end();
   }
 
@@ -99,8 +110,17 @@ class Vocab : public phi::ExtendedTensor,
     return data_.end();
   }
 
+  /// \brief Returns the vocab compiled into tries for WordPiece, which is
+  /// built at the first call and rebuilt after the vocab is modified.
+  std::shared_ptr<const WordPieceTrie> wordpiece_trie() const;
+
  private:
+  void ResetTrie() {
+    std::atomic_store(&trie_, std::shared_ptr<const WordPieceTrie>());
+  }
+
   std::unordered_map<std::wstring, std::int32_t> data_;
+  mutable std::shared_ptr<const WordPieceTrie> trie_;
 };
 
 // Note(YuanRisheng): PhiVector is essentially a vector that only used for PHI
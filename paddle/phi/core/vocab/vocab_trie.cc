@@ -0,0 +1,190 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/vocab/vocab_trie.h"
+
+#include <algorithm>
+
+namespace phi {
+
+// Places the nodes of the sorted keys depth first. The free units are kept
+// in a doubly-linked list, so the search of a base only visits the units
+// where the first child fits.
+class DoubleArrayTrieBuilder {
+ public:
+  using Key = std::pair<std::string, int32_t>;
+
+  explicit DoubleArrayTrieBuilder(std::vector<DoubleArrayTrie::Unit>* units)
+      : units_(units) {}
+
+  void Build(const std::vector<Key>& keys) {
+    units_->clear();
+    next_free_.clear();
+    prev_free_.clear();
+    head_ = -1;
+    tail_ = -1;
+    Grow(256);
+    Use(0, 0);
+    if (!keys.empty()) {
+      Insert(0, keys, 0, keys.size(), 0);
+    }
+    units_->shrink_to_fit();
+  }
+
+ private:
+  // Places the children of node, which are the bytes at depth of the keys
+  // [begin, end), and then their subtries.
+  void Insert(uint32_t node,
+              const std::vector<Key>& keys,
+              size_t begin,
+              size_t end,
+              size_t depth) {
+    if (keys[begin].first.size() == depth) {
+      (*units_)[node].terminal = true;
+      (*units_)[node].value = keys[begin].second;
+      ++begin;
+    }
+    if (begin == end) {
+      return;
+    }
+
+    // the distinct bytes and where their keys start
+    std::vector<std::pair<uint8_t, size_t>> children;
+    for (size_t i = begin; i < end; ++i) {
+      uint8_t c = static_cast<uint8_t>(keys[i].first[depth]);
+      if (children.empty() || children.back().first != c) {
+        children.emplace_back(c, i);
+      }
+    }
+
+    const int32_t first = children[0].first + 1;
+    int32_t base = 0;
+    int32_t unit = head_;
+    while (true) {
+      if (unit < 0) {
+        unit = static_cast<int32_t>(units_->size());
+        Grow(units_->size() + 256);
+      }
+      if (unit >= first) {
+        base = unit - first;
+        bool fits = true;
+        for (size_t i = 1; i < children.size(); ++i) {
+          size_t child = base + children[i].first + 1;
+          if (child < units_->size() && (*units_)[child].check >= 0) {
+            fits = false;
+            break;
+          }
+        }
+        if (fits) {
+          break;
+        }
+      }
+      unit = next_free_[unit];
+    }
+    size_t last = base + children.back().first + 1;
+    if (last >= units_->size()) {
+      Grow(last + 1);
+    }
+    (*units_)[node].base = base;
+    for (auto& child : children) {
+      Use(base + child.first + 1, static_cast<int32_t>(node));
+    }
+
+    for (size_t i = 0; i < children.size(); ++i) {
+      size_t child_end = i + 1 < children.size() ? children[i + 1].second : end;
+      Insert(static_cast<uint32_t>(base + children[i].first + 1),
+             keys,
+             children[i].second,
+             child_end,
+             depth + 1);
+    }
+  }
+
+  // Appends free units up to size.
+  void Grow(size_t size) {
+    size_t old_size = units_->size();
+    units_->resize(size);
+    next_free_.resize(size, -1);
+    prev_free_.resize(size, -1);
+    for (size_t i = old_size; i < size; ++i) {
+      int32_t unit = static_cast<int32_t>(i);
+      prev_free_[unit] = tail_;
+      if (tail_ >= 0) {
+        next_free_[tail_] = unit;
+      } else {
+        head_ = unit;
+      }
+      tail_ = unit;
+    }
+  }
+
+  void Use(size_t unit, int32_t parent) {
+    (*units_)[unit].check = parent;
+    int32_t prev = prev_free_[unit];
+    int32_t next = next_free_[unit];
+    if (prev >= 0) {
+      next_free_[prev] = next;
+    } else {
+      head_ = next;
+    }
+    if (next >= 0) {
+      prev_free_[next] = prev;
+    } else {
+      tail_ = prev;
+    }
+  }
+
+  std::vector<DoubleArrayTrie::Unit>* units_;
+  std::vector<int32_t> next_free_;
+  std::vector<int32_t> prev_free_;
+  int32_t head_{-1};
+  int32_t tail_{-1};
+};
+
+void DoubleArrayTrie::Build(std::vector<std::pair<std::string, int32_t>> keys) {
+  keys.erase(std::remove_if(keys.begin(),
+                            keys.end(),
+                            [](const std::pair<std::string, int32_t>& key) {
+                              return key.first.empty();
+                            }),
+             keys.end());
+  std::sort(keys.begin(), keys.end());
+  DoubleArrayTrieBuilder(&units_).Build(keys);
+}
+
+bool AppendUtf8(char32_t ch, std::string* out) {
+  if (ch < 0x80) {
+    out->push_back(static_cast<char>(ch));
+  } else if (ch < 0x800) {
+    out->push_back(static_cast<char>(0xC0 | (ch >> 6)));
+    out->push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+  } else if (ch < 0x10000) {
+    if (ch >= 0xD800 && ch <= 0xDFFF) {
+      return false;
+    }
+    out->push_back(static_cast<char>(0xE0 | (ch >> 12)));
+    out->push_back(static_cast<char>(0x80 | ((ch >> 6) & 0x3F)));
+    out->push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+  } else if (ch <= 0x10FFFF) {
+    out->push_back(static_cast<char>(0xF0 | (ch >> 18)));
+    out->push_back(static_cast<char>(0x80 | ((ch >> 12) & 0x3F)));
+    out->push_back(static_cast<char>(0x80 | ((ch >> 6) & 0x3F)));
+    out->push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+  } else {
+    return false;
+  }
+  return true;
+}
+
+}  // namespace phi
@@ -0,0 +1,147 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phi {
+
+// A static double-array trie over bytes. The child of the node s for the byte
+// c is the unit t = base[s] + c + 1 if check[t] == s, so a lookup costs one
+// array access per byte and allocates nothing.
+class DoubleArrayTrie {
+ public:
+  DoubleArrayTrie() = default;
+
+  // Builds the trie from the keys, which must be unique. Empty keys are
+  // ignored.
+  void Build(std::vector<std::pair<std::string, int32_t>> keys);
+
+  // Finds the longest key which is a prefix of [begin, end), returns its
+  // length in bytes and writes its value to *value, or returns 0.
+  size_t LongestPrefix(const char* begin,
+                       const char* end,
+                       int32_t* value) const {
+    if (units_.empty()) {
+      return 0;
+    }
+    size_t match = 0;
+    uint32_t node = 0;
+    for (const char* p = begin; p < end; ++p) {
+      uint32_t next = static_cast<uint32_t>(units_[node].base) +
+                      static_cast<uint8_t>(*p) + 1;
+      if (next >= units_.size() ||
+          units_[next].check != static_cast<int32_t>(node)) {
+        break;
+      }
+      node = next;
+      if (units_[node].terminal) {
+        match = static_cast<size_t>(p - begin) + 1;
+        *value = units_[node].value;
+      }
+    }
+    return match;
+  }
+
+  // Finds the key which is exactly [begin, end).
+  bool Find(const char* begin, const char* end, int32_t* value) const {
+    int32_t found = 0;
+    if (LongestPrefix(begin, end, &found) !=
+        static_cast<size_t>(end - begin)) {
+      return false;
+    }
+    *value = found;
+    return begin != end;
+  }
+
+  size_t num_units() const { return units_.size(); }
+
+ private:
+  friend class DoubleArrayTrieBuilder;
+
+  struct Unit {
+    int32_t base{0};
+    int32_t check{-1};
+    int32_t value{0};
+    bool terminal{false};
+  };
+
+  std::vector<Unit> units_;
+};
+
+// The vocab of WordPiece compiled into two tries over the UTF-8 bytes of the
+// tokens, one of all the tokens, which can start a word, and one of the
+// continuations, which are the tokens starting with "##" with it stripped.
+struct WordPieceTrie {
+  DoubleArrayTrie word_start;
+  DoubleArrayTrie continuation;
+};
+
+// Appends the UTF-8 encoding of a code point, returns false if it is not a
+// valid code point.
+bool AppendUtf8(char32_t ch, std::string* out);
+
+// Decodes the code point at *p and advances *p, returns false if the bytes
+// are not valid UTF-8.
+inline bool DecodeUtf8(const char** p, const char* end, char32_t* ch) {
+  const uint8_t* s = reinterpret_cast<const uint8_t*>(*p);
+  size_t left = static_cast<size_t>(end - *p);
+  if (left == 0) {
+    return false;
+  }
+  uint8_t lead = s[0];
+  if (lead < 0x80) {
+    *ch = lead;
+    *p += 1;
+    return true;
+  }
+  size_t len;
+  char32_t min;
+  if ((lead & 0xE0) == 0xC0) {
+    len = 2;
+    min = 0x80;
+    *ch = lead & 0x1F;
+  } else if ((lead & 0xF0) == 0xE0) {
+    len = 3;
+    min = 0x800;
+    *ch = lead & 0x0F;
+  } else if ((lead & 0xF8) == 0xF0) {
+    len = 4;
+    min = 0x10000;
+    *ch = lead & 0x07;
+  } else {
+    return false;
+  }
+  if (left < len) {
+    return false;
+  }
+  for (size_t i = 1; i < len; ++i) {
+    if ((s[i] & 0xC0) != 0x80) {
+      return false;
+    }
+    *ch = (*ch << 6) | (s[i] & 0x3F);
+  }
+  if (*ch < min || *ch > 0x10FFFF || (*ch >= 0xD800 && *ch <= 0xDFFF)) {
+    return false;
+  }
+  *p += len;
+  return true;
+}
+
+}  // namespace phi
@@ -17,6 +17,7 @@ limitations under the License. */
 #include "paddle/phi/backends/cpu/cpu_context.h"
 #include "paddle/phi/core/kernel_registry.h"
 #include "paddle/phi/kernels/funcs/activation_functor.h"
+#include "paddle/phi/kernels/funcs/cpu_vec_math.h"
 #include "paddle/phi/kernels/impl/activation_impl.h"
 
 namespace phi {
@@ -42,6 +43,24 @@ namespace phi {
         dev_ctx, x, out, functor);                                         \
   }
 
+// float, float16 and bfloat16 are computed by CPUVecMath, the integers are
+// computed in float by Eigen.
+#define DEFINE_CPU_VEC_MATH_ACTIVATION_KERNEL(name, functor_class, op)       \
+  template <typename T, typename Context>                                    \
+  void name##Kernel(                                                         \
+      const Context& dev_ctx, const DenseTensor& x, DenseTensor* out) {      \
+    if constexpr (funcs::IsCPUVecMathType<T>::value) {                       \
+      dev_ctx.template Alloc<T>(out);                                        \
+      funcs::CPUVecMath(op, x.data<T>(), out->data<T>(), x.numel());         \
+    } else {                                                                 \
+      funcs::functor_class<T> functor;                                       \
+      using U =                                                              \
+          typename std::conditional_t<std::is_integral<T>::value, float, T>; \
+      ActivationImpl<T, U, Context, funcs::functor_class<T>>(                \
+          dev_ctx, x, out, functor);                                         \
+    }                                                                        \
+  }
+
 #define DEFINE_CPU_ACT_KERNEL_WITH_ONE_ATTRS(name, functor_class, attr) \
   template <typename T, typename Context>                               \
   void name##Kernel(const Context& dev_ctx,                             \
@@ -83,25 +102,35 @@ DEFINE_CPU_ACTIVATION_KERNEL(Asinh, AsinhFunctor)
 DEFINE_CPU_ACTIVATION_KERNEL(Acosh, AcoshFunctor)
 DEFINE_CPU_ACTIVATION_KERNEL(Atanh, AtanhFunctor)
 DEFINE_CPU_ACTIVATION_KERNEL(Relu, ReluCPUFunctor)
-DEFINE_CPU_ACTIVATION_KERNEL(Tanh, TanhFunctor)
+DEFINE_CPU_VEC_MATH_ACTIVATION_KERNEL(Tanh,
+                                      TanhFunctor,
+                                      funcs::CPUVecMathOp::kTanh)
 DEFINE_CPU_ACTIVATION_KERNEL(TanhShrink, TanhShrinkFunctor)
-DEFINE_CPU_ACTIVATION_KERNEL(Silu, SiluFunctor)
+DEFINE_CPU_VEC_MATH_ACTIVATION_KERNEL(Silu,
+                                      SiluFunctor,
+                                      funcs::CPUVecMathOp::kSilu)
 DEFINE_CPU_ACTIVATION_KERNEL(Reciprocal, ReciprocalFunctor)
 DEFINE_CPU_ACTIVATION_KERNEL(Square, SquareFunctor)
 DEFINE_CPU_ACTIVATION_KERNEL(Sqrt, SqrtFunctor)
 DEFINE_CPU_ACTIVATION_KERNEL(Rsqrt, RsqrtFunctor)
 DEFINE_CPU_ACTIVATION_KERNEL(Softsign, SoftsignFunctor)
-DEFINE_CPU_ACTIVATION_KERNEL(Sigmoid, SigmoidFunctor)
+DEFINE_CPU_VEC_MATH_ACTIVATION_KERNEL(Sigmoid,
+                                      SigmoidFunctor,
+                                      funcs::CPUVecMathOp::kSigmoid)
 DEFINE_CPU_ACTIVATION_KERNEL(LogSigmoid, LogSigmoidFunctor)
 DEFINE_CPU_ACTIVATION_KERNEL(Floor, FloorFunctor)
 DEFINE_CPU_ACTIVATION_KERNEL(Ceil, CeilFunctor)
 DEFINE_CPU_ACTIVATION_KERNEL(Negative, NegativeFunctor)
 
-DEFINE_CPU_ACTIVATION_KERNEL_WITH_INT_IN_FLOAT_OUT(Log, LogFunctor)
+DEFINE_CPU_VEC_MATH_ACTIVATION_KERNEL(Log,
+                                      LogFunctor,
+                                      funcs::CPUVecMathOp::kLog)
 DEFINE_CPU_ACTIVATION_KERNEL_WITH_INT_IN_FLOAT_OUT(Log2, Log2Functor)
 DEFINE_CPU_ACTIVATION_KERNEL_WITH_INT_IN_FLOAT_OUT(Log10, Log10Functor)
 DEFINE_CPU_ACTIVATION_KERNEL_WITH_INT_IN_FLOAT_OUT(Log1p, Log1pFunctor)
-DEFINE_CPU_ACTIVATION_KERNEL_WITH_INT_IN_FLOAT_OUT(Exp, ExpFunctor)
+DEFINE_CPU_VEC_MATH_ACTIVATION_KERNEL(Exp,
+                                      ExpFunctor,
+                                      funcs::CPUVecMathOp::kExp)
 DEFINE_CPU_ACTIVATION_KERNEL_WITH_INT_IN_FLOAT_OUT(Expm1, Expm1Functor)
 
 DEFINE_CPU_ACT_KERNEL_WITH_ONE_ATTRS(LeakyRelu, LeakyReluFunctor, alpha)
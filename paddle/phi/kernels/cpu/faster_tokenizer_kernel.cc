@@ -14,6 +14,7 @@
 
 #include <utf8proc.h>
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -22,6 +23,7 @@
 #include "paddle/phi/core/kernel_registry.h"
 #include "paddle/phi/core/tensor_utils.h"
 #include "paddle/phi/core/vocab/string_array.h"
+#include "paddle/phi/core/vocab/vocab_trie.h"
 
 namespace phi {
 
@@ -37,32 +39,55 @@ using std::vector;
 using std::wcout;
 using std::wstring;
 
-inline bool IsControl(const wchar_t& ch);
-inline bool IsChineseChar(const wchar_t& ch);
-inline bool IsWhiteSpace(const wchar_t& ch);
+inline bool IsControl(char32_t ch);
+inline bool IsChineseChar(char32_t ch);
+inline bool IsWhiteSpace(char32_t ch);
 
 using InvVocab = unordered_map<int, wstring>;
 
+// The scratch buffers of tokenizing one text, which are reused by the texts
+// tokenized by the same thread.
+struct TokenizerWorkspace {
+  // the text after dropping the control characters and lower casing
+  string normalized;
+  // the [begin, end) byte offsets of the words in normalized
+  vector<std::pair<size_t, size_t>> words;
+  vector<int64_t> ids;
+  vector<int64_t> pair_ids;
+};
+
+struct EncodedInputs {
+  vector<int64_t> input_ids;
+  vector<int64_t> token_type_ids;
+};
+
 class BasicTokenizer {
  public:
   explicit BasicTokenizer(bool do_lower_case = true);
-  void Tokenize(const string& text, vector<wstring>* res) const;
+  // Splits the UTF-8 text into words on whitespace, punctuation and Chinese
+  // characters, returns false if the text is not valid UTF-8.
+  bool Tokenize(const string& text, TokenizerWorkspace* workspace) const;
 
  private:
-  wchar_t do_lower_case(wchar_t ch) const;
+  char32_t do_lower_case(char32_t ch) const;
 
   bool do_lower_case_;
 };
 
+// Greedy longest-match-first WordPiece on the UTF-8 bytes of a word, using
+// the tries compiled from the vocab.
 class WordPieceTokenizer {
  public:
   explicit WordPieceTokenizer(const phi::Vocab* vocab,
                               const wstring& unk_token = L"[UNK]",
                               const size_t max_input_chars_per_word = 100);
-  void Tokenize(const wstring& text, vector<int64_t>* output) const;
+  void Tokenize(const char* begin,
+                const char* end,
+                vector<int64_t>* output) const;
 
  private:
   const phi::Vocab* vocab_;
+  std::shared_ptr<const WordPieceTrie> trie_;
   wstring unk_token_{L"[UNK]"};
   int64_t unk_token_id_;
   size_t max_input_chars_per_word_;
@@ -79,7 +104,9 @@ class BertTokenizer {
                          const wstring& sep_token = L"[SEP]",
                          const string& padding_site = "right");
 
-  void Tokenize(const string& text, vector<int64_t>* split_tokens) const;
+  void Tokenize(const string& text,
+                TokenizerWorkspace* workspace,
+                vector<int64_t>* split_tokens) const;
   void BuildInputsWithSpecialTokens(
       vector<int64_t>* res,
       const vector<int64_t>& token_ids_0,
@@ -93,19 +120,19 @@ class BertTokenizer {
                         const size_t num_tokens_to_remove = 0,
                         const size_t stride = 0) const;
   int64_t GetNumSpecialTokensToAdd(const bool pair = false) const;
-  int Encode(unordered_map<string, vector<int64_t>>* encoded_inputs,
+  int Encode(EncodedInputs* encoded_inputs,
+             TokenizerWorkspace* workspace,
              const string& text,
              const string& text_pair = "",
              bool is_split_into_words = false,
              const size_t max_seq_len = 0,
              bool pad_to_max_seq_len = false) const;
-  void BatchEncode(
-      vector<unordered_map<string, vector<int64_t>>>* batch_encode_inputs,
-      const Strings& batch_text,
-      const Strings& batch_text_pair = Strings(),
-      bool is_split_into_words = false,
-      const size_t max_seq_len = 0,
-      bool pad_to_max_seq_len = false) const;
+  void BatchEncode(vector<EncodedInputs>* batch_encode_inputs,
+                   const Strings& batch_text,
+                   const Strings& batch_text_pair = Strings(),
+                   bool is_split_into_words = false,
+                   const size_t max_seq_len = 0,
+                   bool pad_to_max_seq_len = false) const;
 
   int64_t GetPadTokenID() const;
 
@@ -125,14 +152,14 @@ class BertTokenizer {
 
 const wstring kStripChars = L" \t\n\r\v\f";
 
-inline bool IsControl(const wchar_t& ch) {
-  if (ch == L'\t' || ch == L'\n' || ch == L'\r') return false;
+inline bool IsControl(char32_t ch) {
+  if (ch == U'\t' || ch == U'\n' || ch == U'\r') return false;
   auto cat = utf8proc_category(ch);
   if (cat == UTF8PROC_CATEGORY_CC || cat == UTF8PROC_CATEGORY_CF) return true;
   return false;
 }
 
-inline bool IsChineseChar(const wchar_t& ch) {
+inline bool IsChineseChar(char32_t ch) {
   if ((ch >= 0x4E00 && ch <= 0x9FFF) || (ch >= 0x3400 && ch <= 0x4DBF) ||
       (ch >= 0x20000 && ch <= 0x2A6DF) || (ch >= 0x2A700 && ch <= 0x2B73F) ||
       (ch >= 0x2B740 && ch <= 0x2B81F) || (ch >= 0x2B820 && ch <= 0x2CEAF) ||
@@ -141,14 +168,14 @@ inline bool IsChineseChar(const wchar_t& ch) {
   return false;
 }
 
-inline bool IsWhiteSpace(const wchar_t& ch) {
-  if (ch == L' ' || ch == L'\t' || ch == L'\n' || ch == L'\r') return true;
+inline bool IsWhiteSpace(char32_t ch) {
+  if (ch == U' ' || ch == U'\t' || ch == U'\n' || ch == U'\r') return true;
   auto cat = utf8proc_category(ch);
   if (cat == UTF8PROC_CATEGORY_ZS) return true;
   return false;
 }
 
-inline bool IsPunctuation(const wchar_t& ch) {
+inline bool IsPunctuation(char32_t ch) {
   if ((ch >= 33 && ch <= 47) || (ch >= 58 && ch <= 64) ||
       (ch >= 91 && ch <= 96) || (ch >= 123 && ch <= 126))
     return true;
@@ -164,26 +191,35 @@ inline bool IsPunctuation(const wchar_t& ch) {
 BasicTokenizer::BasicTokenizer(bool do_lower_case /* = true */)
     : do_lower_case_(do_lower_case) {}
 
-wchar_t BasicTokenizer::do_lower_case(wchar_t ch) const {
-  wchar_t new_ch = utf8proc_tolower(ch);
+char32_t BasicTokenizer::do_lower_case(char32_t ch) const {
+  char32_t new_ch = utf8proc_tolower(ch);
   return new_ch;
 }
 
-void BasicTokenizer::Tokenize(const string& text, vector<wstring>* res) const {
-  std::wstring unicode_text;
-  bool status = phi::ConvertStrToWstr(text, &unicode_text);
-  if (!status) {
-    // String is converted into wstring failedly.
-    return;
-  }
-  std::wstring cache_text = L"";
-  auto PushCacheText = [&]() {
-    if (!cache_text.empty()) {
-      res->emplace_back(cache_text);
-      cache_text = L"";
+bool BasicTokenizer::Tokenize(const string& text,
+                              TokenizerWorkspace* workspace) const {
+  string& normalized = workspace->normalized;
+  auto& words = workspace->words;
+  normalized.clear();
+  words.clear();
+  size_t word_begin = 0;
+  auto PushWord = [&]() {
+    if (normalized.size() > word_begin) {
+      words.emplace_back(word_begin, normalized.size());
     }
+    word_begin = normalized.size();
   };
-  for (auto& ch : unicode_text) {
+  const char* p = text.data();
+  const char* end = p + text.size();
+  while (p < end) {
+    char32_t ch;
+    if (!DecodeUtf8(&p, end, &ch)) {
+      // String is converted into unicode failedly.
+      VLOG(3) << "The string " << text
+              << " was converted to unicode failedly! ";
+      words.clear();
+      return false;
+    }
     if (ch == 0 || ch == 0xfffd || IsControl(ch)) {
       continue;
     }
@@ -191,15 +227,17 @@ void BasicTokenizer::Tokenize(const string& text, vector<wstring>* res) const {
       ch = do_lower_case(ch);
     }
     if (IsChineseChar(ch) || IsPunctuation(ch)) {
-      PushCacheText();
-      res->emplace_back(std::wstring{ch});
+      PushWord();
+      AppendUtf8(ch, &normalized);
+      PushWord();
     } else if (IsWhiteSpace(ch)) {
-      PushCacheText();
+      PushWord();
     } else {
-      cache_text += ch;
+      AppendUtf8(ch, &normalized);
     }
   }
-  PushCacheText();
+  PushWord();
+  return true;
 }
 
 WordPieceTokenizer::WordPieceTokenizer(
@@ -207,55 +245,38 @@ WordPieceTokenizer::WordPieceTokenizer(
     const wstring& unk_token /* = L"[UNK]"*/,
     const size_t max_input_chars_per_word /* = 100 */)
     : vocab_(vocab),
+      trie_(vocab->wordpiece_trie()),
       unk_token_(unk_token),
       max_input_chars_per_word_(max_input_chars_per_word) {
   unk_token_id_ = vocab_->at(unk_token_);
 }
 
-void WordPieceTokenizer::Tokenize(const wstring& text,
+void WordPieceTokenizer::Tokenize(const char* begin,
+                                  const char* end,
                                   vector<int64_t>* token_ids) const {
-  size_t len = text.size();
+  size_t len = 0;
+  for (const char* p = begin; p < end; ++p) {
+    len += (static_cast<uint8_t>(*p) & 0xC0) != 0x80;
+  }
   if (len > max_input_chars_per_word_) {
     token_ids->emplace_back(unk_token_id_);
     return;
   }
 
-  auto it = vocab_->find(text);
-  if (it != vocab_->end()) {
-    token_ids->emplace_back(it->second);
-    return;
-  }
-
-  size_t start = 0;
-  vector<int64_t> wordpiece_ids;
-  while (start < len) {
-    size_t end = len;
-    std::wstring cur_substr;
-    int64_t cur_substr_id = 0;
-    while (start < end) {
-      std::wstring sub = text.substr(start, end - start);
-      if (start > 0) {
-        sub.insert(0, L"##");
-      }
-      auto it = vocab_->find(sub);
-      if (it != vocab_->end()) {
-        cur_substr = sub;
-        cur_substr_id = it->second;
-        break;
-      }
-      end -= 1;
-    }
-
-    if (cur_substr.empty()) {
+  size_t num_tokens = token_ids->size();
+  const char* start = begin;
+  while (start < end) {
+    int32_t id = 0;
+    size_t match =
+        start == begin ? trie_->word_start.LongestPrefix(start, end, &id)
+                       : trie_->continuation.LongestPrefix(start, end, &id);
+    if (match == 0) {
+      token_ids->resize(num_tokens);
       token_ids->emplace_back(unk_token_id_);
       return;
-    } else {
-      start = end;
-      wordpiece_ids.emplace_back(cur_substr_id);
     }
-  }
-  for (auto& token_id : wordpiece_ids) {
-    token_ids->emplace_back(token_id);
+    token_ids->emplace_back(id);
+    start += match;
   }
 }
 
@@ -293,29 +314,13 @@ BertTokenizer::BertTokenizer(const phi::Vocab* vocab,
 }
 
 void BertTokenizer::Tokenize(const string& text,
+                             TokenizerWorkspace* workspace,
                              vector<int64_t>* split_token_ids) const {
-  std::vector<std::wstring> tmp_tokens;
-  basic_tokenizer_.Tokenize(text, &tmp_tokens);
-  if (tmp_tokens.empty()) return;
-  split_token_ids->reserve(tmp_tokens.size());
-  for (auto& w_token : tmp_tokens) {
-    const auto& vec_size = w_token.size();
-    if (vec_size == 1) {
-      if (IsChineseChar(w_token[0])) {
-        auto vocab_it = vocab_->find(w_token);
-        if (vocab_it != vocab_->end()) {
-          split_token_ids->emplace_back(vocab_it->second);
-        } else {
-          split_token_ids->emplace_back(unk_token_id_);
-        }
-      } else {
-        word_piece_tokenizer_.Tokenize(w_token, split_token_ids);
-      }
-    } else if (vec_size > 1) {
-      word_piece_tokenizer_.Tokenize(w_token, split_token_ids);
-    } else {
-      continue;
-    }
+  if (!basic_tokenizer_.Tokenize(text, workspace)) return;
+  const char* normalized = workspace->normalized.data();
+  for (auto& word : workspace->words) {
+    word_piece_tokenizer_.Tokenize(
+        normalized + word.first, normalized + word.second, split_token_ids);
   }
 }
 
@@ -392,33 +397,37 @@ void BertTokenizer::TruncateSequence(
 
 int64_t BertTokenizer::GetPadTokenID() const { return pad_token_id_; }
 
-int BertTokenizer::Encode(
-    unordered_map<string, vector<int64_t>>* encoded_inputs,
-    const string& text,
-    const string& text_pair /* = "" */,
-    bool is_split_into_words /* = false */,
-    const size_t max_seq_len /* = 0 */,
-    bool pad_to_max_seq_len /* = false */) const {
-  vector<int64_t> ids;
-  vector<int64_t> pair_ids;
+int BertTokenizer::Encode(EncodedInputs* encoded_inputs,
+                          TokenizerWorkspace* workspace,
+                          const string& text,
+                          const string& text_pair /* = "" */,
+                          bool is_split_into_words /* = false */,
+                          const size_t max_seq_len /* = 0 */,
+                          bool pad_to_max_seq_len /* = false */) const {
+  vector<int64_t>& ids = workspace->ids;
+  vector<int64_t>& pair_ids = workspace->pair_ids;
+  ids.clear();
+  pair_ids.clear();
   if (!is_split_into_words) {
-    Tokenize(text, &ids);
+    Tokenize(text, workspace, &ids);
     if (ids.empty()) return 0;
     if (!text_pair.empty()) {
-      Tokenize(text_pair, &pair_ids);
+      Tokenize(text_pair, workspace, &pair_ids);
       if (pair_ids.empty()) return 0;
     }
   } else {
-    std::wstring unicode_text;
-    bool status_a = phi::ConvertStrToWstr(text, &unicode_text);
-    if (!status_a) {
-      return 0;
-    }
-    for (size_t i = 0; i < unicode_text.size(); i++) {
-      wstring token = unicode_text.substr(i, 1);
-      auto it = vocab_->find(token);
-      if (it != vocab_->end()) {
-        ids.emplace_back(it->second);
+    const WordPieceTrie& trie = *vocab_->wordpiece_trie();
+    const char* p = text.data();
+    const char* end = p + text.size();
+    while (p < end) {
+      const char* char_begin = p;
+      char32_t ch;
+      if (!DecodeUtf8(&p, end, &ch)) {
+        return 0;
+      }
+      int32_t id = 0;
+      if (trie.word_start.Find(char_begin, p, &id)) {
+        ids.emplace_back(id);
       } else {
         ids.emplace_back(unk_token_id_);
       }
@@ -444,15 +453,11 @@ int BertTokenizer::Encode(
   }
 
   // Add special tokens
-  vector<int64_t> sequence;
-  BuildInputsWithSpecialTokens(&sequence, ids, pair_ids);
-  size_t seq_len = sequence.size();
-  vector<int64_t> token_type_ids;
-  CreateTokenTypeIdsFromSequences(&token_type_ids, ids, pair_ids);
+  BuildInputsWithSpecialTokens(&encoded_inputs->input_ids, ids, pair_ids);
+  size_t seq_len = encoded_inputs->input_ids.size();
+  CreateTokenTypeIdsFromSequences(
+      &encoded_inputs->token_type_ids, ids, pair_ids);
 
-  // Build output dictionary
-  encoded_inputs->emplace("input_ids", sequence);
-  encoded_inputs->emplace("token_type_ids", token_type_ids);
   // Check lengths
   if (max_seq_len > 0 && seq_len > max_seq_len) {
     VLOG(3) << "There is something wrong with the input sequence length."
@@ -468,23 +473,14 @@ int BertTokenizer::Encode(
   }
 
   if (needs_to_be_padded) {
-    int64_t difference = static_cast<int64_t>(max_seq_len - seq_len);
-    size_t pad_start = max_seq_len - 1 - difference;
-    encoded_inputs->at("token_type_ids").resize(max_seq_len);
-    for (size_t i = max_seq_len - 1; i > pad_start; i--) {
-      encoded_inputs->at("token_type_ids")[i] = pad_token_id_;
-    }
-
-    encoded_inputs->at("input_ids").resize(max_seq_len);
-    for (size_t i = max_seq_len - 1; i > pad_start; i--) {
-      encoded_inputs->at("input_ids")[i] = pad_token_id_;
-    }
+    encoded_inputs->token_type_ids.resize(max_seq_len, pad_token_id_);
+    encoded_inputs->input_ids.resize(max_seq_len, pad_token_id_);
   }
   return 1;
 }
 
 void BertTokenizer::BatchEncode(
-    vector<unordered_map<string, vector<int64_t>>>* batch_encode_inputs,
+    vector<EncodedInputs>* batch_encode_inputs,
     const Strings& batch_text,
     const Strings& batch_text_pair /* = vector<string>() */,
     bool is_split_into_words /* = false */,
@@ -495,38 +491,47 @@ void BertTokenizer::BatchEncode(
     has_text_pair = true;
   }
 
-  size_t batch_size = batch_text.size();
+  int64_t batch_size = static_cast<int64_t>(batch_text.size());
+  // the texts differ in length, so they are handed out dynamically, and
+  // every thread reuses its own workspace
 #ifdef PADDLE_WITH_MKLML
-#pragma omp parallel for
+#pragma omp parallel
 #endif
-  for (size_t i = 0; i < batch_size; i++) {
-    unordered_map<string, vector<int64_t>> res;
-    if (has_text_pair) {
-      auto status = Encode(&res,
-                           batch_text[i],
-                           batch_text_pair[i],
-                           is_split_into_words,
-                           max_seq_len,
-                           pad_to_max_seq_len);
-      if (!status) {
-        res["input_ids"] =
-            std::vector<int64_t>{cls_token_id_, sep_token_id_, cls_token_id_};
-        res["token_type_ids"] = std::vector<int64_t>{0, 0, 1};
-      }
-    } else {
-      auto status = Encode(&res,
-                           batch_text[i],
-                           {},
-                           is_split_into_words,
-                           max_seq_len,
-                           pad_to_max_seq_len);
-
-      if (!status) {
-        res["input_ids"] = std::vector<int64_t>{cls_token_id_, sep_token_id_};
-        res["token_type_ids"] = std::vector<int64_t>{0, 0};
+  {
+    TokenizerWorkspace workspace;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp for schedule(dynamic, 4)
+#endif
+    for (int64_t i = 0; i < batch_size; i++) {
+      EncodedInputs& res = batch_encode_inputs->at(i);
+      if (has_text_pair) {
+        auto status = Encode(&res,
+                             &workspace,
+                             batch_text[i],
+                             batch_text_pair[i],
+                             is_split_into_words,
+                             max_seq_len,
+                             pad_to_max_seq_len);
+        if (!status) {
+          res.input_ids = std::vector<int64_t>{
+              cls_token_id_, sep_token_id_, cls_token_id_};
+          res.token_type_ids = std::vector<int64_t>{0, 0, 1};
+        }
+      } else {
+        auto status = Encode(&res,
+                             &workspace,
+                             batch_text[i],
+                             {},
+                             is_split_into_words,
+                             max_seq_len,
+                             pad_to_max_seq_len);
+
+        if (!status) {
+          res.input_ids = std::vector<int64_t>{cls_token_id_, sep_token_id_};
+          res.token_type_ids = std::vector<int64_t>{0, 0};
+        }
       }
     }
-    batch_encode_inputs->at(i) = std::move(res);
   }
 }
 
@@ -556,8 +561,7 @@ void FasterTokenizerKernel(const Context& dev_ctx,
   size_t batch_max_seq_len = 0;
   size_t batch_size = text->size();
 
-  vector<unordered_map<string, vector<int64_t>>> batch_encode_inputs(
-      batch_size);
+  vector<EncodedInputs> batch_encode_inputs(batch_size);
   if (text_pair) {
     tokenizer.BatchEncode(&batch_encode_inputs,
                           *text,
@@ -575,7 +579,7 @@ void FasterTokenizerKernel(const Context& dev_ctx,
   }
 
   for (size_t i = 0; i < batch_size; ++i) {
-    size_t seq_len = batch_encode_inputs[i]["input_ids"].size();
+    size_t seq_len = batch_encode_inputs[i].input_ids.size();
     if (seq_len > batch_max_seq_len) {
       batch_max_seq_len = seq_len;
     }
@@ -591,8 +595,8 @@ void FasterTokenizerKernel(const Context& dev_ctx,
 
   auto pad_token_id = tokenizer.GetPadTokenID();
   for (size_t i = 0; i < batch_size; i++) {
-    auto& encoder_input_ids = batch_encode_inputs[i]["input_ids"];
-    auto& encoder_seg_ids = batch_encode_inputs[i]["token_type_ids"];
+    auto& encoder_input_ids = batch_encode_inputs[i].input_ids;
+    auto& encoder_seg_ids = batch_encode_inputs[i].token_type_ids;
     const size_t& seq_len = encoder_input_ids.size();
     // Copy the memory
     std::memcpy(input_ids_data + i * batch_max_seq_len,
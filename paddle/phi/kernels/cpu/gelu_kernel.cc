@@ -23,6 +23,7 @@
 #include "paddle/phi/core/kernel_registry.h"
 #include "paddle/phi/kernels/funcs/blas/blas.h"
 #include "paddle/phi/kernels/funcs/blas/blas_impl.h"
+#include "paddle/phi/kernels/funcs/cpu_vec_math.h"
 #include "paddle/phi/kernels/funcs/eigen/common.h"
 #include "paddle/phi/kernels/funcs/eigen/eigen_function.h"
 
@@ -93,6 +94,14 @@ void GeluKernel(const Context& dev_ctx,
                 bool approximate,
                 DenseTensor* out) {
   dev_ctx.template Alloc<T>(out);
+  if constexpr (funcs::IsCPUVecMathType<T>::value) {
+    funcs::CPUVecMath(approximate ? funcs::CPUVecMathOp::kGeluTanh
+                                  : funcs::CPUVecMathOp::kGelu,
+                      x.data<T>(),
+                      out->data<T>(),
+                      x.numel());
+    return;
+  }
   auto eigen_out = EigenVector<T>::Flatten(*out);
   auto eigen_x = EigenVector<T>::Flatten(x);
   auto& dev = *dev_ctx.eigen_device();
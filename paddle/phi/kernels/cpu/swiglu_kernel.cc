@@ -16,13 +16,13 @@
 #include "paddle/phi/backends/cpu/cpu_context.h"
 #include "paddle/phi/core/kernel_registry.h"
 #include "paddle/phi/kernels/funcs/activation_functor.h"
+#include "paddle/phi/kernels/funcs/cpu_vec_math.h"
 
 namespace phi {
 
 template <typename T, typename Context>
 void SwiGLUKernelImpl(
     const Context &ctx, const T *x, const T *y, T *z, int64_t m, int64_t n) {
-  funcs::SwiGLUFunctor<T> functor;
   int64_t stride;
   if (y) {
     stride = n;
@@ -31,6 +31,24 @@ void SwiGLUKernelImpl(
     y = x + n;
   }
 
+  if constexpr (funcs::IsCPUVecMathType<T>::value) {
+    // z = silu(x) * y, the rows of x are contiguous unless x holds y as well
+    if (stride == n) {
+      funcs::CPUVecMathMul(funcs::CPUVecMathOp::kSilu, x, y, z, m * n);
+    } else {
+      for (int64_t i = 0; i < m; ++i) {
+        funcs::CPUVecMathMul(funcs::CPUVecMathOp::kSilu,
+                             x + i * stride,
+                             y + i * stride,
+                             z + i * n,
+                             n);
+      }
+    }
+    return;
+  }
+
+  funcs::SwiGLUFunctor<T> functor;
+
   for (int64_t i = 0; i < m; ++i) {
     for (int64_t j = 0; j < n; ++j) {
       z[i * n + j] = functor(x[i * stride + j], y[i * stride + j]);
@@ -0,0 +1,242 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "paddle/phi/backends/cpu/cpu_parallel.h"
+
+namespace phi {
+namespace funcs {
+
+// The lookup and the gradient of the CPU embedding kernels.
+//
+// The lookup copies the rows of the ids in order and prefetches the rows of
+// the ids a few positions ahead, since the rows of a large table are rarely
+// cached. The gradients first group the positions by their id, so that every
+// distinct row is validated and written once:
+// - the dense gradient accumulates every group into its own row of the table
+//   gradient, which the threads share without conflicts
+// - the sparse gradient emits one merged row per distinct id instead of one
+//   row per position
+// Both sum the positions of a row in their order, like the serial loop. The
+// threads share the groups by their positions, so that a few frequent ids
+// do not leave the other threads idle.
+
+// The number of positions ahead whose rows are prefetched.
+constexpr int64_t kEmbeddingPrefetchDistance = 8;
+// The number of leading bytes of a row prefetched, the hardware prefetcher
+// follows the rest of a long row.
+constexpr int64_t kEmbeddingPrefetchBytes = 256;
+// The cycles of copying or adding an element of a row.
+constexpr double kEmbeddingCost = 1.0;
+
+template <typename T>
+inline void PrefetchEmbeddingRow(const T* row, int64_t width) {
+#if defined(__GNUC__)
+  const char* p = reinterpret_cast<const char*>(row);
+  const int64_t bytes =
+      std::min<int64_t>(width * sizeof(T), kEmbeddingPrefetchBytes);
+  for (int64_t b = 0; b < bytes; b += 64) {
+    __builtin_prefetch(p + b, 0, 1);
+  }
+#endif
+}
+
+// The positions of the ids grouped by id. The ids are in the order they are
+// first seen, and the positions of an id, positions[offsets[u]] to
+// positions[offsets[u + 1]], are ascending.
+struct EmbeddingIdGroups {
+  std::vector<int64_t> unique_ids;
+  std::vector<int64_t> offsets;
+  std::vector<int64_t> positions;
+
+  int64_t size() const { return static_cast<int64_t>(unique_ids.size()); }
+};
+
+// Groups the n ids with an open addressing hash table, which keeps at most
+// half of its slots used.
+inline void GroupEmbeddingIds(const int64_t* ids,
+                              int64_t n,
+                              EmbeddingIdGroups* groups) {
+  int bits = 1;
+  while ((int64_t{1} << bits) < 2 * n) {
+    ++bits;
+  }
+  const uint64_t mask = (uint64_t{1} << bits) - 1;
+  std::vector<int64_t> table(mask + 1, -1);
+  std::vector<int64_t> group_of(n);
+  groups->unique_ids.clear();
+  for (int64_t i = 0; i < n; ++i) {
+    uint64_t slot =
+        (static_cast<uint64_t>(ids[i]) * 0x9E3779B97F4A7C15ULL) >> (64 - bits);
+    while (table[slot] >= 0 && groups->unique_ids[table[slot]] != ids[i]) {
+      slot = (slot + 1) & mask;
+    }
+    if (table[slot] < 0) {
+      table[slot] = static_cast<int64_t>(groups->unique_ids.size());
+      groups->unique_ids.push_back(ids[i]);
+    }
+    group_of[i] = table[slot];
+  }
+
+  // counting sort of the positions by group, which keeps them ascending
+  const int64_t num_groups = groups->size();
+  groups->offsets.assign(num_groups + 1, 0);
+  for (int64_t i = 0; i < n; ++i) {
+    ++groups->offsets[group_of[i] + 1];
+  }
+  for (int64_t u = 0; u < num_groups; ++u) {
+    groups->offsets[u + 1] += groups->offsets[u];
+  }
+  groups->positions.resize(n);
+  std::vector<int64_t> next(groups->offsets.begin(), groups->offsets.end() - 1);
+  for (int64_t i = 0; i < n; ++i) {
+    groups->positions[next[group_of[i]]++] = i;
+  }
+}
+
+// out[i] = table[ids[i]], or zeros if ids[i] is padding_idx. The ids are
+// validated by the caller.
+template <typename T>
+void CPUEmbeddingLookup(const T* table,
+                        int64_t width,
+                        const int64_t* ids,
+                        int64_t n,
+                        int64_t padding_idx,
+                        T* out) {
+  const int64_t prefetch_end = n - kEmbeddingPrefetchDistance;
+  backends::cpu::CPUParallelFor(
+      n,
+      kEmbeddingCost * static_cast<double>(width),
+      [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; ++i) {
+          if (i < prefetch_end) {
+            int64_t ahead = ids[i + kEmbeddingPrefetchDistance];
+            if (ahead != padding_idx) {
+              PrefetchEmbeddingRow(table + ahead * width, width);
+            }
+          }
+          if (ids[i] == padding_idx) {
+            std::memset(out + i * width, 0, width * sizeof(T));
+          } else {
+            std::memcpy(
+                out + i * width, table + ids[i] * width, width * sizeof(T));
+          }
+        }
+      });
+}
+
+// Calls fn(u) for every group u in parallel. Every thread takes the groups
+// starting in its range of the positions.
+template <typename Func>
+void ForEachEmbeddingGroup(const EmbeddingIdGroups& groups,
+                           int64_t width,
+                           Func&& fn) {
+  const int64_t n = static_cast<int64_t>(groups.positions.size());
+  // offsets[0, size) are the ascending starts of the groups
+  auto starts_begin = groups.offsets.begin();
+  auto starts_end = groups.offsets.end() - 1;
+  backends::cpu::CPUParallelFor(
+      n,
+      kEmbeddingCost * static_cast<double>(width),
+      [&](int64_t begin, int64_t end) {
+        int64_t first =
+            std::lower_bound(starts_begin, starts_end, begin) - starts_begin;
+        int64_t last =
+            std::lower_bound(starts_begin, starts_end, end) - starts_begin;
+        for (int64_t u = first; u < last; ++u) {
+          fn(u);
+        }
+      });
+}
+
+// Adds the rows of out_grad at the positions of every group to the row of
+// its id in table_grad, whose rows of the ids are zeros. The group of
+// padding_idx is skipped.
+template <typename T>
+void CPUEmbeddingGradAccumulate(const EmbeddingIdGroups& groups,
+                                const T* out_grad,
+                                int64_t width,
+                                int64_t padding_idx,
+                                T* table_grad) {
+  const int64_t n = static_cast<int64_t>(groups.positions.size());
+  const int64_t* positions = groups.positions.data();
+  ForEachEmbeddingGroup(groups, width, [&](int64_t u) {
+    if (groups.unique_ids[u] == padding_idx) {
+      return;
+    }
+    T* dst = table_grad + groups.unique_ids[u] * width;
+    for (int64_t k = groups.offsets[u]; k < groups.offsets[u + 1]; ++k) {
+      if (k + kEmbeddingPrefetchDistance < n) {
+        PrefetchEmbeddingRow(
+            out_grad + positions[k + kEmbeddingPrefetchDistance] * width,
+            width);
+      }
+      const T* src = out_grad + positions[k] * width;
+      for (int64_t j = 0; j < width; ++j) {
+        dst[j] += src[j];
+      }
+    }
+  });
+}
+
+// merged[u] = sum of the rows of out_grad at the positions of group u, or
+// zeros for the group of padding_idx.
+template <typename T>
+void CPUEmbeddingGradMerge(const EmbeddingIdGroups& groups,
+                           const T* out_grad,
+                           int64_t width,
+                           int64_t padding_idx,
+                           T* merged) {
+  const int64_t n = static_cast<int64_t>(groups.positions.size());
+  const int64_t* positions = groups.positions.data();
+  ForEachEmbeddingGroup(groups, width, [&](int64_t u) {
+    T* dst = merged + u * width;
+    if (groups.unique_ids[u] == padding_idx) {
+      std::memset(dst, 0, width * sizeof(T));
+      return;
+    }
+    const int64_t begin = groups.offsets[u];
+    std::memcpy(dst, out_grad + positions[begin] * width, width * sizeof(T));
+    for (int64_t k = begin + 1; k < groups.offsets[u + 1]; ++k) {
+      if (k + kEmbeddingPrefetchDistance < n) {
+        PrefetchEmbeddingRow(
+            out_grad + positions[k + kEmbeddingPrefetchDistance] * width,
+            width);
+      }
+      const T* src = out_grad + positions[k] * width;
+      for (int64_t j = 0; j < width; ++j) {
+        dst[j] += src[j];
+      }
+    }
+  });
+}
+
+// Fills the n elements of x with zeros.
+template <typename T>
+void CPUEmbeddingZero(T* x, int64_t n) {
+  // memset writes several elements a cycle
+  backends::cpu::CPUParallelFor(
+      n, kEmbeddingCost / 4, [&](int64_t begin, int64_t end) {
+        std::memset(x + begin, 0, (end - begin) * sizeof(T));
+      });
+}
+
+}  // namespace funcs
+}  // namespace phi
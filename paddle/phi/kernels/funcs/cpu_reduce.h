@@ -0,0 +1,321 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "paddle/phi/backends/cpu/cpu_parallel.h"
+#include "paddle/phi/common/amp_type_traits.h"
+
+namespace phi {
+namespace funcs {
+
+// The reduction engine of the CPU reduce kernels, which works on raw buffers
+// without Eigen.
+//
+// The size-1 dims are dropped and the adjacent dims which are both reduced or
+// both kept are merged, e.g. reducing the axes {2, 3} of [N, C, H, W] reduces
+// [N * C, H * W] along its last dim. Then every group of reduced dims is
+// reduced by one pass over a [outer, reduce, inner] view, innermost first:
+// - inner == 1 reduces contiguous rows with independent lane accumulators,
+//   which the compiler vectorizes
+// - inner > 1 accumulates whole rows of the inner dim, which is split into
+//   blocks so that the accumulators of a block stay in L1
+// The passes are parallel loops of backends::cpu::CPUParallelFor, and the
+// reduce dim is split as well when there are fewer rows than threads.
+
+enum class CPUReduceType { kSum, kMean, kProd, kMax, kMin, kAll, kAny };
+
+template <CPUReduceType kType, typename AccT>
+struct CPUReducer {
+  static AccT Identity() {
+    if constexpr (kType == CPUReduceType::kSum ||
+                  kType == CPUReduceType::kMean) {
+      return static_cast<AccT>(0);
+    } else if constexpr (kType == CPUReduceType::kProd) {
+      return static_cast<AccT>(1);
+    } else if constexpr (kType == CPUReduceType::kMax) {
+      return std::numeric_limits<AccT>::has_infinity
+                 ? -std::numeric_limits<AccT>::infinity()
+                 : std::numeric_limits<AccT>::lowest();
+    } else if constexpr (kType == CPUReduceType::kMin) {
+      return std::numeric_limits<AccT>::has_infinity
+                 ? std::numeric_limits<AccT>::infinity()
+                 : std::numeric_limits<AccT>::max();
+    } else if constexpr (kType == CPUReduceType::kAll) {
+      return true;
+    } else {
+      return false;
+    }
+  }
+
+  // max and min propagate NaN, like Eigen::PropagateNaN
+  static inline AccT Combine(AccT acc, AccT x) {
+    if constexpr (kType == CPUReduceType::kSum ||
+                  kType == CPUReduceType::kMean) {
+      return acc + x;
+    } else if constexpr (kType == CPUReduceType::kProd) {
+      return acc * x;
+    } else if constexpr (kType == CPUReduceType::kMax) {
+      return (x > acc || x != x) ? x : acc;  // NOLINT
+    } else if constexpr (kType == CPUReduceType::kMin) {
+      return (x < acc || x != x) ? x : acc;  // NOLINT
+    } else if constexpr (kType == CPUReduceType::kAll) {
+      return acc && x;
+    } else {
+      return acc || x;
+    }
+  }
+};
+
+// The number of independent accumulators of a contiguous reduction.
+constexpr int kCPUReduceLanes = 16;
+// The number of elements of a block of the inner dim.
+constexpr int64_t kCPUReduceInnerBlock = 1024;
+// The minimal number of elements of the reduce dim given to one thread.
+constexpr int64_t kCPUReduceMinChunk = 4096;
+// The cycles of reducing an element.
+constexpr double kCPUReduceCost = 1.0;
+
+template <CPUReduceType kType, typename InT, typename AccT>
+inline AccT CPUReduceContiguous(const InT* x, int64_t n) {
+  using Reducer = CPUReducer<kType, AccT>;
+  AccT lanes[kCPUReduceLanes];
+  for (int j = 0; j < kCPUReduceLanes; ++j) {
+    lanes[j] = Reducer::Identity();
+  }
+  int64_t steps = n / kCPUReduceLanes;
+  for (int64_t i = 0; i < steps; ++i) {
+    const InT* px = x + i * kCPUReduceLanes;
+    for (int j = 0; j < kCPUReduceLanes; ++j) {
+      lanes[j] = Reducer::Combine(lanes[j], static_cast<AccT>(px[j]));
+    }
+  }
+  AccT acc = Reducer::Identity();
+  for (int j = 0; j < kCPUReduceLanes; ++j) {
+    acc = Reducer::Combine(acc, lanes[j]);
+  }
+  for (int64_t i = steps * kCPUReduceLanes; i < n; ++i) {
+    acc = Reducer::Combine(acc, static_cast<AccT>(x[i]));
+  }
+  return acc;
+}
+
+// out[o][i] = reduce(x[o][r][i] for r in [0, reduce)), where out holds
+// outer * inner accumulators.
+template <CPUReduceType kType, typename InT, typename AccT>
+void CPUReducePass(
+    const InT* x, int64_t outer, int64_t reduce, int64_t inner, AccT* out) {
+  using Reducer = CPUReducer<kType, AccT>;
+  // the tasks below divide by outer and inner, so the empty extents return
+  // here
+  if (outer == 0 || inner == 0) {
+    return;
+  }
+  if (reduce == 0) {
+    std::fill(out, out + outer * inner, Reducer::Identity());
+    return;
+  }
+  const int64_t numel = outer * reduce * inner;
+  const int threads = backends::cpu::CPUParallelThreads(numel, kCPUReduceCost);
+  const int64_t block = std::min(inner, kCPUReduceInnerBlock);
+  const int64_t blocks = (inner + block - 1) / block;
+  // split the reduce dim into chunks, whose partial results are combined at
+  // last, when there are fewer tasks than threads
+  int64_t chunks = 1;
+  if (outer * blocks < threads) {
+    int64_t max_chunks = reduce * inner / kCPUReduceMinChunk;
+    chunks = std::min((threads + outer * blocks - 1) / (outer * blocks),
+                      std::max<int64_t>(1, max_chunks));
+    chunks = std::max<int64_t>(1, std::min(chunks, reduce));
+  }
+  // not std::vector, which packs bool
+  std::unique_ptr<AccT[]> partial(
+      chunks > 1 ? new AccT[outer * chunks * inner] : nullptr);
+  AccT* acc_base = chunks > 1 ? partial.get() : out;
+
+  const int64_t tasks = outer * chunks * blocks;
+  auto reduce_tasks = [&](int64_t task_begin, int64_t task_end) {
+    for (int64_t task = task_begin; task < task_end; ++task) {
+      int64_t b = task % blocks;
+      int64_t c = task / blocks % chunks;
+      int64_t o = task / blocks / chunks;
+      int64_t r_begin = reduce * c / chunks;
+      int64_t r_end = reduce * (c + 1) / chunks;
+      AccT* acc = acc_base + (o * chunks + c) * inner;
+      if (inner == 1) {
+        acc[0] = CPUReduceContiguous<kType, InT, AccT>(
+            x + o * reduce + r_begin, r_end - r_begin);
+        continue;
+      }
+      int64_t i_begin = b * block;
+      int64_t len = std::min(block, inner - i_begin);
+      acc += i_begin;
+      for (int64_t i = 0; i < len; ++i) {
+        acc[i] = Reducer::Identity();
+      }
+      for (int64_t r = r_begin; r < r_end; ++r) {
+        const InT* px = x + (o * reduce + r) * inner + i_begin;
+        for (int64_t i = 0; i < len; ++i) {
+          acc[i] = Reducer::Combine(acc[i], static_cast<AccT>(px[i]));
+        }
+      }
+    }
+  };
+  backends::cpu::CPUParallelFor(tasks,
+                                kCPUReduceCost * static_cast<double>(numel) /
+                                    static_cast<double>(tasks),
+                                reduce_tasks);
+
+  if (chunks > 1) {
+    const int64_t out_numel = outer * inner;
+    backends::cpu::CPUParallelFor(
+        out_numel,
+        kCPUReduceCost * static_cast<double>(chunks),
+        [&](int64_t begin, int64_t end) {
+          for (int64_t k = begin; k < end; ++k) {
+            int64_t o = k / inner;
+            int64_t i = k % inner;
+            AccT acc = partial[o * chunks * inner + i];
+            for (int64_t c = 1; c < chunks; ++c) {
+              acc =
+                  Reducer::Combine(acc, partial[(o * chunks + c) * inner + i]);
+            }
+            out[k] = acc;
+          }
+        });
+  }
+}
+
+// Reduces the axes reduce_dims of x, whose dims are x_dims, into out, which
+// holds the kept dims in their order. Negative axes count from the end. Sum,
+// mean and prod of float16 and bfloat16 accumulate in float, mean of the
+// integers is rounded like the integer division.
+template <CPUReduceType kType, typename T>
+void CPUReduce(const T* x,
+               const std::vector<int64_t>& x_dims,
+               const std::vector<int64_t>& reduce_dims,
+               T* out) {
+  using AccT = typename phi::dtype::MPTypeTrait<T>::Type;
+  const int rank = static_cast<int>(x_dims.size());
+  std::vector<bool> reduced(rank, false);
+  for (int64_t dim : reduce_dims) {
+    reduced[dim < 0 ? dim + rank : dim] = true;
+  }
+
+  // the merged dims and whether they are reduced
+  std::vector<int64_t> groups;
+  std::vector<bool> group_reduced;
+  int64_t reduce_numel = 1;
+  for (int i = 0; i < rank; ++i) {
+    if (reduced[i]) {
+      reduce_numel *= x_dims[i];
+    }
+    if (x_dims[i] == 1) {
+      continue;
+    }
+    if (!groups.empty() && group_reduced.back() == reduced[i]) {
+      groups.back() *= x_dims[i];
+    } else {
+      groups.push_back(x_dims[i]);
+      group_reduced.push_back(reduced[i]);
+    }
+  }
+
+  auto finalize = [&](const AccT* acc, int64_t n) {
+    for (int64_t i = 0; i < n; ++i) {
+      if constexpr (kType == CPUReduceType::kMean) {
+        out[i] = static_cast<T>(acc[i] / static_cast<AccT>(reduce_numel));
+      } else {
+        out[i] = static_cast<T>(acc[i]);
+      }
+    }
+  };
+  constexpr bool kDirect =
+      std::is_same<AccT, T>::value && kType != CPUReduceType::kMean;
+
+  int num_passes = static_cast<int>(
+      std::count(group_reduced.begin(), group_reduced.end(), true));
+  if (num_passes == 0) {
+    int64_t numel = 1;
+    for (int64_t d : groups) {
+      numel *= d;
+    }
+    if constexpr (kDirect) {
+      std::copy(x, x + numel, out);
+    } else {
+      std::vector<AccT> acc(x, x + numel);
+      finalize(acc.data(), numel);
+    }
+    return;
+  }
+
+  // the results of the previous pass and of this pass
+  std::unique_ptr<AccT[]> src;
+  std::unique_ptr<AccT[]> dst;
+  for (int pass = 0; pass < num_passes; ++pass) {
+    int j = static_cast<int>(groups.size()) - 1;
+    while (!group_reduced[j]) {
+      --j;
+    }
+    int64_t outer = 1;
+    for (int k = 0; k < j; ++k) {
+      outer *= groups[k];
+    }
+    int64_t inner = 1;
+    for (int k = j + 1; k < static_cast<int>(groups.size()); ++k) {
+      inner *= groups[k];
+    }
+    bool last = pass + 1 == num_passes;
+    AccT* pass_out = nullptr;
+    if constexpr (kDirect) {
+      if (last) {
+        pass_out = out;
+      }
+    }
+    bool direct = pass_out != nullptr;
+    if (!direct) {
+      dst.reset(new AccT[outer * inner]);
+      pass_out = dst.get();
+    }
+    if (pass == 0) {
+      CPUReducePass<kType, T, AccT>(x, outer, groups[j], inner, pass_out);
+    } else {
+      CPUReducePass<kType, AccT, AccT>(
+          src.get(), outer, groups[j], inner, pass_out);
+    }
+    if (last && !direct) {
+      finalize(pass_out, outer * inner);
+    }
+    std::swap(src, dst);
+
+    // remove the reduced group and merge its kept neighbours
+    groups.erase(groups.begin() + j);
+    group_reduced.erase(group_reduced.begin() + j);
+    if (j > 0 && j < static_cast<int>(groups.size())) {
+      groups[j - 1] *= groups[j];
+      groups.erase(groups.begin() + j);
+      group_reduced.erase(group_reduced.begin() + j);
+    }
+  }
+}
+
+}  // namespace funcs
+}  // namespace phi
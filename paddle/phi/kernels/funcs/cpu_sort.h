@@ -0,0 +1,462 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifdef PADDLE_WITH_MKLML
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "paddle/phi/backends/cpu/cpu_parallel.h"
+
+namespace phi {
+namespace funcs {
+
+// The top-k and the sort of the rows of a [rows, cols] matrix on CPU.
+//
+// NaN is larger than any number, and the values which are equal keep the
+// order of their indices, so the results do not depend on the algorithm:
+// - CPUTopK filters every row by the k-th best value found so far, the
+//   blocks without a better value are skipped by a vectorized count, and
+//   only the candidates left are selected by nth_element. A few huge rows
+//   are split among the threads, whose top-k are merged at last.
+// - CPUArgsort sorts the long rows of arithmetic types by an LSD radix sort
+//   of their order-preserving unsigned keys, which is stable. The passes of
+//   a few huge rows are shared among the threads.
+
+template <typename T>
+inline bool SortIsNan(T v) {
+  return v != v;  // NOLINT
+}
+
+// Whether the value a comes before the value b.
+template <typename T, bool kLargest>
+inline bool SortValueBefore(T a, T b) {
+  if (kLargest) {
+    return (SortIsNan(a) && !SortIsNan(b)) || a > b;
+  } else {
+    return (!SortIsNan(a) && SortIsNan(b)) || a < b;
+  }
+}
+
+// SortValueBefore without branches, so that a loop counting it is
+// vectorized.
+template <typename T, bool kLargest>
+inline int SortValueBeforeMask(T a, T b) {
+  int a_nan = static_cast<int>(SortIsNan(a));
+  int b_nan = static_cast<int>(SortIsNan(b));
+  if (kLargest) {
+    return (a_nan & (b_nan ^ 1)) | static_cast<int>(a > b);
+  } else {
+    return ((a_nan ^ 1) & b_nan) | static_cast<int>(a < b);
+  }
+}
+
+template <typename T, bool kLargest>
+struct SortPairBefore {
+  bool operator()(const std::pair<T, int64_t>& l,
+                  const std::pair<T, int64_t>& r) const {
+    if (SortValueBefore<T, kLargest>(l.first, r.first)) {
+      return true;
+    }
+    if (SortValueBefore<T, kLargest>(r.first, l.first)) {
+      return false;
+    }
+    return l.second < r.second;
+  }
+};
+
+// The number of elements whose filter is counted at once.
+constexpr int64_t kTopKFilterBlock = 256;
+// Rows shorter than kTopKDirectRatio * k are selected without filter.
+constexpr int64_t kTopKDirectRatio = 8;
+// The minimal number of elements of a row given to one thread.
+constexpr int64_t kTopKMinChunk = 16384;
+// The cycles of filtering an element.
+constexpr double kTopKCost = 2.0;
+
+// Keeps the first k candidates of x[begin, end) in (*cand)[0, k), unordered.
+template <typename T, bool kLargest>
+void CPUTopKSelect(const T* x,
+                   int64_t begin,
+                   int64_t end,
+                   int64_t k,
+                   std::vector<std::pair<T, int64_t>>* cand) {
+  SortPairBefore<T, kLargest> before;
+  cand->clear();
+  k = std::min(k, end - begin);
+  if (k <= 0) {
+    return;
+  }
+  if ((end - begin) < kTopKDirectRatio * k) {
+    for (int64_t j = begin; j < end; ++j) {
+      cand->emplace_back(x[j], j);
+    }
+  } else {
+    // the candidates are cut to k whenever there are cap of them, then
+    // only the values before the k-th one can be candidates
+    const size_t cap =
+        static_cast<size_t>(std::max<int64_t>(4 * k, kTopKFilterBlock));
+    cand->reserve(cap + kTopKFilterBlock);
+    bool has_threshold = false;
+    T threshold = x[begin];
+    for (int64_t b = begin; b < end; b += kTopKFilterBlock) {
+      int64_t e = std::min(b + kTopKFilterBlock, end);
+      if (!has_threshold) {
+        for (int64_t j = b; j < e; ++j) {
+          cand->emplace_back(x[j], j);
+        }
+      } else {
+        int hits = 0;
+        for (int64_t j = b; j < e; ++j) {
+          hits += SortValueBeforeMask<T, kLargest>(x[j], threshold);
+        }
+        if (hits == 0) {
+          continue;
+        }
+        for (int64_t j = b; j < e; ++j) {
+          if (SortValueBeforeMask<T, kLargest>(x[j], threshold)) {
+            cand->emplace_back(x[j], j);
+          }
+        }
+      }
+      if (cand->size() >= cap) {
+        std::nth_element(
+            cand->begin(), cand->begin() + k - 1, cand->end(), before);
+        cand->resize(k);
+        threshold = (*cand)[k - 1].first;
+        has_threshold = true;
+      }
+    }
+  }
+  if (static_cast<int64_t>(cand->size()) > k) {
+    std::nth_element(
+        cand->begin(), cand->begin() + k - 1, cand->end(), before);
+    cand->resize(k);
+  }
+}
+
+template <typename T, bool kLargest>
+void CPUTopKImpl(const T* x,
+                 int64_t rows,
+                 int64_t cols,
+                 int64_t k,
+                 T* out,
+                 int64_t* indices) {
+  SortPairBefore<T, kLargest> before;
+  auto write = [&](std::vector<std::pair<T, int64_t>>* cand, int64_t row) {
+    std::sort(cand->begin(), cand->end(), before);
+    for (int64_t j = 0; j < k; ++j) {
+      out[row * k + j] = (*cand)[j].first;
+      indices[row * k + j] = (*cand)[j].second;
+    }
+  };
+
+  const int threads =
+      backends::cpu::CPUParallelThreads(rows * cols, kTopKCost);
+  int64_t parts = 1;
+  if (rows < threads) {
+    parts = std::min<int64_t>(threads / rows, cols / kTopKMinChunk);
+    parts = std::max<int64_t>(1, parts);
+  }
+
+  if (parts == 1) {
+    backends::cpu::CPUParallelFor(
+        rows,
+        kTopKCost * static_cast<double>(cols),
+        [&](int64_t begin, int64_t end) {
+          std::vector<std::pair<T, int64_t>> cand;
+          for (int64_t i = begin; i < end; ++i) {
+            CPUTopKSelect<T, kLargest>(x + i * cols, 0, cols, k, &cand);
+            write(&cand, i);
+          }
+        });
+    return;
+  }
+
+  // every row is split into parts, whose top-k are merged
+  std::vector<std::vector<std::pair<T, int64_t>>> part_cand(rows * parts);
+  backends::cpu::CPUParallelFor(
+      rows * parts,
+      kTopKCost * static_cast<double>(cols) / static_cast<double>(parts),
+      [&](int64_t begin, int64_t end) {
+        for (int64_t task = begin; task < end; ++task) {
+          int64_t i = task / parts;
+          int64_t p = task % parts;
+          CPUTopKSelect<T, kLargest>(x + i * cols,
+                                     cols * p / parts,
+                                     cols * (p + 1) / parts,
+                                     k,
+                                     &part_cand[task]);
+        }
+      });
+  for (int64_t i = 0; i < rows; ++i) {
+    std::vector<std::pair<T, int64_t>> cand;
+    cand.reserve(parts * k);
+    for (int64_t p = 0; p < parts; ++p) {
+      auto& part = part_cand[i * parts + p];
+      cand.insert(cand.end(), part.begin(), part.end());
+    }
+    std::nth_element(cand.begin(), cand.begin() + k - 1, cand.end(), before);
+    cand.resize(k);
+    write(&cand, i);
+  }
+}
+
+// Writes the top k of every row of x, sorted, to out and their column
+// indices to indices, which hold [rows, k] elements.
+template <typename T>
+void CPUTopK(const T* x,
+             int64_t rows,
+             int64_t cols,
+             int64_t k,
+             bool largest,
+             T* out,
+             int64_t* indices) {
+  if (rows <= 0 || k <= 0) {
+    return;
+  }
+  if (largest) {
+    CPUTopKImpl<T, true>(x, rows, cols, k, out, indices);
+  } else {
+    CPUTopKImpl<T, false>(x, rows, cols, k, out, indices);
+  }
+}
+
+// The unsigned key of a value, whose order is the ascending order of the
+// values, where NaN is the largest and -0 equals 0.
+template <typename T, typename Enable = void>
+struct RadixSortKey {
+  static constexpr bool kSupported = false;
+};
+
+template <typename T>
+struct RadixSortKey<
+    T,
+    typename std::enable_if<std::is_integral<T>::value &&
+                            std::is_signed<T>::value>::type> {
+  static constexpr bool kSupported = true;
+  using Key = typename std::make_unsigned<T>::type;
+  static Key Encode(T v) {
+    return static_cast<Key>(v) ^ (static_cast<Key>(1) << (sizeof(T) * 8 - 1));
+  }
+};
+
+template <typename T>
+struct RadixSortKey<
+    T,
+    typename std::enable_if<std::is_floating_point<T>::value>::type> {
+  static constexpr bool kSupported = sizeof(T) == 4 || sizeof(T) == 8;
+  using Key =
+      typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type;
+  static Key Encode(T v) {
+    constexpr Key kSign = static_cast<Key>(1) << (sizeof(T) * 8 - 1);
+    if (v != v) {  // NOLINT
+      return ~static_cast<Key>(0);
+    }
+    if (v == 0) {
+      return kSign;
+    }
+    Key bits;
+    std::memcpy(&bits, &v, sizeof(T));
+    return (bits & kSign) ? ~bits : (bits | kSign);
+  }
+};
+
+// The bits sorted by a pass of the radix sort.
+constexpr int kRadixBits = 8;
+constexpr int kRadixBuckets = 1 << kRadixBits;
+// Rows shorter than it are sorted by comparison.
+constexpr int64_t kRadixSortMinCols = 512;
+// The minimal number of elements of a row given to one thread of a pass.
+constexpr int64_t kRadixSortMinChunk = 65536;
+
+// Sorts the (key, index) pairs in keys and idx stably by the keys, tmp_keys
+// and tmp_idx are the buffers of the passes. Returns whether the result is
+// in the buffers.
+template <typename Key>
+bool CPURadixSortPairs(Key* keys,
+                       int64_t* idx,
+                       Key* tmp_keys,
+                       int64_t* tmp_idx,
+                       int64_t n,
+                       int threads) {
+  std::vector<int64_t> hist(static_cast<size_t>(threads) * kRadixBuckets);
+  bool swapped = false;
+  for (int shift = 0; shift < static_cast<int>(sizeof(Key) * 8);
+       shift += kRadixBits) {
+    std::fill(hist.begin(), hist.end(), 0);
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for num_threads(threads) if (threads > 1)
+#endif
+    for (int t = 0; t < threads; ++t) {
+      int64_t* h = hist.data() + t * kRadixBuckets;
+      for (int64_t i = n * t / threads; i < n * (t + 1) / threads; ++i) {
+        ++h[(keys[i] >> shift) & (kRadixBuckets - 1)];
+      }
+    }
+    // the offset of every bucket of every thread, the pass is skipped when
+    // all the keys are in one bucket
+    bool skip = false;
+    int64_t offset = 0;
+    for (int d = 0; d < kRadixBuckets; ++d) {
+      int64_t bucket = 0;
+      for (int t = 0; t < threads; ++t) {
+        int64_t count = hist[t * kRadixBuckets + d];
+        hist[t * kRadixBuckets + d] = offset + bucket;
+        bucket += count;
+      }
+      if (bucket == n) {
+        skip = true;
+        break;
+      }
+      offset += bucket;
+    }
+    if (skip) {
+      continue;
+    }
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for num_threads(threads) if (threads > 1)
+#endif
+    for (int t = 0; t < threads; ++t) {
+      int64_t* h = hist.data() + t * kRadixBuckets;
+      for (int64_t i = n * t / threads; i < n * (t + 1) / threads; ++i) {
+        int64_t pos = h[(keys[i] >> shift) & (kRadixBuckets - 1)]++;
+        tmp_keys[pos] = keys[i];
+        tmp_idx[pos] = idx[i];
+      }
+    }
+    std::swap(keys, tmp_keys);
+    std::swap(idx, tmp_idx);
+    swapped = !swapped;
+  }
+  return swapped;
+}
+
+template <typename T, bool kDescending>
+void CPUArgsortRowByCompare(const T* x,
+                            int64_t cols,
+                            T* out,
+                            int64_t* indices,
+                            std::vector<std::pair<T, int64_t>>* pairs) {
+  pairs->resize(cols);
+  for (int64_t j = 0; j < cols; ++j) {
+    (*pairs)[j] = std::make_pair(x[j], j);
+  }
+  std::sort(pairs->begin(), pairs->end(), SortPairBefore<T, kDescending>());
+  for (int64_t j = 0; j < cols; ++j) {
+    out[j] = (*pairs)[j].first;
+    indices[j] = (*pairs)[j].second;
+  }
+}
+
+template <typename T, bool kDescending>
+void CPUArgsortRowByRadix(const T* x,
+                          int64_t cols,
+                          T* out,
+                          int64_t* indices,
+                          int threads) {
+  using Key = typename RadixSortKey<T>::Key;
+  std::unique_ptr<Key[]> keys(new Key[2 * cols]);
+  std::unique_ptr<int64_t[]> tmp_idx(new int64_t[cols]);
+  for (int64_t j = 0; j < cols; ++j) {
+    Key key = RadixSortKey<T>::Encode(x[j]);
+    // the descending order keeps the order of the equal values as well
+    keys[j] = kDescending ? static_cast<Key>(~key) : key;
+    indices[j] = j;
+  }
+  bool swapped = CPURadixSortPairs<Key>(
+      keys.get(), indices, keys.get() + cols, tmp_idx.get(), cols, threads);
+  if (swapped) {
+    std::copy(tmp_idx.get(), tmp_idx.get() + cols, indices);
+  }
+  for (int64_t j = 0; j < cols; ++j) {
+    out[j] = x[indices[j]];
+  }
+}
+
+template <typename T, bool kDescending>
+void CPUArgsortImpl(
+    const T* x, int64_t rows, int64_t cols, T* out, int64_t* indices) {
+  constexpr bool kRadix = RadixSortKey<T>::kSupported;
+  int threads = 1;
+#ifdef PADDLE_WITH_MKLML
+  threads = omp_get_max_threads();
+#endif
+  if constexpr (kRadix) {
+    if (cols >= kRadixSortMinCols && rows < threads) {
+      // a few long rows, whose passes are shared among the threads
+      int row_threads = static_cast<int>(std::max<int64_t>(
+          1, std::min<int64_t>(threads, cols / kRadixSortMinChunk)));
+      for (int64_t i = 0; i < rows; ++i) {
+        CPUArgsortRowByRadix<T, kDescending>(x + i * cols,
+                                             cols,
+                                             out + i * cols,
+                                             indices + i * cols,
+                                             row_threads);
+      }
+      return;
+    }
+  }
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel if (rows > 1)
+#endif
+  {
+    std::vector<std::pair<T, int64_t>> pairs;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp for
+#endif
+    for (int64_t i = 0; i < rows; ++i) {
+      if constexpr (kRadix) {
+        if (cols >= kRadixSortMinCols) {
+          CPUArgsortRowByRadix<T, kDescending>(
+              x + i * cols, cols, out + i * cols, indices + i * cols, 1);
+          continue;
+        }
+      }
+      CPUArgsortRowByCompare<T, kDescending>(
+          x + i * cols, cols, out + i * cols, indices + i * cols, &pairs);
+    }
+  }
+}
+
+// Sorts every row of x stably into out and writes the column indices of the
+// sorted values to indices, which hold [rows, cols] elements.
+template <typename T>
+void CPUArgsort(const T* x,
+                int64_t rows,
+                int64_t cols,
+                bool descending,
+                T* out,
+                int64_t* indices) {
+  if (rows <= 0 || cols <= 0) {
+    return;
+  }
+  if (descending) {
+    CPUArgsortImpl<T, true>(x, rows, cols, out, indices);
+  } else {
+    CPUArgsortImpl<T, false>(x, rows, cols, out, indices);
+  }
+}
+
+}  // namespace funcs
+}  // namespace phi
@@ -0,0 +1,77 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/kernels/funcs/cpu_vec_math.h"
+
+#ifdef PADDLE_WITH_MKLML
+#include <omp.h>
+#endif
+
+#include <algorithm>
+
+#include "glog/logging.h"
+#include "paddle/phi/backends/cpu/cpu_info.h"
+#include "paddle/phi/kernels/funcs/cpu_vec_math_impl.h"
+
+namespace phi {
+namespace funcs {
+
+namespace {
+
+// The number of elements of a task of the OpenMP threads.
+constexpr int64_t kCPUVecMathBlock = 16384;
+
+struct CPUVecMathChoice {
+  detail::CPUVecMathKernel kernel;
+  const char* isa;
+};
+
+const CPUVecMathChoice& ChooseCPUVecMath() {
+  static const CPUVecMathChoice choice = [] {
+    CPUVecMathChoice c{detail::CPUVecMathImpl<detail::VecMathScalar>,
+                       "scalar"};
+    if (detail::kCPUVecMathAVX512 != nullptr &&
+        backends::cpu::MayIUse(backends::cpu::avx512f)) {
+      c = {detail::kCPUVecMathAVX512, "avx512f"};
+    } else if (detail::kCPUVecMathAVX2 != nullptr &&
+               backends::cpu::MayIUse(backends::cpu::avx2)) {
+      c = {detail::kCPUVecMathAVX2, "avx2"};
+    }
+    VLOG(3) << "CPU vector math runs on " << c.isa;
+    return c;
+  }();
+  return choice;
+}
+
+}  // namespace
+
+void CPUVecMath(CPUVecMathOp op, const float* x, float* y, int64_t n) {
+  const detail::CPUVecMathKernel kernel = ChooseCPUVecMath().kernel;
+  const int64_t blocks = (n + kCPUVecMathBlock - 1) / kCPUVecMathBlock;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for if (blocks > 1)
+#endif
+  for (int64_t b = 0; b < blocks; ++b) {
+    int64_t begin = b * kCPUVecMathBlock;
+    kernel(op,
+           x + begin,
+           y + begin,
+           std::min(kCPUVecMathBlock, n - begin));
+  }
+}
+
+const char* CPUVecMathIsa() { return ChooseCPUVecMath().isa; }
+
+}  // namespace funcs
+}  // namespace phi
@@ -0,0 +1,128 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifdef PADDLE_WITH_MKLML
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+#include "paddle/phi/common/bfloat16.h"
+#include "paddle/phi/common/float16.h"
+
+namespace phi {
+namespace funcs {
+
+// The vectorized transcendental functions of the CPU activation kernels.
+//
+// The polynomial approximations are written once for every SIMD width in
+// cpu_vec_math_impl.h, and compiled for AVX-512, for AVX2 with FMA and for
+// scalar floats. The widest one the CPU supports is chosen at runtime.
+//
+// All of them give the same results, since they round the same operations.
+//
+// The max errors against the exact results, in ULP:
+// - exp: 1.3, the results below FLT_MIN are subnormals or 0 like std::exp
+// - log: 0.9
+// - tanh, erf: 1.4
+// - sigmoid: 2.5
+// - silu: 3, for x >= -87 where exp(x) is not subnormal
+// - gelu: 2.4 and gelu_tanh: 3.7 for x >= -1, below which 1 + erf(x) and
+//   1 + tanh(x) cancel and the absolute errors are below 1e-7
+// inf, -0 and NaN are handled like std::exp, std::log and std::tanh.
+
+enum class CPUVecMathOp {
+  kExp,
+  kLog,
+  kTanh,
+  kSigmoid,
+  kSilu,
+  kErf,
+  // gelu(x) = 0.5 * x * (1 + erf(x / sqrt(2)))
+  kGelu,
+  // gelu(x) = 0.5 * x * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3)))
+  kGeluTanh,
+};
+
+// y[i] = op(x[i]) for the n elements, x and y may be the same. Large inputs
+// are shared among the OpenMP threads.
+void CPUVecMath(CPUVecMathOp op, const float* x, float* y, int64_t n);
+
+// The dtypes of CPUVecMath, float16 and bfloat16 are computed in float. The
+// kernels of the other dtypes fall back to Eigen.
+template <typename T>
+struct IsCPUVecMathType
+    : std::integral_constant<bool,
+                             std::is_same<T, float>::value ||
+                                 std::is_same<T, phi::dtype::float16>::value ||
+                                 std::is_same<T, phi::dtype::bfloat16>::value> {
+};
+
+template <typename T>
+void CPUVecMath(CPUVecMathOp op, const T* x, T* y, int64_t n) {
+  static_assert(IsCPUVecMathType<T>::value,
+                "CPUVecMath supports float, float16 and bfloat16.");
+  constexpr int64_t kBlock = 1024;
+  const int64_t blocks = (n + kBlock - 1) / kBlock;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for if (blocks > 16)
+#endif
+  for (int64_t b = 0; b < blocks; ++b) {
+    float buf[kBlock];
+    const int64_t begin = b * kBlock;
+    const int64_t len = std::min(kBlock, n - begin);
+    for (int64_t i = 0; i < len; ++i) {
+      buf[i] = static_cast<float>(x[begin + i]);
+    }
+    CPUVecMath(op, buf, buf, len);
+    for (int64_t i = 0; i < len; ++i) {
+      y[begin + i] = static_cast<T>(buf[i]);
+    }
+  }
+}
+
+// z[i] = op(x[i]) * y[i] for the n elements of the gated activations, such as
+// swiglu. float16 and bfloat16 are computed in float and rounded once.
+template <typename T>
+void CPUVecMathMul(CPUVecMathOp op, const T* x, const T* y, T* z, int64_t n) {
+  static_assert(IsCPUVecMathType<T>::value,
+                "CPUVecMathMul supports float, float16 and bfloat16.");
+  constexpr int64_t kBlock = 1024;
+  const int64_t blocks = (n + kBlock - 1) / kBlock;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for if (blocks > 16)
+#endif
+  for (int64_t b = 0; b < blocks; ++b) {
+    float buf[kBlock];
+    const int64_t begin = b * kBlock;
+    const int64_t len = std::min(kBlock, n - begin);
+    for (int64_t i = 0; i < len; ++i) {
+      buf[i] = static_cast<float>(x[begin + i]);
+    }
+    CPUVecMath(op, buf, buf, len);
+    for (int64_t i = 0; i < len; ++i) {
+      z[begin + i] = static_cast<T>(buf[i] * static_cast<float>(y[begin + i]));
+    }
+  }
+}
+
+// The name of the instruction set CPUVecMath runs on, for the logs.
+const char* CPUVecMathIsa();
+
+}  // namespace funcs
+}  // namespace phi
@@ -0,0 +1,32 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compiled with AVX2 and FMA when the compiler supports them, see
+// paddle/phi/CMakeLists.txt.
+
+#include "paddle/phi/kernels/funcs/cpu_vec_math_impl.h"
+
+namespace phi {
+namespace funcs {
+namespace detail {
+
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+const CPUVecMathKernel kCPUVecMathAVX2 = CPUVecMathImpl<VecMathAVX2>;
+#else
+const CPUVecMathKernel kCPUVecMathAVX2 = nullptr;
+#endif
+
+}  // namespace detail
+}  // namespace funcs
+}  // namespace phi
@@ -0,0 +1,445 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// The algorithms of cpu_vec_math.h written once for every SIMD width. Every
+// cpu_vec_math*.cc includes this file with the instruction set it is compiled
+// for, and instantiates CPUVecMathImpl with its vector type.
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include "paddle/phi/kernels/funcs/cpu_vec_math.h"
+
+namespace phi {
+namespace funcs {
+namespace detail {
+
+// One float, for the CPUs without AVX2 and for the tails.
+struct VecMathScalar {
+  static constexpr int kWidth = 1;
+  using Float = float;
+  using Int = int32_t;
+  using Mask = bool;
+
+  static Float Load(const float* p) { return *p; }
+  static void Store(float* p, Float a) { *p = a; }
+  static Float Set(float a) { return a; }
+  static Int SetInt(int32_t a) { return a; }
+
+  static Float Add(Float a, Float b) { return a + b; }
+  static Float Sub(Float a, Float b) { return a - b; }
+  static Float Mul(Float a, Float b) { return a * b; }
+  static Float Div(Float a, Float b) { return a / b; }
+  // fused like the vector ones, so that all of them give the same results
+  static Float Fma(Float a, Float b, Float c) { return std::fma(a, b, c); }
+  // like maxps and minps, b is returned if any of them is NaN
+  static Float Max(Float a, Float b) { return a > b ? a : b; }
+  static Float Min(Float a, Float b) { return a < b ? a : b; }
+  static Float Round(Float a) { return std::nearbyint(a); }
+
+  static Int AsInt(Float a) {
+    Int i;
+    std::memcpy(&i, &a, sizeof(i));
+    return i;
+  }
+  static Float AsFloat(Int i) {
+    Float a;
+    std::memcpy(&a, &i, sizeof(a));
+    return a;
+  }
+  // a is an integer in the range of int32
+  static Int ToInt(Float a) { return static_cast<Int>(a); }
+  static Float ToFloat(Int i) { return static_cast<Float>(i); }
+  static Int AddInt(Int a, Int b) { return a + b; }
+  static Int SubInt(Int a, Int b) { return a - b; }
+  static Int AndInt(Int a, Int b) { return a & b; }
+  static Int OrInt(Int a, Int b) { return a | b; }
+  static Int XorInt(Int a, Int b) { return a ^ b; }
+  template <int kBits>
+  static Int ShiftLeft(Int a) {
+    return static_cast<Int>(static_cast<uint32_t>(a) << kBits);
+  }
+  template <int kBits>
+  static Int ShiftRight(Int a) {
+    return static_cast<Int>(static_cast<uint32_t>(a) >> kBits);
+  }
+
+  static Mask Less(Float a, Float b) { return a < b; }
+  static Mask Equal(Float a, Float b) { return a == b; }
+  static Mask IsNan(Float a) { return a != a; }  // NOLINT
+  static Mask Or(Mask a, Mask b) { return a || b; }
+  // a where mask is set, otherwise b
+  static Float Select(Mask mask, Float a, Float b) { return mask ? a : b; }
+};
+
+#ifdef __AVX2__
+// 8 floats, which needs AVX2 and FMA.
+struct VecMathAVX2 {
+  static constexpr int kWidth = 8;
+  using Float = __m256;
+  using Int = __m256i;
+  using Mask = __m256;
+
+  static Float Load(const float* p) { return _mm256_loadu_ps(p); }
+  static void Store(float* p, Float a) { _mm256_storeu_ps(p, a); }
+  static Float Set(float a) { return _mm256_set1_ps(a); }
+  static Int SetInt(int32_t a) { return _mm256_set1_epi32(a); }
+
+  static Float Add(Float a, Float b) { return _mm256_add_ps(a, b); }
+  static Float Sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+  static Float Mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+  static Float Div(Float a, Float b) { return _mm256_div_ps(a, b); }
+  static Float Fma(Float a, Float b, Float c) {
+    return _mm256_fmadd_ps(a, b, c);
+  }
+  static Float Max(Float a, Float b) { return _mm256_max_ps(a, b); }
+  static Float Min(Float a, Float b) { return _mm256_min_ps(a, b); }
+  static Float Round(Float a) {
+    return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  }
+
+  static Int AsInt(Float a) { return _mm256_castps_si256(a); }
+  static Float AsFloat(Int i) { return _mm256_castsi256_ps(i); }
+  static Int ToInt(Float a) { return _mm256_cvttps_epi32(a); }
+  static Float ToFloat(Int i) { return _mm256_cvtepi32_ps(i); }
+  static Int AddInt(Int a, Int b) { return _mm256_add_epi32(a, b); }
+  static Int SubInt(Int a, Int b) { return _mm256_sub_epi32(a, b); }
+  static Int AndInt(Int a, Int b) { return _mm256_and_si256(a, b); }
+  static Int OrInt(Int a, Int b) { return _mm256_or_si256(a, b); }
+  static Int XorInt(Int a, Int b) { return _mm256_xor_si256(a, b); }
+  template <int kBits>
+  static Int ShiftLeft(Int a) {
+    return _mm256_slli_epi32(a, kBits);
+  }
+  template <int kBits>
+  static Int ShiftRight(Int a) {
+    return _mm256_srli_epi32(a, kBits);
+  }
+
+  static Mask Less(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+  static Mask Equal(Float a, Float b) {
+    return _mm256_cmp_ps(a, b, _CMP_EQ_OQ);
+  }
+  static Mask IsNan(Float a) { return _mm256_cmp_ps(a, a, _CMP_UNORD_Q); }
+  static Mask Or(Mask a, Mask b) { return _mm256_or_ps(a, b); }
+  static Float Select(Mask mask, Float a, Float b) {
+    return _mm256_blendv_ps(b, a, mask);
+  }
+};
+#endif
+
+#ifdef __AVX512F__
+// 16 floats, which needs AVX512F.
+struct VecMathAVX512 {
+  static constexpr int kWidth = 16;
+  using Float = __m512;
+  using Int = __m512i;
+  using Mask = __mmask16;
+
+  static Float Load(const float* p) { return _mm512_loadu_ps(p); }
+  static void Store(float* p, Float a) { _mm512_storeu_ps(p, a); }
+  static Float Set(float a) { return _mm512_set1_ps(a); }
+  static Int SetInt(int32_t a) { return _mm512_set1_epi32(a); }
+
+  static Float Add(Float a, Float b) { return _mm512_add_ps(a, b); }
+  static Float Sub(Float a, Float b) { return _mm512_sub_ps(a, b); }
+  static Float Mul(Float a, Float b) { return _mm512_mul_ps(a, b); }
+  static Float Div(Float a, Float b) { return _mm512_div_ps(a, b); }
+  static Float Fma(Float a, Float b, Float c) {
+    return _mm512_fmadd_ps(a, b, c);
+  }
+  static Float Max(Float a, Float b) { return _mm512_max_ps(a, b); }
+  static Float Min(Float a, Float b) { return _mm512_min_ps(a, b); }
+  static Float Round(Float a) {
+    return _mm512_roundscale_ps(a,
+                                _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  }
+
+  static Int AsInt(Float a) { return _mm512_castps_si512(a); }
+  static Float AsFloat(Int i) { return _mm512_castsi512_ps(i); }
+  static Int ToInt(Float a) { return _mm512_cvttps_epi32(a); }
+  static Float ToFloat(Int i) { return _mm512_cvtepi32_ps(i); }
+  static Int AddInt(Int a, Int b) { return _mm512_add_epi32(a, b); }
+  static Int SubInt(Int a, Int b) { return _mm512_sub_epi32(a, b); }
+  static Int AndInt(Int a, Int b) { return _mm512_and_si512(a, b); }
+  static Int OrInt(Int a, Int b) { return _mm512_or_si512(a, b); }
+  static Int XorInt(Int a, Int b) { return _mm512_xor_si512(a, b); }
+  template <int kBits>
+  static Int ShiftLeft(Int a) {
+    return _mm512_slli_epi32(a, kBits);
+  }
+  template <int kBits>
+  static Int ShiftRight(Int a) {
+    return _mm512_srli_epi32(a, kBits);
+  }
+
+  static Mask Less(Float a, Float b) {
+    return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ);
+  }
+  static Mask Equal(Float a, Float b) {
+    return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ);
+  }
+  static Mask IsNan(Float a) { return _mm512_cmp_ps_mask(a, a, _CMP_UNORD_Q); }
+  static Mask Or(Mask a, Mask b) { return static_cast<Mask>(a | b); }
+  static Float Select(Mask mask, Float a, Float b) {
+    return _mm512_mask_blend_ps(mask, b, a);
+  }
+};
+#endif
+
+template <typename V>
+struct VecMath {
+  using Float = typename V::Float;
+  using Int = typename V::Int;
+
+  static Float Abs(Float a) {
+    return V::AsFloat(V::AndInt(V::AsInt(a), V::SetInt(0x7FFFFFFF)));
+  }
+
+  // a with the sign of b
+  static Float CopySign(Float a, Float b) {
+    Int sign = V::AndInt(V::AsInt(b), V::SetInt(INT32_MIN));
+    return V::AsFloat(V::OrInt(V::AndInt(V::AsInt(a), V::SetInt(0x7FFFFFFF)),
+                               sign));
+  }
+
+  // 2^n for the integers n in [-126, 127]
+  static Float Pow2(Int n) {
+    return V::AsFloat(V::template ShiftLeft<23>(V::AddInt(n, V::SetInt(127))));
+  }
+
+  // exp(x) = 2^n * exp(r), where n = round(x / ln2) and |r| <= ln2 / 2. The
+  // polynomial of exp(r) is the one of Cephes. 2^n is applied as two factors,
+  // so that the results overflow to inf and underflow to the subnormals and 0
+  // like std::exp.
+  static Float Exp(Float x) {
+    Float t = V::Min(V::Set(89.0f), V::Max(V::Set(-104.0f), x));
+    Float n = V::Round(V::Mul(t, V::Set(1.44269504088896341f)));
+    Float r = V::Fma(n, V::Set(-0.693359375f), t);
+    r = V::Fma(n, V::Set(2.12194440e-4f), r);
+    Float p = V::Set(1.9875691500e-4f);
+    p = V::Fma(p, r, V::Set(1.3981999507e-3f));
+    p = V::Fma(p, r, V::Set(8.3334519073e-3f));
+    p = V::Fma(p, r, V::Set(4.1665795894e-2f));
+    p = V::Fma(p, r, V::Set(1.6666665459e-1f));
+    p = V::Fma(p, r, V::Set(5.0000001201e-1f));
+    p = V::Fma(p, V::Mul(r, r), V::Add(r, V::Set(1.0f)));
+    // n is in [-150, 129], k1 = floor(n / 2) and k2 = n - k1
+    Int k = V::ToInt(n);
+    Int k1 = V::SubInt(
+        V::template ShiftRight<1>(V::AddInt(k, V::SetInt(256))),
+        V::SetInt(128));
+    Int k2 = V::SubInt(k, k1);
+    return V::Mul(V::Mul(p, Pow2(k1)), Pow2(k2));
+  }
+
+  // log(x) = e * ln2 + log(m), where x = 2^e * m and sqrt(0.5) <= m <
+  // sqrt(2). The polynomial of log(m) is the one of Cephes.
+  static Float Log(Float x) {
+    // the subnormals are scaled into the normal range first
+    auto tiny = V::Less(x, V::Set(std::numeric_limits<float>::min()));
+    Float xs = V::Select(tiny, V::Mul(x, V::Set(8388608.0f)), x);
+    Float bias = V::Select(tiny, V::Set(150.0f), V::Set(127.0f));
+    Int bits = V::AsInt(xs);
+    Float e = V::Sub(V::ToFloat(V::template ShiftRight<23>(bits)), bias);
+    Float m = V::AsFloat(V::OrInt(V::AndInt(bits, V::SetInt(0x007FFFFF)),
+                                  V::SetInt(0x3F800000)));
+    auto big = V::Less(V::Set(1.41421356237f), m);
+    m = V::Select(big, V::Mul(m, V::Set(0.5f)), m);
+    e = V::Select(big, V::Add(e, V::Set(1.0f)), e);
+    Float f = V::Sub(m, V::Set(1.0f));
+    Float z = V::Mul(f, f);
+    Float p = V::Set(7.0376836292e-2f);
+    p = V::Fma(p, f, V::Set(-1.1514610310e-1f));
+    p = V::Fma(p, f, V::Set(1.1676998740e-1f));
+    p = V::Fma(p, f, V::Set(-1.2420140846e-1f));
+    p = V::Fma(p, f, V::Set(1.4249322787e-1f));
+    p = V::Fma(p, f, V::Set(-1.6668057665e-1f));
+    p = V::Fma(p, f, V::Set(2.0000714765e-1f));
+    p = V::Fma(p, f, V::Set(-2.4999993993e-1f));
+    p = V::Fma(p, f, V::Set(3.3333331174e-1f));
+    Float y = V::Mul(V::Mul(p, f), z);
+    y = V::Fma(e, V::Set(-2.12194440e-4f), y);
+    y = V::Fma(z, V::Set(-0.5f), y);
+    y = V::Add(f, y);
+    y = V::Fma(e, V::Set(0.693359375f), y);
+
+    const float inf = std::numeric_limits<float>::infinity();
+    y = V::Select(V::Equal(x, V::Set(inf)), x, y);
+    y = V::Select(V::Equal(x, V::Set(0.0f)), V::Set(-inf), y);
+    y = V::Select(V::Less(x, V::Set(0.0f)),
+                  V::Set(std::numeric_limits<float>::quiet_NaN()),
+                  y);
+    return V::Select(V::IsNan(x), x, y);
+  }
+
+  // tanh(x) = x + x^3 * P(x^2) for |x| < 0.625 by the polynomial of Cephes,
+  // otherwise 1 - 2 / (exp(2|x|) + 1), with the sign of x.
+  static Float Tanh(Float x) {
+    Float a = Abs(x);
+    Float z = V::Mul(x, x);
+    Float p = V::Set(-5.70498872745e-3f);
+    p = V::Fma(p, z, V::Set(2.06390887954e-2f));
+    p = V::Fma(p, z, V::Set(-5.37397155531e-2f));
+    p = V::Fma(p, z, V::Set(1.33314422036e-1f));
+    p = V::Fma(p, z, V::Set(-3.33332819422e-1f));
+    Float small = V::Fma(V::Mul(p, z), a, a);
+
+    Float e = Exp(V::Add(a, a));
+    Float large = V::Sub(V::Set(1.0f),
+                         V::Div(V::Set(2.0f), V::Add(e, V::Set(1.0f))));
+    return CopySign(V::Select(V::Less(a, V::Set(0.625f)), small, large), x);
+  }
+
+  // sigmoid(x) = 1 / (1 + exp(-x)) for x >= 0, otherwise exp(x) / (1 +
+  // exp(x)), so that exp never overflows.
+  static Float Sigmoid(Float x) {
+    Float e = Exp(V::Sub(V::Set(0.0f), Abs(x)));
+    Float num = V::Select(V::Less(x, V::Set(0.0f)), e, V::Set(1.0f));
+    return V::Div(num, V::Add(V::Set(1.0f), e));
+  }
+
+  static Float Silu(Float x) {
+    Float e = Exp(V::Sub(V::Set(0.0f), Abs(x)));
+    Float num = V::Select(V::Less(x, V::Set(0.0f)), V::Mul(x, e), x);
+    return V::Div(num, V::Add(V::Set(1.0f), e));
+  }
+
+  // erf(x) = x + x * P(x^2) for |x| < 1, otherwise 1 - exp(-x^2) * R(|x|),
+  // with the sign of x. P and R are Chebyshev fits of erf(x) / x - 1 and
+  // erfc(x) * exp(x^2), and x^2 is split into two floats for exp.
+  static Float Erf(Float x) {
+    Float a = Abs(x);
+    Float z = V::Mul(x, x);
+    Float p = V::Set(7.875875063e-05f);
+    p = V::Fma(p, z, V::Set(-8.016864287e-04f));
+    p = V::Fma(p, z, V::Set(5.189087423e-03f));
+    p = V::Fma(p, z, V::Set(-2.685421201e-02f));
+    p = V::Fma(p, z, V::Set(1.128359472e-01f));
+    p = V::Fma(p, z, V::Set(-3.761262667e-01f));
+    p = V::Fma(p, z, V::Set(1.283791658e-01f));
+    Float small = V::Fma(a, p, a);
+
+    // erf(x) rounds to 1 for |x| >= 4
+    Float t = V::Min(V::Set(4.0f), a);
+    Float s = V::Sub(t, V::Set(2.5f));
+    Float r = V::Set(1.030151299e-07f);
+    r = V::Fma(r, s, V::Set(-4.264734348e-07f));
+    r = V::Fma(r, s, V::Set(9.763901572e-07f));
+    r = V::Fma(r, s, V::Set(-3.747273773e-06f));
+    r = V::Fma(r, s, V::Set(1.611410639e-05f));
+    r = V::Fma(r, s, V::Set(-5.952315703e-05f));
+    r = V::Fma(r, s, V::Set(2.109179638e-04f));
+    r = V::Fma(r, s, V::Set(-7.331529643e-04f));
+    r = V::Fma(r, s, V::Set(2.467065761e-03f));
+    r = V::Fma(r, s, V::Set(-8.001693888e-03f));
+    r = V::Fma(r, s, V::Set(2.493799475e-02f));
+    r = V::Fma(r, s, V::Set(-7.434733674e-02f));
+    r = V::Fma(r, s, V::Set(2.108063641e-01f));
+    Float hi = V::Mul(t, t);
+    Float lo = V::Fma(t, t, V::Sub(V::Set(0.0f), hi));
+    // exp(-hi - lo) = exp(-hi) * (1 - lo)
+    Float erfc = V::Mul(Exp(V::Sub(V::Set(0.0f), hi)), r);
+    erfc = V::Fma(V::Sub(V::Set(0.0f), erfc), lo, erfc);
+    Float large = V::Sub(V::Set(1.0f), erfc);
+
+    Float y = CopySign(V::Select(V::Less(a, V::Set(1.0f)), small, large), x);
+    return V::Select(V::IsNan(x), x, y);
+  }
+
+  // gelu(x) = 0.5 * x * (1 + erf(x / sqrt(2)))
+  static Float Gelu(Float x) {
+    Float e = Erf(V::Mul(x, V::Set(0.70710678118654752f)));
+    return V::Mul(V::Mul(x, V::Set(0.5f)), V::Add(V::Set(1.0f), e));
+  }
+
+  // gelu(x) = 0.5 * x * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3)))
+  static Float GeluTanh(Float x) {
+    Float x3 = V::Mul(V::Mul(x, x), x);
+    Float inner = V::Mul(V::Fma(x3, V::Set(0.044715f), x),
+                         V::Set(0.79788456080286536f));
+    Float t = Tanh(inner);
+    return V::Mul(V::Mul(x, V::Set(0.5f)), V::Add(V::Set(1.0f), t));
+  }
+};
+
+using CPUVecMathKernel = void (*)(CPUVecMathOp op,
+                                  const float* x,
+                                  float* y,
+                                  int64_t n);
+
+// The kernels of cpu_vec_math_avx2.cc and cpu_vec_math_avx512.cc, which are
+// nullptr if they are not compiled for their instruction sets.
+extern const CPUVecMathKernel kCPUVecMathAVX2;
+extern const CPUVecMathKernel kCPUVecMathAVX512;
+
+template <typename V, typename Fn>
+inline void VecMathLoop(const float* x, float* y, int64_t n, Fn fn) {
+  int64_t i = 0;
+  for (; i + V::kWidth <= n; i += V::kWidth) {
+    V::Store(y + i, fn(V::Load(x + i)));
+  }
+  if (i < n) {
+    // the tail goes through a full vector as well, so that every element gets
+    // the same result wherever it is
+    float buf[V::kWidth] = {0};
+    std::memcpy(buf, x + i, (n - i) * sizeof(float));
+    V::Store(buf, fn(V::Load(buf)));
+    std::memcpy(y + i, buf, (n - i) * sizeof(float));
+  }
+}
+
+template <typename V>
+void CPUVecMathImpl(CPUVecMathOp op, const float* x, float* y, int64_t n) {
+  using M = VecMath<V>;
+  using Float = typename V::Float;
+  switch (op) {
+    case CPUVecMathOp::kExp:
+      VecMathLoop<V>(x, y, n, [](Float a) { return M::Exp(a); });
+      break;
+    case CPUVecMathOp::kLog:
+      VecMathLoop<V>(x, y, n, [](Float a) { return M::Log(a); });
+      break;
+    case CPUVecMathOp::kTanh:
+      VecMathLoop<V>(x, y, n, [](Float a) { return M::Tanh(a); });
+      break;
+    case CPUVecMathOp::kSigmoid:
+      VecMathLoop<V>(x, y, n, [](Float a) { return M::Sigmoid(a); });
+      break;
+    case CPUVecMathOp::kSilu:
+      VecMathLoop<V>(x, y, n, [](Float a) { return M::Silu(a); });
+      break;
+    case CPUVecMathOp::kErf:
+      VecMathLoop<V>(x, y, n, [](Float a) { return M::Erf(a); });
+      break;
+    case CPUVecMathOp::kGelu:
+      VecMathLoop<V>(x, y, n, [](Float a) { return M::Gelu(a); });
+      break;
+    case CPUVecMathOp::kGeluTanh:
+      VecMathLoop<V>(x, y, n, [](Float a) { return M::GeluTanh(a); });
+      break;
+  }
+}
+
+}  // namespace detail
+}  // namespace funcs
+}  // namespace phi
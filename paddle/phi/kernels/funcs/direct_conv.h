@@ -0,0 +1,614 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifdef PADDLE_WITH_MKLML
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "paddle/common/flags.h"
+#include "paddle/phi/core/allocator.h"
+#include "paddle/phi/core/ddim.h"
+
+COMMON_DECLARE_int32(conv2d_cpu_direct);
+
+namespace phi {
+namespace funcs {
+
+// Blocked direct convolution of NCHW conv2d on CPU, which needs no im2col
+// buffer. The output channels are split into blocks of kBlock, the filter is
+// packed into [groups][out blocks][in_c / groups][k_h][k_w][kBlock], and for
+// every output row the accumulators of a block, [o_w][kBlock], stay in the
+// L1 cache, every input element is broadcast into kBlock multiply-adds, which
+// the compiler vectorizes. The tasks of (batch, group, out block) are shared
+// among the threads. The backward of the input is the same with the roles of
+// the input and output channels swapped.
+
+struct DirectConv2DParam {
+  int64_t batch;
+  int in_channels;
+  int in_h;
+  int in_w;
+  int out_channels;
+  int out_h;
+  int out_w;
+  int kernel_h;
+  int kernel_w;
+  int stride_h;
+  int stride_w;
+  int pad_top;
+  int pad_left;
+  int dilation_h;
+  int dilation_w;
+  int groups;
+
+  int in_per_group() const { return in_channels / groups; }
+  int out_per_group() const { return out_channels / groups; }
+  int64_t filter_numel() const {
+    return static_cast<int64_t>(out_channels) * in_per_group() * kernel_h *
+           kernel_w;
+  }
+};
+
+// paddings are {top, bottom, left, right}, as updated by
+// UpdatePaddingAndDilation.
+inline DirectConv2DParam MakeDirectConv2DParam(
+    const DDim& in_dims,
+    const DDim& filter_dims,
+    const DDim& out_dims,
+    const std::vector<int>& strides,
+    const std::vector<int>& paddings,
+    const std::vector<int>& dilations,
+    int groups) {
+  DirectConv2DParam p;
+  p.batch = in_dims[0];
+  p.in_channels = static_cast<int>(in_dims[1]);
+  p.in_h = static_cast<int>(in_dims[2]);
+  p.in_w = static_cast<int>(in_dims[3]);
+  p.out_channels = static_cast<int>(out_dims[1]);
+  p.out_h = static_cast<int>(out_dims[2]);
+  p.out_w = static_cast<int>(out_dims[3]);
+  p.kernel_h = static_cast<int>(filter_dims[2]);
+  p.kernel_w = static_cast<int>(filter_dims[3]);
+  p.stride_h = strides[0];
+  p.stride_w = strides[1];
+  p.pad_top = paddings[0];
+  p.pad_left = paddings[2];
+  p.dilation_h = dilations[0];
+  p.dilation_w = dilations[1];
+  p.groups = groups;
+  return p;
+}
+
+// Whether the CPU conv2d kernels use the direct convolution. A convolution
+// which needs no im2col, i.e. 1x1 with stride 1 and no padding, is a plain
+// gemm and stays with blas. FLAGS_conv2d_cpu_direct selects it in builds
+// without oneDNN by default.
+inline bool UseDirectConv2D(bool is_expand) {
+  if (FLAGS_conv2d_cpu_direct == 0 || !is_expand) {
+    return false;
+  }
+  if (FLAGS_conv2d_cpu_direct > 0) {
+    return true;
+  }
+#ifdef PADDLE_WITH_DNNL
+  return false;
+#else
+  return true;
+#endif
+}
+
+// [begin, end) of the outputs whose input index out * stride + offset lies in
+// [0, size).
+inline void DirectConvValidRange(int offset,
+                                 int stride,
+                                 int size,
+                                 int out_size,
+                                 int* begin,
+                                 int* end) {
+  int b = offset >= 0 ? 0 : (-offset + stride - 1) / stride;
+  int e = size - offset <= 0 ? 0 : (size - offset + stride - 1) / stride;
+  *begin = std::min(b, out_size);
+  *end = std::max(*begin, std::min(e, out_size));
+}
+
+// Packs the filter [out_c][in_c / groups][k_h][k_w] into blocks of kBlock
+// output channels, or of kBlock input channels when transposed, which is the
+// layout of the backward of the input. The missing channels of the last block
+// are zero.
+template <typename T>
+void PackDirectConv2DFilter(const T* filter,
+                            const DirectConv2DParam& p,
+                            int block,
+                            bool transposed,
+                            T* packed) {
+  int icg = p.in_per_group();
+  int ocg = p.out_per_group();
+  int ksize = p.kernel_h * p.kernel_w;
+  int outer = transposed ? icg : ocg;
+  int inner = transposed ? ocg : icg;
+  int blocks = (outer + block - 1) / block;
+  for (int g = 0; g < p.groups; ++g) {
+    for (int ob = 0; ob < blocks; ++ob) {
+      for (int i = 0; i < inner; ++i) {
+        for (int k = 0; k < ksize; ++k) {
+          for (int b = 0; b < block; ++b) {
+            int o = ob * block + b;
+            T value = static_cast<T>(0);
+            if (o < outer) {
+              int oc = transposed ? i : o;
+              int ic = transposed ? o : i;
+              value = filter[(static_cast<int64_t>(g * ocg + oc) * icg + ic) *
+                                 ksize +
+                             k];
+            }
+            *packed++ = value;
+          }
+        }
+      }
+    }
+  }
+}
+
+// Caches the packed filters per weight allocation, so that a weight used by
+// every step is only packed again after it is updated. A packed filter is
+// found by the address and the shape of the weight, and is only reused while
+// the allocation holding the weight is alive and the fingerprint of the
+// weight's content is unchanged, since the optimizers update the weights in
+// place. The entries whose allocation is freed are dropped at every insert,
+// and the others are evicted in LRU order beyond kMaxBytes.
+template <typename T>
+class DirectConv2DFilterCache {
+ public:
+  static DirectConv2DFilterCache& Instance() {
+    static DirectConv2DFilterCache cache;
+    return cache;
+  }
+
+  // Packs the filter without caching it if holder is null.
+  std::shared_ptr<const std::vector<T>> Get(
+      const std::shared_ptr<phi::Allocation>& holder,
+      const T* filter,
+      const DirectConv2DParam& p,
+      int block,
+      bool transposed) {
+    Key key{filter,
+            p.out_channels,
+            p.in_per_group(),
+            p.kernel_h,
+            p.kernel_w,
+            p.groups,
+            block,
+            transposed};
+    uint64_t fingerprint = holder ? Fingerprint(filter, p.filter_numel()) : 0;
+    if (holder) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = entries_.find(key);
+      if (it != entries_.end()) {
+        if (it->second.holder.lock() == holder &&
+            it->second.fingerprint == fingerprint) {
+          lru_.splice(lru_.begin(), lru_, it->second.lru);
+          return it->second.packed;
+        }
+        Erase(it);
+      }
+    }
+
+    int outer = transposed ? p.in_per_group() : p.out_per_group();
+    int inner = transposed ? p.out_per_group() : p.in_per_group();
+    size_t size = static_cast<size_t>(p.groups) *
+                  ((outer + block - 1) / block) * block * inner * p.kernel_h *
+                  p.kernel_w;
+    auto packed = std::make_shared<std::vector<T>>(size);
+    PackDirectConv2DFilter(filter, p, block, transposed, packed->data());
+    size_t bytes = size * sizeof(T);
+    if (!holder || bytes > kMaxBytes) {
+      return packed;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      Erase(it);
+    }
+    for (auto iter = entries_.begin(); iter != entries_.end();) {
+      if (iter->second.holder.expired()) {
+        Erase(iter++);
+      } else {
+        ++iter;
+      }
+    }
+    while (bytes_ + bytes > kMaxBytes) {
+      Erase(entries_.find(lru_.back()));
+    }
+    lru_.push_front(key);
+    entries_[key] = Entry{holder, fingerprint, packed, bytes, lru_.begin()};
+    bytes_ += bytes;
+    return packed;
+  }
+
+ private:
+  static constexpr size_t kMaxBytes = size_t{256} << 20;
+
+  using Key = std::tuple<const T*, int, int, int, int, int, int, bool>;
+  struct Entry {
+    std::weak_ptr<phi::Allocation> holder;
+    uint64_t fingerprint;
+    std::shared_ptr<const std::vector<T>> packed;
+    size_t bytes;
+    typename std::list<Key>::iterator lru;
+  };
+
+  void Erase(typename std::map<Key, Entry>::iterator it) {
+    bytes_ -= it->second.bytes;
+    lru_.erase(it->second.lru);
+    entries_.erase(it);
+  }
+
+  static uint64_t Fingerprint(const T* data, int64_t numel) {
+    const char* bytes = reinterpret_cast<const char*>(data);
+    size_t size = static_cast<size_t>(numel) * sizeof(T);
+    uint64_t hash = 0xcbf29ce484222325ULL ^ size;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+      uint64_t word;
+      memcpy(&word, bytes + i, sizeof(uint64_t));
+      hash = (hash ^ word) * 0x100000001b3ULL;
+      hash ^= hash >> 29;
+    }
+    for (; i < size; ++i) {
+      hash = (hash ^ static_cast<uint8_t>(bytes[i])) * 0x100000001b3ULL;
+    }
+    return hash;
+  }
+
+  std::mutex mutex_;
+  std::map<Key, Entry> entries_;
+  // the keys of entries_, the most recently used first
+  std::list<Key> lru_;
+  size_t bytes_ = 0;
+};
+
+// Computes the kBlock output channels of the output (oh, ow), which may read
+// the padding, out_row points to the row oh of the first channel.
+template <typename T, int kBlock>
+inline void DirectConv2DForwardColumn(const T* in,
+                                      const T* filter,
+                                      const DirectConv2DParam& p,
+                                      const int* ow_begin,
+                                      const int* ow_end,
+                                      int oh,
+                                      int ow,
+                                      int oc_num,
+                                      int64_t out_size,
+                                      T* out_row) {
+  const int64_t in_size = static_cast<int64_t>(p.in_h) * p.in_w;
+  T acc[kBlock] = {};
+  for (int ic = 0; ic < p.in_per_group(); ++ic) {
+    const T* in_c = in + ic * in_size;
+    const T* filter_c = filter + ic * p.kernel_h * p.kernel_w * kBlock;
+    for (int kh = 0; kh < p.kernel_h; ++kh) {
+      int ih = oh * p.stride_h - p.pad_top + kh * p.dilation_h;
+      if (ih < 0 || ih >= p.in_h) {
+        continue;
+      }
+      const T* in_row = in_c + static_cast<int64_t>(ih) * p.in_w;
+      for (int kw = 0; kw < p.kernel_w; ++kw) {
+        if (ow < ow_begin[kw] || ow >= ow_end[kw]) {
+          continue;
+        }
+        const T* w = filter_c + (kh * p.kernel_w + kw) * kBlock;
+        T value =
+            in_row[ow * p.stride_w + kw * p.dilation_w - p.pad_left];
+        for (int b = 0; b < kBlock; ++b) {
+          acc[b] += value * w[b];
+        }
+      }
+    }
+  }
+  for (int b = 0; b < oc_num; ++b) {
+    out_row[b * out_size + ow] = acc[b];
+  }
+}
+
+template <typename T, int kBlock>
+void DirectConv2DForwardImpl(const T* input,
+                             const T* packed_filter,
+                             const DirectConv2DParam& p,
+                             T* output) {
+  const int icg = p.in_per_group();
+  const int ocg = p.out_per_group();
+  const int blocks = (ocg + kBlock - 1) / kBlock;
+  const int64_t in_size = static_cast<int64_t>(p.in_h) * p.in_w;
+  const int64_t out_size = static_cast<int64_t>(p.out_h) * p.out_w;
+  const int filter_block_size = icg * p.kernel_h * p.kernel_w * kBlock;
+  std::vector<int> ow_begin(p.kernel_w), ow_end(p.kernel_w);
+  for (int kw = 0; kw < p.kernel_w; ++kw) {
+    DirectConvValidRange(kw * p.dilation_w - p.pad_left,
+                         p.stride_w,
+                         p.in_w,
+                         p.out_w,
+                         &ow_begin[kw],
+                         &ow_end[kw]);
+  }
+  // the outputs in [ow_lo, ow_hi) read no padding for any kw, they are
+  // computed kTile at a time with the accumulators kept in registers
+  constexpr int kTile = 32 / sizeof(T) > 0 ? 32 / sizeof(T) : 1;
+  const int ow_lo = *std::max_element(ow_begin.begin(), ow_begin.end());
+  const int ow_hi = *std::min_element(ow_end.begin(), ow_end.end());
+
+  const int64_t tasks = p.batch * p.groups * blocks;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+  for (int64_t task = 0; task < tasks; ++task) {
+    int ob = static_cast<int>(task % blocks);
+    int g = static_cast<int>(task / blocks % p.groups);
+    int64_t n = task / blocks / p.groups;
+    const T* in = input + (n * p.in_channels + g * icg) * in_size;
+    const T* filter = packed_filter +
+                      static_cast<int64_t>(g * blocks + ob) * filter_block_size;
+    int oc_begin = g * ocg + ob * kBlock;
+    int oc_num = std::min(kBlock, ocg - ob * kBlock);
+    T* out = output + (n * p.out_channels + oc_begin) * out_size;
+
+    for (int oh = 0; oh < p.out_h; ++oh) {
+      T* out_row = out + oh * p.out_w;
+      int ow = 0;
+      for (; ow < std::min(ow_lo, p.out_w); ++ow) {
+        DirectConv2DForwardColumn<T, kBlock>(in,
+                                             filter,
+                                             p,
+                                             ow_begin.data(),
+                                             ow_end.data(),
+                                             oh,
+                                             ow,
+                                             oc_num,
+                                             out_size,
+                                             out_row);
+      }
+      for (; ow + kTile <= ow_hi; ow += kTile) {
+        T acc[kTile][kBlock] = {};
+        for (int ic = 0; ic < icg; ++ic) {
+          const T* in_c = in + ic * in_size;
+          const T* filter_c = filter + ic * p.kernel_h * p.kernel_w * kBlock;
+          for (int kh = 0; kh < p.kernel_h; ++kh) {
+            int ih = oh * p.stride_h - p.pad_top + kh * p.dilation_h;
+            if (ih < 0 || ih >= p.in_h) {
+              continue;
+            }
+            const T* in_row = in_c + static_cast<int64_t>(ih) * p.in_w;
+            for (int kw = 0; kw < p.kernel_w; ++kw) {
+              const T* w = filter_c + (kh * p.kernel_w + kw) * kBlock;
+              const T* x = in_row + ow * p.stride_w + kw * p.dilation_w -
+                           p.pad_left;
+              for (int t = 0; t < kTile; ++t) {
+                T value = x[t * p.stride_w];
+                for (int b = 0; b < kBlock; ++b) {
+                  acc[t][b] += value * w[b];
+                }
+              }
+            }
+          }
+        }
+        for (int b = 0; b < oc_num; ++b) {
+          for (int t = 0; t < kTile; ++t) {
+            out_row[b * out_size + ow + t] = acc[t][b];
+          }
+        }
+      }
+      for (; ow < p.out_w; ++ow) {
+        DirectConv2DForwardColumn<T, kBlock>(in,
+                                             filter,
+                                             p,
+                                             ow_begin.data(),
+                                             ow_end.data(),
+                                             oh,
+                                             ow,
+                                             oc_num,
+                                             out_size,
+                                             out_row);
+      }
+    }
+  }
+}
+
+template <typename T, int kBlock>
+void DirectConv2DBackwardInputImpl(const T* output_grad,
+                                   const T* packed_filter,
+                                   const DirectConv2DParam& p,
+                                   T* input_grad) {
+  const int icg = p.in_per_group();
+  const int ocg = p.out_per_group();
+  const int blocks = (icg + kBlock - 1) / kBlock;
+  const int64_t in_size = static_cast<int64_t>(p.in_h) * p.in_w;
+  const int64_t out_size = static_cast<int64_t>(p.out_h) * p.out_w;
+  const int filter_block_size = ocg * p.kernel_h * p.kernel_w * kBlock;
+  std::vector<int> ow_begin(p.kernel_w), ow_end(p.kernel_w);
+  for (int kw = 0; kw < p.kernel_w; ++kw) {
+    DirectConvValidRange(kw * p.dilation_w - p.pad_left,
+                         p.stride_w,
+                         p.in_w,
+                         p.out_w,
+                         &ow_begin[kw],
+                         &ow_end[kw]);
+  }
+
+  const int64_t tasks = p.batch * p.groups * blocks;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+  for (int64_t task = 0; task < tasks; ++task) {
+    int ib = static_cast<int>(task % blocks);
+    int g = static_cast<int>(task / blocks % p.groups);
+    int64_t n = task / blocks / p.groups;
+    const T* out_grad = output_grad + (n * p.out_channels + g * ocg) * out_size;
+    const T* filter = packed_filter +
+                      static_cast<int64_t>(g * blocks + ib) * filter_block_size;
+    int ic_begin = g * icg + ib * kBlock;
+    int ic_num = std::min(kBlock, icg - ib * kBlock);
+    T* in_grad = input_grad + (n * p.in_channels + ic_begin) * in_size;
+
+    std::vector<T> acc(static_cast<size_t>(p.in_w) * kBlock);
+    for (int ih = 0; ih < p.in_h; ++ih) {
+      std::fill(acc.begin(), acc.end(), static_cast<T>(0));
+      for (int oc = 0; oc < ocg; ++oc) {
+        const T* out_grad_c = out_grad + oc * out_size;
+        const T* filter_c = filter + oc * p.kernel_h * p.kernel_w * kBlock;
+        for (int kh = 0; kh < p.kernel_h; ++kh) {
+          int t = ih + p.pad_top - kh * p.dilation_h;
+          if (t < 0 || t % p.stride_h != 0 || t / p.stride_h >= p.out_h) {
+            continue;
+          }
+          const T* out_grad_row =
+              out_grad_c + static_cast<int64_t>(t / p.stride_h) * p.out_w;
+          for (int kw = 0; kw < p.kernel_w; ++kw) {
+            const T* w = filter_c + (kh * p.kernel_w + kw) * kBlock;
+            int offset = kw * p.dilation_w - p.pad_left;
+            for (int ow = ow_begin[kw]; ow < ow_end[kw]; ++ow) {
+              T value = out_grad_row[ow];
+              T* a_ow = acc.data() + (ow * p.stride_w + offset) * kBlock;
+              for (int b = 0; b < kBlock; ++b) {
+                a_ow[b] += value * w[b];
+              }
+            }
+          }
+        }
+      }
+      for (int b = 0; b < ic_num; ++b) {
+        T* in_grad_row = in_grad + b * in_size + ih * p.in_w;
+        for (int iw = 0; iw < p.in_w; ++iw) {
+          in_grad_row[iw] = acc[iw * kBlock + b];
+        }
+      }
+    }
+  }
+}
+
+// y = conv2d(x, filter), x and y are NCHW.
+// filter_holder is the allocation holding the filter, by which the packed
+// filter is cached, or null.
+template <typename T>
+void DirectConv2DForward(const T* input,
+                         const T* filter,
+                         const std::shared_ptr<phi::Allocation>& filter_holder,
+                         const DirectConv2DParam& p,
+                         T* output) {
+  constexpr int kBlock = 8;
+  if (p.out_per_group() >= kBlock) {
+    auto packed = DirectConv2DFilterCache<T>::Instance().Get(
+        filter_holder, filter, p, kBlock, false);
+    DirectConv2DForwardImpl<T, kBlock>(input, packed->data(), p, output);
+  } else {
+    // the filter is its own packing with blocks of one channel
+    DirectConv2DForwardImpl<T, 1>(input, filter, p, output);
+  }
+}
+
+// Overwrites input_grad with the gradient of the input.
+template <typename T>
+void DirectConv2DBackwardInput(
+    const T* output_grad,
+    const T* filter,
+    const std::shared_ptr<phi::Allocation>& filter_holder,
+    const DirectConv2DParam& p,
+    T* input_grad) {
+  constexpr int kBlock = 8;
+  int block = p.in_per_group() >= kBlock ? kBlock : 1;
+  auto packed = DirectConv2DFilterCache<T>::Instance().Get(
+      filter_holder, filter, p, block, true);
+  if (block == kBlock) {
+    DirectConv2DBackwardInputImpl<T, kBlock>(
+        output_grad, packed->data(), p, input_grad);
+  } else {
+    DirectConv2DBackwardInputImpl<T, 1>(
+        output_grad, packed->data(), p, input_grad);
+  }
+}
+
+// Overwrites filter_grad with the gradient of the filter, the tasks of
+// (out channel, in channel) are shared among the threads.
+template <typename T>
+void DirectConv2DBackwardFilter(const T* input,
+                                const T* output_grad,
+                                const DirectConv2DParam& p,
+                                T* filter_grad) {
+  const int icg = p.in_per_group();
+  const int ocg = p.out_per_group();
+  const int64_t in_size = static_cast<int64_t>(p.in_h) * p.in_w;
+  const int64_t out_size = static_cast<int64_t>(p.out_h) * p.out_w;
+  std::vector<int> oh_begin(p.kernel_h), oh_end(p.kernel_h);
+  std::vector<int> ow_begin(p.kernel_w), ow_end(p.kernel_w);
+  for (int kh = 0; kh < p.kernel_h; ++kh) {
+    DirectConvValidRange(kh * p.dilation_h - p.pad_top,
+                         p.stride_h,
+                         p.in_h,
+                         p.out_h,
+                         &oh_begin[kh],
+                         &oh_end[kh]);
+  }
+  for (int kw = 0; kw < p.kernel_w; ++kw) {
+    DirectConvValidRange(kw * p.dilation_w - p.pad_left,
+                         p.stride_w,
+                         p.in_w,
+                         p.out_w,
+                         &ow_begin[kw],
+                         &ow_end[kw]);
+  }
+
+  const int64_t tasks = static_cast<int64_t>(p.out_channels) * icg;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+  for (int64_t task = 0; task < tasks; ++task) {
+    int oc = static_cast<int>(task / icg);
+    int ic = static_cast<int>(task % icg);
+    int g = oc / ocg;
+    T* dw = filter_grad + task * p.kernel_h * p.kernel_w;
+    for (int kh = 0; kh < p.kernel_h; ++kh) {
+      for (int kw = 0; kw < p.kernel_w; ++kw) {
+        T sum = static_cast<T>(0);
+        for (int64_t n = 0; n < p.batch; ++n) {
+          const T* out_grad_c =
+              output_grad + (n * p.out_channels + oc) * out_size;
+          const T* in_c = input + (n * p.in_channels + g * icg + ic) * in_size;
+          for (int oh = oh_begin[kh]; oh < oh_end[kh]; ++oh) {
+            int ih = oh * p.stride_h - p.pad_top + kh * p.dilation_h;
+            const T* out_grad_row = out_grad_c + oh * p.out_w;
+            const T* in_row = in_c + static_cast<int64_t>(ih) * p.in_w;
+            int offset = kw * p.dilation_w - p.pad_left;
+            for (int ow = ow_begin[kw]; ow < ow_end[kw]; ++ow) {
+              sum += out_grad_row[ow] * in_row[ow * p.stride_w + offset];
+            }
+          }
+        }
+        dw[kh * p.kernel_w + kw] = sum;
+      }
+    }
+  }
+}
+
+}  // namespace funcs
+}  // namespace phi
@@ -354,6 +354,9 @@ void CommonElementwiseBroadcastForward(const CPUContext &dev_ctx,
                                                  is_xsize_larger);
 }
 
+// The cycles of computing an element of a binary elementwise op.
+constexpr double kCPUElementwiseCost = 1.0;
+
 // It is a common CPU implementation to compute binary calculation with the
 // support of broadcast. Note:
 // 1. CPU implementation cannot support the case when x needs broadcast, thus
@@ -379,12 +382,20 @@ void ElementwiseCompute(const CPUContext &dev_ctx,
     is_xsize_larger = false;
     max_dim = y_dims.size();
   }
-  TransformFunctor<Functor, T, CPUContext, OutType> functor(
-      x, y, z, dev_ctx, func, is_xsize_larger);
   if (x_dims == y_dims) {
-    functor.Run();
+    const T *x_data = x.data<T>();
+    const T *y_data = y.data<T>();
+    OutType *z_data = z->data<OutType>();
+    dev_ctx.ParallelFor(
+        x.numel(), kCPUElementwiseCost, [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; ++i) {
+            z_data[i] = func(x_data[i], y_data[i]);
+          }
+        });
     return;
   }
+  TransformFunctor<Functor, T, CPUContext, OutType> functor(
+      x, y, z, dev_ctx, func, is_xsize_larger);
 
   axis = (axis == -1 ? std::abs(x_dims.size() - y_dims.size()) : axis);
   PADDLE_ENFORCE_GE(
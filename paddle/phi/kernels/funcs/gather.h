@@ -26,6 +26,9 @@ limitations under the License. */
 namespace phi {
 namespace funcs {
 
+// The cycles of copying an element of a slice.
+constexpr double kCPUGatherCost = 1.0;
+
 /**
  * A thin wrapper for gathering on cpu tensor
  * Return a new tensor from source tensor, gathered according to index
@@ -34,7 +37,7 @@ namespace funcs {
  * return: output tensor
  */
 template <typename T, typename IndexT = int>
-void CPUGather(const phi::CPUContext& ctx UNUSED,
+void CPUGather(const phi::CPUContext& ctx,
                const DenseTensor& src,
                const DenseTensor& index,
                DenseTensor* output) {
@@ -92,9 +95,20 @@ void CPUGather(const phi::CPUContext& ctx UNUSED,
             -index_dim_size,
             p_index[i],
             i));
-    IndexT index_ = (p_index[i] < 0 ? p_index[i] + index_dim_size : p_index[i]);
-    memcpy(p_output + i * slice_size, p_src + index_ * slice_size, slice_bytes);
   }
+
+  ctx.ParallelFor(
+      index_size,
+      kCPUGatherCost * static_cast<double>(slice_size),
+      [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; ++i) {
+          IndexT index_ =
+              (p_index[i] < 0 ? p_index[i] + index_dim_size : p_index[i]);
+          memcpy(p_output + i * slice_size,
+                 p_src + index_ * slice_size,
+                 slice_bytes);
+        }
+      });
 }
 
 template <typename T, typename IndexT = int>
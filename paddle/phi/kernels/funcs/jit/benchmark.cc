@@ -14,14 +14,19 @@
 
 #include <iostream>
 #include <random>
+#include <type_traits>
+#include <vector>
 
 #include "glog/logging.h"
 #include "paddle/common/flags.h"
 #include "paddle/phi/api/profiler/device_tracer.h"
+#include "paddle/phi/common/amp_type_traits.h"
 #include "paddle/phi/common/place.h"
 #include "paddle/phi/core/dense_tensor.h"
 #include "paddle/phi/core/enforce.h"
+#include "paddle/phi/kernels/funcs/cpu_reduce.h"
 #include "paddle/phi/kernels/funcs/jit/kernels.h"
+#include "paddle/phi/kernels/funcs/layer_norm_cpu.h"
 
 PD_DEFINE_int32(burning, 10, "Burning times.");
 PD_DEFINE_int32(repeat, 3000, "Repeat times.");
@@ -89,20 +94,26 @@ std::vector<int> TestSizes() {
   return s;
 }
 
+// return the avg time of func, which is called without arguments
+template <typename Func>
+double BenchAvgTime(Func&& func) {
+  for (int i = 0; i < FLAGS_burning; ++i) {
+    func();
+  }
+  double start = static_cast<double>(phi::PosixInNsec()) * 1e-3;
+  for (int i = 0; i < FLAGS_repeat; ++i) {
+    func();
+  }
+  double end = static_cast<double>(phi::PosixInNsec()) * 1e-3;
+  return static_cast<double>(end - start) / FLAGS_repeat;
+}
+
 template <typename KernelTuple, typename... Args>
 struct BenchFunc {
   // return this function avg time
   // TODO(TJ): clear cache every time
   double operator()(const typename KernelTuple::func_type tgt, Args... args) {
-    for (int i = 0; i < FLAGS_burning; ++i) {
-      tgt(args...);
-    }
-    double start = static_cast<double>(phi::PosixInNsec()) * 1e-3;
-    for (int i = 0; i < FLAGS_repeat; ++i) {
-      tgt(args...);
-    }
-    double end = static_cast<double>(phi::PosixInNsec()) * 1e-3;
-    return static_cast<double>(end - start) / FLAGS_repeat;
+    return BenchAvgTime([&]() { tgt(args...); });
   }
 };
 
@@ -426,6 +437,125 @@ void BenchKernelLayerNorm() {
   }
 }
 
+// The single-pass LayerNorm of the CPU kernel, with the float jit LayerNorm
+// of the same shape for comparison.
+template <typename T>
+void BenchLayerNormCPU() {
+  using U = typename phi::dtype::MPTypeTrait<T>::Type;
+  const float epsilon = 9.99999975e-06;
+  for (int left : {1, 16, 128, 1024}) {
+    for (int right : {64, 256, 768, 1024, 4096}) {
+      int sz = left * right;
+      std::vector<float> x_float(sz), dy_float(sz), param_float(right);
+      RandomVec<float>(sz, x_float.data(), -2.f, 2.f);
+      RandomVec<float>(sz, dy_float.data(), -2.f, 2.f, 101);
+      RandomVec<float>(right, param_float.data(), -2.f, 2.f, 102);
+      std::vector<T> x(x_float.begin(), x_float.end());
+      std::vector<T> dy(dy_float.begin(), dy_float.end());
+      std::vector<T> scale(param_float.begin(), param_float.end());
+      std::vector<T> bias(param_float.rbegin(), param_float.rend());
+      std::vector<T> y(sz), dx(sz), d_scale(right), d_bias(right);
+      std::vector<U> mean(left), var(left);
+
+      double forward = BenchAvgTime([&]() {
+        phi::funcs::LayerNormForwardCPU<T, U, T>(x.data(),
+                                                 y.data(),
+                                                 mean.data(),
+                                                 var.data(),
+                                                 scale.data(),
+                                                 bias.data(),
+                                                 left,
+                                                 right,
+                                                 epsilon);
+      });
+      double backward = BenchAvgTime([&]() {
+        phi::funcs::LayerNormBackwardCPU<T, U, T>(x.data(),
+                                                  dy.data(),
+                                                  mean.data(),
+                                                  var.data(),
+                                                  scale.data(),
+                                                  left,
+                                                  right,
+                                                  epsilon,
+                                                  dx.data(),
+                                                  d_scale.data(),
+                                                  d_bias.data());
+      });
+      std::ostringstream loginfos;
+      loginfos << "LayerNorm CPU " << left << "x" << right
+               << ": Forward takes " << forward << " us; Backward takes "
+               << backward << " us; ";
+      if constexpr (std::is_same<T, float>::value) {
+        auto jit_ker = jit::KernelFuncs<jit::LayerNormTuple<float>,
+                                        phi::CPUPlace>::Cache()
+                           .At(right);
+        double jit_forward = BenchAvgTime([&]() {
+          jit_ker(x.data(),
+                  y.data(),
+                  mean.data(),
+                  var.data(),
+                  scale.data(),
+                  bias.data(),
+                  left,
+                  epsilon,
+                  right);
+        });
+        loginfos << "Jit Forward takes " << jit_forward << " us; ";
+      }
+      LOG(INFO) << loginfos.str();
+    }
+  }
+}
+
+// The CPU reduction engine over the shapes and axes common in models: the
+// spatial dims of NCHW, the batch and the hidden dims of [batch, hidden], the
+// batch and sequence dims of [batch, seq, hidden] and everything.
+template <typename T>
+void BenchReduceCPU() {
+  using phi::funcs::CPUReduceType;
+  struct ReduceCase {
+    std::vector<int64_t> dims;
+    std::vector<int64_t> axes;
+  };
+  const std::vector<ReduceCase> cases = {{{8, 64, 56, 56}, {2, 3}},
+                                         {{8, 64, 56, 56}, {0, 2, 3}},
+                                         {{1024, 1024}, {0}},
+                                         {{1024, 1024}, {1}},
+                                         {{16, 128, 768}, {0, 1}},
+                                         {{16, 128, 768}, {2}},
+                                         {{4, 1000000}, {0, 1}}};
+  for (const auto& c : cases) {
+    int64_t numel = 1;
+    for (int64_t d : c.dims) {
+      numel *= d;
+    }
+    std::vector<float> x_float(numel);
+    RandomVec<float>(numel, x_float.data(), -2.f, 2.f);
+    std::vector<T> x(x_float.begin(), x_float.end());
+    std::vector<T> out(numel);
+    double sum = BenchAvgTime([&]() {
+      phi::funcs::CPUReduce<CPUReduceType::kSum, T>(
+          x.data(), c.dims, c.axes, out.data());
+    });
+    double mean = BenchAvgTime([&]() {
+      phi::funcs::CPUReduce<CPUReduceType::kMean, T>(
+          x.data(), c.dims, c.axes, out.data());
+    });
+    double max = BenchAvgTime([&]() {
+      phi::funcs::CPUReduce<CPUReduceType::kMax, T>(
+          x.data(), c.dims, c.axes, out.data());
+    });
+    std::ostringstream loginfos;
+    loginfos << "Reduce CPU " << phi::make_ddim(c.dims) << " axes "
+             << phi::make_ddim(c.axes) << ": Sum takes " << sum
+             << " us; Mean takes " << mean << " us; Max takes " << max
+             << " us; Sum reads "
+             << static_cast<double>(numel * sizeof(T)) / sum * 1e-3
+             << " GB/s";
+    LOG(INFO) << loginfos.str();
+  }
+}
+
 template <typename KernelTuple, typename PlaceType>
 void BenchKernelCRFDecoding() {
   using T = typename KernelTuple::data_type;
@@ -531,6 +661,15 @@ BENCH_FP32_CPU(GRUHtPart1);
 BENCH_FP32_CPU(GRUHtPart2);
 
 BENCH_FP32_CPU(LayerNorm);
+BENCH_JITKERNEL(LayerNormCPU, FP32, CPU) { BenchLayerNormCPU<float>(); }
+BENCH_JITKERNEL(LayerNormCPU, FP16, CPU) {
+  BenchLayerNormCPU<phi::dtype::float16>();
+}
+BENCH_JITKERNEL(LayerNormCPU, BF16, CPU) {
+  BenchLayerNormCPU<phi::dtype::bfloat16>();
+}
+BENCH_JITKERNEL(ReduceCPU, FP32, CPU) { BenchReduceCPU<float>(); }
+BENCH_JITKERNEL(ReduceCPU, FP16, CPU) { BenchReduceCPU<phi::dtype::float16>(); }
 BENCH_FP32_CPU(CRFDecoding);
 
 BENCH_FP32_CPU(SeqPool);
@@ -44,6 +44,10 @@ const int ALIGN32_BEG exp_int_0x7f[] ALIGN32_END = {  // NOLINT
 int ALIGN32_BEG g_tmp_mem[16] ALIGN32_END = {0};      // NOLINT
 
 void VActJitCode::genCode() {
+  if (use_avx512_) {
+    genCodeAVX512();
+    return;
+  }
   int offset = 0;
   for (int i = 0; i < num_ / YMM_FLOAT_BLOCK; ++i) {
     vmovups(ymm_src, ptr[param1 + offset]);
@@ -78,6 +82,26 @@ void VActJitCode::genCode() {
   ret();
 }
 
+void VActJitCode::genCodeAVX512() {
+  mov(reg_consts, reinterpret_cast<size_t>(exp_float_consts));
+  int offset = 0;
+  for (int i = 0; i < num_ / ZMM_FLOAT_BLOCK; ++i) {
+    vmovups(zmm_src, ptr[param1 + offset]);
+    act_zmm(zmm_dst, zmm_src, type_, reg_consts);
+    vmovups(ptr[param2 + offset], zmm_dst);
+    offset += sizeof(float) * ZMM_FLOAT_BLOCK;
+  }
+  int rest = num_ % ZMM_FLOAT_BLOCK;
+  if (rest > 0) {
+    mov(reg_tail_mask, (1 << rest) - 1);
+    kmovw(k_tail, reg_tail_mask);
+    vmovups(zmm_src | k_tail | T_z, ptr[param1 + offset]);
+    act_zmm(zmm_dst, zmm_src, type_, reg_consts);
+    vmovups(ptr[param2 + offset] | k_tail, zmm_dst);
+  }
+  ret();
+}
+
 #define DECLARE_ACT_CREATOR(name)                                            \
   class name##Creator : public JitCodeCreator<int> {                         \
    public:                                                                   \
@@ -242,6 +242,102 @@ class VActFunc : public JitCode {
     // dst.setIdx(src.getIdx());
   }
 
+  // The AVX-512 versions below read the constants by embedded broadcast from
+  // exp_float_consts, whose address should be in reg_consts, and use zmm26 ~
+  // zmm31 as temporaries.
+
+  // compute EXP with zmm, 2^n is applied by vscalefps
+  void exp_zmm(const zmm_t& dst, const zmm_t& src, reg64_t& reg_consts) {
+    zmm_t zmm_src = zmm_t(28);
+    zmm_t zmm_fx = zmm_t(29);
+    zmm_t zmm_z = zmm_t(30);
+    zmm_t zmm_tmp = zmm_t(31);
+    vminps(zmm_src, src, ptr_b[reg_consts + OFFSET_EXP_HIG]);
+    vmaxps(zmm_src, zmm_src, ptr_b[reg_consts + OFFSET_EXP_LOW]);
+    // express exp(x) as exp(g + n*log(2))
+    vmulps(zmm_fx, zmm_src, ptr_b[reg_consts + OFFSET_EXP_LOG2EF]);
+    vaddps(zmm_fx, zmm_fx, ptr_b[reg_consts + OFFSET_EXP_0P5]);
+    vrndscaleps(zmm_fx, zmm_fx, 0x09);  // floor, suppress exceptions
+    vmulps(zmm_tmp, zmm_fx, ptr_b[reg_consts + OFFSET_EXP_C1]);
+    vsubps(zmm_src, zmm_src, zmm_tmp);
+    vmulps(zmm_tmp, zmm_fx, ptr_b[reg_consts + OFFSET_EXP_C2]);
+    vsubps(zmm_src, zmm_src, zmm_tmp);
+    vmulps(zmm_z, zmm_src, zmm_src);
+    vmulps(dst, zmm_src, ptr_b[reg_consts + OFFSET_EXP_P0]);
+    for (size_t i = OFFSET_EXP_P1; i < OFFSET_EXP_P5;
+         i += (YMM_FLOAT_BLOCK * sizeof(float))) {
+      vaddps(dst, dst, ptr_b[reg_consts + i]);  // P1~P4
+      vmulps(dst, dst, zmm_src);
+    }
+    vaddps(dst, dst, ptr_b[reg_consts + OFFSET_EXP_P5]);
+    vmulps(dst, dst, zmm_z);
+    vaddps(dst, dst, zmm_src);
+    vaddps(dst, dst, ptr_b[reg_consts + OFFSET_EXP_ONE]);
+    vscalefps(dst, dst, zmm_fx);
+  }
+
+  // compute SIGMOID with zmm
+  void sigmoid_zmm(const zmm_t& dst, const zmm_t& src, reg64_t& reg_consts) {
+    // y = 1 / (1 + e^-x)
+    zmm_t zmm_zero = zmm_t(26);
+    zmm_t zmm_src = zmm_t(27);
+    vminps(zmm_src, src, ptr_b[reg_consts + OFFSET_SIGMOID_MAX]);
+    vmaxps(zmm_src, zmm_src, ptr_b[reg_consts + OFFSET_SIGMOID_MIN]);
+    vpxord(zmm_zero, zmm_zero, zmm_zero);
+    vsubps(zmm_src, zmm_zero, zmm_src);
+    exp_zmm(dst, zmm_src, reg_consts);
+    vaddps(dst, dst, ptr_b[reg_consts + OFFSET_EXP_ONE]);
+    vbroadcastss(zmm_src, ptr[reg_consts + OFFSET_EXP_ONE]);
+    vdivps(dst, zmm_src, dst);
+  }
+
+  // compute TANH with zmm
+  void tanh_zmm(const zmm_t& dst, const zmm_t& src, reg64_t& reg_consts) {
+    // y = 2 / (1 + e^(-2x)) - 1
+    zmm_t zmm_zero = zmm_t(26);
+    zmm_t zmm_src = zmm_t(27);
+    vmulps(zmm_src, src, ptr_b[reg_consts + OFFSET_EXP_TWO]);
+    vpxord(zmm_zero, zmm_zero, zmm_zero);
+    vsubps(zmm_src, zmm_zero, zmm_src);
+    exp_zmm(dst, zmm_src, reg_consts);
+    vaddps(dst, dst, ptr_b[reg_consts + OFFSET_EXP_ONE]);
+    vbroadcastss(zmm_src, ptr[reg_consts + OFFSET_EXP_TWO]);
+    vdivps(dst, zmm_src, dst);
+    vsubps(dst, dst, ptr_b[reg_consts + OFFSET_EXP_ONE]);
+  }
+
+  void act_zmm(const zmm_t& dst,
+               const zmm_t& src,
+               operand_type type,
+               reg64_t& reg_consts) {
+    zmm_t zmm_zero = zmm_t(26);
+    switch (type) {
+      case operand_type::RELU:
+        vpxord(zmm_zero, zmm_zero, zmm_zero);
+        vmaxps(dst, src, zmm_zero);
+        break;
+      case operand_type::SQUARE:
+        vmulps(dst, src, src);
+        break;
+      case operand_type::EXP:
+        exp_zmm(dst, src, reg_consts);
+        break;
+      case operand_type::SIGMOID:
+        sigmoid_zmm(dst, src, reg_consts);
+        break;
+      case operand_type::TANH:
+        tanh_zmm(dst, src, reg_consts);
+        break;
+      case operand_type::IDENTITY:
+        vmovaps(dst, src);
+        break;
+      default:
+        PADDLE_THROW(common::errors::Unimplemented(
+            "Do not support operand type code: %d.", type));
+        break;
+    }
+  }
+
   template <typename JMM>
   void act(JMM& dst, JMM& src, operand_type type) {  // NOLINT
     // use 11~15
@@ -278,7 +374,11 @@ class VActJitCode : public VActFunc {
                        operand_type type,
                        size_t code_size,
                        void* code_ptr = nullptr)
-      : VActFunc(code_size, code_ptr), num_(d), type_(type) {
+      : VActFunc(code_size, code_ptr),
+        num_(d),
+        type_(type),
+        use_avx512_(
+            phi::backends::cpu::MayIUse(phi::backends::cpu::avx512f)) {
     if (!(type_ == operand_type::RELU || type_ == operand_type::EXP ||
           type_ == operand_type::SIGMOID || type_ == operand_type::TANH ||
           type_ == operand_type::IDENTITY || type_ == operand_type::SQUARE)) {
@@ -312,21 +412,33 @@ class VActJitCode : public VActFunc {
       default:
         break;
     }
+    if (use_avx512_) {
+      base += "_AVX512";
+    }
     return base;
   }
   void genCode() override;
 
  protected:
+  // the zmm blocks, the tail is loaded and stored with an opmask
+  void genCodeAVX512();
+
   int num_;
   operand_type type_;
+  bool use_avx512_;
   reg64_t param1{abi_param1};
   reg64_t param2{abi_param2};
+  reg64_t reg_consts{rax};
+  reg32_t reg_tail_mask{ecx};
+  opmask_t k_tail{1};
 
   xmm_t xmm_src = xmm_t(0);
   ymm_t ymm_src = ymm_t(0);
+  zmm_t zmm_src = zmm_t(0);
 
   xmm_t xmm_dst = xmm_t(1);
   ymm_t ymm_dst = ymm_t(1);
+  zmm_t zmm_dst = zmm_t(1);
 };
 
 #define DECLARE_ACT_JITCODE(name, op_type)                                    \
@@ -21,6 +21,10 @@
 namespace phi::jit::gen {
 
 void VXXJitCode::genCode() {
+  if (use_avx512_) {
+    genCodeAVX512();
+    return;
+  }
   // do not need push stack, and do not need save avx512reg if do not use avx512
   int offset = 0;
   if (with_relu_) {
@@ -108,6 +112,52 @@ void VXXJitCode::genCode() {
   ret();
 }
 
+void VXXJitCode::genCodeAVX512() {
+  int offset = 0;
+  if (with_relu_) {
+    vpxord(zmm_zero, zmm_zero, zmm_zero);
+  }
+  if (scalar_index_ == 1) {
+    vbroadcastss(zmm_src1, ptr[param1]);
+  } else if (scalar_index_ == 2) {
+    vbroadcastss(zmm_src2, ptr[param2]);
+  }
+  int blocks = num_ / ZMM_FLOAT_BLOCK;
+  int rest = num_ % ZMM_FLOAT_BLOCK;
+  if (rest > 0) {
+    mov(reg_tail_mask, (1 << rest) - 1);
+    kmovw(k_tail, reg_tail_mask);
+  }
+  for (int i = 0; i < blocks + (rest > 0 ? 1 : 0); ++i) {
+    bool tail = i == blocks;
+    if (scalar_index_ != 1) {
+      vmovups(tail ? zmm_src1 | k_tail | T_z : zmm_src1,
+              ptr[param1 + offset]);
+    }
+    if (scalar_index_ != 2) {
+      vmovups(tail ? zmm_src2 | k_tail | T_z : zmm_src2,
+              ptr[param2 + offset]);
+    }
+    if (type_ == operand_type::MUL) {
+      vmulps(zmm_dst, zmm_src1, zmm_src2);
+    } else if (type_ == operand_type::ADD) {
+      vaddps(zmm_dst, zmm_src1, zmm_src2);
+    } else if (type_ == operand_type::SUB) {
+      vsubps(zmm_dst, zmm_src1, zmm_src2);
+    }
+    if (with_relu_) {
+      vmaxps(zmm_dst, zmm_zero, zmm_dst);
+    }
+    if (tail) {
+      vmovups(ptr[param3 + offset] | k_tail, zmm_dst);
+    } else {
+      vmovups(ptr[param3 + offset], zmm_dst);
+    }
+    offset += sizeof(float) * ZMM_FLOAT_BLOCK;
+  }
+  ret();
+}
+
 #define DECLARE_BLAS_CREATOR(name)                                           \
   class name##Creator : public JitCodeCreator<int> {                         \
    public:                                                                   \
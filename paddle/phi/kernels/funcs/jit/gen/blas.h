@@ -37,7 +37,9 @@ class VXXJitCode : public JitCode {
         num_(d),
         type_(type),
         scalar_index_(scalar_index),
-        with_relu_(with_relu) {
+        with_relu_(with_relu),
+        use_avx512_(
+            phi::backends::cpu::MayIUse(phi::backends::cpu::avx512f)) {
     if (!(type_ == operand_type::MUL || type_ == operand_type::ADD ||
           type_ == operand_type::SUB)) {
       PADDLE_THROW(common::errors::Unimplemented(
@@ -67,18 +69,25 @@ class VXXJitCode : public JitCode {
     }
     base += (with_relu_ ? "_Relu" : "");
     base += "_D" + std::to_string(num_);
+    base += (use_avx512_ ? "_AVX512" : "");
     return base;
   }
   void genCode() override;
 
  private:
+  // the zmm blocks, the tail is loaded and stored with an opmask
+  void genCodeAVX512();
+
   int num_;
   operand_type type_;
   int scalar_index_;
   bool with_relu_;
+  bool use_avx512_;
   reg64_t param1{abi_param1};
   reg64_t param2{abi_param2};
   reg64_t param3{abi_param3};
+  reg32_t reg_tail_mask{r8d};
+  opmask_t k_tail{1};
 
   xmm_t xmm_src1 = xmm_t(0);
   xmm_t xmm_src2 = xmm_t(1);
@@ -89,6 +98,11 @@ class VXXJitCode : public JitCode {
   ymm_t ymm_src2 = ymm_t(1);
   ymm_t ymm_dst = ymm_t(2);
   ymm_t ymm_zero = ymm_t(3);
+
+  zmm_t zmm_src1 = zmm_t(0);
+  zmm_t zmm_src2 = zmm_t(1);
+  zmm_t zmm_dst = zmm_t(2);
+  zmm_t zmm_zero = zmm_t(3);
 };
 
 #define DECLARE_BLAS_JITCODE(name, op_type, scalar_idx, with_relu)             \
@@ -18,6 +18,7 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>  // for std::move
 #include <vector>
@@ -26,6 +27,7 @@
 #include "paddle/phi/core/enforce.h"
 #include "paddle/phi/kernels/funcs/jit/gen_base.h"
 #include "paddle/phi/kernels/funcs/jit/kernel_base.h"
+#include "paddle/phi/kernels/funcs/jit/kernel_cache.h"
 #include "paddle/phi/kernels/funcs/jit/kernel_key.h"
 #include "paddle/phi/kernels/funcs/jit/kernel_pool.h"
 
@@ -41,11 +43,24 @@ inline typename std::enable_if<
     const Kernel*>::type
 GetJitCode(const typename KernelTuple::attr_type& attr) {
   using Attr = typename KernelTuple::attr_type;
+  // the attrs are recorded by their bytes
+  static_assert(std::is_trivially_copyable<Attr>::value,
+                "The attr of jitcode should be trivially copyable.");
   int64_t key = JitCodeKey<Attr>(attr);
   auto& codes = JitCodePool<KernelTuple::kernel_type>::Instance();
   if (codes.Has(key)) {
+    CountKernelCacheEvent(KernelCacheEvent::kCodeHit);
     return codes.AllKernels().at(key).get();
   }
+  // the code generated by another thread or by WarmUpJitKernels
+  auto& shared_codes = SharedJitCodePool::Instance();
+  auto code = shared_codes.Find(KernelTuple::kernel_type, key);
+  if (code) {
+    codes.Insert(key, code);
+    CountKernelCacheEvent(KernelCacheEvent::kCodeHit);
+    RecordJitCodeAttr(KernelTuple::kernel_type, key, &attr, sizeof(Attr));
+    return code.get();
+  }
 
   // creator is not related with attr, so can use KernelKey as key
   KernelKey kkey(KernelTuple::kernel_type, PlaceType());
@@ -59,9 +74,12 @@ GetJitCode(const typename KernelTuple::attr_type& attr) {
       if (i && i->CanBeUsed(attr)) {
         auto p = i->CreateJitCode(attr);
         if (p) {
-          auto res = p.get();
-          codes.Insert(key, std::move(p));
-          return res;
+          code = shared_codes.Insert(
+              KernelTuple::kernel_type, key, std::move(p));
+          codes.Insert(key, code);
+          CountKernelCacheEvent(KernelCacheEvent::kCodeMiss);
+          RecordJitCodeAttr(KernelTuple::kernel_type, key, &attr, sizeof(Attr));
+          return code.get();
         }
       }
     }
@@ -222,8 +240,10 @@ class KernelFuncs {
     // Maybe here is not good enough, not all kernels should have jitcode
     int64_t key = JitCodeKey<typename KernelTuple::attr_type>(attr);
     if (Has(key)) {
+      CountKernelCacheEvent(KernelCacheEvent::kFuncHit);
       return funcs_.at(key);
     }
+    CountKernelCacheEvent(KernelCacheEvent::kFuncMiss);
     // If do not have this attr in cache then get the default best
     auto func = GetDefaultBestFunc<KernelTuple, PlaceType>(attr);
     Insert(key, func);
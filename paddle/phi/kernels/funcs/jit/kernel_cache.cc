@@ -0,0 +1,393 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "paddle/phi/kernels/funcs/jit/kernel_cache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "glog/logging.h"
+#include "paddle/phi/kernels/funcs/jit/helper.h"
+
+PHI_DEFINE_string(jit_kernel_cache_file,
+                  "",
+                  "The file recording the attrs of the jitcode generated, "
+                  "which can be generated again by WarmUpJitKernels. "
+                  "Nothing is recorded if it is empty.");
+PHI_DEFINE_int32(jit_kernel_cache_max_records,
+                 4096,
+                 "The max number of the records of jit_kernel_cache_file, "
+                 "beyond which the oldest ones not used by this process are "
+                 "dropped. No limit if it is not positive.");
+
+namespace phi::jit {
+
+namespace {
+
+constexpr int kNumCacheEvents = 4;
+
+// The counters of a thread, which are only written by their thread and read
+// by GetKernelCacheStats, so no atomic read-modify-write is needed.
+struct ThreadCacheCounters {
+  ThreadCacheCounters();
+  ~ThreadCacheCounters();
+  std::atomic<uint64_t> counts[kNumCacheEvents] = {};
+};
+
+class KernelCacheCounters {
+ public:
+  // never destroyed, so the threads exiting at shutdown can still retire
+  static KernelCacheCounters& Instance() {
+    static auto* counters = new KernelCacheCounters();
+    return *counters;
+  }
+
+  void Register(ThreadCacheCounters* thread) {
+    std::lock_guard<std::mutex> lock(mu_);
+    threads_.insert(thread);
+  }
+
+  // keeps the counts of an exiting thread
+  void Retire(ThreadCacheCounters* thread) {
+    std::lock_guard<std::mutex> lock(mu_);
+    for (int i = 0; i < kNumCacheEvents; ++i) {
+      retired_[i] += thread->counts[i].load(std::memory_order_relaxed);
+    }
+    threads_.erase(thread);
+  }
+
+  void Sum(uint64_t* counts) {
+    for (int i = 0; i < kNumCacheEvents; ++i) {
+      counts[i] = retired_[i];
+    }
+    for (auto* thread : threads_) {
+      for (int i = 0; i < kNumCacheEvents; ++i) {
+        counts[i] += thread->counts[i].load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  KernelCacheStats Get() {
+    std::lock_guard<std::mutex> lock(mu_);
+    uint64_t counts[kNumCacheEvents];
+    Sum(counts);
+    KernelCacheStats stats;
+    stats.func_hits = counts[0] - base_[0];
+    stats.func_misses = counts[1] - base_[1];
+    stats.code_hits = counts[2] - base_[2];
+    stats.code_misses = counts[3] - base_[3];
+    return stats;
+  }
+
+  // the counters of the threads are not cleared, which would race with
+  // their increments, but become the new base
+  void Reset() {
+    std::lock_guard<std::mutex> lock(mu_);
+    Sum(base_);
+  }
+
+ private:
+  std::mutex mu_;
+  std::unordered_set<ThreadCacheCounters*> threads_;
+  uint64_t retired_[kNumCacheEvents] = {};
+  uint64_t base_[kNumCacheEvents] = {};
+};
+
+ThreadCacheCounters::ThreadCacheCounters() {
+  KernelCacheCounters::Instance().Register(this);
+}
+
+ThreadCacheCounters::~ThreadCacheCounters() {
+  KernelCacheCounters::Instance().Retire(this);
+}
+
+// One record per line: the name of the kernel type, the key of the attr and
+// the bytes of the attr in hex.
+std::string EncodeRecord(KernelType kt,
+                         int64_t key,
+                         const void* attr,
+                         size_t size) {
+  static const char kHex[] = "0123456789abcdef";
+  std::string line = to_string(kt);
+  line += ' ';
+  line += std::to_string(key);
+  line += ' ';
+  const auto* bytes = static_cast<const unsigned char*>(attr);
+  for (size_t i = 0; i < size; ++i) {
+    line += kHex[bytes[i] >> 4];
+    line += kHex[bytes[i] & 0xF];
+  }
+  return line;
+}
+
+int HexValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  return -1;
+}
+
+bool DecodeRecord(const std::string& line,
+                  KernelType* kt,
+                  int64_t* key,
+                  std::string* attr) {
+  static const auto* kernel_types = [] {
+    auto* types = new std::unordered_map<std::string, KernelType>();
+    for (int i = kAdam; i <= kVTanh; ++i) {
+      auto type = static_cast<KernelType>(i);
+      types->emplace(to_string(type), type);
+    }
+    return types;
+  }();
+
+  std::istringstream in(line);
+  std::string name;
+  std::string hex;
+  if (!(in >> name >> *key >> hex) || hex.size() % 2 != 0) {
+    return false;
+  }
+  auto iter = kernel_types->find(name);
+  if (iter == kernel_types->end()) {
+    return false;
+  }
+  *kt = iter->second;
+  attr->clear();
+  for (size_t i = 0; i < hex.size(); i += 2) {
+    int high = HexValue(hex[i]);
+    int low = HexValue(hex[i + 1]);
+    if (high < 0 || low < 0) {
+      return false;
+    }
+    attr->push_back(static_cast<char>(high << 4 | low));
+  }
+  return true;
+}
+
+class JitCodeAttrRecorder {
+ public:
+  static JitCodeAttrRecorder& Instance() {
+    static JitCodeAttrRecorder recorder;
+    return recorder;
+  }
+
+  void Record(const std::string& path,
+              KernelType kt,
+              int64_t key,
+              const void* attr,
+              size_t size) {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (path != path_) {
+      Load(path);
+    }
+    RecordId id(kt, key);
+    used_.insert(id);
+    if (recorded_.count(id)) {
+      return;
+    }
+    recorded_.insert(id);
+    records_.emplace_back(id, EncodeRecord(kt, key, attr, size));
+    const int max_records = FLAGS_jit_kernel_cache_max_records;
+    if (max_records > 0 && records_.size() > static_cast<size_t>(max_records)) {
+      Compact(max_records - max_records / 4);
+      return;
+    }
+    std::ofstream out(path, std::ios::app);
+    if (!out) {
+      LOG(WARNING) << "Failed to open the jit kernel cache file " << path;
+      return;
+    }
+    out << records_.back().second << '\n';
+  }
+
+ private:
+  using RecordId = std::pair<int, int64_t>;
+
+  // reads the records in the file, so that they are not appended again
+  void Load(const std::string& path) {
+    path_ = path;
+    recorded_.clear();
+    records_.clear();
+    std::ifstream in(path);
+    std::string line;
+    std::string attr;
+    while (std::getline(in, line)) {
+      KernelType kt;
+      int64_t key;
+      if (DecodeRecord(line, &kt, &key, &attr) &&
+          recorded_.emplace(kt, key).second) {
+        records_.emplace_back(RecordId(kt, key), line);
+      }
+    }
+  }
+
+  // Rewrites the file with the newest num_records records, of which the ones
+  // used by this process are taken first, so that the attrs of the models
+  // run before are dropped ahead of them. Leaves room for the next records,
+  // since every compaction rewrites the whole file.
+  void Compact(size_t num_records) {
+    std::stable_partition(
+        records_.begin(), records_.end(), [this](const auto& record) {
+          return !used_.count(record.first);
+        });
+    records_.erase(records_.begin(),
+                   records_.end() - std::min(num_records, records_.size()));
+    recorded_.clear();
+    std::ofstream out(path_, std::ios::trunc);
+    if (!out) {
+      LOG(WARNING) << "Failed to open the jit kernel cache file " << path_;
+    }
+    for (auto& record : records_) {
+      recorded_.insert(record.first);
+      out << record.second << '\n';
+    }
+    VLOG(3) << "Compacted the jit kernel cache file " << path_ << " to "
+            << records_.size() << " records";
+  }
+
+  std::mutex mu_;
+  std::string path_;
+  // the records in the file, in their order
+  std::vector<std::pair<RecordId, std::string>> records_;
+  std::set<RecordId> recorded_;
+  // the attrs whose jitcode this process used
+  std::set<RecordId> used_;
+};
+
+template <typename Attr>
+void ClearPointers(Attr* attr UNUSED) {}
+
+// the packed weight is owned by the caller of the kernel
+template <>
+void ClearPointers<matmul_attr_t>(matmul_attr_t* attr) {
+  attr->packed_weight = nullptr;
+}
+
+template <typename KernelTuple>
+bool WarmUp(const std::string& bytes) {
+  using Attr = typename KernelTuple::attr_type;
+  if (bytes.size() != sizeof(Attr)) {
+    return false;
+  }
+  Attr attr;
+  std::memcpy(&attr, bytes.data(), sizeof(Attr));
+  ClearPointers(&attr);
+  KernelFuncs<KernelTuple, phi::CPUPlace>::Cache().At(attr);
+  return true;
+}
+
+#define WARM_UP_CASE(type) \
+  case k##type:            \
+    return WarmUp<type##Tuple<float>>(bytes)
+
+bool WarmUp(KernelType kt, const std::string& bytes) {
+  switch (kt) {
+    WARM_UP_CASE(Adam);
+    WARM_UP_CASE(AdamW);
+    WARM_UP_CASE(CRFDecoding);
+    WARM_UP_CASE(EmbSeqPool);
+    WARM_UP_CASE(GRUH1);
+    WARM_UP_CASE(GRUHtPart1);
+    WARM_UP_CASE(GRUHtPart2);
+    WARM_UP_CASE(LSTMCtHt);
+    WARM_UP_CASE(LSTMC1H1);
+    WARM_UP_CASE(LayerNorm);
+    WARM_UP_CASE(MatMul);
+    WARM_UP_CASE(SeqPool);
+    WARM_UP_CASE(VAdd);
+    WARM_UP_CASE(VAddBias);
+    WARM_UP_CASE(VAddRelu);
+    WARM_UP_CASE(VBroadcast);
+    WARM_UP_CASE(VCopy);
+    WARM_UP_CASE(VExp);
+    WARM_UP_CASE(VIdentity);
+    WARM_UP_CASE(VMul);
+    WARM_UP_CASE(VRelu);
+    WARM_UP_CASE(VScal);
+    WARM_UP_CASE(Sgd);
+    WARM_UP_CASE(VSigmoid);
+    WARM_UP_CASE(VSquare);
+    WARM_UP_CASE(VSub);
+    WARM_UP_CASE(VTanh);
+    default:
+      return false;
+  }
+}
+
+#undef WARM_UP_CASE
+
+}  // namespace
+
+void CountKernelCacheEvent(KernelCacheEvent event) {
+  static thread_local ThreadCacheCounters counters;
+  auto& count = counters.counts[static_cast<int>(event)];
+  count.store(count.load(std::memory_order_relaxed) + 1,
+              std::memory_order_relaxed);
+}
+
+KernelCacheStats GetKernelCacheStats() {
+  return KernelCacheCounters::Instance().Get();
+}
+
+void ResetKernelCacheStats() { KernelCacheCounters::Instance().Reset(); }
+
+void RecordJitCodeAttr(KernelType kt,
+                       int64_t key,
+                       const void* attr,
+                       size_t size) {
+  const std::string& path = FLAGS_jit_kernel_cache_file;
+  if (path.empty()) {
+    return;
+  }
+  JitCodeAttrRecorder::Instance().Record(path, kt, key, attr, size);
+}
+
+int WarmUpJitKernels(const std::string& path) {
+  const std::string& file = path.empty() ? FLAGS_jit_kernel_cache_file : path;
+  if (file.empty()) {
+    return 0;
+  }
+  std::ifstream in(file);
+  if (!in) {
+    VLOG(3) << "No jit kernel cache file " << file;
+    return 0;
+  }
+  int num_attrs = 0;
+  std::string line;
+  std::string attr;
+  while (std::getline(in, line)) {
+    KernelType kt;
+    int64_t key;
+    if (DecodeRecord(line, &kt, &key, &attr) && WarmUp(kt, attr)) {
+      ++num_attrs;
+    } else {
+      VLOG(3) << "Skip the jit kernel cache record: " << line;
+    }
+  }
+  VLOG(3) << "Warmed up " << num_attrs << " jit kernels from " << file;
+  return num_attrs;
+}
+
+}  // namespace phi::jit
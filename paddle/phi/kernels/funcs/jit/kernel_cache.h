@@ -0,0 +1,76 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "paddle/common/flags.h"
+#include "paddle/phi/kernels/funcs/jit/kernel_base.h"
+
+PHI_DECLARE_string(jit_kernel_cache_file);
+PHI_DECLARE_int32(jit_kernel_cache_max_records);
+
+namespace phi {
+namespace jit {
+
+// The chosen functions are cached per thread and per attr, and the jitcode
+// per process, so every process generates the jitcode of the attrs it sees
+// again. When FLAGS_jit_kernel_cache_file is set, the attrs of the jitcode
+// used are recorded in that file, and WarmUpJitKernels generates the jitcode
+// of all the attrs recorded there, which AnalysisPredictor::Init runs once
+// per process before any request. The file keeps the attrs used by this
+// process and the newest others, up to FLAGS_jit_kernel_cache_max_records,
+// so it does not grow with the attrs of every model run before.
+// The machine code itself is not stored, it is generated again from the attr
+// since it depends on the CPU and on the addresses it is loaded at.
+
+// The counters of the kernel caches summed over all the threads.
+struct KernelCacheStats {
+  // KernelFuncs::At found the function of the attr in its cache
+  uint64_t func_hits{0};
+  // KernelFuncs::At chose the function of the attr
+  uint64_t func_misses{0};
+  // the jitcode of the attr was generated before
+  uint64_t code_hits{0};
+  // the jitcode of the attr was generated
+  uint64_t code_misses{0};
+};
+
+enum class KernelCacheEvent { kFuncHit, kFuncMiss, kCodeHit, kCodeMiss };
+
+void CountKernelCacheEvent(KernelCacheEvent event);
+
+KernelCacheStats GetKernelCacheStats();
+
+void ResetKernelCacheStats();
+
+// Records the attr of size bytes, whose jitcode of kernel type kt is keyed
+// by key, in FLAGS_jit_kernel_cache_file unless it is recorded already.
+void RecordJitCodeAttr(KernelType kt,
+                       int64_t key,
+                       const void* attr,
+                       size_t size);
+
+// Generates the jitcode of all the float attrs recorded in path,
+// FLAGS_jit_kernel_cache_file if it is empty, in the pool shared by all the
+// threads, and chooses their functions for the calling thread. Returns the
+// number of the attrs, the records which do not match this build are
+// skipped.
+int WarmUpJitKernels(const std::string& path = "");
+
+}  // namespace jit
+}  // namespace phi
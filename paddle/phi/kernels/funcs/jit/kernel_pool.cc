@@ -21,6 +21,25 @@ std::map<size_t, std::shared_ptr<void>>& GetJITCodesMap() {
   return g_jit_codes_map;
 }
 
+SharedJitCodePool& SharedJitCodePool::Instance() {
+  static SharedJitCodePool g_shared_jit_code_pool;
+  return g_shared_jit_code_pool;
+}
+
+std::shared_ptr<const GenBase> SharedJitCodePool::Find(KernelType kt,
+                                                       int64_t key) {
+  std::lock_guard<std::mutex> lock(mu_);
+  auto iter = codes_.find(std::make_pair(static_cast<int>(kt), key));
+  return iter == codes_.end() ? nullptr : iter->second;
+}
+
+std::shared_ptr<const GenBase> SharedJitCodePool::Insert(
+    KernelType kt, int64_t key, std::shared_ptr<const GenBase> value) {
+  std::lock_guard<std::mutex> lock(mu_);
+  return codes_.emplace(std::make_pair(static_cast<int>(kt), key), value)
+      .first->second;
+}
+
 JitCodeCreatorPool& JitCodeCreatorPool::Instance() {
   static JitCodeCreatorPool g_creator_pool;
   return g_creator_pool;
@@ -16,6 +16,7 @@
 
 #include <map>
 #include <memory>  // for unique_ptr
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>  // for move
@@ -35,7 +36,7 @@ extern std::map<size_t, std::shared_ptr<void>>& GetJITCodesMap();
 
 template <KernelType KT>
 class JitCodePool {
-  typedef std::unique_ptr<GenBase> GenBasePtr;
+  typedef std::shared_ptr<const GenBase> GenBasePtr;
   typedef std::unordered_map<int64_t, GenBasePtr> JitCodeMap;
 
  public:
@@ -66,6 +67,30 @@ class JitCodePool {
   DISABLE_COPY_AND_ASSIGN(JitCodePool);
 };
 
+// The jitcode generated by all the threads. The JitCodePools are thread
+// local and lock free, and take the code of an attr from here at their
+// misses, so it is generated once per process and the warm-up of one thread
+// serves all of them.
+class SharedJitCodePool {
+  typedef std::shared_ptr<const GenBase> GenBasePtr;
+
+ public:
+  SharedJitCodePool() = default;
+  static SharedJitCodePool& Instance();
+
+  // nullptr if the code of the attr is not generated yet
+  GenBasePtr Find(KernelType kt, int64_t key);
+
+  // Returns the code of the attr inserted first, since the threads can
+  // generate it at the same time.
+  GenBasePtr Insert(KernelType kt, int64_t key, GenBasePtr value);
+
+ private:
+  std::mutex mu_;
+  std::map<std::pair<int, int64_t>, GenBasePtr> codes_;
+  DISABLE_COPY_AND_ASSIGN(SharedJitCodePool);
+};
+
 class JitCodeCreatorPool {
   typedef std::unique_ptr<const GenCreator> GenCreatorPtr;
   typedef std::
@@ -13,8 +13,13 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #include <array>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <random>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "glog/logging.h"
 #include "gtest/gtest.h"
@@ -1484,6 +1489,241 @@ TEST(JITKernel_key, sgd) {
   EXPECT_TRUE(key4 != key5);
 }
 
+// The jitcode works on zmm blocks on avx512f machines and stores the tail
+// under an opmask, so every tail of three blocks is checked against refer,
+// and the floats after the output should not be written.
+std::vector<int> TestAVX512Sizes() {
+  std::vector<int> s;
+  for (int i = 1; i <= 3 * ZMM_FLOAT_BLOCK; ++i) {
+    s.push_back(i);
+  }
+  s.push_back(100);
+  s.push_back(1000);
+  return s;
+}
+
+template <typename KernelTuple>
+typename KernelTuple::func_type GetAVX512JitCode(
+    const typename KernelTuple::attr_type& attr, const std::string& suffix) {
+  auto jitker = jit::GetJitCode<KernelTuple, CPUPlace>(attr);
+  if (jitker == nullptr) {
+    return nullptr;
+  }
+  auto gen = dynamic_cast<const jit::GenBase*>(jitker);
+  EXPECT_TRUE(gen != nullptr);
+  EXPECT_NE(gen->name().find(suffix), std::string::npos) << gen->name();
+  return gen->template getCode<typename KernelTuple::func_type>();
+}
+
+void ExpectUntouched(const std::vector<float>& out, int d) {
+  for (size_t i = d; i < out.size(); ++i) {
+    EXPECT_EQ(out[i], 7.f) << " at index : " << i;
+  }
+}
+
+template <typename KernelTuple>
+void TestAVX512KernelXYZN() {
+  auto ref = jit::GetReferFunc<KernelTuple>();
+  for (int d : TestAVX512Sizes()) {
+    auto tgt = GetAVX512JitCode<KernelTuple>(d, "_AVX512");
+    ASSERT_TRUE(tgt != nullptr);
+    std::vector<float> x(d), y(d), zref(d);
+    std::vector<float> ztgt(d + ZMM_FLOAT_BLOCK, 7.f);
+    RandomVec<float>(d, x.data());
+    RandomVec<float>(d, y.data());
+    ref(x.data(), y.data(), zref.data(), d);
+    tgt(x.data(), y.data(), ztgt.data(), d);
+    ExpectEQ<float>(ztgt.data(), zref.data(), d);
+    ExpectUntouched(ztgt, d);
+  }
+}
+
+template <typename KernelTuple>
+void TestAVX512KernelAXYN() {
+  auto ref = jit::GetReferFunc<KernelTuple>();
+  const float a = 3.f;
+  for (int d : TestAVX512Sizes()) {
+    auto tgt = GetAVX512JitCode<KernelTuple>(d, "_AVX512");
+    ASSERT_TRUE(tgt != nullptr);
+    std::vector<float> x(d), yref(d);
+    std::vector<float> ytgt(d + ZMM_FLOAT_BLOCK, 7.f);
+    RandomVec<float>(d, x.data());
+    ref(&a, x.data(), yref.data(), d);
+    tgt(&a, x.data(), ytgt.data(), d);
+    ExpectEQ<float>(ytgt.data(), yref.data(), d);
+    ExpectUntouched(ytgt, d);
+  }
+}
+
+template <typename KernelTuple>
+void TestAVX512KernelXYN() {
+  auto ref = jit::GetReferFunc<KernelTuple>();
+  for (int d : TestAVX512Sizes()) {
+    // some activations use jitcode only for the small sizes
+    auto tgt = GetAVX512JitCode<KernelTuple>(d, "_AVX512");
+    if (tgt == nullptr) {
+      EXPECT_GE(d, 32);
+      continue;
+    }
+    std::vector<float> x(d), yref(d);
+    std::vector<float> ytgt(d + ZMM_FLOAT_BLOCK, 7.f);
+    RandomVec<float>(d, x.data());
+    ref(x.data(), yref.data(), d);
+    tgt(x.data(), ytgt.data(), d);
+    ExpectEQ<float>(ytgt.data(), yref.data(), d);
+    ExpectUntouched(ytgt, d);
+  }
+}
+
+TEST(JITKernel_avx512, blas_and_act) {
+  if (!phi::backends::cpu::MayIUse(phi::backends::cpu::avx512f)) {
+    return;
+  }
+  TestAVX512KernelXYZN<jit::VMulTuple<float>>();
+  TestAVX512KernelXYZN<jit::VAddTuple<float>>();
+  TestAVX512KernelXYZN<jit::VAddReluTuple<float>>();
+  TestAVX512KernelXYZN<jit::VSubTuple<float>>();
+
+  TestAVX512KernelAXYN<jit::VScalTuple<float>>();
+  TestAVX512KernelAXYN<jit::VAddBiasTuple<float>>();
+
+  TestAVX512KernelXYN<jit::VReluTuple<float>>();
+  TestAVX512KernelXYN<jit::VIdentityTuple<float>>();
+  TestAVX512KernelXYN<jit::VSquareTuple<float>>();
+  TestAVX512KernelXYN<jit::VExpTuple<float>>();
+  TestAVX512KernelXYN<jit::VSigmoidTuple<float>>();
+  TestAVX512KernelXYN<jit::VTanhTuple<float>>();
+}
+
+// the matmul jitcode of avx512f needs m == 1 and n in zmm blocks, which the
+// sizes of TestKernelMatMul do not reach
+TEST(JITKernel_avx512, matmul) {
+  if (!phi::backends::cpu::MayIUse(phi::backends::cpu::avx512f)) {
+    return;
+  }
+  auto last_acc = FLAGS_acc;
+  FLAGS_acc = 1e-3;
+  auto ref = jit::GetReferFunc<jit::MatMulTuple<float>>();
+  for (int n : {16, 32, 48, 64}) {
+    for (int k : {1, 7, 100, 511}) {
+      const jit::matmul_attr_t attr{1, n, k};
+      auto tgt = GetAVX512JitCode<jit::MatMulTuple<float>>(attr, "MatMul");
+      ASSERT_TRUE(tgt != nullptr);
+      std::vector<float> a(k), b(k * n), cref(n);
+      std::vector<float> ctgt(n + ZMM_FLOAT_BLOCK, 7.f);
+      RandomVec<float>(k, a.data());
+      RandomVec<float>(k * n, b.data());
+      ref(a.data(), b.data(), cref.data(), &attr);
+      tgt(a.data(), b.data(), ctgt.data(), &attr);
+      ExpectEQ<float>(ctgt.data(), cref.data(), n);
+      ExpectUntouched(ctgt, n);
+    }
+  }
+  FLAGS_acc = last_acc;
+}
+
+// test the record and the warm up of the jitcode
+TEST(JITKernel_cache, warm_up) {
+  const std::string path = "jit_kernel_cache_test.txt";
+  std::remove(path.c_str());
+  auto last_file = FLAGS_jit_kernel_cache_file;
+  FLAGS_jit_kernel_cache_file = path;
+  auto count_lines = [&path]() {
+    std::ifstream in(path);
+    std::string line;
+    uint64_t lines = 0;
+    while (std::getline(in, line)) {
+      ++lines;
+    }
+    return lines;
+  };
+  auto run = [] {
+    for (int d : {8, 16, 33}) {
+      jit::KernelFuncs<jit::VAddReluTuple<float>, CPUPlace>::Cache().At(d);
+      jit::KernelFuncs<jit::VAddReluTuple<float>, CPUPlace>::Cache().At(d);
+    }
+    jit::seq_pool_attr_t attr(16, jit::SeqPoolType::kSum);
+    jit::KernelFuncs<jit::SeqPoolTuple<float>, CPUPlace>::Cache().At(attr);
+  };
+
+  // the functions are cached per thread, so every new thread starts empty,
+  // and the jitcode may be generated by the tests before
+  jit::ResetKernelCacheStats();
+  std::thread(run).join();
+  auto stats = jit::GetKernelCacheStats();
+  EXPECT_EQ(stats.func_hits, 3UL);
+  EXPECT_EQ(stats.func_misses, 4UL);
+  // no jitcode is used without avx
+  uint64_t used = stats.code_misses + stats.code_hits;
+  EXPECT_EQ(count_lines(), used);
+
+  // the jitcode is shared by the threads, so a new thread only chooses the
+  // functions again
+  jit::ResetKernelCacheStats();
+  std::thread(run).join();
+  stats = jit::GetKernelCacheStats();
+  EXPECT_EQ(stats.code_misses, 0UL);
+  EXPECT_EQ(stats.code_hits, used);
+  EXPECT_EQ(stats.func_misses, 4UL);
+  // the attrs used again are not recorded twice
+  EXPECT_EQ(count_lines(), used);
+
+  // the warm-up takes the shared jitcode of the recorded attrs
+  jit::ResetKernelCacheStats();
+  int warmed_up = 0;
+  std::thread([&warmed_up] { warmed_up = jit::WarmUpJitKernels(); }).join();
+  stats = jit::GetKernelCacheStats();
+  EXPECT_EQ(static_cast<uint64_t>(warmed_up), used);
+  EXPECT_EQ(stats.code_misses, 0UL);
+  EXPECT_EQ(stats.func_misses, used);
+  EXPECT_EQ(count_lines(), used);
+
+  FLAGS_jit_kernel_cache_file = last_file;
+  std::remove(path.c_str());
+}
+
+// test the bound of the records of the jit kernel cache file
+TEST(JITKernel_cache, max_records) {
+  const std::string path = "jit_kernel_cache_bound_test.txt";
+  auto read_keys = [&path]() {
+    std::ifstream in(path);
+    std::string name;
+    int64_t key;
+    std::string attr;
+    std::vector<int64_t> keys;
+    while (in >> name >> key >> attr) {
+      keys.push_back(key);
+    }
+    return keys;
+  };
+  // the records of another model, which this process does not use
+  {
+    std::ofstream out(path, std::ios::trunc);
+    for (int64_t key = 100; key < 106; ++key) {
+      out << jit::to_string(jit::kVAdd) << ' ' << key << " 00000000\n";
+    }
+  }
+  auto last_file = FLAGS_jit_kernel_cache_file;
+  auto last_max_records = FLAGS_jit_kernel_cache_max_records;
+  FLAGS_jit_kernel_cache_file = path;
+  FLAGS_jit_kernel_cache_max_records = 8;
+
+  int attr = 0;
+  for (int64_t key = 200; key < 203; ++key) {
+    jit::RecordJitCodeAttr(jit::kVAdd, key, &attr, sizeof(attr));
+  }
+  // 9 records are compacted to 6, dropping the oldest ones of the other model
+  EXPECT_EQ(read_keys(), std::vector<int64_t>({103, 104, 105, 200, 201, 202}));
+  jit::RecordJitCodeAttr(jit::kVAdd, 203, &attr, sizeof(attr));
+  jit::RecordJitCodeAttr(jit::kVAdd, 200, &attr, sizeof(attr));
+  EXPECT_EQ(read_keys(),
+            std::vector<int64_t>({103, 104, 105, 200, 201, 202, 203}));
+
+  FLAGS_jit_kernel_cache_file = last_file;
+  FLAGS_jit_kernel_cache_max_records = last_max_records;
+  std::remove(path.c_str());
+}
+
 // test kernels
 #define TestKernelVMul TestKernelXYZN
 #define TestKernelVAdd TestKernelXYZN
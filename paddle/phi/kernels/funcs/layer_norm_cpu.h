@@ -0,0 +1,232 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifdef PADDLE_WITH_MKLML
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace phi {
+namespace funcs {
+
+// Row-wise LayerNorm on CPU without temporaries. T is the type of x and y,
+// U is the type of mean and variance (float for float16 and bfloat16) and
+// ScaleT is the type of scale and bias, which is either T or U.
+
+// The number of independent Welford accumulators of a row. Every step feeds
+// kWelfordLanes consecutive elements into them, which share the count, so
+// the loop has no dependency between lanes and is vectorized by the compiler.
+constexpr int kWelfordLanes = 16;
+
+// Computes the mean and the biased variance of x[0, n) in a single pass.
+template <typename T, typename U>
+inline void WelfordMeanVar(const T* x, int n, U* mean, U* var) {
+  U lane_mean[kWelfordLanes] = {0};
+  U lane_m2[kWelfordLanes] = {0};
+  int steps = n / kWelfordLanes;
+  for (int i = 0; i < steps; ++i) {
+    const T* px = x + i * kWelfordLanes;
+    U inv_count = static_cast<U>(1) / static_cast<U>(i + 1);
+    for (int j = 0; j < kWelfordLanes; ++j) {
+      U v = static_cast<U>(px[j]);
+      U delta = v - lane_mean[j];
+      lane_mean[j] += delta * inv_count;
+      lane_m2[j] += delta * (v - lane_mean[j]);
+    }
+  }
+
+  // all the lanes have the same count, so their mean is the plain average
+  U m = 0;
+  U m2 = 0;
+  if (steps > 0) {
+    for (int j = 0; j < kWelfordLanes; ++j) {
+      m += lane_mean[j];
+    }
+    m /= static_cast<U>(kWelfordLanes);
+    for (int j = 0; j < kWelfordLanes; ++j) {
+      U delta = lane_mean[j] - m;
+      m2 += lane_m2[j] + static_cast<U>(steps) * delta * delta;
+    }
+  }
+  U count = static_cast<U>(steps * kWelfordLanes);
+  for (int j = steps * kWelfordLanes; j < n; ++j) {
+    U v = static_cast<U>(x[j]);
+    count += 1;
+    U delta = v - m;
+    m += delta / count;
+    m2 += delta * (v - m);
+  }
+  *mean = m;
+  *var = n > 0 ? m2 / static_cast<U>(n) : static_cast<U>(0);
+}
+
+// y = (x - mean) / sqrt(var + epsilon) * scale + bias for every row, the
+// rows are shared among the threads.
+template <typename T, typename U, typename ScaleT>
+void LayerNormForwardCPU(const T* x,
+                         T* y,
+                         U* mean,
+                         U* var,
+                         const ScaleT* scale,
+                         const ScaleT* bias,
+                         int64_t rows,
+                         int cols,
+                         float epsilon) {
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+  for (int64_t r = 0; r < rows; ++r) {
+    const T* px = x + r * cols;
+    T* py = y + r * cols;
+    U row_mean;
+    U row_var;
+    WelfordMeanVar(px, cols, &row_mean, &row_var);
+    mean[r] = row_mean;
+    var[r] = row_var;
+    U rstd =
+        static_cast<U>(1) / std::sqrt(row_var + static_cast<U>(epsilon));
+    if (scale != nullptr && bias != nullptr) {
+      for (int j = 0; j < cols; ++j) {
+        py[j] = static_cast<T>((static_cast<U>(px[j]) - row_mean) * rstd *
+                                   static_cast<U>(scale[j]) +
+                               static_cast<U>(bias[j]));
+      }
+    } else if (scale != nullptr) {
+      for (int j = 0; j < cols; ++j) {
+        py[j] = static_cast<T>((static_cast<U>(px[j]) - row_mean) * rstd *
+                               static_cast<U>(scale[j]));
+      }
+    } else if (bias != nullptr) {
+      for (int j = 0; j < cols; ++j) {
+        py[j] = static_cast<T>((static_cast<U>(px[j]) - row_mean) * rstd +
+                               static_cast<U>(bias[j]));
+      }
+    } else {
+      for (int j = 0; j < cols; ++j) {
+        py[j] = static_cast<T>((static_cast<U>(px[j]) - row_mean) * rstd);
+      }
+    }
+  }
+}
+
+// The gradients of LayerNormForwardCPU, every output can be nullptr. The rows
+// are split into one block per thread, every block accumulates its partial
+// d_scale and d_bias, which are summed up at last.
+template <typename T, typename U, typename ScaleT>
+void LayerNormBackwardCPU(const T* x,
+                          const T* d_y,
+                          const U* mean,
+                          const U* var,
+                          const ScaleT* scale,
+                          int64_t rows,
+                          int cols,
+                          float epsilon,
+                          T* d_x,
+                          ScaleT* d_scale,
+                          ScaleT* d_bias) {
+  int num_blocks = 1;
+#ifdef PADDLE_WITH_MKLML
+  num_blocks = std::max(
+      1, static_cast<int>(std::min<int64_t>(rows, omp_get_max_threads())));
+#endif
+  bool need_param_grad = d_scale != nullptr || d_bias != nullptr;
+  std::vector<U> partial_d_scale(
+      d_scale != nullptr ? static_cast<size_t>(num_blocks) * cols : 0, 0);
+  std::vector<U> partial_d_bias(
+      d_bias != nullptr ? static_cast<size_t>(num_blocks) * cols : 0, 0);
+
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+  for (int b = 0; b < num_blocks; ++b) {
+    int64_t row_begin = rows * b / num_blocks;
+    int64_t row_end = rows * (b + 1) / num_blocks;
+    size_t block_offset = static_cast<size_t>(b) * cols;
+    U* block_d_scale =
+        d_scale != nullptr ? partial_d_scale.data() + block_offset : nullptr;
+    U* block_d_bias =
+        d_bias != nullptr ? partial_d_bias.data() + block_offset : nullptr;
+    for (int64_t r = row_begin; r < row_end; ++r) {
+      const T* px = x + r * cols;
+      const T* pdy = d_y + r * cols;
+      U row_mean = mean[r];
+      U rstd =
+          static_cast<U>(1) / std::sqrt(var[r] + static_cast<U>(epsilon));
+      if (need_param_grad) {
+        for (int j = 0; j < cols; ++j) {
+          U dy = static_cast<U>(pdy[j]);
+          if (block_d_scale != nullptr) {
+            block_d_scale[j] += dy * (static_cast<U>(px[j]) - row_mean) * rstd;
+          }
+          if (block_d_bias != nullptr) {
+            block_d_bias[j] += dy;
+          }
+        }
+      }
+      if (d_x == nullptr) {
+        continue;
+      }
+      // d_x = rstd * (g - mean(g) - x_norm * mean(g * x_norm)), g = dy * scale
+      U sum_g = 0;
+      U sum_g_norm = 0;
+      for (int j = 0; j < cols; ++j) {
+        U g = static_cast<U>(pdy[j]);
+        if (scale != nullptr) {
+          g *= static_cast<U>(scale[j]);
+        }
+        sum_g += g;
+        sum_g_norm += g * (static_cast<U>(px[j]) - row_mean) * rstd;
+      }
+      U mean_g = sum_g / static_cast<U>(cols);
+      U mean_g_norm = sum_g_norm / static_cast<U>(cols);
+      T* pdx = d_x + r * cols;
+      for (int j = 0; j < cols; ++j) {
+        U g = static_cast<U>(pdy[j]);
+        if (scale != nullptr) {
+          g *= static_cast<U>(scale[j]);
+        }
+        U x_norm = (static_cast<U>(px[j]) - row_mean) * rstd;
+        pdx[j] = static_cast<T>(rstd * (g - mean_g - x_norm * mean_g_norm));
+      }
+    }
+  }
+
+  if (d_scale != nullptr) {
+    for (int j = 0; j < cols; ++j) {
+      U sum = 0;
+      for (int b = 0; b < num_blocks; ++b) {
+        sum += partial_d_scale[static_cast<size_t>(b) * cols + j];
+      }
+      d_scale[j] = static_cast<ScaleT>(sum);
+    }
+  }
+  if (d_bias != nullptr) {
+    for (int j = 0; j < cols; ++j) {
+      U sum = 0;
+      for (int b = 0; b < num_blocks; ++b) {
+        sum += partial_d_bias[static_cast<size_t>(b) * cols + j];
+      }
+      d_bias[j] = static_cast<ScaleT>(sum);
+    }
+  }
+}
+
+}  // namespace funcs
+}  // namespace phi
@@ -57,13 +57,19 @@ using dim3 = phi::kps::dim3;
 
 #endif
 
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
 #include "paddle/common/array.h"
 #include "paddle/phi/core/dense_tensor.h"
 #include "paddle/phi/core/enforce.h"
 #include "paddle/phi/core/kernel_utils.h"
+#include "paddle/phi/kernels/funcs/cpu_reduce.h"
 #include "paddle/phi/kernels/funcs/eigen/common.h"
 #include "paddle/phi/kernels/funcs/eigen/eigen_function.h"
 #include "paddle/phi/kernels/funcs/math_function.h"
+#include "paddle/phi/kernels/funcs/reduce_functor.h"
 namespace phi {
 namespace funcs {
 
@@ -1348,6 +1354,48 @@ void HandleLargeDim(const Context& dev_ctx,
   output->ResizeAndAllocate(output_dim);
 }
 
+////////////// CPUReduce
+
+// Which reductions of which types the CPU reduction engine handles, the
+// others (e.g. complex types) are left to Eigen.
+template <typename Functor, typename T>
+struct CPUReduceTypeOf {
+  static constexpr bool kSupported = false;
+  static constexpr CPUReduceType kType = CPUReduceType::kSum;
+};
+
+template <typename T>
+constexpr bool kCPUReduceArithmetic =
+    (std::is_arithmetic<T>::value && !std::is_same<T, bool>::value) ||
+    std::is_same<T, phi::dtype::float16>::value ||
+    std::is_same<T, phi::dtype::bfloat16>::value;
+
+#define DEFINE_CPU_REDUCE_TYPE(FUNCTOR, TYPE)                   \
+  template <typename T>                                         \
+  struct CPUReduceTypeOf<FUNCTOR, T> {                          \
+    static constexpr bool kSupported = kCPUReduceArithmetic<T>; \
+    static constexpr CPUReduceType kType = CPUReduceType::TYPE; \
+  }
+
+DEFINE_CPU_REDUCE_TYPE(SumFunctor, kSum);
+DEFINE_CPU_REDUCE_TYPE(MeanFunctor, kMean);
+DEFINE_CPU_REDUCE_TYPE(ProdFunctor, kProd);
+DEFINE_CPU_REDUCE_TYPE(MaxFunctor, kMax);
+DEFINE_CPU_REDUCE_TYPE(MinFunctor, kMin);
+#undef DEFINE_CPU_REDUCE_TYPE
+
+template <typename U, typename T>
+struct CPUReduceTypeOf<AllFunctor<U>, T> {
+  static constexpr bool kSupported = std::is_same<T, bool>::value;
+  static constexpr CPUReduceType kType = CPUReduceType::kAll;
+};
+
+template <typename U, typename T>
+struct CPUReduceTypeOf<AnyFunctor<U>, T> {
+  static constexpr bool kSupported = std::is_same<T, bool>::value;
+  static constexpr CPUReduceType kType = CPUReduceType::kAny;
+};
+
 ////////////// ReduceKernel
 
 template <typename Context, typename T, typename OutT, typename Functor>
@@ -1364,6 +1412,19 @@ void ReduceKernelImpl(const Context& dev_ctx,
 
   dev_ctx.template Alloc<OutT>(output);
 
+  if constexpr (std::is_same<Context, phi::CPUContext>::value &&
+                CPUReduceTypeOf<Functor, OutT>::kSupported) {
+    std::vector<int64_t> x_dims = common::vectorize<int64_t>(input.dims());
+    std::vector<int64_t> reduce_dims = dims;
+    if (reduce_all) {
+      reduce_dims.resize(x_dims.size());
+      std::iota(reduce_dims.begin(), reduce_dims.end(), 0);
+    }
+    CPUReduce<CPUReduceTypeOf<Functor, OutT>::kType, OutT>(
+        input.data<OutT>(), x_dims, reduce_dims, output->data<OutT>());
+    return;
+  }
+
   if (reduce_all) {
     // Flatten and reduce 1-D tensor
     auto x = EigenVector<OutT>::Flatten(input);
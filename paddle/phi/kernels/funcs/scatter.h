@@ -18,6 +18,7 @@ limitations under the License. */
 #include <unordered_set>
 
 #include "paddle/common/ddim.h"
+#include "paddle/phi/backends/cpu/cpu_context.h"
 #include "paddle/phi/common/place.h"
 #include "paddle/phi/core/dense_tensor.h"
 #include "paddle/phi/kernels/funcs/blas/blas.h"
@@ -26,6 +27,9 @@ limitations under the License. */
 namespace phi {
 namespace funcs {
 
+// The cycles of copying or adding an element of a slice.
+constexpr double kCPUScatterCost = 1.0;
+
 /**
  * Return the updated array pointer, use blas or eigen lib to optimize time
  * cost
@@ -72,7 +76,7 @@ elementwise_inner_add(const phi::CPUContext& ctx UNUSED,
  * return: output tensor
  */
 template <typename T, typename IndexT = int>
-void ScatterAssign(const phi::CPUContext& ctx UNUSED,
+void ScatterAssign(const phi::CPUContext& ctx,
                    const DenseTensor& src,
                    const DenseTensor& index,
                    DenseTensor* output) {
@@ -127,8 +131,6 @@ void ScatterAssign(const phi::CPUContext& ctx UNUSED,
     for (int i = 0; i < src_dims.size(); ++i) slice_size *= src_dims[i];
   }
 
-  const size_t slice_bytes = slice_size * sizeof(T);
-
   for (int64_t i = 0; i < index_size; ++i) {
     IndexT index_ = p_index[i];
     PADDLE_ENFORCE_GE(index_,
@@ -151,12 +153,23 @@ void ScatterAssign(const phi::CPUContext& ctx UNUSED,
             "be less than 1st-dim size (%d) of input, but received [%d]",
             dst_dims[0],
             index_));
-    if (index_ < 0) {
-      index_ += dst_dims[0];
-    }
-
-    memcpy(p_output + index_ * slice_size, p_src + i * slice_size, slice_bytes);
   }
+
+  // The threads split the slices, and every one of them writes its columns
+  // in the order of the index, so the last of the duplicate indices wins.
+  const int64_t rows = dst_dims[0];
+  ctx.ParallelFor(
+      static_cast<int64_t>(slice_size),
+      kCPUScatterCost * static_cast<double>(index_size),
+      [&](int64_t begin, int64_t end) {
+        const size_t bytes = (end - begin) * sizeof(T);
+        for (int64_t i = 0; i < index_size; ++i) {
+          int64_t index_ = p_index[i] < 0 ? p_index[i] + rows : p_index[i];
+          memcpy(p_output + index_ * slice_size + begin,
+                 p_src + i * slice_size + begin,
+                 bytes);
+        }
+      });
 }
 
 template <typename T, typename IndexT = int>
@@ -207,8 +220,6 @@ void ScatterAssignAdd(const phi::CPUContext& ctx,
     for (int i = 0; i < src_dims.size(); ++i) slice_size *= src_dims[i];
   }
 
-  const size_t& slice_bytes = slice_size * sizeof(T);
-
   // if not in overwrite mode, need to init output data
   auto max_index = dst_dims[0];
   for (int64_t i = 0; i < index_size; ++i) {
@@ -230,18 +241,30 @@ void ScatterAssignAdd(const phi::CPUContext& ctx,
                           "be less than [%d], but received [%d]",
                           max_index,
                           p_index[i]));
-    const IndexT& index_val =
-        (p_index[i] < 0 ? p_index[i] + max_index : p_index[i]);
-    memset(p_output + slice_size * index_val, 0, slice_bytes);
   }
 
-  // if not in overwrite mode, need to init output data
-  for (int64_t i = 0; i < index_size; ++i) {
-    const IndexT& index_val =
-        (p_index[i] < 0 ? p_index[i] + max_index : p_index[i]);
-    elementwise_inner_add<T, IndexT>(
-        ctx, p_src, p_output, i, index_val, slice_size);
-  }
+  // The threads split the slices, and every one of them adds its columns in
+  // the order of the index, like the serial loop.
+  ctx.ParallelFor(
+      static_cast<int64_t>(slice_size),
+      kCPUScatterCost * 2 * static_cast<double>(index_size),
+      [&](int64_t begin, int64_t end) {
+        const size_t bytes = (end - begin) * sizeof(T);
+        for (int64_t i = 0; i < index_size; ++i) {
+          int64_t index_val =
+              p_index[i] < 0 ? p_index[i] + max_index : p_index[i];
+          memset(p_output + index_val * slice_size + begin, 0, bytes);
+        }
+        for (int64_t i = 0; i < index_size; ++i) {
+          int64_t index_val =
+              p_index[i] < 0 ? p_index[i] + max_index : p_index[i];
+          T* dst = p_output + index_val * slice_size;
+          const T* src = p_src + i * slice_size;
+          for (int64_t j = begin; j < end; ++j) {
+            dst[j] += src[j];
+          }
+        }
+      });
 }
 
 // The function is only for scatter grad x,
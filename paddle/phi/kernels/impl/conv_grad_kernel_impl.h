@@ -14,9 +14,13 @@
 
 #pragma once
 
+#include <type_traits>
+
+#include "paddle/phi/backends/cpu/cpu_context.h"
 #include "paddle/phi/kernels/cpu/conv_util.h"
 #include "paddle/phi/kernels/funcs/batch_norm_utils.h"
 #include "paddle/phi/kernels/funcs/blas/blas.h"
+#include "paddle/phi/kernels/funcs/direct_conv.h"
 #include "paddle/phi/kernels/funcs/im2col.h"
 #include "paddle/phi/kernels/funcs/math_function.h"
 #include "paddle/phi/kernels/funcs/vol2col.h"
@@ -117,6 +121,46 @@ void ConvGradKernel(const Context& dev_ctx,
 
   bool is_expand = IsExpand(filter_shape_vec, strides, paddings, dilations);
 
+  if constexpr (std::is_same<Context, phi::CPUContext>::value) {
+    if (data_dim == 2U && funcs::UseDirectConv2D(is_expand)) {
+      auto param = funcs::MakeDirectConv2DParam(in_dims,
+                                                filter_dims,
+                                                transformed_output_grad.dims(),
+                                                strides,
+                                                paddings,
+                                                dilations,
+                                                groups);
+      if (input_grad) {
+        dev_ctx.template Alloc<T>(input_grad);
+        DenseTensor transformed_input_grad(input_grad->type());
+        if (channel_last) {
+          ResizeToChannelFirst<Context, T>(
+              dev_ctx, input_grad, &transformed_input_grad);
+        } else {
+          transformed_input_grad = *input_grad;
+        }
+        funcs::DirectConv2DBackwardInput<T>(
+            transformed_output_grad.data<T>(),
+            filter.data<T>(),
+            filter.Holder(),
+            param,
+            transformed_input_grad.data<T>());
+        if (channel_last) {
+          TransToChannelLast<Context, T>(
+              dev_ctx, &transformed_input_grad, input_grad);
+        }
+      }
+      if (filter_grad) {
+        funcs::DirectConv2DBackwardFilter<T>(
+            transformed_input.data<T>(),
+            transformed_output_grad.data<T>(),
+            param,
+            dev_ctx.template Alloc<T>(filter_grad));
+      }
+      return;
+    }
+  }
+
   DenseTensor col;
   // col_matrix shares the same piece of data with col,
   // but will be reshaped into a two-dimensional matrix shape
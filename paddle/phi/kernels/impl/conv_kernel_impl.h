@@ -14,10 +14,14 @@
 
 #pragma once
 
+#include <type_traits>
+
+#include "paddle/phi/backends/cpu/cpu_context.h"
 #include "paddle/phi/kernels/conv_kernel.h"
 #include "paddle/phi/kernels/cpu/conv_util.h"
 #include "paddle/phi/kernels/funcs/batch_norm_utils.h"
 #include "paddle/phi/kernels/funcs/blas/blas.h"
+#include "paddle/phi/kernels/funcs/direct_conv.h"
 #include "paddle/phi/kernels/funcs/im2col.h"
 #include "paddle/phi/kernels/funcs/math_function.h"
 #include "paddle/phi/kernels/funcs/vol2col.h"
@@ -105,6 +109,27 @@ void ConvKernelImpl(const Context& dev_ctx,
 
   bool is_expand = IsExpand(filter_shape_vec, strides, paddings, dilations);
 
+  if constexpr (std::is_same<Context, phi::CPUContext>::value) {
+    if (data_dim == 2U && funcs::UseDirectConv2D(is_expand)) {
+      auto param = funcs::MakeDirectConv2DParam(trans_in_dims,
+                                                filter_dims,
+                                                transformed_output.dims(),
+                                                strides,
+                                                paddings,
+                                                dilations,
+                                                groups);
+      funcs::DirectConv2DForward<T>(transformed_input.data<T>(),
+                                    filter.data<T>(),
+                                    filter.Holder(),
+                                    param,
+                                    transformed_output.data<T>());
+      if (channel_last) {
+        TransToChannelLast<Context, T>(dev_ctx, &transformed_output, output);
+      }
+      return;
+    }
+  }
+
   DenseTensor col;
   // col_matrix shares the same piece of data with col,
   // but will be reshaped into a two-dimensional matrix shape
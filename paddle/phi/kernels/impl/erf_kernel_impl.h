@@ -17,6 +17,7 @@ limitations under the License. */
 #include "paddle/phi/backends/all_context.h"
 #include "paddle/phi/core/kernel_registry.h"
 #include "paddle/phi/kernels/erf_kernel.h"
+#include "paddle/phi/kernels/funcs/cpu_vec_math.h"
 #include "paddle/phi/kernels/funcs/eigen/common.h"
 #include "paddle/phi/kernels/funcs/eigen/eigen_function.h"
 
@@ -25,6 +26,12 @@ namespace phi {
 template <typename T, typename Context>
 void ErfKernel(const Context& dev_ctx, const DenseTensor& x, DenseTensor* out) {
   dev_ctx.template Alloc<T>(out);
+  if constexpr (std::is_same<Context, CPUContext>::value &&
+                funcs::IsCPUVecMathType<T>::value) {
+    funcs::CPUVecMath(
+        funcs::CPUVecMathOp::kErf, x.data<T>(), out->data<T>(), x.numel());
+    return;
+  }
 
   auto eigen_out = EigenVector<T>::Flatten(*out);
   auto eigen_in = EigenVector<T>::Flatten(x);
@@ -405,7 +405,10 @@ class InMemoryDataset(DatasetBase):
         Set data_feed_desc
         """
         self.proto_desc.name = data_feed_type
-        if self.proto_desc.name == "SlotRecordInMemoryDataFeed":
+        if self.proto_desc.name in [
+            "SlotRecordInMemoryDataFeed",
+            "SlotRecordMmapInMemoryDataFeed",
+        ]:
             self.dataset = core.Dataset("SlotRecordDataset")
 
     @deprecated(
@@ -761,6 +761,18 @@ class SparseTable(Table):
             table_proto.enable_revert = usr_table_proto.enable_revert
         if usr_table_proto.HasField("shard_merge_rate"):
             table_proto.shard_merge_rate = usr_table_proto.shard_merge_rate
+        if usr_table_proto.HasField("shard_backend"):
+            table_proto.shard_backend = usr_table_proto.shard_backend
+        if usr_table_proto.HasField("enable_slab_value"):
+            table_proto.enable_slab_value = usr_table_proto.enable_slab_value
+        if usr_table_proto.HasField("enable_binary_checkpoint"):
+            table_proto.enable_binary_checkpoint = (
+                usr_table_proto.enable_binary_checkpoint
+            )
+        if usr_table_proto.HasField("memory_cache_capacity"):
+            table_proto.memory_cache_capacity = (
+                usr_table_proto.memory_cache_capacity
+            )
 
         if usr_table_proto.accessor.ByteSize() == 0:
             warnings.warn(
@@ -344,3 +344,110 @@ TEST(DataFeed, MultiSlotUnitTest) {
   // GetElemSetFromFile(&file_elem_set, data_feed_desc, filelist);
   // CheckIsUnorderedSame(reader_elem_set, file_elem_set);
 }
+
+TEST(DataFeed, SlotRecordMmapUnitTest) {
+  const char* protofile = "slot_record_data_feed_desc.prototxt";
+  const char* filelist_name = "slot_record_filelist.txt";
+  GenerateFileForTest(protofile, filelist_name);
+  const std::vector<std::string> filelist =
+      load_filelist_from_file(filelist_name);
+  paddle::framework::DataFeedDesc data_feed_desc =
+      load_datafeed_param_from_file(protofile);
+  data_feed_desc.set_name("SlotRecordMmapInMemoryDataFeed");
+  data_feed_desc.set_pipe_command("cat");
+
+  // the byte ranges of the threads do not fall on line boundaries
+  const int thread_num = 5;
+  std::mutex mutex_for_pick_file;
+  size_t file_idx = 0;
+  auto channel =
+      paddle::framework::MakeChannel<paddle::framework::SlotRecord>();
+  for (int i = 0; i < thread_num; ++i) {
+    std::shared_ptr<paddle::framework::DataFeed> reader =
+        paddle::framework::DataFeedFactory::CreateDataFeed(
+            data_feed_desc.name());
+    reader->Init(data_feed_desc);
+    reader->SetThreadId(i);
+    reader->SetThreadNum(thread_num);
+    reader->SetFileListMutex(&mutex_for_pick_file);
+    reader->SetFileListIndex(&file_idx);
+    reader->SetFileList(filelist);
+    reader->SetInputChannel(channel.get());
+    reader->LoadIntoMemory();
+  }
+  channel->Close();
+  std::vector<paddle::framework::SlotRecord> records;
+  channel->ReadAll(records);
+  ASSERT_EQ(records.size(), filelist.size() * 3);
+
+  std::multiset<uint64_t> uint64_sparse_values;
+  std::multiset<uint64_t> uint64_dense_values;
+  size_t float_sparse_num = 0;
+  for (auto& rec : records) {
+    size_t num = 0;
+    uint64_t* values = rec->slot_uint64_feasigns_.get_values(0, &num);
+    uint64_sparse_values.insert(values, values + num);
+    values = rec->slot_uint64_feasigns_.get_values(1, &num);
+    uint64_dense_values.insert(values, values + num);
+    rec->slot_float_feasigns_.get_values(0, &num);
+    float_sparse_num += num;
+  }
+  std::multiset<uint64_t> expected_sparse_values;
+  std::multiset<uint64_t> expected_dense_values;
+  for (size_t i = 0; i < filelist.size(); ++i) {
+    expected_sparse_values.insert({3978, 620, 82, 1300, 2983353, 19260827});
+    expected_dense_values.insert({1926, 8, 27});
+  }
+  ASSERT_EQ(uint64_sparse_values, expected_sparse_values);
+  ASSERT_EQ(uint64_dense_values, expected_dense_values);
+  ASSERT_EQ(float_sparse_num, filelist.size() * 4);
+  paddle::framework::SlotRecordPool().put(&records);
+}
+
+TEST(DataFeed, SlotRecordMmapMalformedLastLine) {
+  const char* protofile = "slot_record_data_feed_desc.prototxt";
+  const char* filelist_name = "slot_record_filelist.txt";
+  GenerateFileForTest(protofile, filelist_name);
+  paddle::framework::DataFeedDesc data_feed_desc =
+      load_datafeed_param_from_file(protofile);
+  data_feed_desc.set_name("SlotRecordMmapInMemoryDataFeed");
+  data_feed_desc.set_pipe_command("cat");
+
+  // The file fills whole pages, and its last line has no '\n' and misses
+  // the values of its float slot, so a parser running past the line would
+  // read past the mapping.
+  const std::string filename = "TestSlotRecordMmapMalformed.data";
+  const std::string line = "3 3978 620 82 1 1926.08 1 1926 1 6.02 1 1996\n";
+  std::string last_line = "1 7 3 1.5";
+  const size_t file_size = 4096;
+  const size_t line_num = (file_size - last_line.size()) / line.size();
+  last_line.resize(file_size - line_num * line.size(), ' ');
+  {
+    std::ofstream w_datafile(filename.c_str());
+    for (size_t i = 0; i < line_num; ++i) {
+      w_datafile << line;
+    }
+    w_datafile << last_line;
+  }
+
+  std::mutex mutex_for_pick_file;
+  size_t file_idx = 0;
+  auto channel =
+      paddle::framework::MakeChannel<paddle::framework::SlotRecord>();
+  std::shared_ptr<paddle::framework::DataFeed> reader =
+      paddle::framework::DataFeedFactory::CreateDataFeed(
+          data_feed_desc.name());
+  reader->Init(data_feed_desc);
+  reader->SetThreadId(0);
+  reader->SetThreadNum(1);
+  reader->SetFileListMutex(&mutex_for_pick_file);
+  reader->SetFileListIndex(&file_idx);
+  reader->SetFileList({filename});
+  reader->SetInputChannel(channel.get());
+  reader->LoadIntoMemory();
+  channel->Close();
+  std::vector<paddle::framework::SlotRecord> records;
+  channel->ReadAll(records);
+  ASSERT_EQ(records.size(), line_num);
+  paddle::framework::SlotRecordPool().put(&records);
+}
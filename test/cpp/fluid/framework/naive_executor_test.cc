@@ -17,6 +17,12 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "paddle/fluid/framework/op_registry.h"
 #include "paddle/fluid/framework/program_desc.h"
@@ -67,6 +73,82 @@ TEST(NaiveExecutor, Basic) {
   }
 }
 
+// Runs c = a + b, d = c + b, e = d + a on inputs of n floats, binding the
+// intermediates to static_plan if it is not empty, and returns e.
+std::vector<float> RunAddChain(
+    const std::unordered_map<std::string, std::pair<size_t, size_t>>&
+        static_plan,
+    int n) {
+  ProgramDesc program;
+  auto* main_block = program.MutableBlock(0);
+  for (auto name : {"a", "b", "c", "d", "e"}) {
+    main_block->Var(name)->SetType(proto::VarType::DENSE_TENSOR);
+  }
+  auto add = [&](const std::string& x,
+                 const std::string& y,
+                 const std::string& out) {
+    auto* op = main_block->AppendOp();
+    op->SetType("elementwise_add");
+    op->SetInput("X", {x});
+    op->SetInput("Y", {y});
+    op->SetOutput("Out", {out});
+  };
+  add("a", "b", "c");
+  add("c", "b", "d");
+  add("d", "a", "e");
+
+  auto place = phi::CPUPlace();
+  NaiveExecutor exe(place);
+  exe.Prepare(nullptr, program, 0, false);
+  if (!static_plan.empty()) {
+    exe.MakeStaticMemoryPlan(static_plan);
+  }
+  auto* a_tensor = exe.FindTensor("a");
+  auto* b_tensor = exe.FindTensor("b");
+  a_tensor->Resize({1, n});
+  b_tensor->Resize({1, n});
+  float* a_data = a_tensor->mutable_data<float>(place);
+  float* b_data = b_tensor->mutable_data<float>(place);
+  for (int i = 0; i < n; ++i) {
+    a_data[i] = static_cast<float>(i);
+    b_data[i] = 0.5f * static_cast<float>(i) - 1.f;
+  }
+
+  // the second run rebinds nothing, and gives the same results
+  exe.Run();
+  exe.Run();
+
+  auto* c_tensor = exe.FindTensor("c");
+  auto* d_tensor = exe.FindTensor("d");
+  auto* e_tensor = exe.FindTensor("e");
+  if (!static_plan.empty()) {
+    auto* c_ptr = static_cast<const uint8_t*>(c_tensor->data());
+    auto* d_ptr = static_cast<const uint8_t*>(d_tensor->data());
+    auto* e_ptr = static_cast<const uint8_t*>(e_tensor->data());
+    EXPECT_EQ(d_ptr - c_ptr,
+              static_cast<ptrdiff_t>(static_plan.at("d").first) -
+                  static_cast<ptrdiff_t>(static_plan.at("c").first));
+    EXPECT_EQ(e_ptr - c_ptr,
+              static_cast<ptrdiff_t>(static_plan.at("e").first) -
+                  static_cast<ptrdiff_t>(static_plan.at("c").first));
+  }
+  const float* e_data = e_tensor->data<float>();
+  return std::vector<float>(e_data, e_data + n);
+}
+
+TEST(NaiveExecutor, StaticMemoryPlan) {
+  const int n = 64;
+  const size_t bytes = n * sizeof(float);
+  std::vector<float> expected = RunAddChain({}, n);
+  for (int i = 0; i < n; ++i) {
+    EXPECT_NEAR(expected[i], 3.f * i - 2.f, 1e-5);
+  }
+  // c is dead when e is written, so they share their memory
+  std::vector<float> bound = RunAddChain(
+      {{"c", {0, bytes}}, {"d", {bytes, bytes}}, {"e", {0, bytes}}}, n);
+  EXPECT_EQ(bound, expected);
+}
+
 }  // namespace framework
 }  // namespace paddle
 
@@ -14,11 +14,20 @@
 
 #include "paddle/fluid/framework/new_executor/workqueue/workqueue.h"
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "glog/logging.h"
 #include "gtest/gtest.h"
+#include "paddle/fluid/framework/new_executor/interpreter/interpreter_util.h"
 #include "paddle/fluid/framework/new_executor/workqueue/workqueue_utils.h"
 
 TEST(WorkQueueUtils, TestEventsWaiter) {
@@ -85,6 +94,41 @@ TEST(WorkQueue, TestSingleThreadedWorkQueue) {
   EXPECT_EQ(handle.get(), 5678);
 }
 
+TEST(WorkQueue, TestCancelDropsTasks) {
+  using paddle::framework::CreateSingleThreadedWorkQueue;
+  using paddle::framework::EventsWaiter;
+  using paddle::framework::WorkQueueOptions;
+  EventsWaiter events_waiter;
+  WorkQueueOptions options(/*name*/ "CancelWorkQueueForTesting",
+                           /*num_threads*/ 1,
+                           /*allow_spinning*/ false,
+                           /*always_spinning*/ false,
+                           /*track_task*/ true,
+                           /*detached*/ true,
+                           &events_waiter);
+  auto work_queue = CreateSingleThreadedWorkQueue(options);
+  std::promise<void> started;
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::atomic<int> ran{0};
+  work_queue->AddTask([&started, released]() {
+    started.set_value();
+    released.wait();
+  });
+  for (int i = 0; i < 8; ++i) {
+    work_queue->AddTask([&ran]() { ++ran; });
+  }
+  started.get_future().wait();
+  // the worker exits after the running task, leaving the others queued
+  std::thread canceller([&work_queue]() { work_queue->Cancel(); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  release.set_value();
+  canceller.join();
+  EXPECT_EQ(ran.load(), 0);
+  // the dropped tasks count as done, so the queue is empty
+  EXPECT_EQ(events_waiter.WaitEvent(), paddle::framework::kQueueEmptyEvent);
+}
+
 TEST(WorkQueue, TestMultiThreadedWorkQueue) {
   VLOG(1) << "In Test";
   using paddle::framework::CreateMultiThreadedWorkQueue;
@@ -203,3 +247,112 @@ TEST(WorkQueue, TestWorkQueueGroup) {
   queue_group.reset();
   waiter_thread.join();
 }
+
+TEST(WorkQueue, TestTaskAffinity) {
+  using paddle::framework::CreateMultiThreadedWorkQueue;
+  using paddle::framework::WorkQueueOptions;
+  constexpr int kNumThreads = 4;
+  WorkQueueOptions options(/*name*/ "AffinityWorkQueueForTesting",
+                           /*num_threads*/ kNumThreads,
+                           /*allow_spinning*/ true,
+                           /*track_task*/ false);
+  options.cpu_affinity = paddle::framework::GetAvailableCpus();
+  auto work_queue = CreateMultiThreadedWorkQueue(options);
+  EXPECT_EQ(work_queue->CurrentWorkerId(), -1);
+
+  // Hints from outside the pool, including invalid ones.
+  for (int worker = -1; worker <= kNumThreads; ++worker) {
+    std::promise<int> prom;
+    work_queue->AddTask(
+        [&work_queue, &prom]() {
+          prom.set_value(work_queue->CurrentWorkerId());
+        },
+        worker);
+    EXPECT_GE(prom.get_future().get(), 0);
+  }
+
+  // Block every worker, then queue one task for each worker and release the
+  // workers one at a time. The other workers are blocked and can not steal,
+  // so every task must run on the worker it prefers. A task blocks its worker
+  // again, so that the released worker does not steal the next tasks either.
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<bool> released(kNumThreads, false);
+  bool finished = false;
+  int blocked = 0;
+  int returned = 0;
+  for (int i = 0; i < kNumThreads; ++i) {
+    work_queue->AddTask([&]() {
+      int worker = work_queue->CurrentWorkerId();
+      std::unique_lock<std::mutex> lock(mutex);
+      ++blocked;
+      cv.notify_all();
+      cv.wait(lock, [&] { return released[worker]; });
+      ++returned;
+      cv.notify_all();
+    });
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&] { return blocked == kNumThreads; });
+  }
+
+  std::vector<std::promise<int>> ran(kNumThreads);
+  std::vector<std::future<int>> ran_on;
+  for (auto& prom : ran) {
+    ran_on.push_back(prom.get_future());
+  }
+  for (int worker = kNumThreads - 1; worker >= 0; --worker) {
+    work_queue->AddTask(
+        [&, worker]() {
+          ran[worker].set_value(work_queue->CurrentWorkerId());
+          std::unique_lock<std::mutex> lock(mutex);
+          cv.wait(lock, [&] { return finished; });
+          ++returned;
+          cv.notify_all();
+        },
+        worker);
+  }
+  for (int worker = 0; worker < kNumThreads; ++worker) {
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      released[worker] = true;
+    }
+    cv.notify_all();
+    // a task queued elsewhere would never run on the released worker
+    bool ready = ran_on[worker].wait_for(std::chrono::seconds(10)) ==
+                 std::future_status::ready;
+    EXPECT_TRUE(ready);
+    if (ready) {
+      EXPECT_EQ(ran_on[worker].get(), worker);
+    }
+  }
+
+  // the tasks use the locals, so wait for all of them to return
+  std::unique_lock<std::mutex> lock(mutex);
+  std::fill(released.begin(), released.end(), true);
+  finished = true;
+  cv.notify_all();
+  cv.wait(lock, [&] { return returned == 2 * kNumThreads; });
+}
+
+TEST(WorkQueue, TestInstructionWorkers) {
+  paddle::framework::interpreter::InstructionWorkers workers;
+  workers.Reset(4);
+  // instruction 3 consumes the outputs of the instructions 0, 1 and 2
+  for (size_t producer = 0; producer < 3; ++producer) {
+    workers.AddProducer(3, producer);
+  }
+  EXPECT_EQ(workers.PreferredWorker(3, 0), -1);
+
+  workers.Record(0, 2);
+  workers.Record(1, 5);
+  // the scheduling worker goes on with its own thread, so it is skipped
+  EXPECT_EQ(workers.PreferredWorker(3, 2), 5);
+  EXPECT_EQ(workers.PreferredWorker(3, 5), 2);
+  EXPECT_EQ(workers.PreferredWorker(3, -1), 2);
+
+  workers.Record(1, 2);
+  EXPECT_EQ(workers.PreferredWorker(3, 2), -1);
+  EXPECT_EQ(workers.PreferredWorker(0, 2), -1);
+}
@@ -0,0 +1,71 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/memory/allocation/numa_cpu_allocator.h"
+
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/phi/core/memory/stats.h"
+
+namespace paddle {
+namespace memory {
+namespace allocation {
+
+TEST(NUMAAutoGrowthCPUAllocator, reuse_chunk) {
+  size_t chunk_size = 1 << 20;
+  auto allocator = std::make_shared<NUMAAutoGrowthCPUAllocator>(
+      NUMAAutoGrowthCPUAllocator::kAlignment, chunk_size, true, false);
+
+  int64_t reserved_before = HostMemoryStatCurrentValue("Reserved", 0);
+  std::vector<AllocationPtr> allocations;
+  for (size_t size = 1; size <= 4096; size *= 2) {
+    auto allocation = allocator->Allocate(size);
+    ASSERT_NE(allocation->ptr(), nullptr);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(allocation->ptr()) %
+                  NUMAAutoGrowthCPUAllocator::kAlignment,
+              0UL);
+    std::memset(allocation->ptr(), 0, size);
+    allocations.emplace_back(std::move(allocation));
+  }
+  // All small requests are served by a single chunk.
+  int64_t reserved = HostMemoryStatCurrentValue("Reserved", 0);
+  ASSERT_EQ(reserved - reserved_before, static_cast<int64_t>(chunk_size));
+
+  allocations.clear();
+  auto allocation = allocator->Allocate(chunk_size / 2);
+  ASSERT_EQ(HostMemoryStatCurrentValue("Reserved", 0), reserved);
+  allocation.reset();
+
+  allocator->Release(phi::CPUPlace());
+  ASSERT_EQ(HostMemoryStatCurrentValue("Reserved", 0), reserved_before);
+}
+
+TEST(NUMAAutoGrowthCPUAllocator, large_and_huge_page) {
+  size_t chunk_size = 1 << 20;
+  auto allocator = std::make_shared<NUMAAutoGrowthCPUAllocator>(
+      NUMAAutoGrowthCPUAllocator::kAlignment, chunk_size, true, true);
+
+  size_t large_size = 8 * chunk_size + 3;
+  auto allocation = allocator->Allocate(large_size);
+  ASSERT_GE(allocation->size(), large_size);
+  std::memset(allocation->ptr(), 1, large_size);
+  allocation.reset();
+  allocator->Release(phi::CPUPlace());
+}
+
+}  // namespace allocation
+}  // namespace memory
+}  // namespace paddle
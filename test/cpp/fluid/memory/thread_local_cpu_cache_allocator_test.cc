@@ -0,0 +1,124 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/memory/allocation/thread_local_cpu_cache_allocator.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace paddle {
+namespace memory {
+namespace allocation {
+
+class CountedAllocator : public Allocator {
+ public:
+  bool IsAllocThreadSafe() const override { return true; }
+
+  size_t AllocCount() const { return alloc_count_; }
+  size_t AllocatedSize() const { return allocated_size_; }
+
+ protected:
+  phi::Allocation *AllocateImpl(size_t size) override {
+    ++alloc_count_;
+    allocated_size_ += size;
+    return new Allocation(malloc(size), size, phi::CPUPlace());  // NOLINT
+  }
+
+  void FreeImpl(phi::Allocation *allocation) override {
+    allocated_size_ -= allocation->size();
+    free(allocation->ptr());  // NOLINT
+    delete allocation;
+  }
+
+ private:
+  std::atomic<size_t> alloc_count_{0};
+  std::atomic<size_t> allocated_size_{0};
+};
+
+TEST(ThreadLocalCPUCacheAllocator, reuse_in_same_thread) {
+  auto underlying = std::make_shared<CountedAllocator>();
+  auto allocator =
+      std::make_shared<ThreadLocalCPUCacheAllocator>(underlying, 1 << 20, 0);
+
+  for (int i = 0; i < 10; ++i) {
+    auto allocation = allocator->Allocate(100);
+    ASSERT_EQ(allocation->size(), 128UL);
+  }
+  ASSERT_EQ(underlying->AllocCount(), 1UL);
+
+  // Large requests bypass the cache.
+  size_t large_size = CPUBlockCache::kMaxBlockSize + 1;
+  for (int i = 0; i < 2; ++i) {
+    auto allocation = allocator->Allocate(large_size);
+    ASSERT_EQ(allocation->size(), large_size);
+  }
+  ASSERT_EQ(underlying->AllocCount(), 3UL);
+
+  allocator->Release(phi::CPUPlace());
+  ASSERT_EQ(underlying->AllocatedSize(), 0UL);
+}
+
+TEST(ThreadLocalCPUCacheAllocator, spill_when_cache_is_full) {
+  auto underlying = std::make_shared<CountedAllocator>();
+  // Each thread caches a single 1KB block, the shared pool holds one more.
+  auto allocator =
+      std::make_shared<ThreadLocalCPUCacheAllocator>(underlying, 1024, 1024);
+
+  auto a = allocator->Allocate(1024);
+  auto b = allocator->Allocate(1024);
+  auto c = allocator->Allocate(1024);
+  ASSERT_EQ(underlying->AllocatedSize(), 3 * 1024UL);
+  a.reset();
+  b.reset();
+  c.reset();
+  // One block is cached by this thread, one is spilled, one is freed.
+  ASSERT_EQ(underlying->AllocatedSize(), 2 * 1024UL);
+
+  allocator->Release(phi::CPUPlace());
+  ASSERT_EQ(underlying->AllocatedSize(), 0UL);
+}
+
+TEST(ThreadLocalCPUCacheAllocator, multi_thread) {
+  auto underlying = std::make_shared<CountedAllocator>();
+  auto allocator = std::make_shared<ThreadLocalCPUCacheAllocator>(
+      underlying, 1 << 20, 1 << 20);
+
+  std::vector<AllocationPtr> cross_thread_allocations(8);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < cross_thread_allocations.size(); ++t) {
+    threads.emplace_back([&, t] {
+      for (size_t size = 1; size <= 65536; size *= 2) {
+        auto allocation = allocator->Allocate(size);
+        ASSERT_GE(allocation->size(), size);
+      }
+      cross_thread_allocations[t] = allocator->Allocate(4096);
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  // Freed after their owning threads exited.
+  cross_thread_allocations.clear();
+
+  allocator->Release(phi::CPUPlace());
+  ASSERT_EQ(underlying->AllocatedSize(), 0UL);
+}
+
+}  // namespace allocation
+}  // namespace memory
+}  // namespace paddle
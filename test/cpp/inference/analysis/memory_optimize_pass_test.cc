@@ -0,0 +1,145 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/inference/analysis/passes/memory_optimize_pass.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace paddle {
+namespace inference {
+namespace analysis {
+
+using lifecycles_t = std::unordered_map<std::string, std::pair<int, int>>;
+using space_table_t = MemoryOptimizePass::space_table_t;
+using static_plan_t = MemoryOptimizePass::static_plan_t;
+
+size_t AlignedSize(size_t size) {
+  return (size + kStaticMemoryAlignment - 1) / kStaticMemoryAlignment *
+         kStaticMemoryAlignment;
+}
+
+// Checks that the plan holds every var, aligned and inside the arena, and
+// that the vars whose lifetimes overlap do not overlap in the arena.
+void CheckStaticPlan(const lifecycles_t& lifecycles,
+                     const space_table_t& space_table,
+                     const static_plan_t& plan,
+                     size_t arena_size) {
+  std::vector<std::string> names;
+  for (auto& it : plan) {
+    names.push_back(it.first);
+    size_t offset = it.second.first;
+    size_t size = it.second.second;
+    EXPECT_EQ(offset % kStaticMemoryAlignment, 0UL) << it.first;
+    EXPECT_EQ(size, AlignedSize(space_table.at(it.first))) << it.first;
+    EXPECT_LE(offset + size, arena_size) << it.first;
+  }
+  for (size_t i = 0; i < names.size(); ++i) {
+    for (size_t j = i + 1; j < names.size(); ++j) {
+      auto a = lifecycles.at(names[i]);
+      auto b = lifecycles.at(names[j]);
+      if (b.second < a.first || a.second < b.first) continue;
+      auto x = plan.at(names[i]);
+      auto y = plan.at(names[j]);
+      EXPECT_TRUE(x.first + x.second <= y.first ||
+                  y.first + y.second <= x.first)
+          << names[i] << " and " << names[j] << " overlap";
+    }
+  }
+}
+
+// The clusters of the reuse plan, given the aligned sizes of the vars.
+size_t ClustersSize(const lifecycles_t& lifecycles,
+                    const space_table_t& space_table) {
+  space_table_t aligned_table;
+  for (auto& it : space_table) {
+    aligned_table[it.first] = AlignedSize(it.second);
+  }
+  std::unordered_map<std::string, std::string> node2cluster;
+  std::unordered_map<std::string, int> cluster_size;
+  MakeSimpleReusePlan(lifecycles, aligned_table, &node2cluster, &cluster_size);
+  size_t total = 0;
+  for (auto& it : cluster_size) {
+    total += it.second;
+  }
+  return total;
+}
+
+TEST(MemoryOptimizePass, static_plan_chain) {
+  // a and c do not overlap, so they share their memory
+  lifecycles_t lifecycles = {{"a", {0, 1}}, {"b", {1, 2}}, {"c", {2, 3}}};
+  space_table_t space_table = {{"a", 1000}, {"b", 1000}, {"c", 600}};
+  static_plan_t plan;
+  size_t arena_size = 0;
+  MakeStaticMemoryPlan(lifecycles, space_table, &plan, &arena_size);
+  ASSERT_EQ(plan.size(), 3UL);
+  CheckStaticPlan(lifecycles, space_table, plan, arena_size);
+  EXPECT_EQ(arena_size, 2 * AlignedSize(1000));
+  EXPECT_EQ(plan.at("a").first, plan.at("c").first);
+}
+
+TEST(MemoryOptimizePass, static_plan_skips_feed_and_empty_vars) {
+  lifecycles_t lifecycles = {{"feed", {0, std::numeric_limits<int>::max()}},
+                             {"empty", {0, 1}},
+                             {"out", {1, 2}},
+                             {"unsized", {1, 2}}};
+  space_table_t space_table = {{"feed", 4096}, {"empty", 0}, {"out", 256}};
+  static_plan_t plan;
+  size_t arena_size = 0;
+  MakeStaticMemoryPlan(lifecycles, space_table, &plan, &arena_size);
+  ASSERT_EQ(plan.size(), 1UL);
+  EXPECT_EQ(plan.at("out"), std::make_pair(size_t(0), size_t(256)));
+  EXPECT_EQ(arena_size, 256UL);
+}
+
+TEST(MemoryOptimizePass, static_plan_random) {
+  std::mt19937 rng(0);
+  for (int round = 0; round < 20; ++round) {
+    const int num_vars = 10 + round * 10;
+    const int num_ops = num_vars / 2;
+    // distinct aligned sizes, so that the clusters do not depend on the
+    // order of the vars of equal sizes
+    std::vector<size_t> sizes;
+    for (int i = 0; i < num_vars; ++i) {
+      sizes.push_back((i + 1) * kStaticMemoryAlignment - rng() % 200);
+    }
+    std::shuffle(sizes.begin(), sizes.end(), rng);
+    lifecycles_t lifecycles;
+    space_table_t space_table;
+    for (int i = 0; i < num_vars; ++i) {
+      std::string name = "var_" + std::to_string(i);
+      int begin = static_cast<int>(rng() % num_ops);
+      int end = begin + static_cast<int>(rng() % 6);
+      lifecycles[name] = {begin, end};
+      space_table[name] = sizes[i];
+    }
+    static_plan_t plan;
+    size_t arena_size = 0;
+    MakeStaticMemoryPlan(lifecycles, space_table, &plan, &arena_size);
+    ASSERT_EQ(plan.size(), space_table.size());
+    CheckStaticPlan(lifecycles, space_table, plan, arena_size);
+    EXPECT_LE(arena_size, ClustersSize(lifecycles, space_table));
+  }
+}
+
+}  // namespace analysis
+}  // namespace inference
+}  // namespace paddle
@@ -0,0 +1,106 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include "paddle/fluid/inference/api/batching_predictor.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace paddle_infer {
+namespace services {
+
+TEST(BatchingPredictor, length_buckets) {
+  const std::vector<int> buckets = {8, 16, 32};
+  EXPECT_EQ(BatchingPaddedLength(buckets, 1), 8);
+  EXPECT_EQ(BatchingPaddedLength(buckets, 8), 8);
+  EXPECT_EQ(BatchingPaddedLength(buckets, 9), 16);
+  EXPECT_EQ(BatchingPaddedLength(buckets, 32), 32);
+  // not padded beyond the last bucket, or without buckets
+  EXPECT_EQ(BatchingPaddedLength(buckets, 33), 33);
+  EXPECT_EQ(BatchingPaddedLength({}, 5), 5);
+}
+
+TEST(BatchingPredictor, queue_key) {
+  const std::vector<std::string> names = {"ids", "mask", "x"};
+  const std::vector<bool> padded = {true, true, false};
+  const std::vector<int> buckets = {8, 16};
+  auto key_of = [&](int rows, int length, int width) {
+    std::vector<std::vector<int>> input_shapes = {
+        {rows, length}, {rows, length, 1}, {rows, width}};
+    std::vector<std::vector<int>> shapes;
+    std::string key =
+        BatchingQueueKey(names,
+                         input_shapes,
+                         padded,
+                         BatchingPaddedLength(buckets, length),
+                         &shapes);
+    EXPECT_EQ(shapes.size(), names.size());
+    for (size_t i = 0; i < shapes.size(); ++i) {
+      EXPECT_EQ(shapes[i][0], -1);
+      EXPECT_EQ(shapes[i].size(), input_shapes[i].size());
+    }
+    return key;
+  };
+  EXPECT_EQ(key_of(1, 5, 3), "ids:[-1,8];mask:[-1,8,1];x:[-1,3]");
+  // the rows and the lengths of a bucket share a queue
+  EXPECT_EQ(key_of(4, 8, 3), key_of(1, 5, 3));
+  EXPECT_EQ(key_of(2, 9, 3), key_of(1, 16, 3));
+  // other buckets, lengths beyond the buckets and unpadded dims do not
+  EXPECT_NE(key_of(1, 9, 3), key_of(1, 8, 3));
+  EXPECT_NE(key_of(1, 17, 3), key_of(1, 18, 3));
+  EXPECT_NE(key_of(1, 5, 4), key_of(1, 5, 3));
+}
+
+TEST(BatchingPredictor, pad_and_cut_rows) {
+  // 2 rows of length 3, padded to 5, of 2 floats every step
+  const int rows = 2, length = 3, padded_length = 5, step = 2;
+  std::vector<float> src(rows * length * step);
+  for (size_t i = 0; i < src.size(); ++i) {
+    src[i] = static_cast<float>(i + 1);
+  }
+  std::vector<float> padded(rows * padded_length * step, -1.f);
+  CopyBatchingRows(reinterpret_cast<const char*>(src.data()),
+                   length * step * sizeof(float),
+                   reinterpret_cast<char*>(padded.data()),
+                   padded_length * step * sizeof(float),
+                   rows);
+  for (int r = 0; r < rows; ++r) {
+    for (int j = 0; j < padded_length * step; ++j) {
+      float expected = j < length * step ? src[r * length * step + j] : 0.f;
+      EXPECT_EQ(padded[r * padded_length * step + j], expected);
+    }
+  }
+
+  std::vector<float> cut(rows * length * step, -1.f);
+  CopyBatchingRows(reinterpret_cast<const char*>(padded.data()),
+                   padded_length * step * sizeof(float),
+                   reinterpret_cast<char*>(cut.data()),
+                   length * step * sizeof(float),
+                   rows);
+  EXPECT_EQ(cut, src);
+
+  // rows of the same length are copied at once
+  std::vector<float> copy(src.size());
+  CopyBatchingRows(reinterpret_cast<const char*>(src.data()),
+                   length * step * sizeof(float),
+                   reinterpret_cast<char*>(copy.data()),
+                   length * step * sizeof(float),
+                   rows);
+  EXPECT_EQ(copy, src);
+}
+
+}  // namespace services
+}  // namespace paddle_infer
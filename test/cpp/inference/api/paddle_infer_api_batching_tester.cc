@@ -0,0 +1,182 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <random>
+#include <thread>  // NOLINT
+
+#include "paddle/common/flags.h"
+#include "test/cpp/inference/api/tester_helper.h"
+
+namespace paddle_infer {
+
+namespace {
+
+Config GetConfig() {
+  std::string model_dir = FLAGS_infer_model + "/model";
+  Config config;
+  config.EnableNewIR(false);
+  config.SetModel(model_dir + "/model", model_dir + "/params");
+  config.DisableGpu();
+  config.SetCpuMathLibraryNumThreads(1);
+  return config;
+}
+
+std::vector<float> RandomImage(int seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> dist(0.f, 1.f);
+  std::vector<float> image(3 * 224 * 224);
+  for (float& v : image) {
+    v = dist(rng);
+  }
+  return image;
+}
+
+// The output of a predictor run on every image alone.
+std::vector<std::vector<float>> RunUnbatched(int num_images) {
+  std::vector<std::vector<float>> outputs(num_images);
+  auto predictor = CreatePredictor(GetConfig());
+  auto input_t = predictor->GetInputHandle(predictor->GetInputNames()[0]);
+  auto output_t = predictor->GetOutputHandle(predictor->GetOutputNames()[0]);
+  for (int i = 0; i < num_images; ++i) {
+    std::vector<float> image = RandomImage(i);
+    input_t->Reshape({1, 3, 224, 224});
+    input_t->CopyFromCpu(image.data());
+    EXPECT_TRUE(predictor->Run());
+    std::vector<int> shape = output_t->shape();
+    outputs[i].resize(std::accumulate(
+        shape.begin(), shape.end(), 1, std::multiplies<int>()));
+    output_t->CopyToCpu(outputs[i].data());
+  }
+  return outputs;
+}
+
+// Runs a request of the images [first, first + rows) and checks every row of
+// its output against the unbatched outputs.
+void RunAndCheck(services::BatchingPredictor* batching,
+                 int first,
+                 int rows,
+                 const std::vector<std::vector<float>>& expected) {
+  std::vector<float> images;
+  for (int i = first; i < first + rows; ++i) {
+    std::vector<float> image = RandomImage(i);
+    images.insert(images.end(), image.begin(), image.end());
+  }
+  std::vector<paddle::PaddleTensor> inputs(1);
+  inputs[0].shape = {rows, 3, 224, 224};
+  inputs[0].dtype = DataType::FLOAT32;
+  inputs[0].data.Reset(images.data(), images.size() * sizeof(float));
+  std::vector<paddle::PaddleTensor> outputs;
+  ASSERT_TRUE(batching->Run(inputs, &outputs));
+  ASSERT_EQ(outputs.size(), 1UL);
+  ASSERT_EQ(outputs[0].shape[0], rows);
+  const size_t row_size = expected[first].size();
+  ASSERT_EQ(outputs[0].data.length(), rows * row_size * sizeof(float));
+  const float* output = static_cast<float*>(outputs[0].data.data());
+  for (int r = 0; r < rows; ++r) {
+    for (size_t j = 0; j < row_size; ++j) {
+      EXPECT_NEAR(output[r * row_size + j], expected[first + r][j], 1e-4);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(BatchingPredictor, same_as_predictor) {
+  const int kThreads = 4;
+  const int kRequests = 3;
+  std::vector<std::vector<float>> expected =
+      RunUnbatched(kThreads * kRequests);
+
+  services::BatchingOptions options;
+  options.max_batch_size = kThreads;
+  options.batch_timeout_us = 100000;
+  services::BatchingPredictor batching(GetConfig(), options);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (int k = 0; k < kRequests; ++k) {
+        RunAndCheck(&batching, t * kRequests + k, 1, expected);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  services::BatchingStats stats = batching.GetStats();
+  LOG(INFO) << "batches: " << stats.batches << ", mean queue time: "
+            << stats.total_queue_us / stats.requests
+            << " us, mean batch time: "
+            << stats.total_batch_us / stats.batches << " us";
+  EXPECT_EQ(stats.requests, static_cast<uint64_t>(kThreads * kRequests));
+  EXPECT_EQ(stats.rows, static_cast<uint64_t>(kThreads * kRequests));
+  EXPECT_EQ(stats.pending, 0UL);
+  // the concurrent requests wait long enough to share their batches
+  EXPECT_LT(stats.batches, stats.requests);
+  EXPECT_EQ(batching.GetQueueStats().size(), 1UL);
+}
+
+TEST(BatchingPredictor, requests_of_many_rows) {
+  // the requests of 1 to 3 rows, and one of more rows than a batch
+  const std::vector<int> rows = {1, 2, 3, 2, 1, 3, 6};
+  std::vector<int> firsts;
+  int num_images = 0;
+  for (int r : rows) {
+    firsts.push_back(num_images);
+    num_images += r;
+  }
+  std::vector<std::vector<float>> expected = RunUnbatched(num_images);
+
+  services::BatchingOptions options;
+  options.max_batch_size = 4;
+  options.batch_timeout_us = 100000;
+  options.num_workers = 2;
+  services::BatchingPredictor batching(GetConfig(), options);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < rows.size(); ++i) {
+    threads.emplace_back(
+        [&, i] { RunAndCheck(&batching, firsts[i], rows[i], expected); });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  services::BatchingStats stats = batching.GetStats();
+  EXPECT_EQ(stats.requests, rows.size());
+  EXPECT_EQ(stats.rows, static_cast<uint64_t>(num_images));
+  EXPECT_LT(stats.batches, stats.requests);
+}
+
+TEST(BatchingPredictor, prune_idle_queues) {
+  std::vector<std::vector<float>> expected = RunUnbatched(3);
+
+  services::BatchingOptions options;
+  options.batch_timeout_us = 0;
+  options.queue_idle_timeout_us = 0;
+  services::BatchingPredictor batching(GetConfig(), options);
+  for (int i = 0; i < 3; ++i) {
+    RunAndCheck(&batching, i, 1, expected);
+    // the queue is pruned once its batch has run, but not its metrics
+    EXPECT_TRUE(batching.GetQueueStats().empty());
+    services::BatchingStats stats = batching.GetStats();
+    EXPECT_EQ(stats.requests, static_cast<uint64_t>(i + 1));
+    EXPECT_EQ(stats.batches, static_cast<uint64_t>(i + 1));
+  }
+}
+
+}  // namespace paddle_infer
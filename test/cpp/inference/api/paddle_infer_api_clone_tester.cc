@@ -0,0 +1,83 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <thread>  // NOLINT
+
+#include "paddle/common/flags.h"
+#include "test/cpp/inference/api/tester_helper.h"
+
+namespace paddle_infer {
+
+namespace {
+
+std::vector<float> RunImage(Predictor* predictor, float value) {
+  std::vector<float> image(3 * 224 * 224, value);
+  auto input_t = predictor->GetInputHandle(predictor->GetInputNames()[0]);
+  input_t->Reshape({1, 3, 224, 224});
+  input_t->CopyFromCpu(image.data());
+  EXPECT_TRUE(predictor->Run());
+  auto output_t = predictor->GetOutputHandle(predictor->GetOutputNames()[0]);
+  std::vector<int> shape = output_t->shape();
+  std::vector<float> output(
+      std::accumulate(shape.begin(), shape.end(), 1, std::multiplies<int>()));
+  output_t->CopyToCpu(output.data());
+  return output;
+}
+
+void TestLightweightClone(bool use_new_ir) {
+  std::string model_dir = FLAGS_infer_model + "/model";
+  Config config;
+  config.EnableNewIR(use_new_ir);
+  config.SetModel(model_dir + "/model", model_dir + "/params");
+  config.DisableGpu();
+  config.EnableLightweightClone();
+
+  auto predictor = CreatePredictor(config);
+  std::vector<std::unique_ptr<Predictor>> clones;
+  for (int i = 0; i < 4; ++i) {
+    clones.emplace_back(predictor->Clone());
+  }
+
+  std::vector<std::vector<float>> expected;
+  for (int i = 0; i < 4; ++i) {
+    expected.push_back(RunImage(predictor.get(), 0.1f * i));
+  }
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&, i] {
+      for (int k = 0; k < 4; ++k) {
+        std::vector<float> output = RunImage(clones[i].get(), 0.1f * k);
+        ASSERT_EQ(output.size(), expected[k].size());
+        for (size_t j = 0; j < output.size(); ++j) {
+          EXPECT_NEAR(output[j], expected[k][j], 1e-5);
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace
+
+TEST(Predictor, lightweight_clone) { TestLightweightClone(false); }
+
+TEST(Predictor, lightweight_clone_pir) { TestLightweightClone(true); }
+
+}  // namespace paddle_infer
@@ -0,0 +1,98 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <numeric>
+
+#include "paddle/common/flags.h"
+#include "test/cpp/inference/api/tester_helper.h"
+
+namespace paddle_infer {
+
+namespace {
+
+Config GetConfig(bool use_new_ir) {
+  std::string model_dir = FLAGS_infer_model + "/model";
+  Config config;
+  config.EnableNewIR(use_new_ir);
+  config.SetModel(model_dir + "/model", model_dir + "/params");
+  config.DisableGpu();
+  return config;
+}
+
+std::vector<float> RunImage(Predictor* predictor) {
+  std::vector<float> image(3 * 224 * 224, 0.5f);
+  auto input_t = predictor->GetInputHandle(predictor->GetInputNames()[0]);
+  input_t->Reshape({1, 3, 224, 224});
+  input_t->CopyFromCpu(image.data());
+  EXPECT_TRUE(predictor->Run());
+  auto output_t = predictor->GetOutputHandle(predictor->GetOutputNames()[0]);
+  std::vector<int> shape = output_t->shape();
+  std::vector<float> output(
+      std::accumulate(shape.begin(), shape.end(), 1, std::multiplies<int>()));
+  output_t->CopyToCpu(output.data());
+  return output;
+}
+
+std::vector<std::string> CachedModels(const std::string& cache_dir) {
+  std::vector<std::string> models;
+  for (const auto& entry : std::filesystem::directory_iterator(cache_dir)) {
+    models.push_back(entry.path().string());
+  }
+  return models;
+}
+
+void TestOptimizedModelCache(bool use_new_ir) {
+  std::string cache_dir = FLAGS_infer_model + "/optimized_model_cache";
+  std::filesystem::remove_all(cache_dir);
+
+  std::vector<float> expected =
+      RunImage(CreatePredictor(GetConfig(use_new_ir)).get());
+
+  // The first predictor optimizes the model and caches it.
+  Config config = GetConfig(use_new_ir);
+  config.SetOptimizedModelCacheDir(cache_dir);
+  std::vector<float> output = RunImage(CreatePredictor(config).get());
+  std::vector<std::string> models = CachedModels(cache_dir);
+  ASSERT_EQ(models.size(), 1UL);
+  EXPECT_EQ(models[0].find(".tmp"), std::string::npos);
+  EXPECT_TRUE(
+      std::filesystem::exists(models[0] + "/" + "_optimized.pdiparams"));
+
+  // The second one loads the cached model.
+  Config cached_config = GetConfig(use_new_ir);
+  cached_config.SetOptimizedModelCacheDir(cache_dir);
+  std::vector<float> cached_output =
+      RunImage(CreatePredictor(cached_config).get());
+  EXPECT_EQ(CachedModels(cache_dir), models);
+
+  ASSERT_EQ(output.size(), expected.size());
+  ASSERT_EQ(cached_output.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(output[i], expected[i], 1e-5);
+    EXPECT_NEAR(cached_output[i], expected[i], 1e-5);
+  }
+  std::filesystem::remove_all(cache_dir);
+}
+
+}  // namespace
+
+TEST(Predictor, optimized_model_cache) { TestOptimizedModelCache(false); }
+
+TEST(Predictor, optimized_model_cache_pir) { TestOptimizedModelCache(true); }
+
+}  // namespace paddle_infer
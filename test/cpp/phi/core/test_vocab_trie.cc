@@ -0,0 +1,132 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/phi/core/vocab/string_array.h"
+#include "paddle/phi/core/vocab/vocab_trie.h"
+
+namespace phi {
+namespace tests {
+
+TEST(DoubleArrayTrie, LongestPrefix) {
+  std::mt19937 rng(17);
+  std::map<std::string, int32_t> keys;
+  for (int i = 0; i < 5000; ++i) {
+    std::string key;
+    int len = 1 + static_cast<int>(rng() % 6);
+    for (int j = 0; j < len; ++j) {
+      key.push_back(static_cast<char>("abcd\xe4\xb8\x80"[rng() % 7]));
+    }
+    keys.emplace(key, i);
+  }
+  DoubleArrayTrie trie;
+  trie.Build(std::vector<std::pair<std::string, int32_t>>(keys.begin(),
+                                                          keys.end()));
+
+  for (int i = 0; i < 2000; ++i) {
+    std::string text;
+    int len = static_cast<int>(rng() % 9);
+    for (int j = 0; j < len; ++j) {
+      text.push_back(static_cast<char>("abcde\xe4\xb8\x80"[rng() % 8]));
+    }
+    size_t expected_len = 0;
+    int32_t expected_value = -1;
+    for (size_t n = 1; n <= text.size(); ++n) {
+      auto it = keys.find(text.substr(0, n));
+      if (it != keys.end()) {
+        expected_len = n;
+        expected_value = it->second;
+      }
+    }
+    int32_t value = -1;
+    ASSERT_EQ(
+        trie.LongestPrefix(text.data(), text.data() + text.size(), &value),
+        expected_len);
+    if (expected_len > 0) {
+      ASSERT_EQ(value, expected_value);
+    }
+  }
+
+  DoubleArrayTrie empty;
+  empty.Build({});
+  int32_t value = 0;
+  std::string text = "abc";
+  ASSERT_EQ(empty.LongestPrefix(text.data(), text.data() + 3, &value), 0UL);
+}
+
+TEST(DoubleArrayTrie, Utf8) {
+  std::string encoded;
+  for (char32_t ch : {U'a', U'é', U'中', U'\U0001f600'}) {
+    ASSERT_TRUE(AppendUtf8(ch, &encoded));
+  }
+  ASSERT_EQ(encoded, "a\xc3\xa9\xe4\xb8\xad\xf0\x9f\x98\x80");
+  ASSERT_FALSE(AppendUtf8(0xD800, &encoded));
+
+  const char* p = encoded.data();
+  const char* end = p + encoded.size();
+  std::vector<char32_t> decoded;
+  char32_t ch;
+  while (p < end && DecodeUtf8(&p, end, &ch)) {
+    decoded.push_back(ch);
+  }
+  ASSERT_EQ(decoded,
+            std::vector<char32_t>({U'a', U'é', U'中', U'\U0001f600'}));
+
+  for (std::string invalid : {"\xff", "\xc3", "\xc0\xaf", "\xed\xa0\x80"}) {
+    p = invalid.data();
+    ASSERT_FALSE(DecodeUtf8(&p, invalid.data() + invalid.size(), &ch));
+  }
+}
+
+TEST(DoubleArrayTrie, WordPieceVocab) {
+  Vocab vocab;
+  vocab.emplace(L"un", 0);
+  vocab.emplace(L"##aff", 1);
+  vocab.emplace(L"##able", 2);
+  vocab.emplace(L"中", 3);
+
+  auto trie = vocab.wordpiece_trie();
+  ASSERT_EQ(trie.get(), vocab.wordpiece_trie().get());
+  int32_t id = -1;
+  std::string word = "unaffable";
+  ASSERT_EQ(trie->word_start.LongestPrefix(
+                word.data(), word.data() + word.size(), &id),
+            2UL);
+  ASSERT_EQ(id, 0);
+  ASSERT_EQ(trie->continuation.LongestPrefix(
+                word.data() + 2, word.data() + word.size(), &id),
+            3UL);
+  ASSERT_EQ(id, 1);
+  std::string chinese = "\xe4\xb8\xad";
+  ASSERT_TRUE(trie->word_start.Find(
+      chinese.data(), chinese.data() + chinese.size(), &id));
+  ASSERT_EQ(id, 3);
+
+  // modifying the vocab rebuilds the trie
+  vocab.emplace(L"unaff", 4);
+  ASSERT_NE(trie.get(), vocab.wordpiece_trie().get());
+  ASSERT_EQ(vocab.wordpiece_trie()->word_start.LongestPrefix(
+                word.data(), word.data() + word.size(), &id),
+            5UL);
+  ASSERT_EQ(id, 4);
+}
+
+}  // namespace tests
+}  // namespace phi
@@ -0,0 +1,115 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/phi/kernels/funcs/cpu_embedding.h"
+
+namespace phi {
+namespace tests {
+
+// Skewed ids, so that some ids repeat many times.
+std::vector<int64_t> RandomIds(int64_t n, int64_t rows, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int64_t> dist(0, rows - 1);
+  std::vector<int64_t> ids(n);
+  for (int64_t i = 0; i < n; ++i) {
+    ids[i] = dist(rng) % (i % 3 == 0 ? 7 : rows);
+  }
+  return ids;
+}
+
+std::vector<float> RandomValues(int64_t n, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> x(n);
+  for (auto& v : x) {
+    v = dist(rng);
+  }
+  return x;
+}
+
+TEST(CPUEmbedding, group_ids) {
+  std::vector<int64_t> ids = {5, 3, 5, 0, 3, 5, 9};
+  funcs::EmbeddingIdGroups groups;
+  funcs::GroupEmbeddingIds(ids.data(), ids.size(), &groups);
+  EXPECT_EQ(groups.unique_ids, std::vector<int64_t>({5, 3, 0, 9}));
+  EXPECT_EQ(groups.offsets, std::vector<int64_t>({0, 3, 5, 6, 7}));
+  EXPECT_EQ(groups.positions, std::vector<int64_t>({0, 2, 5, 1, 4, 3, 6}));
+
+  funcs::GroupEmbeddingIds(ids.data(), 0, &groups);
+  EXPECT_EQ(groups.size(), 0);
+  EXPECT_EQ(groups.offsets, std::vector<int64_t>({0}));
+}
+
+TEST(CPUEmbedding, lookup) {
+  const int64_t rows = 1000, width = 37, n = 5000, padding_idx = 3;
+  auto table = RandomValues(rows * width, 1);
+  auto ids = RandomIds(n, rows, 2);
+  std::vector<float> out(n * width);
+  funcs::CPUEmbeddingLookup(
+      table.data(), width, ids.data(), n, padding_idx, out.data());
+  for (int64_t i = 0; i < n; ++i) {
+    for (int64_t j = 0; j < width; ++j) {
+      float expected = ids[i] == padding_idx ? 0 : table[ids[i] * width + j];
+      EXPECT_EQ(expected, out[i * width + j]);
+    }
+  }
+}
+
+TEST(CPUEmbedding, dense_and_merged_grad) {
+  const int64_t rows = 3000, width = 19, n = 20000, padding_idx = 4;
+  auto ids = RandomIds(n, rows, 3);
+  auto out_grad = RandomValues(n * width, 4);
+
+  // the serial accumulation in the order of the positions
+  std::vector<float> expected(rows * width, 0);
+  for (int64_t i = 0; i < n; ++i) {
+    if (ids[i] == padding_idx) {
+      continue;
+    }
+    for (int64_t j = 0; j < width; ++j) {
+      expected[ids[i] * width + j] += out_grad[i * width + j];
+    }
+  }
+
+  funcs::EmbeddingIdGroups groups;
+  funcs::GroupEmbeddingIds(ids.data(), n, &groups);
+  std::vector<float> table_grad(rows * width, 1);
+  funcs::CPUEmbeddingZero(table_grad.data(), rows * width);
+  funcs::CPUEmbeddingGradAccumulate(
+      groups, out_grad.data(), width, padding_idx, table_grad.data());
+  EXPECT_EQ(expected, table_grad);
+
+  std::vector<float> merged(groups.size() * width);
+  funcs::CPUEmbeddingGradMerge(
+      groups, out_grad.data(), width, padding_idx, merged.data());
+  std::vector<bool> seen(rows, false);
+  for (int64_t u = 0; u < groups.size(); ++u) {
+    int64_t id = groups.unique_ids[u];
+    EXPECT_FALSE(seen[id]);
+    seen[id] = true;
+    for (int64_t j = 0; j < width; ++j) {
+      EXPECT_EQ(expected[id * width + j], merged[u * width + j]);
+    }
+  }
+  for (int64_t i = 0; i < n; ++i) {
+    EXPECT_TRUE(seen[ids[i]]);
+  }
+}
+
+}  // namespace tests
+}  // namespace phi
@@ -0,0 +1,140 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/phi/backends/context_pool.h"
+#include "paddle/phi/backends/cpu/cpu_parallel.h"
+#include "paddle/phi/kernels/funcs/elementwise_base.h"
+#include "paddle/phi/kernels/funcs/elementwise_functor.h"
+
+namespace phi {
+namespace tests {
+
+using backends::cpu::CPUParallelFor;
+using backends::cpu::CPUParallelMaxThreads;
+using backends::cpu::CPUParallelThreads;
+using backends::cpu::GetCPUParallelCostModel;
+using backends::cpu::GetCPUParallelThreadBudget;
+using backends::cpu::SetCPUParallelThreadBudget;
+
+TEST(CPUParallel, CostModel) {
+  const auto& model = GetCPUParallelCostModel();
+  EXPECT_GT(model.ns_per_cycle, 0.0);
+  EXPECT_GT(model.fork_join_ns, 0.0);
+}
+
+TEST(CPUParallel, Threads) {
+  const int max_threads = CPUParallelMaxThreads();
+  EXPECT_EQ(CPUParallelThreads(0, 1.0), 1);
+  EXPECT_EQ(CPUParallelThreads(1, 1e9), 1);
+  EXPECT_EQ(CPUParallelThreads(16, 1.0), 1);
+  EXPECT_EQ(CPUParallelThreads(int64_t{1} << 40, 1.0), max_threads);
+  // more work never takes fewer threads
+  int last = 1;
+  for (int64_t n = 1; n <= (int64_t{1} << 30); n *= 4) {
+    int threads = CPUParallelThreads(n, 1.0);
+    EXPECT_GE(threads, last);
+    EXPECT_LE(threads, max_threads);
+    last = threads;
+  }
+}
+
+TEST(CPUParallel, ThreadBudget) {
+  EXPECT_EQ(GetCPUParallelThreadBudget(), 0);
+  SetCPUParallelThreadBudget(1);
+  EXPECT_EQ(CPUParallelMaxThreads(), 1);
+  EXPECT_EQ(CPUParallelThreads(int64_t{1} << 40, 1.0), 1);
+  SetCPUParallelThreadBudget(0);
+  EXPECT_EQ(GetCPUParallelThreadBudget(), 0);
+}
+
+TEST(CPUParallel, ParallelFor) {
+  for (int64_t n : {0, 1, 7, 1000, 1 << 20}) {
+    for (double cost : {1.0, 1000.0}) {
+      std::vector<std::atomic<int>> hits(n);
+      for (auto& h : hits) {
+        h = 0;
+      }
+      std::atomic<int> calls(0);
+      CPUParallelFor(n, cost, [&](int64_t begin, int64_t end) {
+        EXPECT_LT(begin, end);
+        ++calls;
+        for (int64_t i = begin; i < end; ++i) {
+          ++hits[i];
+        }
+      });
+      for (int64_t i = 0; i < n; ++i) {
+        EXPECT_EQ(hits[i].load(), 1);
+      }
+      EXPECT_LE(calls.load(), n == 0 ? 0 : CPUParallelThreads(n, cost));
+    }
+  }
+}
+
+TEST(CPUParallel, ParallelForRethrows) {
+  const int64_t n = int64_t{1} << 20;
+  std::atomic<int> calls(0);
+  EXPECT_THROW(CPUParallelFor(n,
+                              1000.0,
+                              [&](int64_t begin, int64_t end) {
+                                ++calls;
+                                if (end == n) {
+                                  throw std::runtime_error("last range");
+                                }
+                              }),
+               std::runtime_error);
+  EXPECT_LE(calls.load(), CPUParallelThreads(n, 1000.0));
+}
+
+// The integer divide functors throw on a zero divisor, which must reach the
+// caller of a parallel elementwise loop instead of terminating.
+TEST(CPUParallel, ElementwiseDivideByZeroThrows) {
+  auto* dev_ctx = DeviceContextPool::Instance().GetByPlace(CPUPlace());
+  const int64_t n = int64_t{1} << 22;
+  DenseTensor x, y, z;
+  x.Resize({n});
+  y.Resize({n});
+  int* x_data = dev_ctx->Alloc<int>(&x);
+  int* y_data = dev_ctx->Alloc<int>(&y);
+  for (int64_t i = 0; i < n; ++i) {
+    x_data[i] = static_cast<int>(i);
+    y_data[i] = 3;
+  }
+  y_data[n - 1] = 0;
+
+  EXPECT_ANY_THROW(
+      (funcs::ElementwiseCompute<funcs::DivideFunctor<int>, int>(
+          *dev_ctx, x, y, funcs::DivideFunctor<int>(), &z)));
+  EXPECT_ANY_THROW(
+      (funcs::ElementwiseCompute<funcs::RemainderFunctor<int>, int>(
+          *dev_ctx, x, y, funcs::RemainderFunctor<int>(), &z)));
+  EXPECT_ANY_THROW(
+      (funcs::ElementwiseCompute<funcs::FloorDivideFunctor<int>, int>(
+          *dev_ctx, x, y, funcs::FloorDivideFunctor<int>(), &z)));
+
+  y_data[n - 1] = 3;
+  funcs::ElementwiseCompute<funcs::DivideFunctor<int>, int>(
+      *dev_ctx, x, y, funcs::DivideFunctor<int>(), &z);
+  const int* z_data = z.data<int>();
+  for (int64_t i = 0; i < n; ++i) {
+    ASSERT_EQ(z_data[i], static_cast<int>(i) / 3);
+  }
+}
+
+}  // namespace tests
+}  // namespace phi
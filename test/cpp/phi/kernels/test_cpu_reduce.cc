@@ -0,0 +1,186 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/phi/common/bfloat16.h"
+#include "paddle/phi/common/float16.h"
+#include "paddle/phi/kernels/funcs/cpu_reduce.h"
+
+namespace phi {
+namespace tests {
+
+using phi::funcs::CPUReduceType;
+
+// Reduces x element by element in double, walking the kept and the reduced
+// indices of every output.
+template <CPUReduceType kType, typename T>
+std::vector<double> NaiveReduce(const T* x,
+                                const std::vector<int64_t>& dims,
+                                const std::vector<bool>& reduced) {
+  int rank = static_cast<int>(dims.size());
+  std::vector<int64_t> strides(rank, 1);
+  for (int i = rank - 2; i >= 0; --i) {
+    strides[i] = strides[i + 1] * dims[i + 1];
+  }
+  int64_t out_numel = 1;
+  for (int i = 0; i < rank; ++i) {
+    if (!reduced[i]) out_numel *= dims[i];
+  }
+  std::vector<double> out(out_numel);
+  std::vector<bool> initialized(out_numel, false);
+  int64_t count = 1;
+  for (int i = 0; i < rank; ++i) {
+    if (reduced[i]) count *= dims[i];
+  }
+  int64_t numel = strides[0] * dims[0];
+  for (int64_t n = 0; n < numel; ++n) {
+    int64_t o = 0;
+    for (int i = 0; i < rank; ++i) {
+      if (!reduced[i]) {
+        o = o * dims[i] + n / strides[i] % dims[i];
+      }
+    }
+    double v = static_cast<double>(x[n]);
+    if (!initialized[o]) {
+      out[o] = v;
+      initialized[o] = true;
+    } else if (kType == CPUReduceType::kSum || kType == CPUReduceType::kMean) {
+      out[o] += v;
+    } else if (kType == CPUReduceType::kProd) {
+      out[o] *= v;
+    } else if (kType == CPUReduceType::kMax) {
+      out[o] = (std::isnan(v) || v > out[o]) ? v : out[o];
+    } else if (kType == CPUReduceType::kMin) {
+      out[o] = (std::isnan(v) || v < out[o]) ? v : out[o];
+    } else if (kType == CPUReduceType::kAll) {
+      out[o] = out[o] != 0 && v != 0;
+    } else {
+      out[o] = out[o] != 0 || v != 0;
+    }
+  }
+  if (kType == CPUReduceType::kMean) {
+    for (auto& v : out) v /= static_cast<double>(count);
+  }
+  return out;
+}
+
+template <CPUReduceType kType, typename T>
+void CheckReduce(double lower, double upper, double tolerance) {
+  std::mt19937 rng(kType == CPUReduceType::kSum ? 1 : 2);
+  std::uniform_real_distribution<double> dist(lower, upper);
+  const std::vector<std::vector<int64_t>> shapes = {
+      {7}, {3, 5}, {2, 1, 9}, {4, 3, 2, 5}, {2, 3, 1, 4, 3}, {257, 33}};
+  for (const auto& dims : shapes) {
+    int rank = static_cast<int>(dims.size());
+    int64_t numel = 1;
+    for (auto d : dims) numel *= d;
+    // not std::vector, which packs bool
+    std::unique_ptr<T[]> x(new T[numel]);
+    for (int64_t i = 0; i < numel; ++i) {
+      x[i] = static_cast<T>(
+          std::is_same<T, bool>::value ? rng() % 4 != 0 : dist(rng));
+    }
+    // every subset of the axes, given as negative axes for odd masks
+    for (int mask = 0; mask < (1 << rank); ++mask) {
+      std::vector<int64_t> reduce_dims;
+      std::vector<bool> reduced(rank, false);
+      for (int i = 0; i < rank; ++i) {
+        if (mask & (1 << i)) {
+          reduce_dims.push_back(mask % 2 ? i - rank : i);
+          reduced[i] = true;
+        }
+      }
+      std::vector<double> expected =
+          NaiveReduce<kType>(x.get(), dims, reduced);
+      std::unique_ptr<T[]> out(new T[expected.size()]);
+      phi::funcs::CPUReduce<kType, T>(x.get(), dims, reduce_dims, out.get());
+      for (size_t i = 0; i < expected.size(); ++i) {
+        double scale = std::max(1.0, std::fabs(expected[i]));
+        EXPECT_NEAR(
+            static_cast<double>(out[i]), expected[i], tolerance * scale);
+      }
+    }
+  }
+}
+
+TEST(CPUReduce, Float) {
+  CheckReduce<CPUReduceType::kSum, float>(-1.0, 1.0, 1e-5);
+  CheckReduce<CPUReduceType::kMean, float>(-1.0, 1.0, 1e-5);
+  CheckReduce<CPUReduceType::kProd, float>(0.9, 1.1, 1e-5);
+  CheckReduce<CPUReduceType::kMax, float>(-1.0, 1.0, 0);
+  CheckReduce<CPUReduceType::kMin, float>(-1.0, 1.0, 0);
+  CheckReduce<CPUReduceType::kSum, double>(-1.0, 1.0, 1e-12);
+}
+
+TEST(CPUReduce, LowPrecision) {
+  CheckReduce<CPUReduceType::kSum, phi::dtype::float16>(-1.0, 1.0, 1e-2);
+  CheckReduce<CPUReduceType::kMean, phi::dtype::bfloat16>(-1.0, 1.0, 1e-2);
+  CheckReduce<CPUReduceType::kMax, phi::dtype::float16>(-1.0, 1.0, 0);
+}
+
+TEST(CPUReduce, IntegerAndBool) {
+  CheckReduce<CPUReduceType::kSum, int64_t>(-100, 100, 0);
+  CheckReduce<CPUReduceType::kMax, int>(-100, 100, 0);
+  CheckReduce<CPUReduceType::kMin, int8_t>(-100, 100, 0);
+  CheckReduce<CPUReduceType::kAll, bool>(0, 1, 0);
+  CheckReduce<CPUReduceType::kAny, bool>(0, 1, 0);
+}
+
+TEST(CPUReduce, LargeAndNaN) {
+  // long rows split among the threads
+  std::vector<float> x(3 * 100000, 1.0f);
+  std::vector<float> out(3);
+  phi::funcs::CPUReduce<CPUReduceType::kSum, float>(
+      x.data(), {3, 100000}, {1}, out.data());
+  for (float v : out) EXPECT_NEAR(v, 100000.0f, 1e-2);
+  phi::funcs::CPUReduce<CPUReduceType::kSum, float>(
+      x.data(), {100000, 3}, {0}, out.data());
+  for (float v : out) EXPECT_NEAR(v, 100000.0f, 1e-2);
+
+  x[5] = std::numeric_limits<float>::quiet_NaN();
+  phi::funcs::CPUReduce<CPUReduceType::kMax, float>(
+      x.data(), {3, 100000}, {1}, out.data());
+  EXPECT_TRUE(std::isnan(out[0]));
+  EXPECT_EQ(out[1], 1.0f);
+}
+
+TEST(CPUReduce, Empty) {
+  std::vector<float> x(8, 1.0f);
+  std::vector<float> out(4, -1.0f);
+  // empty outputs are not written
+  phi::funcs::CPUReduce<CPUReduceType::kSum, float>(
+      x.data(), {0, 4}, {1}, out.data());
+  phi::funcs::CPUReduce<CPUReduceType::kMax, float>(
+      x.data(), {4, 0}, {0}, out.data());
+  for (float v : out) EXPECT_EQ(v, -1.0f);
+  // empty reductions give the identities
+  phi::funcs::CPUReduce<CPUReduceType::kSum, float>(
+      x.data(), {4, 0}, {1}, out.data());
+  for (float v : out) EXPECT_EQ(v, 0.0f);
+  phi::funcs::CPUReduce<CPUReduceType::kProd, float>(
+      x.data(), {0, 2, 2}, {0}, out.data());
+  for (float v : out) EXPECT_EQ(v, 1.0f);
+  phi::funcs::CPUReduce<CPUReduceType::kMax, float>(
+      x.data(), {0, 4}, {0, 1}, out.data());
+  EXPECT_EQ(out[0], -std::numeric_limits<float>::infinity());
+}
+
+}  // namespace tests
+}  // namespace phi
@@ -0,0 +1,163 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/phi/common/float16.h"
+#include "paddle/phi/kernels/funcs/cpu_sort.h"
+
+namespace phi {
+namespace tests {
+
+// Random values with many ties, and NaN, -0 and 0 for floating point.
+template <typename T>
+std::vector<T> RandomValues(int64_t n, int range, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> dist(-range, range);
+  std::vector<T> x(n);
+  for (int64_t i = 0; i < n; ++i) {
+    int v = dist(rng);
+    if (std::numeric_limits<T>::has_quiet_NaN && v == range) {
+      x[i] = std::numeric_limits<T>::quiet_NaN();
+    } else if (std::numeric_limits<T>::is_signed && v == -range) {
+      x[i] = static_cast<T>(-0.0);
+    } else {
+      x[i] = static_cast<T>(v);
+    }
+  }
+  return x;
+}
+
+// Sorts every row stably by the comparison of the values, where NaN is the
+// largest.
+template <typename T>
+void NaiveSort(const std::vector<T>& x,
+               int64_t rows,
+               int64_t cols,
+               bool descending,
+               std::vector<T>* out,
+               std::vector<int64_t>* indices) {
+  out->resize(rows * cols);
+  indices->resize(rows * cols);
+  for (int64_t i = 0; i < rows; ++i) {
+    std::vector<std::pair<T, int64_t>> row;
+    for (int64_t j = 0; j < cols; ++j) {
+      row.emplace_back(x[i * cols + j], j);
+    }
+    std::stable_sort(
+        row.begin(),
+        row.end(),
+        [descending](const std::pair<T, int64_t>& l,
+                     const std::pair<T, int64_t>& r) {
+          double a = static_cast<double>(l.first);
+          double b = static_cast<double>(r.first);
+          if (descending) {
+            return (std::isnan(a) && !std::isnan(b)) || a > b;
+          }
+          return (!std::isnan(a) && std::isnan(b)) || a < b;
+        });
+    for (int64_t j = 0; j < cols; ++j) {
+      (*out)[i * cols + j] = row[j].first;
+      (*indices)[i * cols + j] = row[j].second;
+    }
+  }
+}
+
+template <typename T>
+void ExpectSameValues(const T* expected, const T* actual, int64_t n) {
+  for (int64_t i = 0; i < n; ++i) {
+    double e = static_cast<double>(expected[i]);
+    double a = static_cast<double>(actual[i]);
+    if (std::isnan(e)) {
+      EXPECT_TRUE(std::isnan(a));
+    } else {
+      EXPECT_EQ(e, a);
+    }
+  }
+}
+
+template <typename T>
+void TestTopK(int64_t rows, int64_t cols, int64_t k, int range) {
+  auto x = RandomValues<T>(rows * cols, range, 7);
+  for (bool largest : {true, false}) {
+    std::vector<T> sorted;
+    std::vector<int64_t> sorted_indices;
+    NaiveSort(x, rows, cols, largest, &sorted, &sorted_indices);
+    std::vector<T> out(rows * k);
+    std::vector<int64_t> indices(rows * k);
+    phi::funcs::CPUTopK<T>(
+        x.data(), rows, cols, k, largest, out.data(), indices.data());
+    for (int64_t i = 0; i < rows; ++i) {
+      ExpectSameValues(sorted.data() + i * cols, out.data() + i * k, k);
+      for (int64_t j = 0; j < k; ++j) {
+        EXPECT_EQ(sorted_indices[i * cols + j], indices[i * k + j]);
+      }
+    }
+  }
+}
+
+template <typename T>
+void TestArgsort(int64_t rows, int64_t cols, int range) {
+  auto x = RandomValues<T>(rows * cols, range, 11);
+  for (bool descending : {false, true}) {
+    std::vector<T> expected;
+    std::vector<int64_t> expected_indices;
+    NaiveSort(x, rows, cols, descending, &expected, &expected_indices);
+    std::vector<T> out(rows * cols);
+    std::vector<int64_t> indices(rows * cols);
+    phi::funcs::CPUArgsort<T>(
+        x.data(), rows, cols, descending, out.data(), indices.data());
+    ExpectSameValues(expected.data(), out.data(), rows * cols);
+    for (int64_t i = 0; i < rows * cols; ++i) {
+      EXPECT_EQ(expected_indices[i], indices[i]);
+    }
+  }
+}
+
+TEST(CPUTopK, small_k_of_long_rows) {
+  TestTopK<float>(37, 5000, 5, 1000);
+  TestTopK<float>(3, 70000, 20, 100000);
+  TestTopK<double>(1, 200000, 10, 1000000);
+  TestTopK<int64_t>(2, 100000, 16, 50);
+  TestTopK<int>(1, 300000, 1, 1 << 20);
+}
+
+TEST(CPUTopK, large_k_and_ties) {
+  TestTopK<float>(5, 100, 100, 10);
+  TestTopK<float>(9, 1000, 300, 3);
+  TestTopK<int>(4, 4096, 1000, 2);
+  TestTopK<phi::dtype::float16>(6, 3000, 7, 200);
+}
+
+TEST(CPUArgsort, radix_and_compare) {
+  TestArgsort<float>(13, 100, 10);
+  TestArgsort<float>(7, 5000, 100);
+  TestArgsort<double>(3, 2000, 1000000);
+  TestArgsort<int>(5, 3000, 1 << 30);
+  TestArgsort<int64_t>(4, 1000, 20);
+}
+
+TEST(CPUArgsort, few_huge_rows) {
+  TestArgsort<float>(1, 300000, 1000000);
+  TestArgsort<int64_t>(2, 200000, 1 << 30);
+}
+
+}  // namespace tests
+}  // namespace phi
@@ -0,0 +1,176 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/phi/kernels/funcs/cpu_vec_math.h"
+
+namespace phi {
+namespace tests {
+
+using funcs::CPUVecMathOp;
+
+double Reference(CPUVecMathOp op, double x) {
+  switch (op) {
+    case CPUVecMathOp::kExp:
+      return std::exp(x);
+    case CPUVecMathOp::kLog:
+      return std::log(x);
+    case CPUVecMathOp::kTanh:
+      return std::tanh(x);
+    case CPUVecMathOp::kSigmoid:
+      return 1.0 / (1.0 + std::exp(-x));
+    case CPUVecMathOp::kSilu:
+      return x / (1.0 + std::exp(-x));
+    case CPUVecMathOp::kErf:
+      return std::erf(x);
+    case CPUVecMathOp::kGelu:
+      return 0.5 * x * (1.0 + std::erf(x * M_SQRT1_2));
+    case CPUVecMathOp::kGeluTanh:
+      return 0.5 * x *
+             (1.0 + std::tanh(std::sqrt(2.0 / M_PI) *
+                              (x + 0.044715 * x * x * x)));
+  }
+  return 0;
+}
+
+// The error of y in the ULP of the float nearest to the exact result r.
+double UlpError(double r, float y) {
+  if (std::isnan(r)) {
+    return std::isnan(y) ? 0 : 1e30;
+  }
+  float rf = static_cast<float>(r);
+  if (std::isinf(rf)) {
+    return rf == y ? 0 : 1e30;
+  }
+  int exponent = std::max(std::ilogb(rf), -126);
+  return std::fabs(y - r) / std::ldexp(1.0, exponent - 23);
+}
+
+// Checks the odd sizes, so that the tails are covered as well.
+void ExpectMaxUlp(CPUVecMathOp op, float lo, float hi, double max_ulp) {
+  const int64_t n = 100003;
+  std::vector<float> x(n);
+  for (int64_t i = 0; i < n; ++i) {
+    x[i] = lo + (hi - lo) * static_cast<float>(i) / (n - 1);
+  }
+  std::vector<float> y(n);
+  funcs::CPUVecMath(op, x.data(), y.data(), n);
+  double worst = 0;
+  for (int64_t i = 0; i < n; ++i) {
+    worst = std::max(worst, UlpError(Reference(op, x[i]), y[i]));
+  }
+  EXPECT_LE(worst, max_ulp);
+}
+
+TEST(CPUVecMath, max_ulp) {
+  ExpectMaxUlp(CPUVecMathOp::kExp, -104.0f, 89.0f, 1.3);
+  ExpectMaxUlp(CPUVecMathOp::kLog, 1e-44f, 100.0f, 0.9);
+  ExpectMaxUlp(CPUVecMathOp::kLog, 1.0f, 3e38f, 0.9);
+  ExpectMaxUlp(CPUVecMathOp::kTanh, -10.0f, 10.0f, 1.4);
+  ExpectMaxUlp(CPUVecMathOp::kSigmoid, -100.0f, 30.0f, 2.5);
+  ExpectMaxUlp(CPUVecMathOp::kSilu, -87.0f, 30.0f, 3.0);
+  ExpectMaxUlp(CPUVecMathOp::kErf, -5.0f, 5.0f, 1.4);
+  ExpectMaxUlp(CPUVecMathOp::kErf, -1e-3f, 1e-3f, 1.4);
+  ExpectMaxUlp(CPUVecMathOp::kGelu, -1.0f, 10.0f, 2.4);
+  ExpectMaxUlp(CPUVecMathOp::kGeluTanh, -1.0f, 10.0f, 3.7);
+}
+
+TEST(CPUVecMath, special_values) {
+  const float inf = std::numeric_limits<float>::infinity();
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  std::vector<float> x = {0.0f, -0.0f, inf, -inf, nan, -1.0f, 1e-45f};
+  for (auto op : {CPUVecMathOp::kExp,
+                  CPUVecMathOp::kLog,
+                  CPUVecMathOp::kTanh,
+                  CPUVecMathOp::kSigmoid,
+                  CPUVecMathOp::kErf}) {
+    std::vector<float> y(x.size());
+    funcs::CPUVecMath(op, x.data(), y.data(), x.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+      float r = static_cast<float>(Reference(op, x[i]));
+      if (std::isnan(r)) {
+        EXPECT_TRUE(std::isnan(y[i]));
+      } else {
+        EXPECT_LE(UlpError(r, y[i]), 1.0);
+        EXPECT_EQ(std::signbit(r), std::signbit(y[i]));
+      }
+    }
+  }
+}
+
+TEST(CPUVecMath, in_place_and_float16) {
+  const int64_t n = 5000;
+  std::vector<float> x(n);
+  std::vector<phi::dtype::float16> h(n);
+  for (int64_t i = 0; i < n; ++i) {
+    x[i] = static_cast<float>(i % 200 - 100) / 16;
+    h[i] = static_cast<phi::dtype::float16>(x[i]);
+  }
+  std::vector<float> y(n);
+  funcs::CPUVecMath(CPUVecMathOp::kSigmoid, x.data(), y.data(), n);
+  funcs::CPUVecMath(CPUVecMathOp::kSigmoid, x.data(), x.data(), n);
+  funcs::CPUVecMath(CPUVecMathOp::kSigmoid, h.data(), h.data(), n);
+  for (int64_t i = 0; i < n; ++i) {
+    EXPECT_EQ(y[i], x[i]);
+    EXPECT_EQ(static_cast<float>(static_cast<phi::dtype::float16>(y[i])),
+              static_cast<float>(h[i]));
+  }
+}
+
+// swiglu rounds silu(x) * y to T once, like the MPType computation of the
+// functor, so it lies between the roundings to T of the exact result with the
+// error of the float silu on either side.
+template <typename T>
+void ExpectSwiGLURoundedOnce() {
+  const int64_t n = 5003;
+  std::vector<T> x(n), y(n), z(n);
+  for (int64_t i = 0; i < n; ++i) {
+    x[i] = static_cast<T>(static_cast<float>(i % 397 - 198) / 25);
+    y[i] = static_cast<T>(static_cast<float>(i % 101 - 50) / 7);
+  }
+  funcs::CPUVecMathMul(CPUVecMathOp::kSilu, x.data(), y.data(), z.data(), n);
+  for (int64_t i = 0; i < n; ++i) {
+    double r = static_cast<float>(y[i]) *
+               Reference(CPUVecMathOp::kSilu, static_cast<float>(x[i]));
+    float lo = static_cast<T>(static_cast<float>(r - std::fabs(r) * 1e-6));
+    float hi = static_cast<T>(static_cast<float>(r + std::fabs(r) * 1e-6));
+    EXPECT_LE(lo, static_cast<float>(z[i]));
+    EXPECT_LE(static_cast<float>(z[i]), hi);
+  }
+}
+
+TEST(CPUVecMath, mul_rounded_once) {
+  ExpectSwiGLURoundedOnce<phi::dtype::float16>();
+  ExpectSwiGLURoundedOnce<phi::dtype::bfloat16>();
+
+  const int64_t n = 3000;
+  std::vector<float> x(n), y(n), z(n), silu(n);
+  for (int64_t i = 0; i < n; ++i) {
+    x[i] = static_cast<float>(i % 200 - 100) / 16;
+    y[i] = static_cast<float>(i % 77 - 38) / 5;
+  }
+  funcs::CPUVecMathMul(CPUVecMathOp::kSilu, x.data(), y.data(), z.data(), n);
+  funcs::CPUVecMath(CPUVecMathOp::kSilu, x.data(), silu.data(), n);
+  for (int64_t i = 0; i < n; ++i) {
+    EXPECT_EQ(z[i], silu[i] * y[i]);
+  }
+}
+
+}  // namespace tests
+}  // namespace phi
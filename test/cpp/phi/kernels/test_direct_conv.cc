@@ -0,0 +1,210 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/phi/kernels/funcs/direct_conv.h"
+
+namespace phi {
+namespace tests {
+
+using phi::funcs::DirectConv2DParam;
+
+// The allocation of a weight, which does not own the data.
+std::shared_ptr<phi::Allocation> FilterHolder(std::vector<double>* filter) {
+  return std::make_shared<phi::Allocation>(
+      filter->data(), filter->size() * sizeof(double), phi::CPUPlace());
+}
+
+struct NaiveConvResult {
+  std::vector<double> output;
+  std::vector<double> input_grad;
+  std::vector<double> filter_grad;
+};
+
+NaiveConvResult NaiveConv2D(const std::vector<double>& input,
+                            const std::vector<double>& filter,
+                            const std::vector<double>& output_grad,
+                            const DirectConv2DParam& p) {
+  NaiveConvResult result;
+  result.output.assign(output_grad.size(), 0);
+  result.input_grad.assign(input.size(), 0);
+  result.filter_grad.assign(filter.size(), 0);
+  int icg = p.in_per_group();
+  int ocg = p.out_per_group();
+  for (int n = 0; n < p.batch; ++n) {
+    for (int oc = 0; oc < p.out_channels; ++oc) {
+      int g = oc / ocg;
+      for (int oh = 0; oh < p.out_h; ++oh) {
+        for (int ow = 0; ow < p.out_w; ++ow) {
+          size_t y = ((static_cast<size_t>(n) * p.out_channels + oc) * p.out_h +
+                      oh) *
+                         p.out_w +
+                     ow;
+          for (int i = 0; i < icg; ++i) {
+            for (int kh = 0; kh < p.kernel_h; ++kh) {
+              for (int kw = 0; kw < p.kernel_w; ++kw) {
+                int ih = oh * p.stride_h - p.pad_top + kh * p.dilation_h;
+                int iw = ow * p.stride_w - p.pad_left + kw * p.dilation_w;
+                if (ih < 0 || ih >= p.in_h || iw < 0 || iw >= p.in_w) {
+                  continue;
+                }
+                size_t x = ((static_cast<size_t>(n) * p.in_channels +
+                             g * icg + i) *
+                                p.in_h +
+                            ih) *
+                               p.in_w +
+                           iw;
+                size_t w =
+                    ((static_cast<size_t>(oc) * icg + i) * p.kernel_h + kh) *
+                        p.kernel_w +
+                    kw;
+                result.output[y] += input[x] * filter[w];
+                result.input_grad[x] += output_grad[y] * filter[w];
+                result.filter_grad[w] += output_grad[y] * input[x];
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  return result;
+}
+
+void ExpectNear(const std::vector<double>& actual,
+                const std::vector<double>& expected) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < actual.size(); ++i) {
+    EXPECT_NEAR(actual[i], expected[i], 1e-9);
+  }
+}
+
+void CheckDirectConv2D(int groups,
+                       int icg,
+                       int ocg,
+                       int width,
+                       int stride,
+                       int pad,
+                       int dilation,
+                       std::mt19937* rng) {
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  int height = 6;
+  int kernel = 3;
+  int span = dilation * (kernel - 1) + 1;
+  int out_h = (height + 2 * pad - span) / stride + 1;
+  int out_w = (width + 2 * pad - span) / stride + 1;
+  if (out_h <= 0 || out_w <= 0) {
+    return;
+  }
+  DirectConv2DParam p{2,
+                      groups * icg,
+                      height,
+                      width,
+                      groups * ocg,
+                      out_h,
+                      out_w,
+                      kernel,
+                      kernel,
+                      stride,
+                      stride,
+                      pad,
+                      pad,
+                      dilation,
+                      dilation,
+                      groups};
+  std::vector<double> input(static_cast<size_t>(p.batch) * p.in_channels *
+                            height * width);
+  std::vector<double> filter(p.filter_numel());
+  std::vector<double> output_grad(static_cast<size_t>(p.batch) *
+                                  p.out_channels * out_h * out_w);
+  for (auto& v : input) v = dist(*rng);
+  for (auto& v : filter) v = dist(*rng);
+  for (auto& v : output_grad) v = dist(*rng);
+  NaiveConvResult expected = NaiveConv2D(input, filter, output_grad, p);
+
+  std::vector<double> output(output_grad.size());
+  std::vector<double> input_grad(input.size());
+  std::vector<double> filter_grad(filter.size());
+  auto holder = FilterHolder(&filter);
+  phi::funcs::DirectConv2DForward(
+      input.data(), filter.data(), holder, p, output.data());
+  phi::funcs::DirectConv2DBackwardInput(
+      output_grad.data(), filter.data(), holder, p, input_grad.data());
+  phi::funcs::DirectConv2DBackwardFilter(
+      input.data(), output_grad.data(), p, filter_grad.data());
+  ExpectNear(output, expected.output);
+  ExpectNear(input_grad, expected.input_grad);
+  ExpectNear(filter_grad, expected.filter_grad);
+
+  // the packed filter is cached, updating the weights in place must not
+  // reuse the stale packing
+  for (auto& v : filter) v *= 2;
+  phi::funcs::DirectConv2DForward(
+      input.data(), filter.data(), holder, p, output.data());
+  for (size_t i = 0; i < output.size(); ++i) {
+    EXPECT_NEAR(output[i], 2 * expected.output[i], 1e-9);
+  }
+}
+
+TEST(DirectConv2D, CompareWithNaive) {
+  std::mt19937 rng(7);
+  // icg of 8 fills the input channel blocks of the backward of the input,
+  // and 11 leaves a partial block
+  for (int groups : {1, 3}) {
+    for (int icg : {3, 8, 11}) {
+      for (int ocg : {1, 5, 8, 17}) {
+        for (int width : {5, 19}) {
+          for (int stride : {1, 2}) {
+            for (int pad : {0, 1}) {
+              for (int dilation : {1, 2}) {
+                CheckDirectConv2D(
+                    groups, icg, ocg, width, stride, pad, dilation, &rng);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(DirectConv2D, FilterCache) {
+  DirectConv2DParam p{1, 3, 5, 5, 16, 3, 3, 3, 3, 1, 1, 0, 0, 1, 1, 1};
+  std::vector<double> filter(p.filter_numel(), 1.0);
+  auto& cache = phi::funcs::DirectConv2DFilterCache<double>::Instance();
+  auto holder = FilterHolder(&filter);
+  auto packed = cache.Get(holder, filter.data(), p, 8, false);
+  EXPECT_EQ(cache.Get(holder, filter.data(), p, 8, false), packed);
+  // the forward and the backward packings are different entries
+  EXPECT_NE(cache.Get(holder, filter.data(), p, 8, true), packed);
+
+  // a new weight at the same address is packed again, even if its content
+  // is the same
+  holder = FilterHolder(&filter);
+  auto repacked = cache.Get(holder, filter.data(), p, 8, false);
+  EXPECT_NE(repacked, packed);
+  EXPECT_EQ(*repacked, *packed);
+  EXPECT_EQ(cache.Get(holder, filter.data(), p, 8, false), repacked);
+
+  // a weight without its allocation is not cached
+  EXPECT_NE(cache.Get(nullptr, filter.data(), p, 8, false), repacked);
+  EXPECT_EQ(cache.Get(holder, filter.data(), p, 8, false), repacked);
+}
+
+}  // namespace tests
+}  // namespace phi
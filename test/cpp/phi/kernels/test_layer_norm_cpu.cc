@@ -0,0 +1,203 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/phi/common/bfloat16.h"
+#include "paddle/phi/common/float16.h"
+#include "paddle/phi/kernels/funcs/layer_norm_cpu.h"
+
+namespace phi {
+namespace tests {
+
+constexpr float kEpsilon = 1e-5f;
+
+std::vector<double> RandomVector(int n, double lower, double upper, int seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> dist(lower, upper);
+  std::vector<double> v(n);
+  for (auto& e : v) {
+    e = dist(rng);
+  }
+  return v;
+}
+
+// loss = sum(y * w), which gives the numeric gradients of LayerNorm
+double LayerNormLoss(const std::vector<double>& x,
+                     const std::vector<double>& scale,
+                     const std::vector<double>& bias,
+                     const std::vector<double>& w,
+                     int rows,
+                     int cols) {
+  std::vector<double> y(x.size()), mean(rows), var(rows);
+  funcs::LayerNormForwardCPU<double, double, double>(x.data(),
+                                                     y.data(),
+                                                     mean.data(),
+                                                     var.data(),
+                                                     scale.data(),
+                                                     bias.data(),
+                                                     rows,
+                                                     cols,
+                                                     kEpsilon);
+  double loss = 0;
+  for (size_t i = 0; i < y.size(); ++i) {
+    loss += y[i] * w[i];
+  }
+  return loss;
+}
+
+TEST(LayerNormCPU, ForwardMatchesTwoPass) {
+  const int rows = 7;
+  for (int cols : {1, 5, 16, 17, 100, 1023}) {
+    // a large offset makes the naive sum of squares lose precision
+    auto x = RandomVector(rows * cols, 999.0, 1001.0, cols);
+    auto scale = RandomVector(cols, -2.0, 2.0, cols + 1);
+    auto bias = RandomVector(cols, -2.0, 2.0, cols + 2);
+    std::vector<double> y(x.size()), mean(rows), var(rows);
+    funcs::LayerNormForwardCPU<double, double, double>(x.data(),
+                                                       y.data(),
+                                                       mean.data(),
+                                                       var.data(),
+                                                       scale.data(),
+                                                       bias.data(),
+                                                       rows,
+                                                       cols,
+                                                       kEpsilon);
+    for (int r = 0; r < rows; ++r) {
+      double m = 0;
+      for (int j = 0; j < cols; ++j) {
+        m += x[r * cols + j];
+      }
+      m /= cols;
+      double v = 0;
+      for (int j = 0; j < cols; ++j) {
+        v += (x[r * cols + j] - m) * (x[r * cols + j] - m);
+      }
+      v /= cols;
+      EXPECT_NEAR(mean[r], m, 1e-9);
+      EXPECT_NEAR(var[r], v, 1e-9);
+      for (int j = 0; j < cols; ++j) {
+        double expected =
+            (x[r * cols + j] - m) / std::sqrt(v + kEpsilon) * scale[j] +
+            bias[j];
+        EXPECT_NEAR(y[r * cols + j], expected, 1e-6);
+      }
+    }
+  }
+}
+
+TEST(LayerNormCPU, BackwardMatchesNumeric) {
+  const int rows = 3;
+  const int cols = 37;
+  const double h = 1e-5;
+  auto x = RandomVector(rows * cols, -3.0, 3.0, 1);
+  auto scale = RandomVector(cols, -2.0, 2.0, 2);
+  auto bias = RandomVector(cols, -2.0, 2.0, 3);
+  auto w = RandomVector(rows * cols, -1.0, 1.0, 4);
+  std::vector<double> y(x.size()), mean(rows), var(rows);
+  funcs::LayerNormForwardCPU<double, double, double>(x.data(),
+                                                     y.data(),
+                                                     mean.data(),
+                                                     var.data(),
+                                                     scale.data(),
+                                                     bias.data(),
+                                                     rows,
+                                                     cols,
+                                                     kEpsilon);
+  std::vector<double> d_x(x.size()), d_scale(cols), d_bias(cols);
+  funcs::LayerNormBackwardCPU<double, double, double>(x.data(),
+                                                      w.data(),
+                                                      mean.data(),
+                                                      var.data(),
+                                                      scale.data(),
+                                                      rows,
+                                                      cols,
+                                                      kEpsilon,
+                                                      d_x.data(),
+                                                      d_scale.data(),
+                                                      d_bias.data());
+  auto numeric = [&](std::vector<double>* param, int i) {
+    double origin = (*param)[i];
+    (*param)[i] = origin + h;
+    double loss_plus = LayerNormLoss(x, scale, bias, w, rows, cols);
+    (*param)[i] = origin - h;
+    double loss_minus = LayerNormLoss(x, scale, bias, w, rows, cols);
+    (*param)[i] = origin;
+    return (loss_plus - loss_minus) / (2 * h);
+  };
+  for (int i = 0; i < rows * cols; ++i) {
+    EXPECT_NEAR(d_x[i], numeric(&x, i), 1e-5);
+  }
+  for (int j = 0; j < cols; ++j) {
+    EXPECT_NEAR(d_scale[j], numeric(&scale, j), 1e-5);
+    EXPECT_NEAR(d_bias[j], numeric(&bias, j), 1e-5);
+  }
+}
+
+template <typename T>
+void CheckLowPrecisionForward(double tolerance) {
+  const int rows = 4;
+  const int cols = 300;
+  auto x_double = RandomVector(rows * cols, -3.0, 3.0, 5);
+  auto scale_double = RandomVector(cols, -2.0, 2.0, 6);
+  std::vector<T> x(rows * cols), y(rows * cols);
+  std::vector<double> x_rounded(rows * cols), y_expected(rows * cols);
+  for (int i = 0; i < rows * cols; ++i) {
+    x[i] = static_cast<T>(x_double[i]);
+    x_rounded[i] = static_cast<float>(x[i]);
+  }
+  // scale and bias in float, as the layer_norm of AMP does
+  std::vector<float> scale(scale_double.begin(), scale_double.end());
+  std::vector<float> bias(cols, 0.5f);
+  std::vector<float> mean(rows), var(rows);
+  funcs::LayerNormForwardCPU<T, float, float>(x.data(),
+                                              y.data(),
+                                              mean.data(),
+                                              var.data(),
+                                              scale.data(),
+                                              bias.data(),
+                                              rows,
+                                              cols,
+                                              kEpsilon);
+  std::vector<double> scale_rounded(scale.begin(), scale.end());
+  std::vector<double> bias_rounded(bias.begin(), bias.end());
+  std::vector<double> mean_expected(rows), var_expected(rows);
+  funcs::LayerNormForwardCPU<double, double, double>(x_rounded.data(),
+                                                     y_expected.data(),
+                                                     mean_expected.data(),
+                                                     var_expected.data(),
+                                                     scale_rounded.data(),
+                                                     bias_rounded.data(),
+                                                     rows,
+                                                     cols,
+                                                     kEpsilon);
+  for (int r = 0; r < rows; ++r) {
+    EXPECT_NEAR(mean[r], mean_expected[r], 1e-5);
+    EXPECT_NEAR(var[r], var_expected[r], 1e-4);
+  }
+  for (int i = 0; i < rows * cols; ++i) {
+    EXPECT_NEAR(static_cast<float>(y[i]), y_expected[i], tolerance);
+  }
+}
+
+TEST(LayerNormCPU, LowPrecision) {
+  CheckLowPrecisionForward<phi::dtype::float16>(2e-2);
+  CheckLowPrecisionForward<phi::dtype::bfloat16>(1e-1);
+}
+
+}  // namespace tests
+}  // namespace phi
@@ -0,0 +1,220 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+#include "paddle/common/flags.h"
+#include "paddle/fluid/pir/dialect/operator/ir/control_flow_op.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
+#include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/interface.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/ir_binary.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/ir_deserialize.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/version_compat.h"
+#include "paddle/pir/include/core/builtin_attribute.h"
+#include "paddle/pir/include/core/builtin_dialect.h"
+#include "paddle/pir/include/core/builtin_op.h"
+#include "paddle/pir/include/core/program.h"
+#include "paddle/pir/include/dialect/control_flow/ir/cf_dialect.h"
+#include "paddle/pir/include/dialect/control_flow/ir/cf_op.h"
+
+COMMON_DECLARE_bool(save_pir_as_binary);
+
+namespace {
+
+std::string ProgramString(const std::string& file_path) {
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  pir::Program program(ctx);
+  pir::ReadModule(file_path, &program, /*pir_version*/ 0);
+  std::stringstream ss;
+  ss << program;
+  return ss.str();
+}
+
+std::string ReadFile(const std::string& file_path) {
+  std::ifstream f(file_path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(f),
+                     std::istreambuf_iterator<char>());
+}
+
+void WriteFile(const std::string& file_path, const std::string& data) {
+  std::ofstream f(file_path, std::ios::binary | std::ios::trunc);
+  f.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+// Reads a binary program with the patches of the yamls in "patch".
+void ReadBinaryModuleForTest(const std::string& file_path,
+                             pir::Program* program,
+                             uint64_t pir_version) {
+  pir::BinaryDecoder decoder(ReadFile(file_path));
+  pir::PatchBuilder builder(pir_version);
+  builder.SetFileVersion(
+      decoder.base_code().at("version").template get<uint64_t>());
+  std::filesystem::path patch_path("patch");
+  builder.BuildPatch(2, 2, patch_path.string());
+  pir::ProgramReader reader(pir_version);
+  reader.RecoverProgram(&decoder, program, &builder);
+}
+
+}  // namespace
+
+TEST(SaveLoadTest, binary_same_as_json) {
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  ctx->GetOrRegisterDialect<pir::BuiltinDialect>();
+  ctx->GetOrRegisterDialect<pir::ControlFlowDialect>();
+  pir::Program program(ctx);
+  pir::Builder builder(ctx, program.block());
+
+  auto x = builder
+               .Build<paddle::dialect::FullOp>(
+                   std::vector<int64_t>{64, 64}, 1.5, phi::DataType::FLOAT32)
+               .out();
+  auto y = builder
+               .Build<paddle::dialect::FullOp>(
+                   std::vector<int64_t>{64, 64}, 2.5, phi::DataType::FLOAT32)
+               .out();
+  auto sum = builder.Build<paddle::dialect::AddOp>(x, y).out();
+  auto cond = builder
+                  .Build<paddle::dialect::FullOp>(
+                      std::vector<int64_t>{1}, true, phi::DataType::BOOL)
+                  .out();
+  auto if_op = builder.Build<paddle::dialect::IfOp>(
+      cond, std::vector<pir::Type>{sum.type()});
+  builder.SetInsertionPointToStart(&if_op.true_block());
+  auto true_out = builder.Build<paddle::dialect::AddOp>(sum, x).out();
+  builder.Build<pir::YieldOp>(std::vector<pir::Value>{true_out});
+  builder.SetInsertionPointToStart(&if_op.false_block());
+  auto false_out = builder.Build<paddle::dialect::AddOp>(sum, y).out();
+  builder.Build<pir::YieldOp>(std::vector<pir::Value>{false_out});
+  builder.SetInsertionPointAfter(if_op);
+  builder.Build<paddle::dialect::AddOp>(if_op.result(0), sum);
+
+  FLAGS_save_pir_as_binary = false;
+  pir::WriteModule(
+      program, "./test_save_load_json", /*pir_version*/ 0, true, false, true);
+  FLAGS_save_pir_as_binary = true;
+  pir::WriteModule(
+      program, "./test_save_load_binary", /*pir_version*/ 0, true, false, true);
+  FLAGS_save_pir_as_binary = false;
+
+  std::string json_program = ProgramString("./test_save_load_json");
+  std::string binary_program = ProgramString("./test_save_load_binary");
+  EXPECT_EQ(binary_program, json_program);
+  EXPECT_LT(std::filesystem::file_size("./test_save_load_binary"),
+            std::filesystem::file_size("./test_save_load_json"));
+}
+
+// The patched ops have their types and attributes expanded from the value
+// table before the patches apply.
+TEST(SaveLoadTest, binary_with_patch) {
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  ctx->GetOrRegisterDialect<pir::BuiltinDialect>();
+  pir::Program program(ctx);
+  pir::Type fp32_dtype = pir::Float32Type::get(ctx);
+
+  pir::OpInfo param_info =
+      ctx->GetRegisteredOpInfo(pir::ParameterOp::name());
+  pir::Operation* param_op = pir::Operation::Create(
+      {},
+      {{"parameter_name", pir::StrAttribute::get(ctx, "a")}},
+      {fp32_dtype},
+      param_info);
+  program.block()->push_back(param_op);
+  pir::OpInfo constant_info =
+      ctx->GetRegisteredOpInfo(pir::ConstantOp::name());
+  pir::Operation* constant_op = pir::Operation::Create(
+      {},
+      {{"value", pir::FloatAttribute::get(ctx, 2.0)}},
+      {fp32_dtype},
+      constant_info);
+  program.block()->push_back(constant_op);
+
+  FLAGS_save_pir_as_binary = true;
+  pir::WriteModule(program,
+                   "./test_save_load_binary_patch",
+                   /*pir_version*/ 1,
+                   true,
+                   false,
+                   true);
+  FLAGS_save_pir_as_binary = false;
+
+  pir::Program new_program(ctx);
+  ReadBinaryModuleForTest("./test_save_load_binary_patch", &new_program, 2);
+
+  ASSERT_EQ(new_program.block()->size(), 2u);
+  // In patch yaml, the value of attribute "parameter_name" in builtin.parameter
+  // is changed into "fc_0"
+  EXPECT_EQ(new_program.block()
+                ->front()
+                .attribute("parameter_name")
+                .dyn_cast<pir::StrAttribute>()
+                .AsString(),
+            "fc_0");
+  // In patch yaml, the value of attribute "value" in builtin.constant is
+  // changed into 1.0, and FloatAttribute is changed into DoubleAttribute.
+  EXPECT_EQ(new_program.block()
+                ->back()
+                .attribute("value")
+                .dyn_cast<pir::DoubleAttribute>()
+                .data(),
+            1.0);
+  // In patch yaml, the type of Float32Type is changed into Float64Type
+  EXPECT_EQ(new_program.block()->front().result(0).type(),
+            pir::Float64Type::get(ctx));
+  EXPECT_EQ(new_program.block()->back().result(0).type(),
+            pir::Float64Type::get(ctx));
+}
+
+TEST(SaveLoadTest, binary_truncated) {
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  ctx->GetOrRegisterDialect<pir::BuiltinDialect>();
+  pir::Program program(ctx);
+  pir::Builder builder(ctx, program.block());
+  auto x = builder
+               .Build<paddle::dialect::FullOp>(
+                   std::vector<int64_t>{64, 64}, 1.5, phi::DataType::FLOAT32)
+               .out();
+  builder.Build<paddle::dialect::AddOp>(x, x);
+
+  FLAGS_save_pir_as_binary = true;
+  pir::WriteModule(program,
+                   "./test_save_load_binary_full",
+                   /*pir_version*/ 0,
+                   true,
+                   false,
+                   true);
+  FLAGS_save_pir_as_binary = false;
+
+  std::string data = ReadFile("./test_save_load_binary_full");
+  ASSERT_GT(data.size(), std::strlen(BINARY_MAGIC) + 1);
+  for (size_t size : {std::strlen(BINARY_MAGIC),
+                      std::strlen(BINARY_MAGIC) + 1,
+                      data.size() / 2,
+                      data.size() - 1}) {
+    WriteFile("./test_save_load_binary_truncated", data.substr(0, size));
+    pir::Program new_program(ctx);
+    EXPECT_ANY_THROW(pir::ReadModule(
+        "./test_save_load_binary_truncated", &new_program, /*pir_version*/ 0))
+        << "truncated at " << size;
+  }
+}